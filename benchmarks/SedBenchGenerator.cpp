@@ -0,0 +1,320 @@
+/**
+ * @file   SedBenchGenerator.cpp
+ * @brief  Synthetic documents for the benchmark suite
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include "SedBenchGenerator.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <sbml/math/FormulaParser.h>
+
+using namespace std;
+
+
+static string
+name(const char* prefix, unsigned int n)
+{
+  ostringstream text;
+  text << prefix << n;
+  return text.str();
+}
+
+
+static ASTNode*
+parse(const string& formula)
+{
+  return SBML_parseFormula(formula.c_str());
+}
+
+
+SedBenchSize
+SedBenchSize::scaled(unsigned int scale, unsigned int nestingDepth,
+                     unsigned int rangeLength)
+{
+  SedBenchSize size;
+  size.numModels = scale;
+  size.numTasks = scale;
+  size.numRepeatedTasks = (scale + 9) / 10;
+  size.nestingDepth = nestingDepth;
+  size.rangeLength = rangeLength;
+  size.numDataGenerators = 4 * scale;
+  size.numOutputs = (scale + 9) / 10;
+  return size;
+}
+
+
+SedBenchGenerator::SedBenchGenerator(const SedBenchSize& size)
+  : mSize(size)
+{
+  if (mSize.numModels == 0) mSize.numModels = 1;
+  if (mSize.numTasks == 0) mSize.numTasks = 1;
+  if (mSize.nestingDepth == 0) mSize.nestingDepth = 1;
+}
+
+
+const SedBenchSize&
+SedBenchGenerator::getSize() const
+{
+  return mSize;
+}
+
+
+SedDocument*
+SedBenchGenerator::generate(bool useStringPool) const
+{
+  SedDocument* doc = new SedDocument(1, 2);
+  doc->getStringPool().setEnabled(useStringPool);
+
+  SedUniformTimeCourse* timeCourse = doc->createUniformTimeCourse();
+  timeCourse->setId("timeCourse");
+  timeCourse->setInitialTime(0);
+  timeCourse->setOutputStartTime(0);
+  timeCourse->setOutputEndTime(100);
+  timeCourse->setNumberOfPoints(1000);
+  timeCourse->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedSteadyState* steadyState = doc->createSteadyState();
+  steadyState->setId("steadyState");
+  steadyState->createAlgorithm()->setKisaoID("KISAO:0000282");
+
+  addModels(doc);
+  addTasks(doc);
+  addRepeatedTasks(doc);
+  addDataGenerators(doc);
+  addOutputs(doc);
+
+  return doc;
+}
+
+
+vector<string>
+SedBenchGenerator::getIds() const
+{
+  vector<string> ids;
+
+  for (unsigned int i = 0; i < mSize.numModels; ++i)
+    ids.push_back(name("model", i));
+
+  for (unsigned int i = 0; i < mSize.numTasks; ++i)
+    ids.push_back(name("task", i));
+
+  for (unsigned int i = 0; i < mSize.numDataGenerators; ++i)
+    ids.push_back(name("dg", i));
+
+  for (unsigned int i = 0; i < mSize.numOutputs; ++i)
+    ids.push_back(name("output", i));
+
+  // a fixed permutation, so that lookups do not follow document order
+  unsigned int state = 12345;
+  for (size_t i = ids.size(); i > 1; --i)
+  {
+    state = state * 1103515245u + 12345u;
+    swap(ids[i - 1], ids[(state >> 8) % i]);
+  }
+
+  return ids;
+}
+
+
+void
+SedBenchGenerator::addModels(SedDocument* doc) const
+{
+  for (unsigned int i = 0; i < mSize.numModels; ++i)
+  {
+    SedModel* model = doc->createModel();
+    model->setId(name("model", i));
+    model->setLanguage("urn:sedml:language:sbml");
+
+    // every tenth model is derived from the one before it
+    if (i % 10 == 9)
+      model->setSource(name("#model", i - 1));
+    else
+      model->setSource(name("urn:miriam:biomodels.db:BIOMD", 1000000 + i));
+
+    SedChangeAttribute* change = model->createChangeAttribute();
+    change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']/@value");
+    change->setNewValue(name("", i + 1));
+
+    SedComputeChange* compute = model->createComputeChange();
+    compute->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k2']/@value");
+    SedVariable* variable = compute->createVariable();
+    variable->setId("k1");
+    variable->setModelReference(model->getId());
+    variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']");
+    ASTNode* math = parse("2 * k1");
+    compute->setMath(math);
+    delete math;
+  }
+}
+
+
+void
+SedBenchGenerator::addTasks(SedDocument* doc) const
+{
+  for (unsigned int i = 0; i < mSize.numTasks; ++i)
+  {
+    SedTask* task = doc->createTask();
+    task->setId(name("task", i));
+    task->setModelReference(name("model", i % mSize.numModels));
+    task->setSimulationReference(i % 5 == 4 ? "steadyState" : "timeCourse");
+  }
+}
+
+
+void
+SedBenchGenerator::addRepeatedTasks(SedDocument* doc) const
+{
+  vector<double> values(mSize.rangeLength);
+  for (unsigned int i = 0; i < mSize.rangeLength; ++i)
+    values[i] = 0.5 + 0.001 * i;
+
+  for (unsigned int i = 0; i < mSize.numRepeatedTasks; ++i)
+  {
+    // each level repeats the one below it, the lowest repeats a task
+    string inner = name("task", i % mSize.numTasks);
+    string model = name("model", i % mSize.numTasks % mSize.numModels);
+
+    for (unsigned int depth = 0; depth < mSize.nestingDepth; ++depth)
+    {
+      ostringstream id;
+      id << "repeated" << i << "_" << depth;
+
+      SedRepeatedTask* repeated = doc->createRepeatedTask();
+      repeated->setId(id.str());
+      repeated->setRangeId("range");
+      repeated->setResetModel(depth == 0);
+
+      SedVectorRange* range = repeated->createVectorRange();
+      range->setId("range");
+      range->setValues(values);
+
+      SedUniformRange* uniform = repeated->createUniformRange();
+      uniform->setId("uniform");
+      uniform->setStart(0);
+      uniform->setEnd(10);
+      uniform->setNumberOfPoints(100);
+      uniform->setType("linear");
+
+      SedSetValue* setValue = repeated->createTaskChange();
+      setValue->setModelReference(model);
+      setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']/@value");
+      setValue->setRange("range");
+      ASTNode* math = parse("range * uniform");
+      setValue->setMath(math);
+      delete math;
+
+      SedSubTask* subTask = repeated->createSubTask();
+      subTask->setTask(inner);
+      subTask->setOrder(1);
+
+      inner = id.str();
+    }
+  }
+}
+
+
+void
+SedBenchGenerator::addDataGenerators(SedDocument* doc) const
+{
+  for (unsigned int i = 0; i < mSize.numDataGenerators; ++i)
+  {
+    SedDataGenerator* dg = doc->createDataGenerator();
+    dg->setId(name("dg", i));
+
+    string task = name("task", i % mSize.numTasks);
+
+    SedVariable* time = dg->createVariable();
+    time->setId("time");
+    time->setTaskReference(task);
+    time->setSymbol("urn:sedml:symbol:time");
+
+    SedVariable* species = dg->createVariable();
+    species->setId("S");
+    species->setTaskReference(task);
+    species->setTarget(name("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S", i % 16) + "']");
+
+    SedParameter* parameter = dg->createParameter();
+    parameter->setId("scale");
+    parameter->setValue(1.0 + i);
+
+    ASTNode* math = parse("scale * S / (1 + exp(-time))");
+    dg->setMath(math);
+    delete math;
+  }
+}
+
+
+void
+SedBenchGenerator::addOutputs(SedDocument* doc) const
+{
+  if (mSize.numDataGenerators == 0) return;
+
+  for (unsigned int i = 0; i < mSize.numOutputs; ++i)
+  {
+    // ten columns or curves each, referring to consecutive data generators
+    if (i % 2 == 0)
+    {
+      SedReport* report = doc->createReport();
+      report->setId(name("output", i));
+
+      for (unsigned int j = 0; j < 10; ++j)
+      {
+        SedDataSet* dataSet = report->createDataSet();
+        dataSet->setId(name("ds", j));
+        dataSet->setLabel(name("column ", j));
+        dataSet->setDataReference(name("dg", (i * 10 + j) % mSize.numDataGenerators));
+      }
+    }
+    else
+    {
+      SedPlot2D* plot = doc->createPlot2D();
+      plot->setId(name("output", i));
+
+      for (unsigned int j = 0; j < 10; ++j)
+      {
+        SedCurve* curve = plot->createCurve();
+        curve->setId(name("curve", j));
+        curve->setLogX(false);
+        curve->setLogY(false);
+        curve->setXDataReference(name("dg", (i * 10) % mSize.numDataGenerators));
+        curve->setYDataReference(name("dg", (i * 10 + j) % mSize.numDataGenerators));
+      }
+    }
+  }
+}
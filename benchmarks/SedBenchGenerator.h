@@ -0,0 +1,123 @@
+/**
+ * @file   SedBenchGenerator.h
+ * @brief  Synthetic documents for the benchmark suite
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedBenchGenerator
+ * @brief Builds synthetic SED-ML documents of a given size.
+ *
+ * Every element that the benchmarks measure is present in numbers that
+ * scale with the size: models with changes, simulations, tasks, chains of
+ * nested repeated tasks with long vector ranges and set values, data
+ * generators with math and reports and plots over them.  The documents
+ * are built through the API, so they are identical on every run and on
+ * every platform.
+ */
+
+#ifndef SedBenchGenerator_h
+#define SedBenchGenerator_h
+
+
+#include <string>
+#include <vector>
+#include <sedml/SedTypes.h>
+
+LIBSEDML_CPP_NAMESPACE_USE
+
+
+/*
+ * The counts of elements in a synthetic document.
+ */
+struct SedBenchSize
+{
+  unsigned int numModels;
+  unsigned int numTasks;
+  unsigned int numRepeatedTasks;
+  unsigned int nestingDepth;
+  unsigned int rangeLength;
+  unsigned int numDataGenerators;
+  unsigned int numOutputs;
+
+  /*
+   * The counts for the given scale: one model and one task per unit, a
+   * chain of repeated tasks per ten units, four data generators per unit
+   * and one output per ten.
+   */
+  static SedBenchSize scaled(unsigned int scale,
+                             unsigned int nestingDepth = 3,
+                             unsigned int rangeLength = 1000);
+};
+
+
+class SedBenchGenerator
+{
+public:
+
+  /*
+   * Creates a generator for documents of the given size.
+   */
+  SedBenchGenerator(const SedBenchSize& size);
+
+
+  /*
+   * Returns a new document; the caller owns it.  With useStringPool false
+   * every object keeps its own copy of its strings, which shows what the
+   * string pool of the document saves.
+   */
+  SedDocument* generate(bool useStringPool = true) const;
+
+
+  /*
+   * The ids of all models, tasks, data generators and outputs of the
+   * generated documents, in a fixed shuffled order, for lookups.
+   */
+  std::vector<std::string> getIds() const;
+
+
+  const SedBenchSize& getSize() const;
+
+
+private:
+  void addModels(SedDocument* doc) const;
+  void addTasks(SedDocument* doc) const;
+  void addRepeatedTasks(SedDocument* doc) const;
+  void addDataGenerators(SedDocument* doc) const;
+  void addOutputs(SedDocument* doc) const;
+
+  SedBenchSize mSize;
+};
+
+
+#endif  /* SedBenchGenerator_h */
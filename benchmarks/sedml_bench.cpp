@@ -0,0 +1,681 @@
+/**
+ * @file   sedml_bench.cpp
+ * @brief  Benchmark suite for reading, writing and walking documents
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sedml/SedTypes.h>
+#include <sedml/SedTypedVisitor.h>
+#include <sedml/common/libsedml-version.h>
+
+#include "SedBenchGenerator.h"
+
+using namespace std;
+
+
+/*
+ * The heap bytes in use, counted by the replaced global operators so that
+ * the generate operations can report the size of a document.
+ */
+static size_t liveBytes = 0;
+
+#if __cplusplus >= 201103L
+void* operator new(size_t size)
+#else
+void* operator new(size_t size) throw(std::bad_alloc)
+#endif
+{
+  size_t* block = (size_t*)malloc(size + sizeof(size_t) * 2);
+
+  if (block == NULL) throw std::bad_alloc();
+
+  block[0] = size;
+  liveBytes += size;
+  return block + 2;
+}
+
+void operator delete(void* pointer) throw()
+{
+  if (pointer == NULL) return;
+
+  size_t* block = (size_t*)pointer - 2;
+  liveBytes -= block[0];
+  free(block);
+}
+
+
+/*
+ * Counts the objects of a document.
+ */
+class CountingVisitor : public SedVisitor
+{
+public:
+  CountingVisitor() : numObjects(0) {}
+
+  virtual bool visit(const SedBase&)
+  {
+    ++numObjects;
+    return true;
+  }
+
+  unsigned long numObjects;
+};
+
+
+/*
+ * Checks the required attributes and elements of every object.
+ */
+class CheckingVisitor : public SedVisitor
+{
+public:
+  CheckingVisitor() : numInvalid(0) {}
+
+  virtual bool visit(const SedBase& x)
+  {
+    if (!x.hasRequiredAttributes() || !x.hasRequiredElements())
+      ++numInvalid;
+    return true;
+  }
+
+  unsigned long numInvalid;
+};
+
+
+/*
+ * The number of objects of each kind that the classify operations tell
+ * apart.
+ */
+struct Counts
+{
+  unsigned long ranges[3];
+  unsigned long tasks[2];
+  unsigned long outputs[3];
+  unsigned long curves[2];
+  unsigned long other;
+
+  Counts() : other(0)
+  {
+    ranges[0] = ranges[1] = ranges[2] = 0;
+    tasks[0] = tasks[1] = 0;
+    outputs[0] = outputs[1] = outputs[2] = 0;
+    curves[0] = curves[1] = 0;
+  }
+
+  bool operator==(const Counts& rhs) const
+  {
+    for (int n = 0; n < 3; ++n)
+      if (ranges[n] != rhs.ranges[n] || outputs[n] != rhs.outputs[n])
+        return false;
+    return tasks[0] == rhs.tasks[0] && tasks[1] == rhs.tasks[1]
+           && curves[0] == rhs.curves[0] && curves[1] == rhs.curves[1]
+           && other == rhs.other;
+  }
+};
+
+
+/*
+ * The way print_sedml tells the classes apart: derived classes are tried
+ * before their bases.
+ */
+static void
+classify(const SedBase* current, Counts& counts)
+{
+  if (dynamic_cast<const SedFunctionalRange*>(current) != NULL)
+    ++counts.ranges[0];
+  else if (dynamic_cast<const SedVectorRange*>(current) != NULL)
+    ++counts.ranges[1];
+  else if (dynamic_cast<const SedUniformRange*>(current) != NULL)
+    ++counts.ranges[2];
+  else if (dynamic_cast<const SedRepeatedTask*>(current) != NULL)
+    ++counts.tasks[0];
+  else if (dynamic_cast<const SedTask*>(current) != NULL)
+    ++counts.tasks[1];
+  else if (dynamic_cast<const SedPlot2D*>(current) != NULL)
+    ++counts.outputs[0];
+  else if (dynamic_cast<const SedPlot3D*>(current) != NULL)
+    ++counts.outputs[1];
+  else if (dynamic_cast<const SedReport*>(current) != NULL)
+    ++counts.outputs[2];
+  else if (dynamic_cast<const SedSurface*>(current) != NULL)
+    ++counts.curves[0];
+  else if (dynamic_cast<const SedCurve*>(current) != NULL)
+    ++counts.curves[1];
+  else
+    ++counts.other;
+}
+
+
+static void
+classifyWithCasts(const SedDocument& doc, Counts& counts)
+{
+  vector<const SedBase*> stack(1, &doc);
+
+  while (!stack.empty())
+  {
+    const SedBase* current = stack.back();
+    stack.pop_back();
+    classify(current, counts);
+    current->getChildObjects(stack);
+  }
+}
+
+
+/*
+ * The same classification through SedTypedVisitor.
+ */
+class Classifier : public SedTypedVisitor<Classifier>
+{
+public:
+  Counts counts;
+
+  bool visitFunctionalRange(const SedFunctionalRange&) { ++counts.ranges[0]; return true; }
+  bool visitVectorRange(const SedVectorRange&) { ++counts.ranges[1]; return true; }
+  bool visitUniformRange(const SedUniformRange&) { ++counts.ranges[2]; return true; }
+  bool visitRepeatedTask(const SedRepeatedTask&) { ++counts.tasks[0]; return true; }
+  bool visitTask(const SedTask&) { ++counts.tasks[1]; return true; }
+  bool visitPlot2D(const SedPlot2D&) { ++counts.outputs[0]; return true; }
+  bool visitPlot3D(const SedPlot3D&) { ++counts.outputs[1]; return true; }
+  bool visitReport(const SedReport&) { ++counts.outputs[2]; return true; }
+  bool visitSurface(const SedSurface&) { ++counts.curves[0]; return true; }
+  bool visitCurve(const SedCurve&) { ++counts.curves[1]; return true; }
+  bool visitBase(const SedBase&) { ++counts.other; return true; }
+};
+
+
+/*
+ * Adds a model with one change attribute per parameter of the SBML model
+ * returned, for the changes operation.
+ */
+static string
+createChangeModel(SedDocument& doc, unsigned int numChanges)
+{
+  static const char* SBML_NS = "http://www.sbml.org/sbml/level3/version1/core";
+  doc.getNamespaces()->add(SBML_NS, "sbml");
+
+  SedModel* model = doc.createModel();
+  model->setId("model1");
+  model->setLanguage("urn:sedml:language:sbml");
+  model->setSource("bench.xml");
+
+  ostringstream source;
+  source << "<sbml xmlns='" << SBML_NS << "' level='3' version='1'>"
+         << "<model id='bench'><listOfParameters>";
+
+  for (unsigned int n = 0; n < numChanges; ++n)
+  {
+    ostringstream target;
+    target << "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='p"
+           << n << "']/@value";
+
+    SedChangeAttribute* change = model->createChangeAttribute();
+    change->setTarget(target.str());
+    change->setNewValue(SedBase::attributeValueToString(n * 0.5));
+
+    source << "<parameter id='p" << n << "' value='1' constant='true'/>";
+  }
+
+  source << "</listOfParameters></model></sbml>";
+  return source.str();
+}
+
+
+/*
+ * Fills steps with irregular solver steps from 0 to 100 and values with
+ * numColumns values per step, for the resample operation.
+ */
+static void
+createSolverOutput(unsigned int numSteps, unsigned int numColumns,
+                   vector<double>& steps, vector<double>& values)
+{
+  steps.resize(numSteps + 1);
+  values.resize((size_t)(numSteps + 1) * numColumns);
+  srand(1);
+
+  for (unsigned int k = 0; k <= numSteps; ++k)
+  {
+    steps[k] = k == 0 ? 0 : steps[k - 1] + 0.5 + (double)rand() / RAND_MAX;
+
+    for (unsigned int j = 0; j < numColumns; ++j)
+      values[(size_t)k * numColumns + j] = k + j;
+  }
+
+  for (unsigned int k = 0; k <= numSteps; ++k)
+    steps[k] *= 100 / steps[numSteps];
+}
+
+
+/*
+ * The timings of one operation at one size.
+ */
+struct Measurement
+{
+  string operation;
+  unsigned int scale;
+  unsigned long numObjects;
+  unsigned long bytes;
+  unsigned long heapBytes;
+  vector<double> seconds;
+};
+
+
+static double
+seconds(clock_t start)
+{
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+
+static double
+minimum(const vector<double>& values)
+{
+  double result = values.empty() ? 0 : values[0];
+  for (size_t n = 1; n < values.size(); ++n)
+    if (values[n] < result) result = values[n];
+  return result;
+}
+
+
+static double
+mean(const vector<double>& values)
+{
+  double sum = 0;
+  for (size_t n = 0; n < values.size(); ++n)
+    sum += values[n];
+  return values.empty() ? 0 : sum / values.size();
+}
+
+
+static string
+json(double value)
+{
+  char text[32];
+  sprintf(text, "%.9g", value);
+  return text;
+}
+
+
+static bool
+contains(const vector<string>& operations, const string& operation)
+{
+  if (operations.empty()) return true;
+
+  for (size_t n = 0; n < operations.size(); ++n)
+    if (operations[n] == operation) return true;
+
+  return false;
+}
+
+
+/*
+ * Runs every selected operation repeats times on a document of the given
+ * scale; returns false if a result does not match the document.
+ */
+static bool
+run(unsigned int scale, unsigned int repeats,
+    const vector<string>& operations, vector<Measurement>& results)
+{
+  SedBenchGenerator generator(SedBenchSize::scaled(scale));
+  vector<string> ids = generator.getIds();
+  bool ok = true;
+
+  SedDocument* doc = generator.generate();
+  CountingVisitor counter;
+  doc->accept(counter);
+
+  SedWriter writer;
+  char* text = writer.writeSedMLToString(doc);
+  string xml = text != NULL ? text : "";
+  free(text);
+
+  Measurement base;
+  base.scale = scale;
+  base.numObjects = counter.numObjects;
+  base.bytes = (unsigned long)xml.size();
+  base.heapBytes = 0;
+
+  // the inputs of the remaining operations, built only when they run
+  SedDocument changeDoc;
+  string changeSource;
+  if (contains(operations, "changes"))
+    changeSource = createChangeModel(changeDoc, 10 * scale);
+
+  const unsigned int numColumns = 16;
+  vector<double> steps;
+  vector<double> values;
+  if (contains(operations, "resample"))
+    createSolverOutput(50 * scale, numColumns, steps, values);
+
+  Counts expected;
+  if (contains(operations, "classify-cast")
+      || contains(operations, "classify-typed"))
+    classifyWithCasts(*doc, expected);
+
+  string data;
+  if (contains(operations, "deserialize"))
+    data = SedSerializer::serialize(doc);
+
+  const char* names[] = { "generate", "generate-unpooled", "write", "parse",
+                          "scan", "clone", "lookup", "traverse", "validate",
+                          "classify-cast", "classify-typed", "serialize",
+                          "deserialize", "changes", "resample" };
+
+  for (size_t op = 0; op < sizeof(names) / sizeof(names[0]); ++op)
+  {
+    if (!contains(operations, names[op])) continue;
+
+    Measurement measurement = base;
+    measurement.operation = names[op];
+
+    for (unsigned int r = 0; r < repeats; ++r)
+    {
+      clock_t start = clock();
+
+      if (measurement.operation == "generate"
+          || measurement.operation == "generate-unpooled")
+      {
+        size_t before = liveBytes;
+        SedDocument* generated =
+          generator.generate(measurement.operation == "generate");
+        measurement.heapBytes = (unsigned long)(liveBytes - before);
+        delete generated;
+      }
+      else if (measurement.operation == "write")
+      {
+        char* written = writer.writeSedMLToString(doc);
+        ok = ok && written != NULL && xml.size() == strlen(written);
+        free(written);
+      }
+      else if (measurement.operation == "parse")
+      {
+        SedReader reader;
+        SedDocument* parsed = reader.readSedMLFromString(xml);
+        ok = ok && parsed != NULL && parsed->getNumErrors(LIBSEDML_SEV_ERROR) == 0
+             && parsed->getNumDataGenerators() == doc->getNumDataGenerators();
+        delete parsed;
+      }
+      else if (measurement.operation == "scan")
+      {
+        // what an indexer needs: model sources and simulation algorithms
+        SedReader reader;
+        reader.addTypeToRead(SEDML_MODEL);
+        reader.addTypeToRead(SEDML_SIMULATION);
+        reader.addTypeToRead(SEDML_SIMULATION_ALGORITHM);
+        SedDocument* parsed = reader.readSedMLFromString(xml);
+        ok = ok && parsed != NULL && parsed->getNumErrors(LIBSEDML_SEV_ERROR) == 0
+             && parsed->getNumModels() == doc->getNumModels()
+             && parsed->getNumSimulations() == doc->getNumSimulations()
+             && parsed->getNumDataGenerators() == 0;
+        delete parsed;
+      }
+      else if (measurement.operation == "clone")
+      {
+        delete doc->clone();
+      }
+      else if (measurement.operation == "lookup")
+      {
+        unsigned long found = 0;
+        for (size_t n = 0; n < ids.size(); ++n)
+        {
+          const string& id = ids[n];
+          if (doc->getModel(id) != NULL || doc->getTask(id) != NULL
+              || doc->getDataGenerator(id) != NULL
+              || doc->getOutput(id) != NULL)
+            ++found;
+        }
+        ok = ok && found == ids.size();
+      }
+      else if (measurement.operation == "traverse")
+      {
+        CountingVisitor visitor;
+        doc->accept(visitor);
+        ok = ok && visitor.numObjects == counter.numObjects;
+      }
+      else if (measurement.operation == "validate")
+      {
+        // required attributes and elements, then every reference from
+        // the outputs down to the models
+        CheckingVisitor checker;
+        doc->accept(checker);
+
+        SedDependencyGraph graph(doc);
+        vector<const SedBase*> closure;
+        for (unsigned int n = 0; n < doc->getNumOutputs(); ++n)
+          graph.getClosure(doc->getOutput(n), closure);
+
+        ok = ok && checker.numInvalid == 0;
+      }
+      else if (measurement.operation == "classify-cast")
+      {
+        Counts counts;
+        classifyWithCasts(*doc, counts);
+        ok = ok && counts == expected;
+      }
+      else if (measurement.operation == "classify-typed")
+      {
+        Classifier classifier;
+        classifier.traverse(*doc);
+        ok = ok && classifier.counts == expected;
+      }
+      else if (measurement.operation == "serialize")
+      {
+        ok = ok && !SedSerializer::serialize(doc).empty();
+      }
+      else if (measurement.operation == "deserialize")
+      {
+        SedDocument* read = SedSerializer::deserialize(data);
+        ok = ok && read != NULL
+             && read->getNumDataGenerators() == doc->getNumDataGenerators();
+        delete read;
+      }
+      else if (measurement.operation == "changes")
+      {
+        // only applying the changes is timed, not parsing the model
+        XMLNode* model = XMLNode::convertStringToXMLNode(changeSource);
+        start = clock();
+
+        SedChangeEngine engine(model, changeDoc.getNamespaces());
+        ok = ok && engine.apply(changeDoc.getModel(0))
+                   == LIBSEDML_OPERATION_SUCCESS;
+
+        measurement.seconds.push_back(seconds(start));
+        delete model;
+        continue;
+      }
+      else if (measurement.operation == "resample")
+      {
+        SedTimeGrid grid(0, 100, 100 * scale);
+        vector<double> result((size_t)grid.getNumTimes() * numColumns);
+        ok = ok && grid.resample(&steps[0], (unsigned int)steps.size(),
+                                 &values[0], numColumns, &result[0])
+                   == LIBSEDML_OPERATION_SUCCESS;
+      }
+
+      measurement.seconds.push_back(seconds(start));
+    }
+
+    results.push_back(measurement);
+  }
+
+  delete doc;
+  return ok;
+}
+
+
+static void
+writeJson(ostream& out, unsigned int repeats,
+          const vector<Measurement>& results)
+{
+  out << "{\n"
+      << "  \"library\": \"libsedml\",\n"
+      << "  \"version\": \"" << LIBSEDML_DOTTED_VERSION << "\",\n"
+      << "  \"repeats\": " << repeats << ",\n"
+      << "  \"timestamp\": " << (unsigned long)time(NULL) << ",\n"
+      << "  \"results\": [";
+
+  for (size_t n = 0; n < results.size(); ++n)
+  {
+    const Measurement& m = results[n];
+    out << (n == 0 ? "\n" : ",\n")
+        << "    {\"operation\": \"" << m.operation << "\""
+        << ", \"scale\": " << m.scale
+        << ", \"objects\": " << m.numObjects
+        << ", \"bytes\": " << m.bytes;
+
+    if (m.heapBytes != 0)
+      out << ", \"heap_bytes\": " << m.heapBytes;
+
+    out << ", \"min_seconds\": " << json(minimum(m.seconds))
+        << ", \"mean_seconds\": " << json(mean(m.seconds))
+        << ", \"seconds\": [";
+
+    for (size_t r = 0; r < m.seconds.size(); ++r)
+      out << (r == 0 ? "" : ", ") << json(m.seconds[r]);
+
+    out << "]}";
+  }
+
+  out << "\n  ]\n}\n";
+}
+
+
+static void
+usage()
+{
+  cerr << "usage: sedml-bench [--sizes 10,100,1000] [--repeats 5]\n"
+       << "                   [--only write,parse,...] [--output results.json]\n"
+       << "\n"
+       << "operations: generate generate-unpooled write parse scan clone lookup\n"
+       << "            traverse validate classify-cast classify-typed serialize\n"
+       << "            deserialize changes resample\n";
+}
+
+
+static vector<string>
+split(const string& text)
+{
+  vector<string> parts;
+  stringstream stream(text);
+  string part;
+
+  while (getline(stream, part, ','))
+    if (!part.empty()) parts.push_back(part);
+
+  return parts;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  vector<unsigned int> sizes;
+  unsigned int repeats = 5;
+  vector<string> operations;
+  string output;
+
+  for (int n = 1; n < argc; ++n)
+  {
+    string arg = argv[n];
+
+    if (n + 1 < argc && arg == "--sizes")
+    {
+      vector<string> parts = split(argv[++n]);
+      for (size_t i = 0; i < parts.size(); ++i)
+        sizes.push_back((unsigned int)atoi(parts[i].c_str()));
+    }
+    else if (n + 1 < argc && arg == "--repeats")
+      repeats = (unsigned int)atoi(argv[++n]);
+    else if (n + 1 < argc && arg == "--only")
+      operations = split(argv[++n]);
+    else if (n + 1 < argc && arg == "--output")
+      output = argv[++n];
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+
+  if (sizes.empty())
+  {
+    sizes.push_back(10);
+    sizes.push_back(100);
+    sizes.push_back(1000);
+  }
+
+  if (repeats == 0) repeats = 1;
+
+  vector<Measurement> results;
+  bool ok = true;
+
+  for (size_t n = 0; n < sizes.size(); ++n)
+  {
+    size_t first = results.size();
+    ok = run(sizes[n], repeats, operations, results) && ok;
+
+    for (size_t i = first; i < results.size(); ++i)
+      cerr << "scale " << results[i].scale << "\t" << results[i].operation
+           << "\t" << minimum(results[i].seconds) << " s" << endl;
+  }
+
+  if (output.empty())
+  {
+    writeJson(cout, repeats, results);
+  }
+  else
+  {
+    ofstream file(output.c_str());
+    if (!file)
+    {
+      cerr << "cannot write " << output << endl;
+      return 2;
+    }
+    writeJson(file, repeats, results);
+  }
+
+  if (!ok) cerr << "some results did not match the generated documents" << endl;
+
+  return ok ? 0 : 1;
+}
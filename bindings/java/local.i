@@ -667,6 +667,58 @@ XMLCONSTRUCTOR_EXCEPTION(XMLTripple)
 }
 
 
+/**
+* Return the columns of SedColumns as Java arrays, filled in one JNI call
+* each, instead of vector proxies that cross into C++ for every element.
+*/
+%typemap(jni)    SedIntColumn    "jintArray"
+%typemap(jtype)  SedIntColumn    "int[]"
+%typemap(jstype) SedIntColumn    "int[]"
+%typemap(javaout) SedIntColumn
+{
+	return $jnicall;
+}
+%typemap(out) SedIntColumn
+{
+	$result = jenv->NewIntArray((jsize)$1.size());
+	if ($result != NULL && !$1.empty())
+		jenv->SetIntArrayRegion($result, 0, (jsize)$1.size(), (const jint*)&$1[0]);
+}
+
+%typemap(jni)    SedDoubleColumn "jdoubleArray"
+%typemap(jtype)  SedDoubleColumn "double[]"
+%typemap(jstype) SedDoubleColumn "double[]"
+%typemap(javaout) SedDoubleColumn
+{
+	return $jnicall;
+}
+%typemap(out) SedDoubleColumn
+{
+	$result = jenv->NewDoubleArray((jsize)$1.size());
+	if ($result != NULL && !$1.empty())
+		jenv->SetDoubleArrayRegion($result, 0, (jsize)$1.size(), &$1[0]);
+}
+
+%typemap(jni)    SedStringColumn "jobjectArray"
+%typemap(jtype)  SedStringColumn "String[]"
+%typemap(jstype) SedStringColumn "String[]"
+%typemap(javaout) SedStringColumn
+{
+	return $jnicall;
+}
+%typemap(out) SedStringColumn
+{
+	jclass stringClass = jenv->FindClass("java/lang/String");
+	$result = jenv->NewObjectArray((jsize)$1.size(), stringClass, NULL);
+	for (size_t n = 0; $result != NULL && n < $1.size(); ++n)
+	{
+		jstring value = jenv->NewStringUTF($1[n].c_str());
+		jenv->SetObjectArrayElement($result, (jsize)n, value);
+		jenv->DeleteLocalRef(value);
+	}
+}
+
+
 
 /**
 * getCPtrAndDisown() is like getCPtr() but it also sets the SWIG memory
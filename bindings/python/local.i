@@ -41,6 +41,35 @@
 %include "local-contrib.i"
 
 
+/**
+ * Releases the GIL while whole documents are parsed, written or copied,
+ * so that other Python threads keep running meanwhile.  The module is
+ * generated with -threads; %nothread turns the GIL handling off again for
+ * all other calls, which are short and would only pay for it.
+ *
+ * Several threads can write, copy and freeze the same document at once:
+ * the fragments cached by the writer and the notes and annotations kept
+ * as text are updated under locks, and string reference counts are
+ * atomic.  The document must not be changed from another thread while
+ * the calls below run, and a SedWriter with a trace writes one document
+ * at a time.
+ */
+%nothread;
+%thread SedReader::readSedML;
+%thread SedReader::readSedMLFromFile;
+%thread SedReader::readSedMLFromString;
+%thread readSedMLFromFile;
+%thread readSedMLFromString;
+%thread SedWriter::writeSedML;
+%thread SedWriter::writeSedMLToFile;
+%thread SedWriter::writeSedMLToString;
+%thread writeSedML;
+%thread writeSedMLToFile;
+%thread writeSedMLToString;
+%thread SedDocument::clone;
+%thread SedDocument::freeze;
+
+
 /**
  *  Wraps std::cout, std::cerr, std::clog, std::ostream, and std::ostringstream, 
  *
@@ -815,6 +844,166 @@ def readSedML(*args):
 %}
 
 
+/**
+ * The columns of SedColumns come back as NumPy arrays when NumPy is
+ * installed, and as tuples otherwise.
+ */
+%pythoncode
+%{
+def _asColumn(values):
+  try:
+    import numpy
+  except ImportError:
+    return values
+  return numpy.asarray(values)
+%}
+
+%define SEDCOLUMNS_AS_ARRAY(METHOD_NAME)
+%feature("pythonappend")
+SedColumns::METHOD_NAME
+%{
+        val = _asColumn(val)
+%}
+%enddef
+
+SEDCOLUMNS_AS_ARRAY(getTypeCodes)
+SEDCOLUMNS_AS_ARRAY(getIds)
+SEDCOLUMNS_AS_ARRAY(getNames)
+SEDCOLUMNS_AS_ARRAY(getStrings)
+SEDCOLUMNS_AS_ARRAY(getDoubles)
+
+
+/**
+ * asyncio variants of reading, writing and copying.  Each returns a
+ * future to be awaited in a coroutine, for example
+ *
+ *   docs = await asyncio.gather(*[libsedml.readSedMLAsync(f) for f in files])
+ *
+ * The work runs on a pool of threads shared by the module.  Since the
+ * native calls release the GIL, the threads parse and write in parallel.
+ */
+%pythoncode
+%{
+_async_lock = None
+_async_executor = None
+_async_workers = None
+
+def setAsyncWorkers(count):
+  """
+  setAsyncWorkers(int count)
+
+  Sets the number of threads used by the Async functions; None uses one
+  per processor.  A pool that was already started finishes its pending
+  work and is then replaced.
+  """
+  global _async_executor, _async_workers
+  _async_workers = count
+  executor = _async_executor
+  _async_executor = None
+  if executor is not None:
+    executor.shutdown(wait=False)
+
+def _getAsyncExecutor():
+  global _async_lock, _async_executor
+  import threading
+  if _async_lock is None:
+    _async_lock = threading.Lock()
+  with _async_lock:
+    if _async_executor is None:
+      import concurrent.futures
+      import os
+      workers = _async_workers
+      if workers is None:
+        workers = getattr(os, 'cpu_count', lambda: None)() or 4
+      _async_executor = concurrent.futures.ThreadPoolExecutor(max_workers=workers)
+    return _async_executor
+
+def _runAsync(function, *args):
+  import asyncio
+  loop = asyncio.get_event_loop()
+  return loop.run_in_executor(_getAsyncExecutor(), function, *args)
+
+def readSedMLAsync(filename):
+  """
+  readSedMLAsync(string filename) -> future of SedDocument
+
+  Reads an SEDML document from a file on the thread pool of the module,
+  like readSedML().
+  """
+  return _runAsync(readSedML, filename)
+
+def readSedMLFromStringAsync(xml):
+  """
+  readSedMLFromStringAsync(string xml) -> future of SedDocument
+
+  Reads an SEDML document from a string on the thread pool of the module,
+  like readSedMLFromString().
+  """
+  return _runAsync(readSedMLFromString, xml)
+
+def writeSedMLAsync(d, filename):
+  """
+  writeSedMLAsync(SedDocument d, string filename) -> future of int
+
+  Writes an SEDML document to a file on the thread pool of the module,
+  like writeSedML().  The document must not be changed until the future
+  is done.
+  """
+  return _runAsync(writeSedML, d, filename)
+
+def writeSedMLToStringAsync(d):
+  """
+  writeSedMLToStringAsync(SedDocument d) -> future of string
+
+  Writes an SEDML document to a string on the thread pool of the module,
+  like writeSedMLToString().  The document must not be changed until the
+  future is done.
+  """
+  return _runAsync(writeSedMLToString, d)
+
+def cloneAsync(d):
+  """
+  cloneAsync(SedDocument d) -> future of SedDocument
+
+  Copies a document on the thread pool of the module, like d.clone().
+  The document must not be changed until the future is done.
+  """
+  return _runAsync(d.clone)
+%}
+
+/**
+ * Pickling, e.g. for multiprocessing, goes through SedSerializer instead
+ * of SED-ML.  An object inside a document is restored together with a
+ * copy of what it depends on, which the restored object keeps alive.
+ */
+%extend SedBase
+{
+  %pythoncode
+  %{
+    def __reduce__(self):
+      data = SedSerializer.serialize(self)
+      if not data:
+        raise TypeError("cannot pickle '%s' object" % self.__class__.__name__)
+      return (_unpickleSed, (data,))
+  %}
+}
+
+%pythoncode
+%{
+def _unpickleSed(data):
+  doc = SedSerializer.deserialize(data)
+  if doc is None:
+    raise ValueError("malformed serialized SEDML object")
+  obj = SedSerializer.getObject(doc, data)
+  if obj is None:
+    raise ValueError("malformed serialized SEDML object")
+  if obj.getTypeCode() == SEDML_DOCUMENT:
+    return doc
+  obj._sedDocument = doc
+  return obj
+%}
+
+
 /**
  *  Wraps the following functions by using the corresponding 
  *  ListWrapper<TYPENAME> class.
@@ -0,0 +1,218 @@
+#ifndef SedColumns_h
+#define SedColumns_h
+
+/**
+ * @file    SedColumns.h
+ * @brief   Whole columns of attributes of many Sed objects in one call
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ * Copyright (c) 2013-2016, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <sedml/SedBase.h>
+#include <sedml/SedListOf.h>
+#include <sedml/common/extern.h>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_USE
+
+/**
+ * The column types returned by SedColumns.  They are typedefs so that the
+ * language bindings can map them to native arrays without affecting other
+ * functions that return vectors.
+ */
+typedef std::vector<int> SedIntColumn;
+typedef std::vector<double> SedDoubleColumn;
+typedef std::vector<std::string> SedStringColumn;
+
+/**
+ * Reads one attribute of many Sed objects at once.
+ *
+ * Walking a list with 100,000 items element by element crosses the
+ * boundary between the target language and C++ several times per item,
+ * once for get(), once for getId() and so on.  A SedColumns object
+ * collects the objects once; each getter then returns the value for all
+ * of them in a single call, as a NumPy array (or tuple) in Python, a
+ * vector in R and an array in Java.
+ *
+ *   columns = libsedml.SedColumns(doc.getListOfDataGenerators())
+ *   ids = columns.getIds()
+ *
+ *   variables = libsedml.SedColumns(doc, libsedml.SEDML_VARIABLE)
+ *   targets = variables.getStrings("target")
+ *   tasks = variables.getStrings("taskReference")
+ *
+ * The objects are not copied; the document must stay alive and unchanged
+ * while the SedColumns object is used.
+ */
+class SedColumns
+{
+  private:
+    std::vector<const SedBase*> mObjects;
+
+  public:
+    /**
+     * Collects the items of a list.
+     *
+     * @param list the list; @c NULL gives no objects.
+     */
+    SedColumns(const SedListOf* list)
+    {
+      if (list == NULL) return;
+
+      mObjects.reserve(list->size());
+      for (unsigned int n = 0; n < list->size(); ++n)
+        mObjects.push_back(list->get(n));
+    }
+
+    /**
+     * Collects @p root and all objects below it, in document order, that
+     * have the given type code.  Lists are never collected.
+     *
+     * @param root the object at which to start; @c NULL gives no objects.
+     * @param typeCode the type code of the objects to collect, or
+     * SEDML_UNKNOWN to collect objects of any type.
+     */
+    SedColumns(const SedBase* root, int typeCode)
+    {
+      std::vector<const SedBase*> stack;
+      if (root != NULL) stack.push_back(root);
+
+      while (!stack.empty())
+      {
+        const SedBase* current = stack.back();
+        stack.pop_back();
+
+        int code = current->getTypeCode();
+        if (code != SEDML_LIST_OF
+            && (typeCode == SEDML_UNKNOWN || code == typeCode))
+          mObjects.push_back(current);
+
+        size_t first = stack.size();
+        current->getChildObjects(stack);
+        std::reverse(stack.begin() + first, stack.end());
+      }
+    }
+
+    /**
+     * @return the number of objects collected.
+     */
+    unsigned int getNumObjects() const
+    {
+      return (unsigned int)mObjects.size();
+    }
+
+    /**
+     * @return the nth object collected, or @c NULL if @p n is out of range.
+     */
+    const SedBase* getObject(unsigned int n) const
+    {
+      return n < mObjects.size() ? mObjects[n] : NULL;
+    }
+
+    /**
+     * @return the type codes of the objects.
+     */
+    SedIntColumn getTypeCodes() const
+    {
+      SedIntColumn column(mObjects.size());
+      for (size_t n = 0; n < mObjects.size(); ++n)
+        column[n] = mObjects[n]->getTypeCode();
+      return column;
+    }
+
+    /**
+     * @return the ids of the objects; empty where not set.
+     */
+    SedStringColumn getIds() const
+    {
+      SedStringColumn column(mObjects.size());
+      for (size_t n = 0; n < mObjects.size(); ++n)
+        column[n] = mObjects[n]->getId();
+      return column;
+    }
+
+    /**
+     * @return the names of the objects; empty where not set.
+     */
+    SedStringColumn getNames() const
+    {
+      SedStringColumn column(mObjects.size());
+      for (size_t n = 0; n < mObjects.size(); ++n)
+        column[n] = mObjects[n]->getName();
+      return column;
+    }
+
+    /**
+     * @param attributeName the name of an attribute as used in SED-ML,
+     * such as "target", "taskReference" or "modelReference".
+     *
+     * @return the values of the attribute, formatted as in SED-ML; empty
+     * where the attribute is not set or does not exist.
+     */
+    SedStringColumn getStrings(const std::string& attributeName) const
+    {
+      SedStringColumn column(mObjects.size());
+      for (size_t n = 0; n < mObjects.size(); ++n)
+        mObjects[n]->getAttribute(attributeName, column[n]);
+      return column;
+    }
+
+    /**
+     * @param attributeName the name of a numeric attribute as used in
+     * SED-ML, such as "start" or "numberOfPoints".
+     *
+     * @return the values of the attribute; NaN where the attribute is not
+     * set, does not exist or is not a number.
+     */
+    SedDoubleColumn getDoubles(const std::string& attributeName) const
+    {
+      SedDoubleColumn column(mObjects.size(),
+                             std::numeric_limits<double>::quiet_NaN());
+      std::string text;
+      for (size_t n = 0; n < mObjects.size(); ++n)
+      {
+        if (mObjects[n]->getAttribute(attributeName, text)
+            != LIBSEDML_OPERATION_SUCCESS)
+          continue;
+
+        double value;
+        if (SedBase::attributeValueFromString(text, value))
+          column[n] = value;
+      }
+      return column;
+    }
+};
+
+#endif /* SedColumns_h */
@@ -31,6 +31,7 @@
 #include <sedml/SedTypes.h>
 
 #include "ListWrapper.h"
+#include "SedColumns.h"
 
 #include <sbml/SBase.h>
 #include <sbml/Model.h>
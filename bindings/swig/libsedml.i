@@ -257,6 +257,16 @@ LIBSEDML_CPP_NAMESPACE_USE
 %newobject readSEDMLFromFile(const char *);
 %newobject SEDMLWriter::writeToString;
 %newobject writeSEDMLToString;
+%newobject SedReader::readSedML;
+%newobject SedReader::readSedMLFromFile;
+%newobject SedReader::readSedMLFromString;
+%newobject readSedMLFromFile(const char *);
+%newobject readSedMLFromString(const char *);
+%newobject SedPatch::createDiff;
+%newobject SedPatch::fromString;
+%newobject SedDependencyGraph::extract;
+%newobject SedDocument::freeze;
+%newobject SedSerializer::deserialize;
 %newobject readMathMLFromString;
 %newobject writeMathMLToString;
 %newobject SEDML_formulaToString;
@@ -380,6 +390,10 @@ typedef std::vector<double> DoubleStdVector;
 typedef std::vector<XMLError*> XmlErrorStdVector;
 %template(SedErrorStdVector) std::vector<SedError>;
 typedef std::vector<SedError> SedErrorStdVector;
+%template(IntStdVector) std::vector<int>;
+typedef std::vector<int> IntStdVector;
+%template(StringStdVector) std::vector<std::string>;
+typedef std::vector<std::string> StringStdVector;
 
 
 %include sedml/common/libsedml-version.h
@@ -388,6 +402,9 @@ typedef std::vector<SedError> SedErrorStdVector;
 %include sbml/common/operationReturnValues.h
 
 %include <sedml/SedTypeCodes.h>
+%ignore SedString::operator const std::string&;
+%include <sedml/SedStringPool.h>
+%include <sedml/SedMemoryFootprint.h>
 %include <sedml/SedBase.h>
 %include <sedml/SedNamespaces.h>
 %include <sbml/xml/XMLError.h>
@@ -438,7 +455,25 @@ typedef std::vector<SedError> SedErrorStdVector;
 
 %include <sedml/SedReader.h>
 %include <sedml/SedWriter.h>
+%include "stdint.i"
+%include <sedml/SedCanonicalForm.h>
+%include <sedml/SedPatch.h>
+%include <sedml/SedDependencyGraph.h>
+%include <sedml/SedDocumentMerger.h>
+%include <sedml/SedTargetResolver.h>
+%include <sedml/SedChangeEngine.h>
+%include <sedml/SedModelRepository.h>
+%include <sedml/SedCompiledMath.h>
+%include <sedml/SedPreparedTaskChanges.h>
+%include <sedml/SedTimeGrid.h>
+%include <sedml/SedDownsampler.h>
+%include <sedml/SedEvaluationPlan.h>
+%include <sedml/SedTaskDeduplicator.h>
+%include <sedml/SedFrozenDocument.h>
+%include <sedml/SedSerializer.h>
+%include <sedml/SedTrace.h>
 %include <sedml/SedTypes.h>
+%include "SedColumns.h"
 
 %include sbml/math/MathML.h
 %include sbml/math/ASTNode.h
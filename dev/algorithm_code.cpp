@@ -28,6 +28,6 @@ SedAlgorithm::setKisaoID(int kisaoID)
       << std::setfill('0') 
       << std::setw(7)
       << kisaoID; 
-  mKisaoID = str.str();
+  mKisaoID = internString(str.str());
   return LIBSEDML_OPERATION_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+## 
+## @file    bench_columns.py
+## @brief   Compares reading ids and targets element by element with
+##          reading them as whole columns through SedColumns.
+## @author  Frank T. Bergmann
+## 
+## <!--------------------------------------------------------------------------
+## This file is part of libSEDML.  Please visit http://sed-ml.org for more
+## information about SEDML, and the latest version of libSEDML.
+## 
+## Copyright (c) 2013, Frank T. Bergmann  
+## All rights reserved.
+## 
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met: 
+## 
+## 1. Redistributions of source code must retain the above copyright notice, this
+##    list of conditions and the following disclaimer. 
+## 2. Redistributions in binary form must reproduce the above copyright notice,
+##    this list of conditions and the following disclaimer in the documentation
+##    and/or other materials provided with the distribution. 
+## 
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+## ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+## WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+## DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+## ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+## (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+## LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+## ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+## (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+## SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+## ------------------------------------------------------------------------ -.
+## 
+
+import sys
+import time
+import libsedml
+
+def build(numDataGenerators):
+  doc = libsedml.SedDocument(1, 2)
+  for i in range(numDataGenerators):
+    dg = doc.createDataGenerator()
+    dg.setId('dg%d' % i)
+    variable = dg.createVariable()
+    variable.setId('v%d' % i)
+    variable.setTaskReference('task')
+    variable.setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S%d']" % i)
+  return doc
+
+def perElement(doc):
+  ids = []
+  targets = []
+  dataGenerators = doc.getListOfDataGenerators()
+  for i in range(dataGenerators.size()):
+    dg = dataGenerators.get(i)
+    ids.append(dg.getId())
+    for j in range(dg.getNumVariables()):
+      targets.append(dg.getVariable(j).getTarget())
+  return ids, targets
+
+def columns(doc):
+  ids = libsedml.SedColumns(doc.getListOfDataGenerators()).getIds()
+  targets = libsedml.SedColumns(doc, libsedml.SEDML_VARIABLE).getStrings('target')
+  return ids, targets
+
+def main (args):
+  """Usage: bench_columns [data-generators]
+  """
+  numDataGenerators = int(args[1]) if len(args) > 1 else 100000
+  doc = build(numDataGenerators)
+
+  start = time.time()
+  slow = perElement(doc)
+  elementwise = time.time() - start
+
+  start = time.time()
+  fast = columns(doc)
+  bulk = time.time() - start
+
+  print('data generators        : %d' % numDataGenerators)
+  print('element by element     : %.3f s' % elementwise)
+  print('SedColumns             : %.3f s (%.1f times as fast)'
+        % (bulk, elementwise / max(bulk, 1e-9)))
+
+  same = list(slow[0]) == list(fast[0]) and list(slow[1]) == list(fast[1])
+  return 0 if same else 1
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv))
@@ -0,0 +1,137 @@
+#!/usr/bin/env python
+## 
+## @file    bench_concurrent_parse.py
+## @brief   Parses one SED-ML document many times, one after the other and
+##          concurrently from threads and from asyncio, and writes and copies
+##          one document from several threads at once.
+## @author  Frank T. Bergmann
+## 
+## <!--------------------------------------------------------------------------
+## This file is part of libSEDML.  Please visit http://sed-ml.org for more
+## information about SEDML, and the latest version of libSEDML.
+## 
+## Copyright (c) 2013, Frank T. Bergmann  
+## All rights reserved.
+## 
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met: 
+## 
+## 1. Redistributions of source code must retain the above copyright notice, this
+##    list of conditions and the following disclaimer. 
+## 2. Redistributions in binary form must reproduce the above copyright notice,
+##    this list of conditions and the following disclaimer in the documentation
+##    and/or other materials provided with the distribution. 
+## 
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+## ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+## WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+## DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+## ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+## (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+## LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+## ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+## (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+## SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+## ------------------------------------------------------------------------ -.
+## 
+
+import asyncio
+import sys
+import time
+import concurrent.futures
+import libsedml
+
+def build(numDataGenerators):
+  """Returns a document with the given number of data generators as XML."""
+  doc = libsedml.SedDocument(1, 2)
+  model = doc.createModel()
+  model.setId('model')
+  model.setSource('model.xml')
+  sim = doc.createUniformTimeCourse()
+  sim.setId('sim')
+  sim.createAlgorithm().setKisaoID('KISAO:0000019')
+  task = doc.createTask()
+  task.setId('task')
+  task.setModelReference('model')
+  task.setSimulationReference('sim')
+
+  for i in range(numDataGenerators):
+    dg = doc.createDataGenerator()
+    dg.setId('dg%d' % i)
+    variable = dg.createVariable()
+    variable.setId('v%d' % i)
+    variable.setTaskReference('task')
+    variable.setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S%d']" % i)
+    dg.setMath(libsedml.parseFormula('v%d' % i))
+
+  return libsedml.writeSedMLToString(doc)
+
+def parse(xml):
+  return libsedml.readSedMLFromString(xml).getNumDataGenerators()
+
+async def parseAll(xml, count):
+  futures = [libsedml.readSedMLFromStringAsync(xml) for i in range(count)]
+  docs = await asyncio.gather(*futures)
+  return [doc.getNumDataGenerators() for doc in docs]
+
+def write(writer, doc):
+  return writer.writeSedMLToString(doc)
+
+async def writeAll(doc, count):
+  futures = [libsedml.writeSedMLToStringAsync(doc) for i in range(count)]
+  futures += [libsedml.cloneAsync(doc) for i in range(count)]
+  results = await asyncio.gather(*futures)
+  return results[:count], [copy.getNumDataGenerators() for copy in results[count:]]
+
+def main (args):
+  """Usage: bench_concurrent_parse [data-generators [parses [threads]]]
+  """
+  numDataGenerators = int(args[1]) if len(args) > 1 else 20000
+  numParses = int(args[2]) if len(args) > 2 else 8
+  numThreads = int(args[3]) if len(args) > 3 else 4
+
+  xml = build(numDataGenerators)
+  print('document size          : %d KiB' % (len(xml) // 1024))
+  print('parses                 : %d' % numParses)
+
+  start = time.time()
+  serial = [parse(xml) for i in range(numParses)]
+  sequential = time.time() - start
+  print('one after the other    : %.2f s' % sequential)
+
+  start = time.time()
+  with concurrent.futures.ThreadPoolExecutor(max_workers=numThreads) as pool:
+    threaded = list(pool.map(parse, [xml] * numParses))
+  elapsed = time.time() - start
+  print('%2d threads             : %.2f s (%.1f times as fast)'
+        % (numThreads, elapsed, sequential / max(elapsed, 1e-9)))
+
+  libsedml.setAsyncWorkers(numThreads)
+  start = time.time()
+  awaited = asyncio.run(parseAll(xml, numParses))
+  elapsed = time.time() - start
+  print('asyncio, %2d workers    : %.2f s (%.1f times as fast)'
+        % (numThreads, elapsed, sequential / max(elapsed, 1e-9)))
+
+  # the same document written and copied by several threads at once, with
+  # the cached fragments shared between them
+  doc = libsedml.readSedMLFromString(xml)
+  writer = libsedml.SedWriter()
+  writer.setCacheFragments(True)
+  expected = libsedml.writeSedMLToString(doc)
+  start = time.time()
+  with concurrent.futures.ThreadPoolExecutor(max_workers=numThreads) as pool:
+    written = list(pool.map(lambda i: write(writer, doc), range(numParses)))
+  elapsed = time.time() - start
+  print('%2d threads, one doc    : %.2f s to write %d times'
+        % (numThreads, elapsed, numParses))
+
+  texts, copies = asyncio.run(writeAll(doc, numParses))
+
+  same = (serial == threaded == awaited
+          and all(text == expected for text in written + texts)
+          and copies == serial)
+  return 0 if same else 1
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv))
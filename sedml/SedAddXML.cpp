@@ -141,6 +141,8 @@ SedAddXML::isSetNewXML() const
 int
 SedAddXML::setNewXML(XMLNode* newXML)
 {
+  markDirty();
+
   if (mNewXML == newXML)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -165,6 +167,8 @@ SedAddXML::setNewXML(XMLNode* newXML)
 int
 SedAddXML::unsetNewXML()
 {
+  markDirty();
+
   delete mNewXML;
   mNewXML = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -252,8 +256,30 @@ SedAddXML::writeElements(XMLOutputStream& stream) const
 bool
 SedAddXML::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedAddXML::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedChange::addMemoryFootprint(footprint);
 
+  footprint.addXML(mNewXML);
 }
 
 
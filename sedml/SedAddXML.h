@@ -246,6 +246,17 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Charges the memory this object owns to the footprint.
+   */
+  virtual void addMemoryFootprint(SedMemoryFootprint& footprint) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -157,8 +157,10 @@ SedAlgorithm::isSetKisaoID() const
 int
 SedAlgorithm::setKisaoID(const std::string& kisaoID)
 {
+  markDirty();
+
   {
-    mKisaoID = kisaoID;
+    mKisaoID = internString(kisaoID);
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -170,6 +172,8 @@ SedAlgorithm::setKisaoID(const std::string& kisaoID)
 int
 SedAlgorithm::unsetKisaoID()
 {
+  markDirty();
+
   mKisaoID.erase();
 
   if (mKisaoID.empty() == true)
@@ -385,6 +389,95 @@ SedAlgorithm::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedAlgorithm to the vector.
+ */
+void
+SedAlgorithm::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("kisaoID");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedAlgorithm::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "kisaoID")
+    {
+      return isSetKisaoID();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedAlgorithm::getAttribute(const std::string& attributeName,
+                           std::string& value) const
+{
+  if (attributeName == "kisaoID")
+    {
+      if (isSetKisaoID() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mKisaoID;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedAlgorithm::setAttribute(const std::string& attributeName,
+                           const std::string& value)
+{
+  if (attributeName == "kisaoID")
+    {
+      return setKisaoID(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedAlgorithm::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "kisaoID")
+    {
+      return unsetKisaoID();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedAlgorithm::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedBase::getChildObjects(children);
+
+  children.push_back(&mAlgorithmParameters);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -413,8 +506,47 @@ SedAlgorithm::writeElements(XMLOutputStream& stream) const
 bool
 SedAlgorithm::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
 
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedAlgorithm::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mKisaoID);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedAlgorithm::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mKisaoID);
 }
 
 
@@ -470,7 +602,7 @@ SedAlgorithm::readAttributes(const XMLAttributes& attributes,
   //
   // kisaoID string   ( use = "required" )
   //
-  assigned = attributes.readInto("kisaoID", mKisaoID, getErrorLog(), true);
+  assigned = readInto(attributes, "kisaoID", mKisaoID, true);
 
   if (assigned == true)
     {
@@ -533,12 +665,14 @@ SedAlgorithm::getKisaoIDasInt() const
 int
 SedAlgorithm::setKisaoID(int kisaoID)
 {
+  markDirty();
+
   std::stringstream str;
   str << "KISAO:"
       << std::setfill('0')
       << std::setw(7)
       << kisaoID;
-  mKisaoID = str.str();
+  mKisaoID = internString(str.str());
   return LIBSEDML_OPERATION_SUCCESS;
 }/**
  * write comments
@@ -65,7 +65,7 @@ class LIBSEDML_EXTERN SedAlgorithm : public SedBase
 protected:
 
   SedListOfAlgorithmParameters   mAlgorithmParameters;
-  std::string   mKisaoID;
+  SedString     mKisaoID;
 
 
 public:
@@ -366,6 +366,81 @@ public:
   virtual bool hasRequiredElements() const;
 
 
+  /**
+   * Adds the names of the attributes of this SedAlgorithm object to @p names, in
+   * the order in which they are written.
+   *
+   * @param names the vector to which the attribute names are appended.
+   */
+  virtual void getAttributeNames(std::vector<std::string>& names) const;
+
+
+  /**
+   * Predicate returning @c true if the attribute with the given name is set
+   * on this SedAlgorithm object.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   *
+   * @return @c true if the attribute is set, @c false otherwise.
+   */
+  virtual bool isSetAttribute(const std::string& attributeName) const;
+
+
+  /**
+   * Returns the value of the attribute with the given name as a string,
+   * formatted the way it is written in SED-ML.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   * @param value the string that receives the value of the attribute.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int getAttribute(const std::string& attributeName,
+                           std::string& value) const;
+
+
+  /**
+   * Sets the attribute with the given name on this SedAlgorithm object from its
+   * string form, as it would be read from SED-ML.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   * @param value the value of the attribute.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int setAttribute(const std::string& attributeName,
+                           const std::string& value);
+
+
+  /**
+   * Unsets the attribute with the given name on this SedAlgorithm object.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int unsetAttribute(const std::string& attributeName);
+
+
+  /**
+   * Adds the SEDML objects directly contained in this SedAlgorithm object to
+   * @p children, in the order in which they are written.
+   *
+   * @param children the vector to which the child objects are appended.
+   */
+  virtual void getChildObjects(std::vector<const SedBase*>& children) const;
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -390,6 +465,28 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Charges the memory this object owns to the footprint.
+   */
+  virtual void addMemoryFootprint(SedMemoryFootprint& footprint) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Interns the strings of this object in the pool of its document.
+   */
+  virtual void internStrings();
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -165,8 +165,10 @@ SedAlgorithmParameter::isSetValue() const
 int
 SedAlgorithmParameter::setKisaoID(const std::string& kisaoID)
 {
+  markDirty();
+
   {
-    mKisaoID = kisaoID;
+    mKisaoID = internString(kisaoID);
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -178,6 +180,8 @@ SedAlgorithmParameter::setKisaoID(const std::string& kisaoID)
 int
 SedAlgorithmParameter::setValue(const std::string& value)
 {
+  markDirty();
+
   {
     mValue = value;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -191,6 +195,8 @@ SedAlgorithmParameter::setValue(const std::string& value)
 int
 SedAlgorithmParameter::unsetKisaoID()
 {
+  markDirty();
+
   mKisaoID.erase();
 
   if (mKisaoID.empty() == true)
@@ -210,6 +216,8 @@ SedAlgorithmParameter::unsetKisaoID()
 int
 SedAlgorithmParameter::unsetValue()
 {
+  markDirty();
+
   mValue.erase();
 
   if (mValue.empty() == true)
@@ -262,6 +270,103 @@ SedAlgorithmParameter::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedAlgorithmParameter to the vector.
+ */
+void
+SedAlgorithmParameter::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("kisaoID");
+  names.push_back("value");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedAlgorithmParameter::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "kisaoID")
+    {
+      return isSetKisaoID();
+    }
+  else if (attributeName == "value")
+    {
+      return isSetValue();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedAlgorithmParameter::getAttribute(const std::string& attributeName,
+                                    std::string& value) const
+{
+  if (attributeName == "kisaoID")
+    {
+      if (isSetKisaoID() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mKisaoID;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "value")
+    {
+      if (isSetValue() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mValue;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedAlgorithmParameter::setAttribute(const std::string& attributeName,
+                                    const std::string& value)
+{
+  if (attributeName == "kisaoID")
+    {
+      return setKisaoID(value);
+    }
+  else if (attributeName == "value")
+    {
+      return setValue(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedAlgorithmParameter::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "kisaoID")
+    {
+      return unsetKisaoID();
+    }
+  else if (attributeName == "value")
+    {
+      return unsetValue();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -285,8 +390,48 @@ SedAlgorithmParameter::writeElements(XMLOutputStream& stream) const
 bool
 SedAlgorithmParameter::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedAlgorithmParameter::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mKisaoID);
+  footprint.addString(mValue);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedAlgorithmParameter::internStrings()
+{
+  SedBase::internStrings();
 
+  reinternString(mKisaoID);
 }
 
 
@@ -342,7 +487,7 @@ SedAlgorithmParameter::readAttributes(const XMLAttributes& attributes,
   //
   // kisaoID string   ( use = "required" )
   //
-  assigned = attributes.readInto("kisaoID", mKisaoID, getErrorLog(), true);
+  assigned = readInto(attributes, "kisaoID", mKisaoID, true);
 
   if (assigned == true)
     {
@@ -423,12 +568,14 @@ SedAlgorithmParameter::getKisaoIDasInt() const
 int
 SedAlgorithmParameter::setKisaoID(int kisaoID)
 {
+  markDirty();
+
   std::stringstream str;
   str << "KISAO:"
       << std::setfill('0')
       << std::setw(7)
       << kisaoID;
-  mKisaoID = str.str();
+  mKisaoID = internString(str.str());
   return LIBSEDML_OPERATION_SUCCESS;
 }/*
  * Constructor
@@ -581,6 +728,8 @@ SedListOfAlgorithmParameters::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedAlgorithmParameter*>(item);
@@ -618,15 +767,12 @@ SedListOfAlgorithmParameters::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedAlgorithmParameter in this SedListOfAlgorithmParameters
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfAlgorithmParameters::createObject(XMLInputStream& stream)
+SedListOfAlgorithmParameters::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "algorithmParameter")
@@ -639,6 +785,18 @@ SedListOfAlgorithmParameters::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedAlgorithmParameter in this SedListOfAlgorithmParameters
+ */
+SedBase*
+SedListOfAlgorithmParameters::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -36,8 +36,18 @@
  */
 
 #include <sstream>
+#include <locale>
 #include <vector>
 
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 #include <sbml/xml/XMLError.h>
 #include <sbml/xml/XMLErrorLog.h>
 #include <sbml/xml/XMLOutputStream.h>
@@ -52,6 +62,9 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedListOf.h>
 #include <sedml/SedBase.h>
+#include <sedml/SedFragmentOutputStream.h>
+#include <sedml/SedTrace.h>
+#include <sedml/SedElementFilter.h>
 
 
 //#include <sbml/validator/constraints/IdList.h>
@@ -66,6 +79,171 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 /** @endcond */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The trace of the given document, if any.
+ */
+static SedTrace*
+traceOf(const SedDocument* document)
+{
+  return document != NULL ? document->getTrace() : NULL;
+}
+
+
+/*
+ * The filter of the elements to read of the given document, if any.
+ */
+static SedElementFilter*
+filterOf(const SedDocument* document)
+{
+  return document != NULL ? document->getElementFilter() : NULL;
+}
+
+
+/*
+ * Consumes the element starting at the next token of the stream and
+ * stores its text in raw.  No indentation is added, so the whitespace of
+ * the content is kept as it was read.
+ *
+ * If outline is not NULL, it receives the element with its top level
+ * children, without their content, as XMLNode(stream) would read them.
+ */
+static void
+readRawElement(XMLInputStream& stream, std::string& raw,
+               XMLNode* outline = NULL)
+{
+  ostringstream    text;
+  XMLOutputStream  out(text, "UTF-8", false);
+  out.setAutoIndent(false);
+
+  unsigned int depth = 0;
+
+  do
+    {
+      const XMLToken token = stream.next();
+      token.write(out);
+
+      if (outline != NULL && depth == 0)
+        {
+          *outline = XMLNode(token);
+        }
+      else if (outline != NULL && depth == 1)
+        {
+          // whitespace between the children is dropped
+          if (token.isStart()
+              || (token.isText() && token.getCharacters()
+                  .find_first_not_of(" \t\r\n") != string::npos))
+            {
+              outline->addChild(XMLNode(token));
+            }
+        }
+
+      if (token.isStart() && !token.isEnd())
+        {
+          ++depth;
+        }
+      else if (token.isEnd() && !token.isStart() && depth > 0)
+        {
+          --depth;
+        }
+    }
+  while (depth > 0 && stream.isGood());
+
+  raw = text.str();
+}
+
+
+/*
+ * Bits of SedBase::mUnparsed.
+ */
+static const long UNPARSED_NOTES = 1;
+static const long UNPARSED_ANNOTATION = 2;
+
+
+#ifdef _WIN32
+typedef SRWLOCK SectionLock;
+#define SECTION_LOCK_INIT SRWLOCK_INIT
+#else
+typedef pthread_mutex_t SectionLock;
+#define SECTION_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#endif
+
+
+/*
+ * Several threads may read an object whose notes or annotation were kept
+ * as text, so the first of them to need the XML parses it under this
+ * lock.  mUnparsed is only read and changed with the atomic operations
+ * below; the text itself is left in place until the object is changed.
+ */
+static SectionLock sParseLock = SECTION_LOCK_INIT;
+
+
+/*
+ * Several threads may write the same document; the XML cached for the
+ * fragments of a SedFragmentOutputStream is read and stored under this
+ * lock.
+ */
+static SectionLock sFragmentLock = SECTION_LOCK_INIT;
+
+
+static void
+lockSection(SectionLock* lock)
+{
+#ifdef _WIN32
+  AcquireSRWLockExclusive(lock);
+#else
+  pthread_mutex_lock(lock);
+#endif
+}
+
+
+static void
+unlockSection(SectionLock* lock)
+{
+#ifdef _WIN32
+  ReleaseSRWLockExclusive(lock);
+#else
+  pthread_mutex_unlock(lock);
+#endif
+}
+
+
+static long
+loadUnparsed(const volatile long* flags)
+{
+#ifdef _WIN32
+  return InterlockedOr(const_cast<volatile long*>(flags), 0);
+#else
+  return __sync_fetch_and_or(const_cast<volatile long*>(flags), 0);
+#endif
+}
+
+
+static void
+setUnparsed(volatile long* flags, long flag)
+{
+#ifdef _WIN32
+  InterlockedOr(flags, flag);
+#else
+  __sync_fetch_and_or(flags, flag);
+#endif
+}
+
+
+static void
+clearUnparsed(volatile long* flags, long flag)
+{
+#ifdef _WIN32
+  InterlockedAnd(flags, ~flag);
+#else
+  __sync_fetch_and_and(flags, ~flag);
+#endif
+}
+
+/** @endcond */
+
+
 
 SedBase*
 SedBase::getElementBySId(std::string id)
@@ -98,6 +276,7 @@ SedBase::getAllElements()
 SedBase::SedBase(unsigned int level, unsigned int version) :
   mNotes(NULL)
   , mAnnotation(NULL)
+  , mUnparsed(0)
   , mSed(NULL)
   , mSedNamespaces(NULL)
   , mUserData(NULL)
@@ -107,6 +286,10 @@ SedBase::SedBase(unsigned int level, unsigned int version) :
   , mHasBeenDeleted(false)
   , mEmptyString("")
   , mURI("")
+  , mDirty(true)
+  , mCachedXML("")
+  , mCachedIndent(0)
+  , mCachedGeneration(0)
 {
   mSedNamespaces = new SedNamespaces(level, version);
 
@@ -127,6 +310,7 @@ SedBase::SedBase(unsigned int level, unsigned int version) :
 SedBase::SedBase(SedNamespaces *sbmlns) :
   mNotes(NULL)
   , mAnnotation(NULL)
+  , mUnparsed(0)
   , mSed(NULL)
   , mSedNamespaces(NULL)
   , mUserData(NULL)
@@ -136,6 +320,10 @@ SedBase::SedBase(SedNamespaces *sbmlns) :
   , mHasBeenDeleted(false)
   , mEmptyString("")
   , mURI("")
+  , mDirty(true)
+  , mCachedXML("")
+  , mCachedIndent(0)
+  , mCachedGeneration(0)
 {
   if (!sbmlns)
     {
@@ -171,15 +359,22 @@ SedBase::SedBase(const SedBase& orig)
 {
   this->mMetaId = orig.mMetaId;
 
-  if (orig.mNotes != NULL)
-    this->mNotes = new XMLNode(*const_cast<SedBase&>(orig).getNotes());
-  else
-    this->mNotes = NULL;
+  // other threads may parse the text of orig meanwhile; the copy keeps
+  // whatever was unparsed when it was made
+  long unparsed = loadUnparsed(&orig.mUnparsed);
+  this->mUnparsed = unparsed;
+  this->mNotes = NULL;
+  this->mAnnotation = NULL;
 
-  if (orig.mAnnotation != NULL)
-    this->mAnnotation = new XMLNode(*const_cast<SedBase&>(orig).mAnnotation);
-  else
-    this->mAnnotation = NULL;
+  if ((unparsed & UNPARSED_NOTES) != 0)
+    this->mRawNotes = orig.mRawNotes;
+  else if (orig.mNotes != NULL)
+    this->mNotes = new XMLNode(*orig.mNotes);
+
+  if ((unparsed & UNPARSED_ANNOTATION) != 0)
+    this->mRawAnnotation = orig.mRawAnnotation;
+  else if (orig.mAnnotation != NULL)
+    this->mAnnotation = new XMLNode(*orig.mAnnotation);
 
   /* the copy does not contain a pointer to the document since technically
    * a copy is not part of the document
@@ -204,6 +399,11 @@ SedBase::SedBase(const SedBase& orig)
   this->mHasBeenDeleted = false;
 
   this->mURI = orig.mURI;
+
+  /* the cached XML belongs to the original, the copy starts out dirty */
+  this->mDirty = true;
+  this->mCachedIndent = 0;
+  this->mCachedGeneration = 0;
 }
 
 
@@ -232,19 +432,26 @@ SedBase& SedBase::operator=(const SedBase& rhs)
     {
       this->mMetaId = rhs.mMetaId;
 
+      long unparsed = loadUnparsed(&rhs.mUnparsed);
+      this->mUnparsed = unparsed;
+      this->mRawNotes.clear();
+      this->mRawAnnotation.clear();
+
       delete this->mNotes;
+      this->mNotes = NULL;
 
-      if (rhs.mNotes != NULL)
-        this->mNotes = new XMLNode(*const_cast<SedBase&>(rhs).getNotes());
-      else
-        this->mNotes = NULL;
+      if ((unparsed & UNPARSED_NOTES) != 0)
+        this->mRawNotes = rhs.mRawNotes;
+      else if (rhs.mNotes != NULL)
+        this->mNotes = new XMLNode(*rhs.mNotes);
 
       delete this->mAnnotation;
+      this->mAnnotation = NULL;
 
-      if (rhs.mAnnotation != NULL)
-        this->mAnnotation = new XMLNode(*const_cast<SedBase&>(rhs).mAnnotation);
-      else
-        this->mAnnotation = NULL;
+      if ((unparsed & UNPARSED_ANNOTATION) != 0)
+        this->mRawAnnotation = rhs.mRawAnnotation;
+      else if (rhs.mAnnotation != NULL)
+        this->mAnnotation = new XMLNode(*rhs.mAnnotation);
 
       this->mSed       = rhs.mSed;
       this->mLine       = rhs.mLine;
@@ -263,6 +470,8 @@ SedBase& SedBase::operator=(const SedBase& rhs)
 
       this->mURI = rhs.mURI;
 
+      markDirty();
+      this->mCachedXML.clear();
     }
 
   return *this;
@@ -323,6 +532,8 @@ SedBase::getName() const
 XMLNode*
 SedBase::getNotes()
 {
+  parseRawNotes();
+
   return mNotes;
 }
 
@@ -330,6 +541,8 @@ SedBase::getNotes()
 XMLNode*
 SedBase::getNotes() const
 {
+  parseRawNotes();
+
   return mNotes;
 }
 
@@ -340,14 +553,14 @@ SedBase::getNotes() const
 std::string
 SedBase::getNotesString()
 {
-  return XMLNode::convertXMLNodeToString(mNotes);
+  return XMLNode::convertXMLNodeToString(getNotes());
 }
 
 
 std::string
 SedBase::getNotesString() const
 {
-  return XMLNode::convertXMLNodeToString(mNotes);
+  return XMLNode::convertXMLNodeToString(getNotes());
 }
 
 
@@ -357,6 +570,7 @@ SedBase::getNotesString() const
 XMLNode*
 SedBase::getAnnotation()
 {
+  parseRawAnnotation();
   syncAnnotation();
 
   return mAnnotation;
@@ -366,7 +580,12 @@ SedBase::getAnnotation()
 XMLNode*
 SedBase::getAnnotation() const
 {
-  return const_cast<SedBase *>(this)->getAnnotation();
+  parseRawAnnotation();
+
+  // unlike syncAnnotation(), leaves an empty annotation in place
+  if (mAnnotation == NULL || mAnnotation->getNumChildren() == 0) return NULL;
+
+  return mAnnotation;
 }
 
 
@@ -403,6 +622,211 @@ SedBase::getUserData() const
 }
 
 
+bool
+SedBase::isDirty() const
+{
+  return mDirty;
+}
+
+
+/*
+ * Marks this object and its ancestors as modified.  The walk does not stop
+ * at an ancestor that is already dirty: objects that were never written
+ * (such as empty lists) stay dirty while their parents are cached.
+ */
+void
+SedBase::markDirty()
+{
+  SedBase* current = this;
+
+  while (current != NULL)
+    {
+      current->mDirty = true;
+      current = current->mParentSedObject;
+    }
+}
+
+
+void
+SedBase::getAttributeNames(std::vector<std::string>& names) const
+{
+  names.push_back("metaid");
+}
+
+
+bool
+SedBase::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "metaid")
+    {
+      return isSetMetaId();
+    }
+
+  return false;
+}
+
+
+int
+SedBase::getAttribute(const std::string& attributeName,
+                      std::string& value) const
+{
+  if (attributeName == "metaid" && isSetMetaId())
+    {
+      value = mMetaId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return LIBSEDML_OPERATION_FAILED;
+}
+
+
+int
+SedBase::setAttribute(const std::string& attributeName,
+                      const std::string& value)
+{
+  if (attributeName == "metaid")
+    {
+      return setMetaId(value);
+    }
+
+  return LIBSEDML_OPERATION_FAILED;
+}
+
+
+int
+SedBase::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "metaid")
+    {
+      return unsetMetaId();
+    }
+
+  return LIBSEDML_OPERATION_FAILED;
+}
+
+
+SedBase*
+SedBase::createChildObject(const std::string& /* elementName */)
+{
+  return NULL;
+}
+
+
+void
+SedBase::getChildObjects(std::vector<const SedBase*>& /* children */) const
+{
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+std::string
+SedBase::attributeValueToString(double value)
+{
+  if (util_isNaN(value))
+    return "NaN";
+  else if (util_isInf(value) > 0)
+    return "INF";
+  else if (util_isInf(value) < 0)
+    return "-INF";
+
+  // the shortest of 15 and 17 significant digits that reads back exactly
+  std::ostringstream stream;
+  stream.imbue(std::locale::classic());
+  stream.precision(15);
+  stream << value;
+
+  std::istringstream check(stream.str());
+  check.imbue(std::locale::classic());
+  double parsed = 0;
+  check >> parsed;
+
+  if (parsed != value)
+    {
+      stream.str("");
+      stream.precision(17);
+      stream << value;
+    }
+
+  return stream.str();
+}
+
+
+std::string
+SedBase::attributeValueToString(int value)
+{
+  std::ostringstream stream;
+  stream.imbue(std::locale::classic());
+  stream << value;
+  return stream.str();
+}
+
+
+std::string
+SedBase::attributeValueToString(bool value)
+{
+  return value ? "true" : "false";
+}
+
+
+bool
+SedBase::attributeValueFromString(const std::string& text, double& value)
+{
+  if (text == "NaN")
+    {
+      value = util_NaN();
+      return true;
+    }
+  else if (text == "INF")
+    {
+      value = util_PosInf();
+      return true;
+    }
+  else if (text == "-INF")
+    {
+      value = util_NegInf();
+      return true;
+    }
+
+  std::istringstream stream(text);
+  stream.imbue(std::locale::classic());
+  stream >> value;
+
+  return !stream.fail() && stream.eof();
+}
+
+
+bool
+SedBase::attributeValueFromString(const std::string& text, int& value)
+{
+  std::istringstream stream(text);
+  stream.imbue(std::locale::classic());
+  stream >> value;
+
+  return !stream.fail() && stream.eof();
+}
+
+
+bool
+SedBase::attributeValueFromString(const std::string& text, bool& value)
+{
+  if (text == "true" || text == "1")
+    {
+      value = true;
+      return true;
+    }
+  else if (text == "false" || text == "0")
+    {
+      value = false;
+      return true;
+    }
+
+  return false;
+}
+
+/** @endcond */
+
+
 int
 SedBase::setUserData(void *userData)
 {
@@ -615,6 +1039,9 @@ SedBase::isSetName() const
 bool
 SedBase::isSetNotes() const
 {
+  // mNotes is only read once no other thread can be parsing into it
+  if (hasUnparsedNotes()) return true;
+
   return (mNotes != NULL);
 }
 
@@ -626,8 +1053,9 @@ SedBase::isSetNotes() const
 bool
 SedBase::isSetAnnotation() const
 {
-  const_cast <SedBase *>(this)->syncAnnotation();
-  return (mAnnotation != NULL);
+  if (hasUnparsedAnnotation()) return true;
+
+  return (getAnnotation() != NULL);
 }
 
 
@@ -639,6 +1067,8 @@ SedBase::isSetAnnotation() const
 int
 SedBase::setMetaId(const std::string& metaid)
 {
+  markDirty();
+
   if (getLevel() == 1)
     {
       return LIBSEDML_UNEXPECTED_ATTRIBUTE;
@@ -670,6 +1100,8 @@ SedBase::setMetaId(const std::string& metaid)
 int
 SedBase::setId(const std::string& sid)
 {
+  markDirty();
+
   return LIBSEDML_UNEXPECTED_ATTRIBUTE;
 }
 
@@ -681,6 +1113,8 @@ SedBase::setId(const std::string& sid)
 int
 SedBase::setName(const std::string& name)
 {
+  markDirty();
+
   return LIBSEDML_UNEXPECTED_ATTRIBUTE;
 }
 
@@ -694,6 +1128,8 @@ SedBase::setName(const std::string& name)
 int
 SedBase::setAnnotation(const XMLNode* annotation)
 {
+  markDirty();
+
   //
   // (*NOTICE*)
   //
@@ -701,6 +1137,9 @@ SedBase::setAnnotation(const XMLNode* annotation)
   //
   //
 
+  mRawAnnotation.clear();
+  clearUnparsed(&mUnparsed, UNPARSED_ANNOTATION);
+
   if (annotation == NULL)
     {
       delete mAnnotation;
@@ -771,6 +1210,8 @@ SedBase::setAnnotation(const XMLNode* annotation)
 int
 SedBase::setAnnotation(const std::string& annotation)
 {
+  markDirty();
+
   {
     int success = LIBSEDML_OPERATION_FAILED;
 
@@ -819,6 +1260,9 @@ SedBase::setAnnotation(const std::string& annotation)
 int
 SedBase::appendAnnotation(const XMLNode* annotation)
 {
+  markDirty();
+  parseRawAnnotation();
+
   int success = LIBSEDML_OPERATION_FAILED;
   unsigned int duplicates = 0;
 
@@ -935,6 +1379,9 @@ int
 SedBase::removeTopLevelAnnotationElement(const std::string elementName,
     const std::string elementURI)
 {
+  markDirty();
+  parseRawAnnotation();
+
 
   int success = LIBSEDML_OPERATION_FAILED;
 
@@ -1052,6 +1499,11 @@ SedBase::replaceTopLevelAnnotationElement(const std::string& annotation)
 int
 SedBase::setNotes(const XMLNode* notes)
 {
+  markDirty();
+
+  mRawNotes.clear();
+  clearUnparsed(&mUnparsed, UNPARSED_NOTES);
+
   if (mNotes == notes)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -1124,6 +1576,8 @@ SedBase::setNotes(const XMLNode* notes)
 int
 SedBase::setNotes(const std::string& notes, bool addXHTMLMarkup)
 {
+  markDirty();
+
   int success = LIBSEDML_OPERATION_FAILED;
 
   if (notes.empty())
@@ -1204,6 +1658,9 @@ SedBase::setNotes(const std::string& notes, bool addXHTMLMarkup)
 int
 SedBase::appendNotes(const XMLNode* notes)
 {
+  markDirty();
+  parseRawNotes();
+
   int success = LIBSEDML_OPERATION_FAILED;
 
   if (notes == NULL)
@@ -1595,8 +2052,12 @@ SedBase::appendNotes(const std::string& notes)
 void
 SedBase::setSedDocument(SedDocument* d)
 {
+  if (d == mSed) return;
+
   mSed = d;
 
+  // strings of another document must not share its storage
+  if (mSed != NULL) internStrings();
 }
 
 
@@ -1612,6 +2073,8 @@ SedBase::connectToParent(SedBase* parent)
 
   if (mParentSedObject)
     {
+      if (mDirty) mParentSedObject->markDirty();
+
       setSedDocument(mParentSedObject->getSedDocument());
     }
   else
@@ -1700,6 +2163,11 @@ SedBase::getAncestorOfType(int type, const std::string pkgName) const
 int
 SedBase::setNamespaces(XMLNamespaces* xmlns)
 {
+  markDirty();
+
+  // prefixes of every element in the document may change
+  if (mSed != NULL) mSed->invalidateXMLFragments();
+
   if (xmlns == NULL)
     {
       mSedNamespaces->setNamespaces(NULL);
@@ -1720,6 +2188,8 @@ SedBase::setNamespaces(XMLNamespaces* xmlns)
 int
 SedBase::unsetMetaId()
 {
+  markDirty();
+
   /* only in L2 onwards */
   if (getLevel() < 2)
     {
@@ -1745,6 +2215,8 @@ SedBase::unsetMetaId()
 int
 SedBase::unsetId()
 {
+  markDirty();
+
   return LIBSEDML_OPERATION_FAILED;
 }
 
@@ -1755,6 +2227,8 @@ SedBase::unsetId()
 int
 SedBase::unsetName()
 {
+  markDirty();
+
   return LIBSEDML_OPERATION_FAILED;
 }
 
@@ -1765,6 +2239,10 @@ SedBase::unsetName()
 int
 SedBase::unsetNotes()
 {
+  markDirty();
+
+  mRawNotes.clear();
+  clearUnparsed(&mUnparsed, UNPARSED_NOTES);
   delete mNotes;
   mNotes = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -1777,6 +2255,8 @@ SedBase::unsetNotes()
 int
 SedBase::unsetAnnotation()
 {
+  markDirty();
+
   XMLNode* empty = NULL;
   return setAnnotation(empty);
 }
@@ -2070,8 +2550,8 @@ SedBase::getSedNamespaces() const
 char*
 SedBase::toSed()
 {
-  ostringstream    os;
-  XMLOutputStream  stream(os, "UTF-8", false);
+  ostringstream       os;
+  SedRawOutputStream  stream(os, "UTF-8", false);
 
   write(stream);
 
@@ -2088,6 +2568,10 @@ SedBase::read(XMLInputStream& stream)
 {
   if (!stream.peek().isStart()) return;
 
+  SedTrace* trace = traceOf(mSed);
+  SedTraceScope scope(trace, SedTrace::PHASE_READ, getElementName());
+  SedElementFilter* filter = filterOf(mSed);
+
   const XMLToken  element  = stream.next();
   int             position =  0;
 
@@ -2223,7 +2707,21 @@ SedBase::read(XMLInputStream& stream)
                << stream.peek().getURI() << endl;
 #endif
 
-          SedBase * object = createObject(stream);
+          // elements that are not read are passed over by the tokenizer,
+          // before any object is created for them
+          if (filter != NULL && filter->isSkipped(nextName))
+            {
+              filter->addSkipped();
+              stream.skipPastEnd(stream.next());
+              continue;
+            }
+
+          SedBase * object = NULL;
+
+          {
+            SedTraceScope created(trace, SedTrace::PHASE_CREATE_OBJECT, nextName);
+            object = createObject(stream);
+          }
 
           if (object != NULL)
             {
@@ -2232,18 +2730,37 @@ SedBase::read(XMLInputStream& stream)
 
               object->connectToParent(static_cast <SedBase*>(this));
 
+              unsigned int skipped = 0;
+
+              if (filter != NULL)
+                {
+                  skipped = filter->getNumSkipped();
+                  filter->beginElement(nextName);
+                }
+
               object->read(stream);
 
+              if (filter != NULL) filter->endElement();
+
               if (!stream.isGood()) break;
 
-              checkListOfPopulated(object);
+              // a list emptied by the filter is not an error
+              if (filter == NULL || filter->getNumSkipped() == skipped)
+                {
+                  checkListOfPopulated(object);
+                }
             }
-          else if (!(readOtherXML(stream)
-                     || readAnnotation(stream)
-                     || readNotes(stream)))
+          else
             {
-              logUnknownElement(nextName, getLevel(), getVersion());
-              stream.skipPastEnd(stream.next());
+              SedTraceScope content(trace, SedTrace::PHASE_XML, nextName);
+
+              if (!(readOtherXML(stream)
+                    || readAnnotation(stream)
+                    || readNotes(stream)))
+                {
+                  logUnknownElement(nextName, getLevel(), getVersion());
+                  stream.skipPastEnd(stream.next());
+                }
             }
         }
       else
@@ -2284,6 +2801,60 @@ SedBase::write(XMLOutputStream& stream) const
 
     }
 
+  SedTraceScope scope(traceOf(mSed), SedTrace::PHASE_WRITE, getElementName());
+
+  SedFragmentOutputStream* fragments =
+    dynamic_cast<SedFragmentOutputStream*>(&stream);
+
+  if (fragments != NULL && fragments->canUseFragments())
+    {
+      unsigned int generation =
+        (mSed != NULL) ? mSed->getFragmentGeneration() : 0;
+
+      size_t start = fragments->beginFragment();
+      unsigned int indent = fragments->getIndent();
+
+      // only the items of the top-level lists keep their text, so that
+      // every part of the document is cached once and not at every level
+      bool cache = (indent == SedFragmentOutputStream::CACHED_INDENT);
+
+      if (cache)
+        {
+          lockSection(&sFragmentLock);
+
+          if (!mDirty && mCachedGeneration == generation
+              && mCachedIndent == indent)
+            {
+              fragments->writeFragment(mCachedXML);
+              unlockSection(&sFragmentLock);
+              return;
+            }
+
+          unlockSection(&sFragmentLock);
+        }
+
+      stream.startElement(getElementName(), getPrefix());
+
+      writeXMLNS(stream);
+      writeAttributes(stream);
+      writeElements(stream);
+
+      stream.endElement(getElementName(), getPrefix());
+
+      // threads writing the same document store the same text
+      std::string text;
+
+      if (cache) fragments->endFragment(start, text);
+
+      lockSection(&sFragmentLock);
+      mCachedXML.swap(text);
+      mCachedIndent = indent;
+      mCachedGeneration = generation;
+      mDirty = false;
+      unlockSection(&sFragmentLock);
+      return;
+    }
+
   stream.startElement(getElementName(), getPrefix());
 
   writeXMLNS(stream);
@@ -2305,15 +2876,32 @@ SedBase::write(XMLOutputStream& stream) const
 void
 SedBase::writeElements(XMLOutputStream& stream) const
 {
-  if (mNotes != NULL) stream << *mNotes;
+  // notes and annotation kept as text by a lazy read are copied as they
+  // are, unless the stream can only write parsed XML
+  SedRawOutputStream* raw = dynamic_cast<SedRawOutputStream*>(&stream);
+
+  if (hasUnparsedNotes() && raw != NULL)
+    {
+      raw->writeRaw(mRawNotes);
+    }
+  else if (getNotes() != NULL)
+    {
+      stream << *mNotes;
+    }
+
+  if (hasUnparsedAnnotation() && raw != NULL)
+    {
+      raw->writeRaw(mRawAnnotation);
+      return;
+    }
 
   /*
    * NOTE: CVTerms on a model have already been dealt with
    */
 
-  const_cast <SedBase *>(this)->syncAnnotation();
+  const XMLNode* annotation = getAnnotation();
 
-  if (mAnnotation != NULL) stream << *mAnnotation;
+  if (annotation != NULL) stream << *annotation;
 }
 
 /** @endcond */
@@ -2373,7 +2961,7 @@ SedBase::readAnnotation(XMLInputStream& stream)
       // If an annotation already exists, log it as an error and replace
       // the content of the existing annotation with the new one.
 
-      if (mAnnotation != NULL)
+      if (mAnnotation != NULL || hasUnparsedAnnotation())
         {
           if (getLevel() < 3)
             {
@@ -2388,8 +2976,23 @@ SedBase::readAnnotation(XMLInputStream& stream)
         }
 
       delete mAnnotation;
+      mAnnotation = NULL;
+      mRawAnnotation.clear();
+      clearUnparsed(&mUnparsed, UNPARSED_ANNOTATION);
+
+      if (mSed != NULL && mSed->getLazyNotesAndAnnotations())
+        {
+          // the checks only need the top level elements
+          XMLNode outline;
+          readRawElement(stream, mRawAnnotation, &outline);
+          setUnparsed(&mUnparsed, UNPARSED_ANNOTATION);
+          checkAnnotation(outline);
+          return true;
+        }
+
       mAnnotation = new XMLNode(stream);
       checkAnnotation();
+      syncAnnotation();
       return true;
     }
 
@@ -2414,7 +3017,7 @@ SedBase::readNotes(XMLInputStream& stream)
       // If an annotation element already exists, then the ordering is wrong.
       // In either case, replace existing content with the new notes read.
 
-      if (mNotes != NULL)
+      if (mNotes != NULL || hasUnparsedNotes())
         {
           if (getLevel() < 3)
             {
@@ -2427,7 +3030,7 @@ SedBase::readNotes(XMLInputStream& stream)
               logError(SedOnlyOneNotesElementAllowed, getLevel(), getVersion());
             }
         }
-      else if (mAnnotation != NULL)
+      else if (mAnnotation != NULL || hasUnparsedAnnotation())
         {
           logError(SedNotSchemaConformant, getLevel(), getVersion(),
                    "Incorrect ordering of <annotation> and <notes> elements -- "
@@ -2436,6 +3039,20 @@ SedBase::readNotes(XMLInputStream& stream)
         }
 
       delete mNotes;
+      mNotes = NULL;
+      mRawNotes.clear();
+      clearUnparsed(&mUnparsed, UNPARSED_NOTES);
+
+      if (mSed != NULL && mSed->getLazyNotesAndAnnotations())
+        {
+          const XMLNamespaces xmlns = stream.peek().getNamespaces();
+          checkDefaultNamespace(&xmlns, "notes");
+
+          readRawElement(stream, mRawNotes);
+          setUnparsed(&mUnparsed, UNPARSED_NOTES);
+          return true;
+        }
+
       mNotes = new XMLNode(stream);
 
       //
@@ -2466,6 +3083,20 @@ SedBase::getHasBeenDeleted() const
 }
 
 
+bool
+SedBase::hasUnparsedNotes() const
+{
+  return (loadUnparsed(&mUnparsed) & UNPARSED_NOTES) != 0;
+}
+
+
+bool
+SedBase::hasUnparsedAnnotation() const
+{
+  return (loadUnparsed(&mUnparsed) & UNPARSED_ANNOTATION) != 0;
+}
+
+
 /** @endcond */
 
 
@@ -2585,6 +3216,118 @@ SedBase::logEmptyString(const string& attribute,
 /** @endcond */
 
 
+/*
+ * Estimates the memory used by this object and everything below it.
+ */
+SedMemoryFootprint
+SedBase::getMemoryFootprint() const
+{
+  SedMemoryFootprint footprint;
+  footprint.add(this);
+  return footprint;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+/*
+ * Charges the metaid, notes, annotation and namespaces of this object.
+ */
+void
+SedBase::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  footprint.addString(mMetaId);
+  footprint.addString(mURI);
+  footprint.addString(mEmptyString);
+  footprint.addString(mCachedXML);
+  footprint.addString(mRawNotes);
+  footprint.addString(mRawAnnotation);
+  footprint.addXML(mNotes);
+  footprint.addXML(mAnnotation);
+  footprint.addNamespaces(mSedNamespaces);
+}
+
+
+/*
+ * SedBase has no interned strings of its own.
+ */
+void
+SedBase::internStrings()
+{
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Visits the child objects in document order.
+ */
+void
+SedBase::acceptChildren(SedVisitor& v) const
+{
+  std::vector<const SedBase*> children;
+  getChildObjects(children);
+
+  for (size_t n = 0; n < children.size(); ++n)
+    children[n]->accept(v);
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Interns a value in the string pool of the document.
+ */
+SedString
+SedBase::internString(const std::string& value)
+{
+  if (mSed == NULL) return SedString(value);
+
+  return mSed->getStringPool().intern(value);
+}
+
+
+/*
+ * Interns a value again, in the string pool of the current document.
+ */
+void
+SedBase::reinternString(SedString& value)
+{
+  if (!value.empty()) value = internString(value.str());
+}
+
+
+/*
+ * Reads an attribute into an interned string.
+ */
+bool
+SedBase::readInto(const XMLAttributes& attributes, const std::string& name,
+                  SedString& value, bool required)
+{
+  std::string text;
+  bool assigned = attributes.readInto(name, text, getErrorLog(), required);
+
+  if (assigned) value = internString(text);
+
+  return assigned;
+}
+
+
+/*
+ * Checks the syntax of an id and sets it as an interned string.
+ */
+int
+SedBase::checkAndSetSId(const std::string& id, SedString& value)
+{
+  std::string text;
+  int result = SyntaxChecker::checkAndSetSId(id, text);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS) value = internString(text);
+
+  return result;
+}
+/** @endcond */
+
+
 /** @cond doxygen-libsbml-internal */
 /*
  * Convenience method for easily logging problems from within method
@@ -2602,6 +3345,10 @@ SedBase::logError(unsigned int       id
   // (TODO) Needs to be fixed so that error can be added when
   // no SedDocument attached.
   //
+  SedTrace* trace = traceOf(mSed);
+  SedTraceScope scope(trace, SedTrace::PHASE_ERROR,
+                      trace != NULL ? attributeValueToString((int)id) : "");
+
   if (SedBase::getErrorLog() != NULL && mSed != NULL)
     getErrorLog()->logError(id, getLevel(), getVersion(), details, getLine(), getColumn());
 }
@@ -2851,15 +3598,7 @@ SedBase::writeXMLNS(XMLOutputStream& stream) const
 void
 SedBase::syncAnnotation()
 {
-
-  if (mAnnotation == NULL)
-    {
-      XMLToken ann_token = XMLToken(XMLTriple("annotation", "", ""),
-                                    XMLAttributes());
-      mAnnotation = new XMLNode(ann_token);
-    }
-
-  // if annotation still empty delete the annotation
+  // if annotation is empty delete the annotation
   if (mAnnotation != NULL && mAnnotation->getNumChildren() == 0)
     {
       delete mAnnotation;
@@ -3037,12 +3776,101 @@ SedBase::checkDefaultNamespace(const XMLNamespaces* xmlns,
     }
 }
 
+/*
+ * Parses the notes kept as text by a lazy read, if any, into mNotes.
+ */
+void
+SedBase::parseRawNotes() const
+{
+  if (!hasUnparsedNotes()) return;
+
+  lockSection(&sParseLock);
+
+  // another thread may have parsed them while this one waited
+  if (!hasUnparsedNotes())
+    {
+      unlockSection(&sParseLock);
+      return;
+    }
+
+  SedBase* self = const_cast<SedBase *>(this);
+  XMLNode* notes_xmln;
+
+  // you might not have a document !!
+  if (getSedDocument() != NULL)
+    {
+      XMLNamespaces* xmlns = getSedDocument()->getNamespaces();
+      notes_xmln = XMLNode::convertStringToXMLNode(mRawNotes, xmlns);
+    }
+  else
+    {
+      notes_xmln = XMLNode::convertStringToXMLNode(mRawNotes);
+    }
+
+  delete self->mNotes;
+  self->mNotes = notes_xmln;
+
+  // the text stays, other threads may be writing it
+  clearUnparsed(&mUnparsed, UNPARSED_NOTES);
+  unlockSection(&sParseLock);
+}
+
+
+/*
+ * Parses the annotation kept as text by a lazy read, if any, into
+ * mAnnotation.
+ */
+void
+SedBase::parseRawAnnotation() const
+{
+  if (!hasUnparsedAnnotation()) return;
+
+  lockSection(&sParseLock);
+
+  if (!hasUnparsedAnnotation())
+    {
+      unlockSection(&sParseLock);
+      return;
+    }
+
+  SedBase* self = const_cast<SedBase *>(this);
+  XMLNode* annt_xmln;
+
+  // you might not have a document !!
+  if (getSedDocument() != NULL)
+    {
+      XMLNamespaces* xmlns = getSedDocument()->getNamespaces();
+      annt_xmln = XMLNode::convertStringToXMLNode(mRawAnnotation, xmlns);
+    }
+  else
+    {
+      annt_xmln = XMLNode::convertStringToXMLNode(mRawAnnotation);
+    }
+
+  delete self->mAnnotation;
+  self->mAnnotation = annt_xmln;
+  self->syncAnnotation();
+
+  clearUnparsed(&mUnparsed, UNPARSED_ANNOTATION);
+  unlockSection(&sParseLock);
+}
+
+
 /*
  * Checks the annotation does not declare an sbml namespace.
  * If the annotation declares an sbml namespace an error is logged.
  */
 void
 SedBase::checkAnnotation()
+{
+  if (mAnnotation == NULL) return;
+
+  checkAnnotation(*mAnnotation);
+}
+
+
+void
+SedBase::checkAnnotation(const XMLNode& annotation)
 {
   unsigned int nNodes = 0;
   unsigned int match = 0;
@@ -3050,18 +3878,16 @@ SedBase::checkAnnotation()
   std::vector<std::string> uri_list;
   uri_list.clear();
 
-  if (mAnnotation == NULL) return;
-
   //
   // checks if the given default namespace (if any) is a valid
   // Sed namespace
   //
-  const XMLNamespaces &xmlns = mAnnotation->getNamespaces();
+  const XMLNamespaces &xmlns = annotation.getNamespaces();
   checkDefaultNamespace(&xmlns, "annotation");
 
-  while (nNodes < mAnnotation->getNumChildren())
+  while (nNodes < annotation.getNumChildren())
     {
-      XMLNode topLevel = mAnnotation->getChild(nNodes);
+      const XMLNode& topLevel = annotation.getChild(nNodes);
 
       // the top level must be an element (so it should be a start)
       if (topLevel.isStart() == false)
@@ -3329,6 +4155,8 @@ SedBase::removeDuplicateAnnotations()
   XMLToken token = XMLToken(triple, att, xmlns);
   XMLNode * newNode = NULL;
 
+  parseRawAnnotation();
+
   if (isSetAnnotation())
     {
       //make a copy to work with
@@ -4591,4 +5419,34 @@ SedBase_getAllElements(SedBase_t* sb)
 }
 
 
+/**
+ * Predicate returning @c true if the given SedBase_t structure was modified
+ * since it was last written with fragment caching enabled.
+ *
+ * @param sb the SedBase_t structure
+ *
+ * @return @c 1 if @p sb is dirty, @c 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedBase_isDirty(const SedBase_t* sb)
+{
+  return (sb != NULL) ? static_cast<int>(sb->isDirty()) : 0;
+}
+
+
+/**
+ * Marks the given SedBase_t structure, and every structure containing it,
+ * as modified.
+ *
+ * @param sb the SedBase_t structure
+ */
+LIBSEDML_EXTERN
+void
+SedBase_markDirty(SedBase_t* sb)
+{
+  if (sb != NULL) sb->markDirty();
+}
+
+
 LIBSEDML_CPP_NAMESPACE_END
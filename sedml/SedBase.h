@@ -138,6 +138,8 @@
 #include <sedml/common/sedmlfwd.h>
 #include <sedml/SedTypeCodes.h>
 #include <sedml/SedNamespaces.h>
+#include <sedml/SedStringPool.h>
+#include <sedml/SedMemoryFootprint.h>
 #include <sbml/util/List.h>
 #include <sbml/SyntaxChecker.h>
 #include <sedml/SedConstructorException.h>
@@ -148,6 +150,7 @@
 
 
 #include <string>
+#include <vector>
 #include <stdexcept>
 #include <algorithm>
 
@@ -204,6 +207,10 @@ public:
   /**
    * Accepts the given SedVisitor for this SedBase object.
    *
+   * The object is passed to <code>v.visit()</code>; when that returns
+   * @c true the child objects are visited in document order before
+   * <code>v.leave()</code> is called for this object.
+   *
    * @param v the SedVisitor instance to be used
    *
    * @return the result of calling <code>v.visit()</code>.
@@ -211,6 +218,39 @@ public:
   virtual bool accept(SedVisitor& v) const = 0;
 
 
+  /**
+   * Estimates the memory used by this object and everything below it.
+   *
+   * @return the footprint, with the bytes per type code and per kind of
+   * content.
+   *
+   * @see SedMemoryFootprint
+   */
+  SedMemoryFootprint getMemoryFootprint() const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Charges the memory this object owns, besides its own size and its
+   * child objects, to the footprint.  Subclasses add their strings, math
+   * and values and call the implementation of their parent.
+   */
+  virtual void addMemoryFootprint(SedMemoryFootprint& footprint) const;
+
+
+  /**
+   * Interns the strings of this object in the string pool of its document,
+   * so that it shares no storage with the document it was copied or moved
+   * from.  Called by setSedDocument() when the document changes;
+   * subclasses intern their SedString attributes and call the
+   * implementation of their parent.
+   */
+  virtual void internStrings();
+
+  /** @endcond */
+
+
   /**
    * Creates and returns a deep copy of this SedBase object.
    *
@@ -499,6 +539,11 @@ public:
    * @see appendNotes(const std::string& notes)
    * @see unsetNotes()
    * @see SyntaxChecker::hasExpectedXHTMLSyntax(@if java XMLNode xhtml@endif)
+   *
+   * @note Notes kept as text by a SedReader with
+   * SedReader::setLazyNotesAndAnnotations() enabled are parsed by the first
+   * call.  Parsing is done once, under a lock, so several threads can call
+   * this method on an object that none of them changes.
    */
   XMLNode* getNotes() const;
 
@@ -661,6 +706,11 @@ public:
    * @see appendAnnotation(const XMLNode* annotation)
    * @see appendAnnotation(const std::string& annotation)
    * @see unsetAnnotation()
+   *
+   * @note An annotation kept as text by a SedReader with
+   * SedReader::setLazyNotesAndAnnotations() enabled is parsed by the first
+   * call.  Parsing is done once, under a lock, so several threads can call
+   * this method on an object that none of them changes.
    */
   XMLNode* getAnnotation() const;
 
@@ -2151,6 +2201,23 @@ public:
   /** @endcond */
 
 
+  /** @cond doxygen-libsedml-internal */
+  /**
+   * @return true if the notes of this object were kept as text by a
+   * SedReader with SedReader::setLazyNotesAndAnnotations() enabled and
+   * have not been parsed since.
+   */
+  bool hasUnparsedNotes() const;
+
+  /**
+   * @return true if the annotation of this object was kept as text by a
+   * SedReader with SedReader::setLazyNotesAndAnnotations() enabled and
+   * has not been parsed since.
+   */
+  bool hasUnparsedAnnotation() const;
+  /** @endcond */
+
+
   /**
    * Removes itself from its parent.  If the parent was storing it as a
    * pointer, it is deleted.  If not, it is simply cleared (as in ListOf
@@ -2245,6 +2312,154 @@ public:
    */
   void *getUserData() const;
 
+
+  /**
+   * Predicate returning @c true if this object has been modified since it
+   * was last written by a SedWriter with fragment caching enabled.
+   *
+   * Newly created and copied objects are always dirty.  When a document is
+   * written with fragment caching enabled, every object written becomes
+   * clean, and the items of the top-level lists keep the XML produced for
+   * them; writing the document again then copies that XML for clean items
+   * instead of serializing them anew.
+   *
+   * @return @c true if this object needs to be serialized again, @c false
+   * otherwise.
+   *
+   * @see markDirty()
+   * @see SedWriter::setCacheFragments(bool cache)
+   */
+  bool isDirty() const;
+
+
+  /**
+   * Marks this object, and every object containing it, as modified.
+   *
+   * All setters, unsetters and list operations of libSEDML call this
+   * function themselves.  It only needs to be called after changing an
+   * object by other means, for example after editing the XMLNode returned
+   * by getNotes() or getAnnotation() in place.
+   *
+   * @see isDirty()
+   */
+  void markDirty();
+
+
+  /**
+   * Adds the names of the attributes of this object to @p names, in the
+   * order in which they are written.
+   *
+   * Together with isSetAttribute() and getAttribute() this allows generic
+   * code to inspect any Sed object without knowing its concrete class.
+   *
+   * @param names the vector to which the attribute names are appended.
+   *
+   * @see getAttribute(const std::string& attributeName, std::string& value)
+   */
+  virtual void getAttributeNames(std::vector<std::string>& names) const;
+
+
+  /**
+   * Predicate returning @c true if the attribute with the given name is set
+   * on this object.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   *
+   * @return @c true if the attribute is set, @c false otherwise.
+   */
+  virtual bool isSetAttribute(const std::string& attributeName) const;
+
+
+  /**
+   * Returns the value of the attribute with the given name as a string,
+   * formatted the way it is written in SED-ML.  Numbers are written with
+   * enough digits to be read back exactly.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   * @param value the string that receives the value of the attribute.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int getAttribute(const std::string& attributeName,
+                           std::string& value) const;
+
+
+  /**
+   * Sets the attribute with the given name from its string form, as it
+   * would be read from SED-ML.  This is the counterpart of getAttribute().
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   * @param value the value of the attribute.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int setAttribute(const std::string& attributeName,
+                           const std::string& value);
+
+
+  /**
+   * Unsets the attribute with the given name.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int unsetAttribute(const std::string& attributeName);
+
+
+  /**
+   * Creates a new child object for the SED-ML element with the given name
+   * and adds it to this object, the way the reader does.  Lists append the
+   * new item; objects with a single optional child replace it.
+   *
+   * @param elementName the name of the element, e.g. "task".
+   *
+   * @return the new object, or @c NULL if this object cannot contain an
+   * element of that name.  The object is owned by this object.
+   */
+  virtual SedBase* createChildObject(const std::string& elementName);
+
+
+  /**
+   * Adds the Sed objects directly contained in this object to @p children,
+   * in the order in which they are written.  Contained lists are added
+   * even when they are empty; the items of a list are its children.
+   *
+   * @param children the vector to which the child objects are appended.
+   */
+  virtual void getChildObjects(std::vector<const SedBase*>& children) const;
+
+
+  /** @cond doxygen-libsbml-internal */
+
+  /*
+   * Formatting helpers used by getAttribute(); doubles are written with
+   * the shortest precision that reads back to the same value.
+   */
+  static std::string attributeValueToString(double value);
+  static std::string attributeValueToString(int value);
+  static std::string attributeValueToString(bool value);
+
+  /*
+   * Parsing helpers used by setAttribute(); they accept what the
+   * formatting helpers write and return false on malformed text.
+   */
+  static bool attributeValueFromString(const std::string& text, double& value);
+  static bool attributeValueFromString(const std::string& text, int& value);
+  static bool attributeValueFromString(const std::string& text, bool& value);
+
+  /** @endcond */
+
   /**
    * @return the SedErrorLog used to log errors during while reading and
    * validating Sed.
@@ -2387,6 +2602,40 @@ protected:
                       const std::string& element);
 
 
+  /**
+   * Calls accept() on each of the objects returned by getChildObjects().
+   */
+  void acceptChildren(SedVisitor& v) const;
+
+
+  /**
+   * Returns the given value interned in the string pool of the document
+   * of this object, or an unshared SedString if there is no document.
+   */
+  SedString internString(const std::string& value);
+
+
+  /**
+   * Replaces a non-empty value by its copy interned in the string pool of
+   * the document of this object.
+   */
+  void reinternString(SedString& value);
+
+
+  /**
+   * Reads an attribute like XMLAttributes::readInto() and interns its
+   * value.
+   */
+  bool readInto(const XMLAttributes& attributes, const std::string& name,
+                SedString& value, bool required);
+
+
+  /**
+   * Sets an id like SyntaxChecker::checkAndSetSId() and interns it.
+   */
+  int checkAndSetSId(const std::string& id, SedString& value);
+
+
   /**
    * Subclasses should override this method to add the list of
    * expected attributes. Be sure to call your parents implementation
@@ -2469,6 +2718,28 @@ protected:
   void checkAnnotation();
 
 
+  /**
+   * Checks the given annotation like checkAnnotation(); only its namespaces
+   * and top level elements are used.
+   */
+  void checkAnnotation(const XMLNode& annotation);
+
+
+  /**
+   * Parses the notes kept as text by a lazy read, if any, into mNotes.
+   * Safe to call from several threads at once.
+   */
+  void parseRawNotes() const;
+
+
+  /**
+   * Parses the annotation kept as text by a lazy read, if any, into
+   * mAnnotation.  It was checked when it was read.  Safe to call from
+   * several threads at once.
+   */
+  void parseRawAnnotation() const;
+
+
   /**
    * Checks that the XHTML is valid.
    * If the xhtml does not conform to the specification of valid xhtml within
@@ -2547,6 +2818,11 @@ protected:
   std::string     mMetaId;
   XMLNode*        mNotes;
   XMLNode*        mAnnotation;
+  /* notes and annotation kept as text by a lazy read, until they change */
+  std::string     mRawNotes;
+  std::string     mRawAnnotation;
+  /* which of them have not been parsed yet; changed atomically */
+  mutable volatile long mUnparsed;
   SedDocument*   mSed;
   SedNamespaces* mSedNamespaces;
   void*           mUserData;
@@ -2582,6 +2858,12 @@ protected:
   //
   std::string mURI;
 
+  /* serialization cache used when fragment caching is enabled on SedWriter */
+  mutable bool mDirty;
+  mutable std::string mCachedXML;
+  mutable unsigned int mCachedIndent;
+  mutable unsigned int mCachedGeneration;
+
   bool getHasBeenDeleted() const;
 
   /** @endcond */
@@ -2846,6 +3128,14 @@ LIBSEDML_EXTERN
 void
 SedBase_renameSIdRefs(SedBase_t* sb, const char* oldid, const char* newid);
 
+LIBSEDML_EXTERN
+int
+SedBase_isDirty(const SedBase_t* sb);
+
+LIBSEDML_EXTERN
+void
+SedBase_markDirty(SedBase_t* sb);
+
 
 END_C_DECLS
 LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,963 @@
+/**
+ * @file   SedCanonicalForm.cpp
+ * @brief  Canonical form and structural hash of Sed objects
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedCanonicalForm.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedTypes.h>
+
+#include <sbml/xml/XMLOutputStream.h>
+#include <sbml/util/util.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Receives the canonical form of an object as a sequence of events.
+ */
+class SedCanonicalSink
+{
+public:
+  virtual ~SedCanonicalSink() {}
+
+  virtual void startElement(const std::string& name) = 0;
+  virtual void attribute(const std::string& name, const std::string& value) = 0;
+  virtual void characters(const std::string& chars) = 0;
+  virtual void endElement(const std::string& name) = 0;
+};
+
+
+/*
+ * Writes the canonical form as XML-like text: no whitespace between
+ * elements, attributes in declaration order, no namespace prefixes.
+ */
+class SedCanonicalTextSink : public SedCanonicalSink
+{
+public:
+  SedCanonicalTextSink() : mInStart(false) {}
+
+  virtual void startElement(const std::string& name)
+  {
+    closeStart();
+    mText += '<';
+    mText += name;
+    mInStart = true;
+  }
+
+  virtual void attribute(const std::string& name, const std::string& value)
+  {
+    mText += ' ';
+    mText += name;
+    mText += "=\"";
+    escape(value);
+    mText += '"';
+  }
+
+  virtual void characters(const std::string& chars)
+  {
+    closeStart();
+    escape(chars);
+  }
+
+  virtual void endElement(const std::string& name)
+  {
+    if (mInStart)
+      {
+        mText += "/>";
+        mInStart = false;
+      }
+    else
+      {
+        mText += "</";
+        mText += name;
+        mText += '>';
+      }
+  }
+
+  const std::string& getText() const { return mText; }
+
+private:
+  void closeStart()
+  {
+    if (mInStart)
+      {
+        mText += '>';
+        mInStart = false;
+      }
+  }
+
+  void escape(const std::string& value)
+  {
+    for (std::string::const_iterator it = value.begin(); it != value.end(); ++it)
+      {
+        switch (*it)
+          {
+          case '&': mText += "&amp;";  break;
+          case '<': mText += "&lt;";   break;
+          case '>': mText += "&gt;";   break;
+          case '"': mText += "&quot;"; break;
+          default:  mText += *it;      break;
+          }
+      }
+  }
+
+  std::string mText;
+  bool mInStart;
+};
+
+
+/*
+ * Streaming MurmurHash3 (x64, 128 bit) over a length-prefixed encoding of
+ * the canonical events.  Bytes are always combined in little endian order
+ * so that the result does not depend on the platform.
+ */
+class SedCanonicalHashSink : public SedCanonicalSink
+{
+public:
+  SedCanonicalHashSink()
+    : mH1(0), mH2(0), mTailLength(0), mLength(0)
+  {
+  }
+
+  virtual void startElement(const std::string& name)
+  {
+    tag('S');
+    add(name);
+  }
+
+  virtual void attribute(const std::string& name, const std::string& value)
+  {
+    tag('A');
+    add(name);
+    add(value);
+  }
+
+  virtual void characters(const std::string& chars)
+  {
+    tag('C');
+    add(chars);
+  }
+
+  virtual void endElement(const std::string& /* name */)
+  {
+    tag('E');
+  }
+
+  SedHash finish() const
+  {
+    uint64_t h1 = mH1;
+    uint64_t h2 = mH2;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    for (size_t i = mTailLength; i > 8; --i)
+      k2 |= static_cast<uint64_t>(mTail[i - 1]) << ((i - 9) * 8);
+
+    for (size_t i = std::min<size_t>(mTailLength, 8); i > 0; --i)
+      k1 |= static_cast<uint64_t>(mTail[i - 1]) << ((i - 1) * 8);
+
+    if (mTailLength > 8)
+      {
+        k2 *= C2; k2 = rotl(k2, 33); k2 *= C1; h2 ^= k2;
+      }
+
+    if (mTailLength > 0)
+      {
+        k1 *= C1; k1 = rotl(k1, 31); k1 *= C2; h1 ^= k1;
+      }
+
+    h1 ^= mLength;
+    h2 ^= mLength;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix(h1);
+    h2 = fmix(h2);
+    h1 += h2;
+    h2 += h1;
+
+    return SedHash(h1, h2);
+  }
+
+private:
+  static const uint64_t C1 = 0x87c37b91114253d5ULL;
+  static const uint64_t C2 = 0x4cf5ad432745937fULL;
+
+  static uint64_t rotl(uint64_t x, int r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  static uint64_t fmix(uint64_t k)
+  {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+  }
+
+  static uint64_t load(const unsigned char* bytes)
+  {
+    uint64_t value = 0;
+
+    for (int i = 7; i >= 0; --i)
+      value = (value << 8) | bytes[i];
+
+    return value;
+  }
+
+  void block(const unsigned char* bytes)
+  {
+    uint64_t k1 = load(bytes);
+    uint64_t k2 = load(bytes + 8);
+
+    k1 *= C1; k1 = rotl(k1, 31); k1 *= C2; mH1 ^= k1;
+    mH1 = rotl(mH1, 27); mH1 += mH2; mH1 = mH1 * 5 + 0x52dce729;
+
+    k2 *= C2; k2 = rotl(k2, 33); k2 *= C1; mH2 ^= k2;
+    mH2 = rotl(mH2, 31); mH2 += mH1; mH2 = mH2 * 5 + 0x38495ab5;
+  }
+
+  void update(const unsigned char* data, size_t length)
+  {
+    mLength += length;
+
+    if (mTailLength > 0)
+      {
+        size_t fill = std::min(length, 16 - mTailLength);
+        memcpy(mTail + mTailLength, data, fill);
+        mTailLength += fill;
+        data += fill;
+        length -= fill;
+
+        if (mTailLength < 16) return;
+
+        block(mTail);
+        mTailLength = 0;
+      }
+
+    for (; length >= 16; data += 16, length -= 16)
+      block(data);
+
+    memcpy(mTail, data, length);
+    mTailLength = length;
+  }
+
+  void tag(char value)
+  {
+    unsigned char byte = static_cast<unsigned char>(value);
+    update(&byte, 1);
+  }
+
+  void add(const std::string& value)
+  {
+    uint64_t length = value.size();
+    unsigned char prefix[4];
+
+    for (int i = 0; i < 4; ++i)
+      prefix[i] = static_cast<unsigned char>((length >> (8 * i)) & 0xff);
+
+    update(prefix, 4);
+    update(reinterpret_cast<const unsigned char*>(value.data()), value.size());
+  }
+
+  uint64_t mH1;
+  uint64_t mH2;
+  unsigned char mTail[16];
+  size_t mTailLength;
+  uint64_t mLength;
+};
+
+
+/*
+ * Writes an XMLNode ignoring prefixes, namespace declarations, attribute
+ * order and whitespace-only text.
+ */
+static void
+writeCanonicalXML(const XMLNode& node, SedCanonicalSink& sink)
+{
+  if (node.isText())
+    {
+      const std::string& chars = node.getCharacters();
+      size_t first = chars.find_first_not_of(" \t\r\n");
+
+      if (first != std::string::npos)
+        {
+          size_t last = chars.find_last_not_of(" \t\r\n");
+          sink.characters(chars.substr(first, last - first + 1));
+        }
+
+      return;
+    }
+
+  bool isElement = node.isElement() && !node.getName().empty();
+  std::string name;
+
+  if (isElement)
+    {
+      name = node.getURI().empty() ? node.getName()
+             : "{" + node.getURI() + "}" + node.getName();
+      sink.startElement(name);
+
+      const XMLAttributes& attributes = node.getAttributes();
+      std::vector<std::pair<std::string, std::string> > sorted;
+
+      for (int i = 0; i < attributes.getLength(); ++i)
+        {
+          std::string attributeName = attributes.getURI(i).empty()
+                                      ? attributes.getName(i)
+                                      : "{" + attributes.getURI(i) + "}" + attributes.getName(i);
+          sorted.push_back(std::make_pair(attributeName, attributes.getValue(i)));
+        }
+
+      std::sort(sorted.begin(), sorted.end());
+
+      for (size_t i = 0; i < sorted.size(); ++i)
+        sink.attribute(sorted[i].first, sorted[i].second);
+    }
+
+  for (unsigned int i = 0; i < node.getNumChildren(); ++i)
+    writeCanonicalXML(node.getChild(i), sink);
+
+  if (isElement)
+    sink.endElement(name);
+}
+
+
+/*
+ * Writes an ASTNode.  Numbers are written by value, so that for example
+ * 1e3 and 1000.0 have the same canonical form.
+ */
+static void
+writeCanonicalMath(const ASTNode* node, SedCanonicalSink& sink)
+{
+  if (node == NULL) return;
+
+  static const std::string name = "ast";
+  sink.startElement(name);
+
+  if (node->isInteger())
+    {
+      sink.attribute("type", SedBase::attributeValueToString((int)AST_INTEGER));
+      std::ostringstream value;
+      value << node->getInteger();
+      sink.attribute("value", value.str());
+    }
+  else if (node->isRational())
+    {
+      sink.attribute("type", SedBase::attributeValueToString((int)AST_RATIONAL));
+      std::ostringstream value;
+      value << node->getNumerator() << "/" << node->getDenominator();
+      sink.attribute("value", value.str());
+    }
+  else if (node->isReal())
+    {
+      sink.attribute("type", SedBase::attributeValueToString((int)AST_REAL));
+      sink.attribute("value", SedBase::attributeValueToString(node->getReal()));
+    }
+  else
+    {
+      sink.attribute("type", SedBase::attributeValueToString((int)node->getType()));
+
+      if (node->getName() != NULL && (node->isName() || node->getType() == AST_FUNCTION))
+        sink.attribute("name", node->getName());
+    }
+
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+    writeCanonicalMath(node->getChild(i), sink);
+
+  sink.endElement(name);
+}
+
+
+/*
+ * Writes the content of a Sed object that is not available as attributes
+ * or child objects.
+ */
+static void
+writeCanonicalContent(const SedBase* object, SedCanonicalSink& sink)
+{
+  const XMLNode* xml = NULL;
+  const ASTNode* math = NULL;
+
+  switch (object->getTypeCode())
+    {
+    case SEDML_CHANGE_ADDXML:
+      xml = static_cast<const SedAddXML*>(object)->getNewXML();
+      break;
+
+    case SEDML_CHANGE_CHANGEXML:
+      xml = static_cast<const SedChangeXML*>(object)->getNewXML();
+      break;
+
+    case SEDML_CHANGE_COMPUTECHANGE:
+      math = static_cast<const SedComputeChange*>(object)->getMath();
+      break;
+
+    case SEDML_DATAGENERATOR:
+      math = static_cast<const SedDataGenerator*>(object)->getMath();
+      break;
+
+    case SEDML_TASK_SETVALUE:
+      math = static_cast<const SedSetValue*>(object)->getMath();
+      break;
+
+    case SEDML_RANGE_FUNCTIONALRANGE:
+      math = static_cast<const SedFunctionalRange*>(object)->getMath();
+      break;
+
+    case SEDML_RANGE_VECTORRANGE:
+      {
+        static const std::string value = "value";
+        const std::vector<double>& values =
+          static_cast<const SedVectorRange*>(object)->getValues();
+
+        for (size_t i = 0; i < values.size(); ++i)
+          {
+            sink.startElement(value);
+            sink.characters(SedBase::attributeValueToString(values[i]));
+            sink.endElement(value);
+          }
+      }
+      break;
+
+    case SEDML_DATA_DESCRIPTION:
+      {
+        // the NuML description is only available as XML; its writer is
+        // deterministic, so the text with collapsed whitespace is used
+        const DimensionDescription* description =
+          static_cast<const SedDataDescription*>(object)->getDimensionDescription();
+
+        if (description != NULL)
+          {
+            std::ostringstream text;
+            XMLOutputStringStream stream(text, "UTF-8", false);
+            description->write(stream);
+
+            std::string collapsed;
+            bool space = false;
+            std::string raw = text.str();
+
+            for (std::string::const_iterator it = raw.begin(); it != raw.end(); ++it)
+              {
+                if (*it == ' ' || *it == '\t' || *it == '\r' || *it == '\n')
+                  {
+                    space = true;
+                    continue;
+                  }
+
+                if (space && !collapsed.empty() && *it != '<'
+                    && collapsed[collapsed.size() - 1] != '>')
+                  collapsed += ' ';
+
+                space = false;
+                collapsed += *it;
+              }
+
+            static const std::string name = "dimensionDescription";
+            sink.startElement(name);
+            sink.characters(collapsed);
+            sink.endElement(name);
+          }
+      }
+      break;
+
+    default:
+      break;
+    }
+
+  if (xml != NULL)
+    {
+      static const std::string name = "newXML";
+      sink.startElement(name);
+      writeCanonicalXML(*xml, sink);
+      sink.endElement(name);
+    }
+
+  if (math != NULL)
+    {
+      static const std::string name = "math";
+      sink.startElement(name);
+      writeCanonicalMath(math, sink);
+      sink.endElement(name);
+    }
+}
+
+/** @endcond */
+
+
+SedHash::SedHash()
+  : mHigh(0)
+  , mLow(0)
+{
+}
+
+
+SedHash::SedHash(uint64_t high, uint64_t low)
+  : mHigh(high)
+  , mLow(low)
+{
+}
+
+
+uint64_t
+SedHash::getHigh() const
+{
+  return mHigh;
+}
+
+
+uint64_t
+SedHash::getLow() const
+{
+  return mLow;
+}
+
+
+std::string
+SedHash::toString() const
+{
+  static const char digits[] = "0123456789abcdef";
+  std::string result(32, '0');
+
+  for (int i = 0; i < 16; ++i)
+    {
+      result[15 - i] = digits[(mHigh >> (4 * i)) & 0xf];
+      result[31 - i] = digits[(mLow >> (4 * i)) & 0xf];
+    }
+
+  return result;
+}
+
+
+bool
+SedHash::operator==(const SedHash& rhs) const
+{
+  return mHigh == rhs.mHigh && mLow == rhs.mLow;
+}
+
+
+bool
+SedHash::operator!=(const SedHash& rhs) const
+{
+  return !(*this == rhs);
+}
+
+
+bool
+SedHash::operator<(const SedHash& rhs) const
+{
+  return mHigh < rhs.mHigh || (mHigh == rhs.mHigh && mLow < rhs.mLow);
+}
+
+
+SedCanonicalForm::SedCanonicalForm()
+  : mIncludeNotes(false)
+  , mIncludeAnnotations(true)
+{
+}
+
+
+void
+SedCanonicalForm::setIncludeNotes(bool includeNotes)
+{
+  mIncludeNotes = includeNotes;
+}
+
+
+bool
+SedCanonicalForm::getIncludeNotes() const
+{
+  return mIncludeNotes;
+}
+
+
+void
+SedCanonicalForm::setIncludeAnnotations(bool includeAnnotations)
+{
+  mIncludeAnnotations = includeAnnotations;
+}
+
+
+bool
+SedCanonicalForm::getIncludeAnnotations() const
+{
+  return mIncludeAnnotations;
+}
+
+
+std::string
+SedCanonicalForm::toString(const SedBase* object) const
+{
+  if (object == NULL) return "";
+
+  SedCanonicalTextSink sink;
+  write(object, sink);
+  return sink.getText();
+}
+
+
+SedHash
+SedCanonicalForm::hash(const SedBase* object) const
+{
+  if (object == NULL) return SedHash();
+
+  SedCanonicalHashSink sink;
+  write(object, sink);
+  return sink.finish();
+}
+
+
+std::string
+SedCanonicalForm::taskClosureToString(const SedTask* task,
+                                      const SedDependencyGraph* graph) const
+{
+  std::vector<const SedBase*> objects;
+  getClosure(task, graph, objects);
+
+  static const std::string name = "closure";
+  SedCanonicalTextSink sink;
+  sink.startElement(name);
+
+  for (size_t i = 0; i < objects.size(); ++i)
+    write(objects[i], sink);
+
+  sink.endElement(name);
+  return sink.getText();
+}
+
+
+SedHash
+SedCanonicalForm::hashTaskClosure(const SedTask* task,
+                                  const SedDependencyGraph* graph) const
+{
+  std::vector<const SedBase*> objects;
+  getClosure(task, graph, objects);
+
+  static const std::string name = "closure";
+  SedCanonicalHashSink sink;
+  sink.startElement(name);
+
+  for (size_t i = 0; i < objects.size(); ++i)
+    write(objects[i], sink);
+
+  sink.endElement(name);
+  return sink.finish();
+}
+
+
+std::string
+SedCanonicalForm::taskWorkToString(const SedTask* task,
+                                   const SedDependencyGraph* graph) const
+{
+  SedCanonicalTextSink sink;
+  writeTaskWork(task, NULL, graph, sink);
+  return sink.getText();
+}
+
+
+SedHash
+SedCanonicalForm::hashTaskWork(const SedTask* task,
+                               const SedDependencyGraph* graph) const
+{
+  SedCanonicalHashSink sink;
+  writeTaskWork(task, NULL, graph, sink);
+  return sink.finish();
+}
+
+
+SedHash
+SedCanonicalForm::hashTaskWork(const SedTask* task,
+                               const SedHash& modelHash,
+                               const SedDependencyGraph* graph) const
+{
+  SedCanonicalHashSink sink;
+  writeTaskWork(task, &modelHash, graph, sink);
+  return sink.finish();
+}
+
+
+SedHash
+SedCanonicalForm::hashXML(const XMLNode* xml) const
+{
+  if (xml == NULL) return SedHash();
+
+  SedCanonicalHashSink sink;
+  writeCanonicalXML(*xml, sink);
+  return sink.finish();
+}
+
+
+void
+SedCanonicalForm::getTaskClosure(const SedTask* task,
+                                 std::vector<const SedBase*>& objects)
+{
+  if (task == NULL) return;
+
+  const SedDocument* doc = task->getSedDocument();
+
+  if (doc == NULL)
+    {
+      objects.push_back(task);
+      return;
+    }
+
+  SedDependencyGraph graph(doc);
+  graph.getClosure(task, objects);
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+void
+SedCanonicalForm::getClosure(const SedTask* task,
+                             const SedDependencyGraph* graph,
+                             std::vector<const SedBase*>& objects)
+{
+  if (task == NULL) return;
+
+  // a graph of another document cannot resolve the references of task
+  if (graph == NULL || graph->getDocument() != task->getSedDocument())
+    {
+      getTaskClosure(task, objects);
+      return;
+    }
+
+  graph->getClosure(task, objects);
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-libsedml-internal */
+
+void
+SedCanonicalForm::write(const SedBase* object, SedCanonicalSink& sink,
+                        bool writeIds) const
+{
+  const std::string& name = object->getElementName();
+  sink.startElement(name);
+
+  std::vector<std::string> names;
+  object->getAttributeNames(names);
+  std::string value;
+
+  for (size_t i = 0; i < names.size(); ++i)
+    {
+      if (!writeIds && (names[i] == "id" || names[i] == "name"))
+        continue;
+
+      if (object->getAttribute(names[i], value) == LIBSEDML_OPERATION_SUCCESS)
+        sink.attribute(names[i], value);
+    }
+
+  if (mIncludeNotes && object->isSetNotes())
+    writeCanonicalXML(*object->getNotes(), sink);
+
+  if (mIncludeAnnotations && object->isSetAnnotation())
+    writeCanonicalXML(*object->getAnnotation(), sink);
+
+  std::vector<const SedBase*> children;
+  object->getChildObjects(children);
+
+  for (size_t i = 0; i < children.size(); ++i)
+    {
+      const SedBase* child = children[i];
+
+      // empty lists are not written, so they do not change the content
+      if (child->getTypeCode() == SEDML_LIST_OF
+          && static_cast<const SedListOf*>(child)->size() == 0)
+        continue;
+
+      write(child, sink);
+    }
+
+  writeCanonicalContent(object, sink);
+
+  sink.endElement(name);
+}
+
+
+/*
+ * Writes the model of a task, with the changes of the models it is derived
+ * from (oldest first), and its simulation, leaving out their ids.  Tasks
+ * other than a plain SedTask are written as their closure.
+ */
+void
+SedCanonicalForm::writeTaskWork(const SedTask* task, const SedHash* modelHash,
+                                const SedDependencyGraph* graph,
+                                SedCanonicalSink& sink) const
+{
+  static const std::string work = "work";
+  static const std::string model = "model";
+  sink.startElement(work);
+
+  const SedDocument* doc = task != NULL ? task->getSedDocument() : NULL;
+
+  if (task == NULL || doc == NULL || task->getTypeCode() != SEDML_TASK)
+    {
+      std::vector<const SedBase*> objects;
+      getClosure(task, graph, objects);
+
+      for (size_t i = 0; i < objects.size(); ++i)
+        write(objects[i], sink);
+
+      sink.endElement(work);
+      return;
+    }
+
+  sink.startElement(model);
+
+  if (modelHash != NULL)
+    {
+      sink.attribute("resolved", modelHash->toString());
+    }
+  else
+    {
+      std::vector<const SedModel*> chain;
+      std::string reference = task->getModelReference();
+
+      for (;;)
+        {
+          const SedModel* current = doc->getModel(reference);
+
+          if (current == NULL)
+            {
+              sink.attribute("missing", reference);
+              break;
+            }
+
+          if (std::find(chain.begin(), chain.end(), current) != chain.end())
+            {
+              sink.attribute("cycle", reference);
+              break;
+            }
+
+          chain.push_back(current);
+          const std::string& source = current->getSource();
+
+          if (source.empty() || source[0] != '#')
+            {
+              sink.attribute("language", current->getLanguage());
+              sink.attribute("source", source);
+              break;
+            }
+
+          reference = source.substr(1);
+        }
+
+      for (size_t i = chain.size(); i > 0; --i)
+        {
+          const SedModel* current = chain[i - 1];
+
+          for (unsigned int n = 0; n < current->getNumChanges(); ++n)
+            write(current->getChange(n), sink, false);
+        }
+    }
+
+  sink.endElement(model);
+
+  const SedSimulation* simulation =
+    doc->getSimulation(task->getSimulationReference());
+
+  if (simulation != NULL)
+    write(simulation, sink, false);
+
+  sink.endElement(work);
+}
+
+/** @endcond */
+
+
+/**
+ * Returns the canonical form of the given SedBase_t structure.  The
+ * returned string is owned by the caller.
+ */
+LIBSEDML_EXTERN
+char *
+SedCanonicalForm_toString(const SedBase_t * sb)
+{
+  if (sb == NULL) return NULL;
+
+  SedCanonicalForm canonical;
+  return safe_strdup(canonical.toString(sb).c_str());
+}
+
+
+/**
+ * Returns the structural hash of the given SedBase_t structure as 32
+ * hexadecimal digits.  The returned string is owned by the caller.
+ */
+LIBSEDML_EXTERN
+char *
+SedCanonicalForm_hash(const SedBase_t * sb)
+{
+  if (sb == NULL) return NULL;
+
+  SedCanonicalForm canonical;
+  return safe_strdup(canonical.hash(sb).toString().c_str());
+}
+
+
+/**
+ * Returns the structural hash of the given SedTask_t structure together
+ * with the objects it depends on, as 32 hexadecimal digits.  The returned
+ * string is owned by the caller.
+ */
+LIBSEDML_EXTERN
+char *
+SedCanonicalForm_hashTaskClosure(const SedTask_t * st)
+{
+  if (st == NULL) return NULL;
+
+  SedCanonicalForm canonical;
+  return safe_strdup(canonical.hashTaskClosure(st).toString().c_str());
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,361 @@
+/**
+ * @file   SedCanonicalForm.h
+ * @brief  Canonical form and structural hash of Sed objects
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedHash
+ * @ingroup Core
+ * @brief A 128 bit structural hash value.
+ *
+ * @class SedCanonicalForm
+ * @ingroup Core
+ * @brief Computes canonical forms and structural hashes of Sed objects.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * The canonical form of a Sed object depends only on its content: element
+ * types, attribute values, math, XML content and the order of contained
+ * elements.  It does not depend on attribute order, whitespace, namespace
+ * prefixes, the number format used in the file or the comments written by
+ * SedWriter.  Empty lists are treated as absent.
+ *
+ * hash() computes a 128 bit hash of the canonical form directly from the
+ * object model, without building it and without serializing to XML.  The
+ * hash is stable across platforms and program runs, so it can be used as
+ * a persistent cache key.
+ *
+ * For a SedTask, hashTaskClosure() covers the task together with
+ * everything needed to run it: the referenced model (and the models it is
+ * derived from), its changes, the simulation with its algorithm, and for
+ * repeated tasks all sub-tasks and models referenced by set values.
+ * hashTaskWork() covers only what determines the results of a task (its
+ * model with all changes and its simulation, without their ids), so that
+ * tasks doing the same work can be run once.
+ *
+ * Notes are ignored by default, annotations are included; both can be
+ * configured.
+ *
+ * The closures of tasks are resolved through a SedDependencyGraph of
+ * their document.  The methods on tasks build one for the call; to hash
+ * many tasks of a document, build a graph once and pass it to each call.
+ * The caller then owns the graph and knows when the document changes; a
+ * SedCanonicalForm keeps no state besides its options.
+ */
+
+#ifndef SedCanonicalForm_h
+#define SedCanonicalForm_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedTask;
+class SedCanonicalSink;
+class SedDependencyGraph;
+
+
+class LIBSEDML_EXTERN SedHash
+{
+public:
+
+  /**
+   * Creates a new SedHash with all bits cleared.
+   */
+  SedHash();
+
+
+  /**
+   * Creates a new SedHash from its two 64 bit halves.
+   */
+  SedHash(uint64_t high, uint64_t low);
+
+
+  /**
+   * @return the most significant 64 bits of this hash.
+   */
+  uint64_t getHigh() const;
+
+
+  /**
+   * @return the least significant 64 bits of this hash.
+   */
+  uint64_t getLow() const;
+
+
+  /**
+   * @return this hash as 32 lower case hexadecimal digits.
+   */
+  std::string toString() const;
+
+
+  bool operator==(const SedHash& rhs) const;
+  bool operator!=(const SedHash& rhs) const;
+  bool operator<(const SedHash& rhs) const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  uint64_t mHigh;
+  uint64_t mLow;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedCanonicalForm
+{
+public:
+
+  /**
+   * Creates a new SedCanonicalForm that ignores notes and includes
+   * annotations.
+   */
+  SedCanonicalForm();
+
+
+  /**
+   * Sets whether the content of notes is part of the canonical form.
+   *
+   * @param includeNotes a boolean, @c true to include notes.
+   */
+  void setIncludeNotes(bool includeNotes);
+
+
+  /**
+   * @return @c true if the content of notes is part of the canonical form.
+   */
+  bool getIncludeNotes() const;
+
+
+  /**
+   * Sets whether the content of annotations is part of the canonical form.
+   *
+   * @param includeAnnotations a boolean, @c true to include annotations.
+   */
+  void setIncludeAnnotations(bool includeAnnotations);
+
+
+  /**
+   * @return @c true if the content of annotations is part of the canonical
+   * form.
+   */
+  bool getIncludeAnnotations() const;
+
+
+  /**
+   * Returns the canonical form of the given object and everything it
+   * contains.  The canonical form is XML-like text meant for comparison
+   * and inspection; it is not a SED-ML document.
+   *
+   * @param object the Sed object.
+   *
+   * @return the canonical form, or an empty string if @p object is @c NULL.
+   */
+  std::string toString(const SedBase* object) const;
+
+
+  /**
+   * Returns the structural hash of the given object and everything it
+   * contains.  Two objects have the same hash if and only if (up to hash
+   * collisions) their canonical forms are equal.
+   *
+   * @param object the Sed object.
+   *
+   * @return the hash; all bits are cleared if @p object is @c NULL.
+   */
+  SedHash hash(const SedBase* object) const;
+
+
+  /**
+   * Returns the canonical form of the given task together with the models,
+   * simulations and sub-tasks it depends on.
+   *
+   * @param task the task, which has to be part of a SedDocument.
+   * @param graph a dependency graph of the document of @p task, built
+   * after its last change, or @c NULL to build one for this call.
+   *
+   * @return the canonical form of the closure of @p task.
+   */
+  std::string taskClosureToString(const SedTask* task,
+                                  const SedDependencyGraph* graph = NULL) const;
+
+
+  /**
+   * Returns the structural hash of the given task together with the
+   * models, simulations and sub-tasks it depends on.
+   *
+   * @param task the task, which has to be part of a SedDocument.
+   * @param graph a dependency graph of the document of @p task, built
+   * after its last change, or @c NULL to build one for this call.
+   *
+   * @return the hash of the closure of @p task.
+   */
+  SedHash hashTaskClosure(const SedTask* task,
+                          const SedDependencyGraph* graph = NULL) const;
+
+
+  /**
+   * Returns the canonical form of the work the given task describes: the
+   * model it simulates, with the changes of that model and of the models it
+   * is derived from, and the simulation with its algorithm.  Unlike the
+   * closure, the ids and names of the task, models and simulation are left
+   * out, so tasks that would compute the same results have equal forms.
+   *
+   * Only a SedTask that directly references a model has a work of its own;
+   * for other tasks the closure is used.
+   *
+   * @param task the task, which has to be part of a SedDocument.
+   * @param graph a dependency graph of the document of @p task, built
+   * after its last change, or @c NULL to build one for this call.
+   *
+   * @return the canonical form of the work of @p task.
+   */
+  std::string taskWorkToString(const SedTask* task,
+                               const SedDependencyGraph* graph = NULL) const;
+
+
+  /**
+   * Returns the structural hash of the work the given task describes.
+   *
+   * @param task the task, which has to be part of a SedDocument.
+   * @param graph a dependency graph of the document of @p task, built
+   * after its last change, or @c NULL to build one for this call.
+   *
+   * @return the hash of the work of @p task.
+   *
+   * @see taskWorkToString()
+   */
+  SedHash hashTaskWork(const SedTask* task,
+                       const SedDependencyGraph* graph = NULL) const;
+
+
+  /**
+   * Returns the structural hash of the work the given task describes, with
+   * the model and its changes replaced by the given hash of the model they
+   * result in.
+   *
+   * @param task the task, which has to be part of a SedDocument.
+   * @param modelHash the hash of the resolved model, for example from
+   * hashXML().
+   * @param graph a dependency graph of the document of @p task, built
+   * after its last change, or @c NULL to build one for this call.
+   *
+   * @return the hash of the work of @p task.
+   */
+  SedHash hashTaskWork(const SedTask* task, const SedHash& modelHash,
+                       const SedDependencyGraph* graph = NULL) const;
+
+
+  /**
+   * Returns the structural hash of the given XML, which ignores prefixes,
+   * namespace declarations, attribute order and whitespace-only text.
+   *
+   * @param xml the XMLNode.
+   *
+   * @return the hash; all bits are cleared if @p xml is @c NULL.
+   */
+  SedHash hashXML(const XMLNode* xml) const;
+
+
+  /**
+   * Adds the given task and every object it depends on to @p objects, in
+   * a deterministic order and without duplicates.
+   *
+   * @param task the task, which has to be part of a SedDocument.
+   * @param objects the vector to which the objects are appended.
+   */
+  static void getTaskClosure(const SedTask* task,
+                             std::vector<const SedBase*>& objects);
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  void write(const SedBase* object, SedCanonicalSink& sink,
+             bool writeIds = true) const;
+
+  void writeTaskWork(const SedTask* task, const SedHash* modelHash,
+                     const SedDependencyGraph* graph,
+                     SedCanonicalSink& sink) const;
+
+  /* getTaskClosure() through graph if it belongs to the document */
+  static void getClosure(const SedTask* task, const SedDependencyGraph* graph,
+                         std::vector<const SedBase*>& objects);
+
+  bool mIncludeNotes;
+  bool mIncludeAnnotations;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+LIBSEDML_EXTERN
+char *
+SedCanonicalForm_toString(const SedBase_t * sb);
+
+LIBSEDML_EXTERN
+char *
+SedCanonicalForm_hash(const SedBase_t * sb);
+
+LIBSEDML_EXTERN
+char *
+SedCanonicalForm_hashTaskClosure(const SedTask_t * st);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+#endif  /* SedCanonicalForm_h */
@@ -141,8 +141,10 @@ SedChange::isSetTarget() const
 int
 SedChange::setTarget(const std::string& target)
 {
+  markDirty();
+
   {
-    mTarget = target;
+    mTarget = internString(target);
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -154,6 +156,8 @@ SedChange::setTarget(const std::string& target)
 int
 SedChange::unsetTarget()
 {
+  markDirty();
+
   mTarget.erase();
 
   if (mTarget.empty() == true)
@@ -203,6 +207,83 @@ SedChange::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedChange to the vector.
+ */
+void
+SedChange::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("target");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedChange::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "target")
+    {
+      return isSetTarget();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedChange::getAttribute(const std::string& attributeName,
+                        std::string& value) const
+{
+  if (attributeName == "target")
+    {
+      if (isSetTarget() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mTarget;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedChange::setAttribute(const std::string& attributeName,
+                        const std::string& value)
+{
+  if (attributeName == "target")
+    {
+      return setTarget(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedChange::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "target")
+    {
+      return unsetTarget();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -226,8 +307,47 @@ SedChange::writeElements(XMLOutputStream& stream) const
 bool
 SedChange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedChange::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
 
+  footprint.addString(mTarget);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedChange::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mTarget);
 }
 
 
@@ -282,7 +402,7 @@ SedChange::readAttributes(const XMLAttributes& attributes,
   //
   // target string   ( use = "required" )
   //
-  assigned = attributes.readInto("target", mTarget, getErrorLog(), true);
+  assigned = readInto(attributes, "target", mTarget, true);
 
   if (assigned == true)
     {
@@ -542,6 +662,8 @@ SedListOfChanges::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedChange*>(item);
@@ -579,15 +701,12 @@ SedListOfChanges::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedChange in this SedListOfChanges
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfChanges::createObject(XMLInputStream& stream)
+SedListOfChanges::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "addXML")
@@ -624,6 +743,18 @@ SedListOfChanges::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedChange in this SedListOfChanges
+ */
+SedBase*
+SedListOfChanges::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
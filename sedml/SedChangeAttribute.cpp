@@ -141,6 +141,8 @@ SedChangeAttribute::isSetNewValue() const
 int
 SedChangeAttribute::setNewValue(const std::string& newValue)
 {
+  markDirty();
+
   {
     mNewValue = newValue;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -154,6 +156,8 @@ SedChangeAttribute::setNewValue(const std::string& newValue)
 int
 SedChangeAttribute::unsetNewValue()
 {
+  markDirty();
+
   mNewValue.erase();
 
   if (mNewValue.empty() == true)
@@ -217,6 +221,83 @@ SedChangeAttribute::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedChangeAttribute to the vector.
+ */
+void
+SedChangeAttribute::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedChange::getAttributeNames(names);
+
+  names.push_back("newValue");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedChangeAttribute::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "newValue")
+    {
+      return isSetNewValue();
+    }
+
+  return SedChange::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedChangeAttribute::getAttribute(const std::string& attributeName,
+                                 std::string& value) const
+{
+  if (attributeName == "newValue")
+    {
+      if (isSetNewValue() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mNewValue;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedChange::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedChangeAttribute::setAttribute(const std::string& attributeName,
+                                 const std::string& value)
+{
+  if (attributeName == "newValue")
+    {
+      return setNewValue(value);
+    }
+
+  return SedChange::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedChangeAttribute::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "newValue")
+    {
+      return unsetNewValue();
+    }
+
+  return SedChange::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -240,8 +321,30 @@ SedChangeAttribute::writeElements(XMLOutputStream& stream) const
 bool
 SedChangeAttribute::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedChangeAttribute::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedChange::addMemoryFootprint(footprint);
 
+  footprint.addString(mNewValue);
 }
 
 
@@ -222,6 +222,72 @@ public:
   virtual bool hasRequiredAttributes() const;
 
 
+  /**
+   * Adds the names of the attributes of this SedChangeAttribute object to @p names, in
+   * the order in which they are written.
+   *
+   * @param names the vector to which the attribute names are appended.
+   */
+  virtual void getAttributeNames(std::vector<std::string>& names) const;
+
+
+  /**
+   * Predicate returning @c true if the attribute with the given name is set
+   * on this SedChangeAttribute object.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   *
+   * @return @c true if the attribute is set, @c false otherwise.
+   */
+  virtual bool isSetAttribute(const std::string& attributeName) const;
+
+
+  /**
+   * Returns the value of the attribute with the given name as a string,
+   * formatted the way it is written in SED-ML.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   * @param value the string that receives the value of the attribute.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int getAttribute(const std::string& attributeName,
+                           std::string& value) const;
+
+
+  /**
+   * Sets the attribute with the given name on this SedChangeAttribute object from its
+   * string form, as it would be read from SED-ML.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   * @param value the value of the attribute.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int setAttribute(const std::string& attributeName,
+                           const std::string& value);
+
+
+  /**
+   * Unsets the attribute with the given name on this SedChangeAttribute object.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int unsetAttribute(const std::string& attributeName);
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -246,6 +312,17 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Charges the memory this object owns to the footprint.
+   */
+  virtual void addMemoryFootprint(SedMemoryFootprint& footprint) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -0,0 +1,457 @@
+/**
+ * @file   SedChangeEngine.cpp
+ * @brief  Applies the changes of a SedModel to its XML
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedChangeEngine.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedTypes.h>
+#include <sedml/common/unordered.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Returns the position of node among the children of parent.
+ */
+static unsigned int
+indexOfChild(const XMLNode* parent, const XMLNode* node)
+{
+  unsigned int n = 0;
+
+  while (n < parent->getNumChildren() && &parent->getChild(n) != node)
+    ++n;
+
+  return n;
+}
+
+
+/*
+ * Inserts the content of newXML into parent at the given position: the
+ * node itself if it is an element, otherwise its children.  Returns the
+ * number of nodes inserted.
+ */
+static unsigned int
+insertContent(XMLNode* parent, unsigned int index, const XMLNode* newXML)
+{
+  if (newXML->isElement())
+    {
+      parent->insertChild(index, *newXML);
+      return 1;
+    }
+
+  for (unsigned int n = 0; n < newXML->getNumChildren(); ++n)
+    parent->insertChild(index + n, newXML->getChild(n));
+
+  return newXML->getNumChildren();
+}
+
+/** @endcond */
+
+
+SedChangeEngine::SedChangeEngine(XMLNode* model,
+                                 const XMLNamespaces* namespaces)
+  : mResolver(model, namespaces)
+  , mPending()
+  , mPendingIndex()
+  , mFailed()
+{
+}
+
+
+XMLNode*
+SedChangeEngine::getModel() const
+{
+  return mResolver.getModel();
+}
+
+
+SedTargetResolver&
+SedChangeEngine::getResolver()
+{
+  return mResolver;
+}
+
+
+int
+SedChangeEngine::apply(const SedModel* model)
+{
+  if (model == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return apply(model->getListOfChanges());
+}
+
+
+int
+SedChangeEngine::apply(const SedListOfChanges* changes)
+{
+  if (changes == NULL || getModel() == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  mFailed.clear();
+
+  for (unsigned int n = 0; n < changes->size(); ++n)
+    {
+      const SedChange* change = static_cast<const SedChange*>(changes->get(n));
+
+      switch (change->getTypeCode())
+        {
+        case SEDML_CHANGE_ATTRIBUTE:
+          setValue(change->getTarget(),
+                   static_cast<const SedChangeAttribute*>(change)->getNewValue(),
+                   change);
+          break;
+
+        case SEDML_CHANGE_COMPUTECHANGE:
+          if (!compute(static_cast<const SedComputeChange*>(change)))
+            mFailed.push_back(change);
+          break;
+
+        default:
+          flush();
+          if (!applyStructural(change))
+            mFailed.push_back(change);
+          break;
+        }
+    }
+
+  flush();
+
+  return mFailed.empty() ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+unsigned int
+SedChangeEngine::getNumFailed() const
+{
+  return (unsigned int)mFailed.size();
+}
+
+
+const SedChange*
+SedChangeEngine::getFailed(unsigned int n) const
+{
+  return n < mFailed.size() ? mFailed[n] : NULL;
+}
+
+
+int
+SedChangeEngine::evaluate(const ASTNode* math,
+                          const std::map<std::string, double>& values,
+                          double& result)
+{
+  if (math == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  std::map<std::string, unsigned int> inputs;
+  std::vector<double> array;
+  std::map<std::string, double>::const_iterator it = values.begin();
+
+  for (; it != values.end(); ++it)
+    {
+      inputs[it->first] = (unsigned int)array.size();
+      array.push_back(it->second);
+    }
+
+  SedCompiledMath compiled;
+  int success = compiled.compile(math, inputs);
+
+  if (success != LIBSEDML_OPERATION_SUCCESS) return success;
+
+  result = compiled.evaluate(array.empty() ? NULL : &array[0]);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+SedChangeEngine::TargetKey
+SedChangeEngine::keyOf(const SedTargetHandle& handle)
+{
+  return TargetKey(handle.getNode(),
+                   std::make_pair(handle.getAttributeName(), handle.getAttributeURI()));
+}
+
+
+void
+SedChangeEngine::setValue(const std::string& target, const std::string& value,
+                          const SedChange* change)
+{
+  const SedTargetHandle* handle = mResolver.resolve(target);
+
+  if (handle == NULL)
+    {
+      mFailed.push_back(change);
+      return;
+    }
+
+  std::map<TargetKey, size_t>::const_iterator it = mPendingIndex.find(keyOf(*handle));
+
+  if (it == mPendingIndex.end())
+    {
+      PendingValue pending = { *handle, value, change };
+      mPendingIndex[keyOf(*handle)] = mPending.size();
+      mPending.push_back(pending);
+      return;
+    }
+
+  // a later change of the same attribute replaces the value; the earlier
+  // change has no effect of its own, so it cannot fail any more
+  mPending[it->second].value = value;
+  mPending[it->second].change = change;
+}
+
+
+/*
+ * Reads the current value of a target, taking pending values into account.
+ */
+bool
+SedChangeEngine::getValue(const std::string& target, double& value)
+{
+  const SedTargetHandle* handle = mResolver.resolve(target);
+
+  if (handle == NULL || !handle->isAttribute()) return false;
+
+  std::map<TargetKey, size_t>::const_iterator it = mPendingIndex.find(keyOf(*handle));
+
+  if (it != mPendingIndex.end())
+    return SedBase::attributeValueFromString(mPending[it->second].value, value);
+
+  return SedBase::attributeValueFromString(handle->getValue(), value);
+}
+
+
+bool
+SedChangeEngine::compute(const SedComputeChange* change)
+{
+  std::map<std::string, double> values;
+
+  for (unsigned int n = 0; n < change->getNumParameters(); ++n)
+    {
+      const SedParameter* parameter = change->getParameter(n);
+      values[parameter->getId()] = parameter->getValue();
+    }
+
+  // only the model being changed can be read
+  const SedBase* model = change->getAncestorOfType(SEDML_MODEL);
+
+  for (unsigned int n = 0; n < change->getNumVariables(); ++n)
+    {
+      const SedVariable* variable = change->getVariable(n);
+
+      if (variable->isSetModelReference()
+          && (model == NULL || variable->getModelReference() != model->getId()))
+        return false;
+
+      if (!variable->isSetTarget()
+          || !getValue(variable->getTarget(), values[variable->getId()]))
+        return false;
+    }
+
+  double result;
+
+  if (evaluate(change->getMath(), values, result) != LIBSEDML_OPERATION_SUCCESS)
+    return false;
+
+  setValue(change->getTarget(), SedBase::attributeValueToString(result), change);
+  return true;
+}
+
+
+/*
+ * Writes the pending values in the order their attributes were first
+ * changed.
+ */
+void
+SedChangeEngine::flush()
+{
+  for (size_t i = 0; i < mPending.size(); ++i)
+    {
+      if (mPending[i].handle.setValue(mPending[i].value) != LIBSEDML_OPERATION_SUCCESS)
+        mFailed.push_back(mPending[i].change);
+    }
+
+  mPending.clear();
+  mPendingIndex.clear();
+}
+
+
+bool
+SedChangeEngine::applyStructural(const SedChange* change)
+{
+  const XMLNode* newXML = NULL;
+  int type = change->getTypeCode();
+
+  if (type == SEDML_CHANGE_ADDXML)
+    newXML = static_cast<const SedAddXML*>(change)->getNewXML();
+  else if (type == SEDML_CHANGE_CHANGEXML)
+    newXML = static_cast<const SedChangeXML*>(change)->getNewXML();
+  else if (type != SEDML_CHANGE_REMOVEXML)
+    return false;
+
+  if (type != SEDML_CHANGE_REMOVEXML && newXML == NULL) return false;
+
+  std::vector<SedTargetHandle> handles;
+  mResolver.resolveAll(SedXPath(change->getTarget(), mResolver.getNamespaces()),
+                       handles);
+
+  if (handles.empty()) return false;
+
+  // editing the children of a node moves them in memory, so the nodes are
+  // addressed by their child indices, innermost first.  Going backwards
+  // through the document keeps the indices of the remaining nodes valid.
+  std::vector<std::vector<unsigned int> > paths(handles.size());
+
+  // the elements whose children change.  All handles of a target have the
+  // same depth, so none of them is below another and editing below one
+  // does not move the others.
+  std::vector<XMLNode*> scopes;
+  LIBSEDML_UNORDERED_NAMESPACE::unordered_set<XMLNode*> isScope;
+  bool changesRoot = false;
+
+  for (size_t i = 0; i < handles.size(); ++i)
+    {
+      XMLNode* scope = handles[i].getNode();
+
+      // of the attributes, only removing an id changes the index
+      bool changesIndex = !handles[i].isAttribute()
+                          || (handles[i].getAttributeName() == "id"
+                              && handles[i].getAttributeURI().empty());
+
+      if (type != SEDML_CHANGE_ADDXML || handles[i].isAttribute())
+        scope = mResolver.getParent(scope);
+
+      if (changesIndex && scope == NULL)
+        changesRoot = true;
+      else if (changesIndex && isScope.insert(scope).second)
+        scopes.push_back(scope);
+
+      const XMLNode* node = handles[i].getNode();
+
+      for (XMLNode* parent = mResolver.getParent(node); parent != NULL;
+           parent = mResolver.getParent(node))
+        {
+          paths[i].push_back(indexOfChild(parent, node));
+          node = parent;
+        }
+    }
+
+  // only the elements below the scopes are indexed again
+  for (size_t i = 0; i < scopes.size(); ++i)
+    mResolver.invalidateChildren(scopes[i]);
+
+  bool applied = true;
+
+  for (size_t i = handles.size(); i > 0; --i)
+    {
+      const std::vector<unsigned int>& path = paths[i - 1];
+      XMLNode* parent = NULL;
+      XMLNode* node = getModel();
+
+      for (size_t k = path.size(); k > 0; --k)
+        {
+          parent = node;
+          node = &node->getChild(path[k - 1]);
+        }
+
+      if (handles[i - 1].isAttribute())
+        {
+          if (type != SEDML_CHANGE_REMOVEXML)
+            applied = false;
+          else
+            node->removeAttr(handles[i - 1].getAttributeName(),
+                             handles[i - 1].getAttributeURI());
+        }
+      else if (type == SEDML_CHANGE_ADDXML)
+        {
+          insertContent(node, node->getNumChildren(), newXML);
+        }
+      else if (parent == NULL)
+        {
+          // the root can only be replaced by a single element
+          if (type == SEDML_CHANGE_REMOVEXML || !newXML->isElement())
+            applied = false;
+          else
+            *node = *newXML;
+        }
+      else
+        {
+          unsigned int index = path[0];
+
+          if (type == SEDML_CHANGE_CHANGEXML)
+            index += insertContent(parent, index, newXML);
+
+          delete parent->removeChild(index);
+        }
+    }
+
+  if (changesRoot)
+    {
+      mResolver.invalidate();
+    }
+  else
+    {
+      for (size_t i = 0; i < scopes.size(); ++i)
+        mResolver.indexChildren(scopes[i]);
+    }
+
+  return applied;
+}
+
+/** @endcond */
+
+
+/**
+ * Applies the changes of the given SedModel to the XML of its source, in
+ * place, using the namespaces of the model to resolve the targets.
+ */
+LIBSEDML_EXTERN
+int
+SedChangeEngine_applyChanges(SedModel_t * model, XMLNode_t * xml)
+{
+  if (model == NULL || xml == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  SedChangeEngine engine(xml, model->getNamespaces());
+  return engine.apply(model);
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,249 @@
+/**
+ * @file   SedChangeEngine.h
+ * @brief  Applies the changes of a SedModel to its XML
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedChangeEngine
+ * @ingroup Core
+ * @brief Applies SedChange objects to the XML of a model in one pass.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedChangeEngine edits one parsed model tree in place; the model is
+ * never serialized between changes.  Changes are applied in the order of
+ * the list, but consecutive SedChangeAttribute and SedComputeChange
+ * objects are batched: their new values are collected by the attribute
+ * their target selects and written, in the order the attributes were
+ * first changed, when the batch ends.  Each distinct target is resolved
+ * once, and two paths that select the same attribute share one value.  A
+ * SedComputeChange evaluates its math against the current values,
+ * including those written earlier in the same batch.  Its variables are
+ * read from the changed model; a variable whose modelReference names
+ * another model cannot be read, and the change fails.
+ *
+ * SedAddXML, SedRemoveXML and SedChangeXML end a batch.  They apply to
+ * every element their target selects; afterwards the targets are
+ * resolved anew.
+ *
+ * A change that cannot be applied (because its target selects nothing,
+ * or its math cannot be evaluated) does not stop the others; it is
+ * recorded and can be retrieved with getFailed().
+ */
+
+#ifndef SedChangeEngine_h
+#define SedChangeEngine_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sedml/SedTargetResolver.h>
+
+#include <sbml/math/ASTNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedChange;
+class SedComputeChange;
+class SedListOfChanges;
+class SedModel;
+
+
+class LIBSEDML_EXTERN SedChangeEngine
+{
+public:
+
+  /**
+   * Creates a new SedChangeEngine for the given model tree.
+   *
+   * @param model the root element of the model XML, which is changed in
+   * place; it has to outlive this object.
+   * @param namespaces the namespaces used to resolve prefixes in targets,
+   * usually those of the SedDocument.  May be @c NULL.
+   */
+  SedChangeEngine(XMLNode* model, const XMLNamespaces* namespaces = NULL);
+
+
+  /**
+   * @return the root element of the model tree.
+   */
+  XMLNode* getModel() const;
+
+
+  /**
+   * @return the resolver used for the targets of the changes, which stays
+   * valid for the changed model.
+   */
+  SedTargetResolver& getResolver();
+
+
+  /**
+   * Applies the changes of the given model.
+   *
+   * @param model the SedModel whose list of changes is applied.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if one or more changes could not be applied
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   */
+  int apply(const SedModel* model);
+
+
+  /**
+   * Applies the given list of changes.
+   *
+   * @param changes the changes to apply.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if one or more changes could not be applied
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   */
+  int apply(const SedListOfChanges* changes);
+
+
+  /**
+   * @return the number of changes that could not be applied by the last
+   * call to apply().
+   */
+  unsigned int getNumFailed() const;
+
+
+  /**
+   * @param n the index of the failed change.
+   *
+   * @return the nth change that could not be applied by the last call to
+   * apply(), or @c NULL if there is no such change.
+   */
+  const SedChange* getFailed(unsigned int n) const;
+
+
+  /**
+   * Evaluates math using the given values for its names.  Arithmetic,
+   * relational and logical operators, piecewise and the functions of
+   * MathML are supported.
+   *
+   * @param math the expression.
+   * @param values the values of the names used in @p math.
+   * @param result receives the value.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if a name has no value or a construct is not supported
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   */
+  static int evaluate(const ASTNode* math,
+                      const std::map<std::string, double>& values,
+                      double& result);
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  void setValue(const std::string& target, const std::string& value,
+                const SedChange* change);
+
+  bool getValue(const std::string& target, double& value);
+
+  bool compute(const SedComputeChange* change);
+
+  void flush();
+
+  bool applyStructural(const SedChange* change);
+
+  // the node, attribute name and attribute URI a target selects
+  typedef std::pair<const XMLNode*, std::pair<std::string, std::string> > TargetKey;
+
+  struct PendingValue
+  {
+    SedTargetHandle handle;
+    std::string value;
+    const SedChange* change;
+  };
+
+  static TargetKey keyOf(const SedTargetHandle& handle);
+
+  SedTargetResolver mResolver;
+
+  // the values written by flush(), in the order their attributes were
+  // first changed, and the position of each attribute among them
+  std::vector<PendingValue> mPending;
+  std::map<TargetKey, size_t> mPendingIndex;
+
+  std::vector<const SedChange*> mFailed;
+
+  /** @endcond */
+
+private:
+  SedChangeEngine(const SedChangeEngine&);
+  SedChangeEngine& operator=(const SedChangeEngine&);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+LIBSEDML_EXTERN
+int
+SedChangeEngine_applyChanges(SedModel_t * model, XMLNode_t * xml);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+#endif  /* SedChangeEngine_h */
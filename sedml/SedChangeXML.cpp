@@ -141,6 +141,8 @@ SedChangeXML::isSetNewXML() const
 int
 SedChangeXML::setNewXML(XMLNode* newXML)
 {
+  markDirty();
+
   if (mNewXML == newXML)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -165,6 +167,8 @@ SedChangeXML::setNewXML(XMLNode* newXML)
 int
 SedChangeXML::unsetNewXML()
 {
+  markDirty();
+
   delete mNewXML;
   mNewXML = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -252,8 +256,30 @@ SedChangeXML::writeElements(XMLOutputStream& stream) const
 bool
 SedChangeXML::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedChangeXML::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedChange::addMemoryFootprint(footprint);
 
+  footprint.addXML(mNewXML);
 }
 
 
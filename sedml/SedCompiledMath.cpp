@@ -0,0 +1,465 @@
+/**
+ * @file   SedCompiledMath.cpp
+ * @brief  Math compiled for repeated evaluation
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedCompiledMath.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cmath>
+#include <limits>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+
+SedCompiledMath::SedCompiledMath()
+  : mProgram()
+  , mNumInputs(0)
+  , mStackSize(0)
+  , mIsCompiled(false)
+{
+}
+
+
+int
+SedCompiledMath::compile(const ASTNode* math,
+                         const std::map<std::string, unsigned int>& inputs)
+{
+  mProgram.clear();
+  mNumInputs = 0;
+  mStackSize = 0;
+  mIsCompiled = false;
+
+  if (math == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  if (!compileNode(math, inputs, 0))
+    {
+      mProgram.clear();
+      mNumInputs = 0;
+      mStackSize = 0;
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  mIsCompiled = true;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+bool
+SedCompiledMath::isCompiled() const
+{
+  return mIsCompiled;
+}
+
+
+unsigned int
+SedCompiledMath::getNumInstructions() const
+{
+  return (unsigned int)mProgram.size();
+}
+
+
+unsigned int
+SedCompiledMath::getNumInputs() const
+{
+  return mNumInputs;
+}
+
+
+unsigned int
+SedCompiledMath::getStackSize() const
+{
+  return mStackSize;
+}
+
+
+double
+SedCompiledMath::evaluate(const double* inputs) const
+{
+  if (!mIsCompiled) return numeric_limits<double>::quiet_NaN();
+
+  if (mStackSize <= STACK_BUFFER_SIZE)
+    {
+      double stack[STACK_BUFFER_SIZE];
+      return run(inputs, stack);
+    }
+
+  std::vector<double> stack(mStackSize);
+  return run(inputs, &stack[0]);
+}
+
+
+double
+SedCompiledMath::evaluate(const double* inputs, double* workspace) const
+{
+  if (!mIsCompiled || workspace == NULL)
+    return numeric_limits<double>::quiet_NaN();
+
+  return run(inputs, workspace);
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+double
+SedCompiledMath::run(const double* inputs, double* stack) const
+{
+  unsigned int size = 0;
+  std::vector<Instruction>::const_iterator it = mProgram.begin();
+
+  for (; it != mProgram.end(); ++it)
+    {
+      switch (it->type)
+        {
+        case AST_REAL:
+          stack[size++] = it->value;
+          break;
+
+        case AST_NAME:
+          stack[size++] = inputs[it->input];
+          break;
+
+        default:
+          {
+            double result;
+            size -= it->numArgs;
+            applyOperator(it->type, stack + size, it->numArgs, result);
+            stack[size++] = result;
+          }
+          break;
+        }
+    }
+
+  return stack[0];
+}
+
+/** @endcond */
+
+
+bool
+SedCompiledMath::applyOperator(ASTNodeType_t type, const double* args,
+                               unsigned int n, double& result)
+{
+  double a = n > 0 ? args[0] : 0;
+  double b = n > 1 ? args[1] : 0;
+  double value;
+
+  switch (type)
+    {
+    case AST_PLUS:
+      value = 0;
+      for (unsigned int i = 0; i < n; ++i) value += args[i];
+      break;
+
+    case AST_TIMES:
+      value = 1;
+      for (unsigned int i = 0; i < n; ++i) value *= args[i];
+      break;
+
+    case AST_MINUS:
+      if (n == 1) value = -a;
+      else if (n == 2) value = a - b;
+      else return false;
+      break;
+
+    case AST_DIVIDE:
+      if (n != 2) return false;
+      value = a / b;
+      break;
+
+    case AST_POWER:
+    case AST_FUNCTION_POWER:
+      if (n != 2) return false;
+      value = pow(a, b);
+      break;
+
+    case AST_FUNCTION_ROOT:
+      // the degree comes first, if given
+      if (n == 1) value = sqrt(a);
+      else if (n == 2) value = pow(b, 1.0 / a);
+      else return false;
+      break;
+
+    case AST_FUNCTION_LOG:
+      // the base comes first, if given
+      if (n == 1) value = log10(a);
+      else if (n == 2) value = log(b) / log(a);
+      else return false;
+      break;
+
+    case AST_FUNCTION_MIN:
+    case AST_FUNCTION_MAX:
+      if (n == 0) return false;
+      value = a;
+      for (unsigned int i = 1; i < n; ++i)
+        {
+          if (type == AST_FUNCTION_MIN ? args[i] < value : args[i] > value)
+            value = args[i];
+        }
+      break;
+
+    case AST_FUNCTION_PIECEWISE:
+      // pieces are (value, condition) pairs, optionally followed by otherwise
+      value = n % 2 == 1 ? args[n - 1] : numeric_limits<double>::quiet_NaN();
+      for (unsigned int i = 0; i + 1 < n; i += 2)
+        {
+          if (args[i + 1] != 0)
+            {
+              value = args[i];
+              break;
+            }
+        }
+      break;
+
+    case AST_RELATIONAL_EQ:
+    case AST_RELATIONAL_NEQ:
+    case AST_RELATIONAL_GT:
+    case AST_RELATIONAL_GEQ:
+    case AST_RELATIONAL_LT:
+    case AST_RELATIONAL_LEQ:
+      if (n < 2) return false;
+      value = 1;
+      for (unsigned int i = 0; i + 1 < n; ++i)
+        {
+          double x = args[i], y = args[i + 1];
+          bool holds;
+
+          switch (type)
+            {
+            case AST_RELATIONAL_EQ:  holds = x == y; break;
+            case AST_RELATIONAL_NEQ: holds = x != y; break;
+            case AST_RELATIONAL_GT:  holds = x > y;  break;
+            case AST_RELATIONAL_GEQ: holds = x >= y; break;
+            case AST_RELATIONAL_LT:  holds = x < y;  break;
+            default:                 holds = x <= y; break;
+            }
+
+          if (!holds) value = 0;
+        }
+      break;
+
+    case AST_LOGICAL_AND:
+      value = 1;
+      for (unsigned int i = 0; i < n; ++i) if (args[i] == 0) value = 0;
+      break;
+
+    case AST_LOGICAL_OR:
+      value = 0;
+      for (unsigned int i = 0; i < n; ++i) if (args[i] != 0) value = 1;
+      break;
+
+    case AST_LOGICAL_XOR:
+      value = 0;
+      for (unsigned int i = 0; i < n; ++i) if (args[i] != 0) value = 1 - value;
+      break;
+
+    case AST_LOGICAL_NOT:
+      if (n != 1) return false;
+      value = a == 0 ? 1 : 0;
+      break;
+
+    case AST_LOGICAL_IMPLIES:
+      if (n != 2) return false;
+      value = (a == 0 || b != 0) ? 1 : 0;
+      break;
+
+    case AST_FUNCTION_QUOTIENT:
+      if (n != 2) return false;
+      value = a / b;
+      value = value < 0 ? ceil(value) : floor(value);
+      break;
+
+    case AST_FUNCTION_REM:
+      if (n != 2) return false;
+      value = fmod(a, b);
+      break;
+
+    default:
+      // the remaining functions take one argument
+      if (n != 1) return false;
+
+      switch (type)
+        {
+        case AST_FUNCTION_ABS:     value = fabs(a);  break;
+        case AST_FUNCTION_EXP:     value = exp(a);   break;
+        case AST_FUNCTION_LN:      value = log(a);   break;
+        case AST_FUNCTION_FLOOR:   value = floor(a); break;
+        case AST_FUNCTION_CEILING: value = ceil(a);  break;
+        case AST_FUNCTION_SIN:     value = sin(a);   break;
+        case AST_FUNCTION_COS:     value = cos(a);   break;
+        case AST_FUNCTION_TAN:     value = tan(a);   break;
+        case AST_FUNCTION_SEC:     value = 1 / cos(a); break;
+        case AST_FUNCTION_CSC:     value = 1 / sin(a); break;
+        case AST_FUNCTION_COT:     value = 1 / tan(a); break;
+        case AST_FUNCTION_SINH:    value = sinh(a);  break;
+        case AST_FUNCTION_COSH:    value = cosh(a);  break;
+        case AST_FUNCTION_TANH:    value = tanh(a);  break;
+        case AST_FUNCTION_SECH:    value = 1 / cosh(a); break;
+        case AST_FUNCTION_CSCH:    value = 1 / sinh(a); break;
+        case AST_FUNCTION_COTH:    value = 1 / tanh(a); break;
+        case AST_FUNCTION_ARCSIN:  value = asin(a);  break;
+        case AST_FUNCTION_ARCCOS:  value = acos(a);  break;
+        case AST_FUNCTION_ARCTAN:  value = atan(a);  break;
+        case AST_FUNCTION_ARCSEC:  value = acos(1 / a); break;
+        case AST_FUNCTION_ARCCSC:  value = asin(1 / a); break;
+        case AST_FUNCTION_ARCCOT:  value = atan(1 / a); break;
+        case AST_FUNCTION_ARCSINH: value = log(a + sqrt(a * a + 1)); break;
+        case AST_FUNCTION_ARCCOSH: value = log(a + sqrt(a * a - 1)); break;
+        case AST_FUNCTION_ARCTANH: value = 0.5 * log((1 + a) / (1 - a)); break;
+        case AST_FUNCTION_ARCSECH: value = log((1 + sqrt(1 - a * a)) / a); break;
+        case AST_FUNCTION_ARCCSCH: value = log(1 / a + sqrt(1 / (a * a) + 1)); break;
+        case AST_FUNCTION_ARCCOTH: value = 0.5 * log((a + 1) / (a - 1)); break;
+
+        case AST_FUNCTION_FACTORIAL:
+          if (a < 0 || a != floor(a))
+            {
+              value = numeric_limits<double>::quiet_NaN();
+              break;
+            }
+          value = 1;
+          for (double k = 2; k <= a; ++k) value *= k;
+          break;
+
+        default:
+          return false;
+        }
+      break;
+    }
+
+  result = value;
+  return true;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Appends the program of a node whose value ends up at the given depth of
+ * the stack.
+ */
+bool
+SedCompiledMath::compileNode(const ASTNode* node,
+                             const std::map<std::string, unsigned int>& inputs,
+                             unsigned int depth)
+{
+  if (node == NULL) return false;
+
+  if (mStackSize < depth + 1) mStackSize = depth + 1;
+
+  Instruction instruction;
+  instruction.type = AST_REAL;
+  instruction.numArgs = 0;
+  instruction.input = 0;
+  instruction.value = 0;
+
+  switch (node->getType())
+    {
+    case AST_INTEGER:
+      instruction.value = (double)node->getInteger();
+      break;
+
+    case AST_REAL:
+    case AST_REAL_E:
+    case AST_RATIONAL:
+      instruction.value = node->getReal();
+      break;
+
+    case AST_CONSTANT_E:
+      instruction.value = exp(1.0);
+      break;
+
+    case AST_CONSTANT_PI:
+      instruction.value = 4.0 * atan(1.0);
+      break;
+
+    case AST_CONSTANT_TRUE:
+      instruction.value = 1;
+      break;
+
+    case AST_CONSTANT_FALSE:
+      instruction.value = 0;
+      break;
+
+    case AST_NAME:
+      {
+        std::map<std::string, unsigned int>::const_iterator it =
+          inputs.find(node->getName() != NULL ? node->getName() : "");
+
+        if (it == inputs.end()) return false;
+
+        instruction.type = AST_NAME;
+        instruction.input = it->second;
+
+        if (mNumInputs < it->second + 1) mNumInputs = it->second + 1;
+      }
+      break;
+
+    default:
+      {
+        unsigned int n = node->getNumChildren();
+
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            if (!compileNode(node->getChild(i), inputs, depth + i)) return false;
+          }
+
+        // check that the operator is supported with this many arguments
+        std::vector<double> zeros(n + 1, 0.0);
+        double result;
+
+        if (!applyOperator(node->getType(), &zeros[0], n, result)) return false;
+
+        instruction.type = node->getType();
+        instruction.numArgs = n;
+      }
+      break;
+    }
+
+  mProgram.push_back(instruction);
+  return true;
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
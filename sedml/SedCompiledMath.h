@@ -0,0 +1,212 @@
+/**
+ * @file   SedCompiledMath.h
+ * @brief  Math compiled for repeated evaluation
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedCompiledMath
+ * @ingroup Core
+ * @brief Math compiled to a flat program over numbered inputs.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * compile() translates an ASTNode into a postfix program, replacing each
+ * name by the index of an input and each constant by its value.
+ * evaluate() then runs the program over an array of inputs; it does not
+ * look at the ASTNode again, so the same math can be evaluated for many
+ * sets of inputs cheaply.
+ *
+ * Arithmetic, relational and logical operators, piecewise and the
+ * functions of MathML are supported.  All pieces of a piecewise are
+ * evaluated before one is selected.
+ *
+ * The stack of evaluate() is local to the call: a fixed buffer for up to
+ * STACK_BUFFER_SIZE values, which is enough for all but very deeply nested
+ * math, and an allocated one otherwise.  A caller can also supply a
+ * workspace of getStackSize() values, which is never allocated.  Either
+ * way, one compiled SedCompiledMath can be evaluated by several threads at
+ * once.
+ */
+
+#ifndef SedCompiledMath_h
+#define SedCompiledMath_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sbml/math/ASTNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedCompiledMath
+{
+public:
+
+  /**
+   * Creates a new, empty SedCompiledMath.
+   */
+  SedCompiledMath();
+
+
+  /**
+   * Compiles the given math.
+   *
+   * @param math the expression.
+   * @param inputs the index in the input array of each name that may occur
+   * in @p math.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if a name is not among the inputs or a construct is not supported
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   */
+  int compile(const ASTNode* math,
+              const std::map<std::string, unsigned int>& inputs);
+
+
+  /**
+   * @return @c true if the last call to compile() succeeded.
+   */
+  bool isCompiled() const;
+
+
+  /**
+   * @return the number of instructions of the program.
+   */
+  unsigned int getNumInstructions() const;
+
+
+  /**
+   * @return the number of inputs the program reads, that is, one more
+   * than the largest input index used.
+   */
+  unsigned int getNumInputs() const;
+
+
+  /**
+   * @return the number of values the program keeps on its stack at most.
+   */
+  unsigned int getStackSize() const;
+
+
+  /**
+   * Evaluates the program.
+   *
+   * @param inputs the values of the inputs, at the indices given to
+   * compile().
+   *
+   * @return the value, or NaN if nothing is compiled.
+   */
+  double evaluate(const double* inputs) const;
+
+
+  /**
+   * Evaluates the program using the given stack.
+   *
+   * @param inputs the values of the inputs, at the indices given to
+   * compile().
+   * @param workspace an array with room for getStackSize() values; it is
+   * overwritten.
+   *
+   * @return the value, or NaN if nothing is compiled or @p workspace is
+   * @c NULL.
+   */
+  double evaluate(const double* inputs, double* workspace) const;
+
+
+  /**
+   * The largest stack that evaluate() keeps in a buffer of its own instead
+   * of allocating it.
+   */
+  static const unsigned int STACK_BUFFER_SIZE = 64;
+
+
+  /**
+   * Applies an operator or function of MathML to evaluated arguments.
+   *
+   * @param type the type of the ASTNode.
+   * @param args the values of its children.
+   * @param numArgs the number of children.
+   * @param result receives the value; arguments outside the domain of a
+   * function give NaN or infinity.
+   *
+   * @return @c true unless the operator is not supported with that many
+   * arguments.
+   */
+  static bool applyOperator(ASTNodeType_t type, const double* args,
+                            unsigned int numArgs, double& result);
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Instruction
+  {
+    ASTNodeType_t type;     // AST_REAL: push value; AST_NAME: push input
+    unsigned int numArgs;
+    unsigned int input;
+    double value;
+  };
+
+  bool compileNode(const ASTNode* node,
+                   const std::map<std::string, unsigned int>& inputs,
+                   unsigned int depth);
+
+  double run(const double* inputs, double* stack) const;
+
+  std::vector<Instruction> mProgram;
+  unsigned int mNumInputs;
+  unsigned int mStackSize;
+  bool mIsCompiled;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedCompiledMath_h */
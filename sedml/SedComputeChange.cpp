@@ -163,6 +163,8 @@ SedComputeChange::isSetMath() const
 int
 SedComputeChange::setMath(ASTNode* math)
 {
+  markDirty();
+
   if (mMath == math)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -198,6 +200,8 @@ SedComputeChange::setMath(ASTNode* math)
 int
 SedComputeChange::unsetMath()
 {
+  markDirty();
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -530,6 +534,19 @@ SedComputeChange::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedComputeChange::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedChange::getChildObjects(children);
+
+  children.push_back(&mVariables);
+  children.push_back(&mParameters);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -568,8 +585,30 @@ SedComputeChange::writeElements(XMLOutputStream& stream) const
 bool
 SedComputeChange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedComputeChange::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedChange::addMemoryFootprint(footprint);
 
+  footprint.addMath(mMath);
 }
 
 
@@ -499,6 +499,15 @@ public:
   virtual bool hasRequiredElements() const;
 
 
+  /**
+   * Adds the SEDML objects directly contained in this SedComputeChange object to
+   * @p children, in the order in which they are written.
+   *
+   * @param children the vector to which the child objects are appended.
+   */
+  virtual void getChildObjects(std::vector<const SedBase*>& children) const;
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -523,6 +532,17 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Charges the memory this object owns to the footprint.
+   */
+  virtual void addMemoryFootprint(SedMemoryFootprint& footprint) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -393,7 +393,9 @@ SedCurve::isSetLineStyle() const
 int
 SedCurve::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -403,6 +405,8 @@ SedCurve::setId(const std::string& id)
 int
 SedCurve::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -416,6 +420,8 @@ SedCurve::setName(const std::string& name)
 int
 SedCurve::setLogX(bool logX)
 {
+  markDirty();
+
   mLogX = logX;
   mIsSetLogX = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -428,6 +434,8 @@ SedCurve::setLogX(bool logX)
 int
 SedCurve::setLogY(bool logY)
 {
+  markDirty();
+
   mLogY = logY;
   mIsSetLogY = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -440,13 +448,15 @@ SedCurve::setLogY(bool logY)
 int
 SedCurve::setXDataReference(const std::string& xDataReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(xDataReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mXDataReference = xDataReference;
+      mXDataReference = internString(xDataReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -458,13 +468,15 @@ SedCurve::setXDataReference(const std::string& xDataReference)
 int
 SedCurve::setYDataReference(const std::string& yDataReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(yDataReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mYDataReference = yDataReference;
+      mYDataReference = internString(yDataReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -476,6 +488,8 @@ SedCurve::setYDataReference(const std::string& yDataReference)
 int
 SedCurve::setLineColor(const std::string& lineColor)
 {
+  markDirty();
+
   {
     mLineColor = lineColor;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -489,6 +503,8 @@ SedCurve::setLineColor(const std::string& lineColor)
 int
 SedCurve::setFillColor(const std::string& fillColor)
 {
+  markDirty();
+
   {
     mFillColor = fillColor;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -502,8 +518,10 @@ SedCurve::setFillColor(const std::string& fillColor)
 int
 SedCurve::setSymbol(const std::string& symbol)
 {
+  markDirty();
+
   {
-    mSymbol = symbol;
+    mSymbol = internString(symbol);
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -515,6 +533,8 @@ SedCurve::setSymbol(const std::string& symbol)
 int
 SedCurve::setLineThickness(double lineThickness)
 {
+  markDirty();
+
   mLineThickness = lineThickness;
   mIsSetLineThickness = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -527,6 +547,8 @@ SedCurve::setLineThickness(double lineThickness)
 int
 SedCurve::setLineStyle(const std::string& lineStyle)
 {
+  markDirty();
+
   {
     mLineStyle = lineStyle;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -540,6 +562,8 @@ SedCurve::setLineStyle(const std::string& lineStyle)
 int
 SedCurve::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -559,6 +583,8 @@ SedCurve::unsetId()
 int
 SedCurve::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -578,6 +604,8 @@ SedCurve::unsetName()
 int
 SedCurve::unsetLogX()
 {
+  markDirty();
+
   mLogX = false;
   mIsSetLogX = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -590,6 +618,8 @@ SedCurve::unsetLogX()
 int
 SedCurve::unsetLogY()
 {
+  markDirty();
+
   mLogY = false;
   mIsSetLogY = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -602,6 +632,8 @@ SedCurve::unsetLogY()
 int
 SedCurve::unsetXDataReference()
 {
+  markDirty();
+
   mXDataReference.erase();
 
   if (mXDataReference.empty() == true)
@@ -621,6 +653,8 @@ SedCurve::unsetXDataReference()
 int
 SedCurve::unsetYDataReference()
 {
+  markDirty();
+
   mYDataReference.erase();
 
   if (mYDataReference.empty() == true)
@@ -640,6 +674,8 @@ SedCurve::unsetYDataReference()
 int
 SedCurve::unsetLineColor()
 {
+  markDirty();
+
   mLineColor.erase();
 
   if (mLineColor.empty() == true)
@@ -659,6 +695,8 @@ SedCurve::unsetLineColor()
 int
 SedCurve::unsetFillColor()
 {
+  markDirty();
+
   mFillColor.erase();
 
   if (mFillColor.empty() == true)
@@ -678,6 +716,8 @@ SedCurve::unsetFillColor()
 int
 SedCurve::unsetSymbol()
 {
+  markDirty();
+
   mSymbol.erase();
 
   if (mSymbol.empty() == true)
@@ -697,6 +737,8 @@ SedCurve::unsetSymbol()
 int
 SedCurve::unsetLineThickness()
 {
+  markDirty();
+
   mLineThickness = numeric_limits<double>::quiet_NaN();
   mIsSetLineThickness = false;
 
@@ -717,6 +759,8 @@ SedCurve::unsetLineThickness()
 int
 SedCurve::unsetLineStyle()
 {
+  markDirty();
+
   mLineStyle.erase();
 
   if (mLineStyle.empty() == true)
@@ -775,6 +819,298 @@ SedCurve::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedCurve to the vector.
+ */
+void
+SedCurve::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+  names.push_back("logX");
+  names.push_back("logY");
+  names.push_back("xDataReference");
+  names.push_back("yDataReference");
+  names.push_back("lineColor");
+  names.push_back("fillColor");
+  names.push_back("symbol");
+  names.push_back("lineThickness");
+  names.push_back("lineStyle");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedCurve::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+  else if (attributeName == "logX")
+    {
+      return isSetLogX();
+    }
+  else if (attributeName == "logY")
+    {
+      return isSetLogY();
+    }
+  else if (attributeName == "xDataReference")
+    {
+      return isSetXDataReference();
+    }
+  else if (attributeName == "yDataReference")
+    {
+      return isSetYDataReference();
+    }
+  else if (attributeName == "lineColor")
+    {
+      return isSetLineColor();
+    }
+  else if (attributeName == "fillColor")
+    {
+      return isSetFillColor();
+    }
+  else if (attributeName == "symbol")
+    {
+      return isSetSymbol();
+    }
+  else if (attributeName == "lineThickness")
+    {
+      return isSetLineThickness();
+    }
+  else if (attributeName == "lineStyle")
+    {
+      return isSetLineStyle();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedCurve::getAttribute(const std::string& attributeName,
+                       std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "logX")
+    {
+      if (isSetLogX() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mLogX);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "logY")
+    {
+      if (isSetLogY() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mLogY);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "xDataReference")
+    {
+      if (isSetXDataReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mXDataReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "yDataReference")
+    {
+      if (isSetYDataReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mYDataReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "lineColor")
+    {
+      if (isSetLineColor() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mLineColor;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "fillColor")
+    {
+      if (isSetFillColor() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mFillColor;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "symbol")
+    {
+      if (isSetSymbol() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mSymbol;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "lineThickness")
+    {
+      if (isSetLineThickness() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mLineThickness);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "lineStyle")
+    {
+      if (isSetLineStyle() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mLineStyle;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedCurve::setAttribute(const std::string& attributeName,
+                       const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+  else if (attributeName == "logX")
+    {
+      bool parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setLogX(parsed);
+    }
+  else if (attributeName == "logY")
+    {
+      bool parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setLogY(parsed);
+    }
+  else if (attributeName == "xDataReference")
+    {
+      return setXDataReference(value);
+    }
+  else if (attributeName == "yDataReference")
+    {
+      return setYDataReference(value);
+    }
+  else if (attributeName == "lineColor")
+    {
+      return setLineColor(value);
+    }
+  else if (attributeName == "fillColor")
+    {
+      return setFillColor(value);
+    }
+  else if (attributeName == "symbol")
+    {
+      return setSymbol(value);
+    }
+  else if (attributeName == "lineThickness")
+    {
+      double parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setLineThickness(parsed);
+    }
+  else if (attributeName == "lineStyle")
+    {
+      return setLineStyle(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedCurve::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+  else if (attributeName == "logX")
+    {
+      return unsetLogX();
+    }
+  else if (attributeName == "logY")
+    {
+      return unsetLogY();
+    }
+  else if (attributeName == "xDataReference")
+    {
+      return unsetXDataReference();
+    }
+  else if (attributeName == "yDataReference")
+    {
+      return unsetYDataReference();
+    }
+  else if (attributeName == "lineColor")
+    {
+      return unsetLineColor();
+    }
+  else if (attributeName == "fillColor")
+    {
+      return unsetFillColor();
+    }
+  else if (attributeName == "symbol")
+    {
+      return unsetSymbol();
+    }
+  else if (attributeName == "lineThickness")
+    {
+      return unsetLineThickness();
+    }
+  else if (attributeName == "lineStyle")
+    {
+      return unsetLineStyle();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -798,8 +1134,57 @@ SedCurve::writeElements(XMLOutputStream& stream) const
 bool
 SedCurve::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedCurve::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
 
+  footprint.addString(mId);
+  footprint.addString(mName);
+  footprint.addString(mXDataReference);
+  footprint.addString(mYDataReference);
+  footprint.addString(mLineColor);
+  footprint.addString(mFillColor);
+  footprint.addString(mSymbol);
+  footprint.addString(mLineStyle);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedCurve::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
+  reinternString(mXDataReference);
+  reinternString(mYDataReference);
+  reinternString(mSymbol);
 }
 
 
@@ -864,7 +1249,7 @@ SedCurve::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "optional" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), false);
+  assigned = readInto(attributes, "id", mId, false);
 
   if (assigned == true)
     {
@@ -908,7 +1293,7 @@ SedCurve::readAttributes(const XMLAttributes& attributes,
   //
   // xDataReference SIdRef   ( use = "required" )
   //
-  assigned = attributes.readInto("xDataReference", mXDataReference, getErrorLog(), true);
+  assigned = readInto(attributes, "xDataReference", mXDataReference, true);
 
   if (assigned == true)
     {
@@ -927,7 +1312,7 @@ SedCurve::readAttributes(const XMLAttributes& attributes,
   //
   // yDataReference SIdRef   ( use = "required" )
   //
-  assigned = attributes.readInto("yDataReference", mYDataReference, getErrorLog(), true);
+  assigned = readInto(attributes, "yDataReference", mYDataReference, true);
 
   if (assigned == true)
     {
@@ -976,7 +1361,7 @@ SedCurve::readAttributes(const XMLAttributes& attributes,
   //
   // symbol string   ( use = "optional" )
   //
-  assigned = attributes.readInto("symbol", mSymbol, getErrorLog(), false);
+  assigned = readInto(attributes, "symbol", mSymbol, false);
 
   if (assigned == true)
     {
@@ -1214,6 +1599,8 @@ SedListOfCurves::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedCurve*>(item);
@@ -1251,15 +1638,12 @@ SedListOfCurves::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedCurve in this SedListOfCurves
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfCurves::createObject(XMLInputStream& stream)
+SedListOfCurves::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "curve")
@@ -1272,6 +1656,18 @@ SedListOfCurves::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedCurve in this SedListOfCurves
+ */
+SedBase*
+SedListOfCurves::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
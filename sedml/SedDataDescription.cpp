@@ -204,6 +204,8 @@ SedDataDescription::getDimensionDescription() const
 DimensionDescription*
 SedDataDescription::createDimensionDescription()
 {
+  markDirty();
+
   if (mDimensionDescription != NULL)
     delete mDimensionDescription;
 
@@ -268,7 +270,9 @@ SedDataDescription::isSetDimensionDescription() const
 int
 SedDataDescription::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -278,6 +282,8 @@ SedDataDescription::setId(const std::string& id)
 int
 SedDataDescription::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -291,6 +297,8 @@ SedDataDescription::setName(const std::string& name)
 int
 SedDataDescription::setFormat(const std::string& format)
 {
+  markDirty();
+
   {
     mFormat = format;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -304,6 +312,8 @@ SedDataDescription::setFormat(const std::string& format)
 int
 SedDataDescription::setSource(const std::string& source)
 {
+  markDirty();
+
   {
     mSource = source;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -317,6 +327,8 @@ SedDataDescription::setSource(const std::string& source)
 int
 SedDataDescription::setDimensionDescription(DimensionDescription* dimensionDescription)
 {
+  markDirty();
+
   if (mDimensionDescription == dimensionDescription)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -341,6 +353,8 @@ SedDataDescription::setDimensionDescription(DimensionDescription* dimensionDescr
 int
 SedDataDescription::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -360,6 +374,8 @@ SedDataDescription::unsetId()
 int
 SedDataDescription::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -379,6 +395,8 @@ SedDataDescription::unsetName()
 int
 SedDataDescription::unsetFormat()
 {
+  markDirty();
+
   mFormat.erase();
 
   if (mFormat.empty() == true)
@@ -398,6 +416,8 @@ SedDataDescription::unsetFormat()
 int
 SedDataDescription::unsetSource()
 {
+  markDirty();
+
   mSource.erase();
 
   if (mSource.empty() == true)
@@ -417,6 +437,8 @@ SedDataDescription::unsetSource()
 int
 SedDataDescription::unsetDimensionDescription()
 {
+  markDirty();
+
   delete mDimensionDescription;
   mDimensionDescription = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -628,6 +650,155 @@ SedDataDescription::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedDataDescription to the vector.
+ */
+void
+SedDataDescription::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+  names.push_back("format");
+  names.push_back("source");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedDataDescription::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+  else if (attributeName == "format")
+    {
+      return isSetFormat();
+    }
+  else if (attributeName == "source")
+    {
+      return isSetSource();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedDataDescription::getAttribute(const std::string& attributeName,
+                                 std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "format")
+    {
+      if (isSetFormat() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mFormat;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "source")
+    {
+      if (isSetSource() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mSource;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedDataDescription::setAttribute(const std::string& attributeName,
+                                 const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+  else if (attributeName == "format")
+    {
+      return setFormat(value);
+    }
+  else if (attributeName == "source")
+    {
+      return setSource(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedDataDescription::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+  else if (attributeName == "format")
+    {
+      return unsetFormat();
+    }
+  else if (attributeName == "source")
+    {
+      return unsetSource();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedDataDescription::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedBase::getChildObjects(children);
+
+  children.push_back(&mDataSources);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -661,8 +832,53 @@ SedDataDescription::writeElements(XMLOutputStream& stream) const
 bool
 SedDataDescription::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
 
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedDataDescription::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mName);
+  footprint.addString(mFormat);
+  footprint.addString(mSource);
+
+  // the NUML description is charged its own size only
+  if (mDimensionDescription != NULL) footprint.addOther(sizeof(DimensionDescription));
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedDataDescription::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
 }
 
 
@@ -722,7 +938,7 @@ SedDataDescription::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -998,6 +1214,8 @@ SedListOfDataDescriptions::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedDataDescription*>(item);
@@ -1035,15 +1253,12 @@ SedListOfDataDescriptions::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedDataDescription in this SedListOfDataDescriptions
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfDataDescriptions::createObject(XMLInputStream& stream)
+SedListOfDataDescriptions::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "dataDescription")
@@ -1056,6 +1271,18 @@ SedListOfDataDescriptions::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedDataDescription in this SedListOfDataDescriptions
+ */
+SedBase*
+SedListOfDataDescriptions::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -211,7 +211,9 @@ SedDataGenerator::isSetMath() const
 int
 SedDataGenerator::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -221,6 +223,8 @@ SedDataGenerator::setId(const std::string& id)
 int
 SedDataGenerator::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -234,6 +238,8 @@ SedDataGenerator::setName(const std::string& name)
 int
 SedDataGenerator::setMath(ASTNode* math)
 {
+  markDirty();
+
   if (mMath == math)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -269,6 +275,8 @@ SedDataGenerator::setMath(ASTNode* math)
 int
 SedDataGenerator::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -288,6 +296,8 @@ SedDataGenerator::unsetId()
 int
 SedDataGenerator::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -307,6 +317,8 @@ SedDataGenerator::unsetName()
 int
 SedDataGenerator::unsetMath()
 {
+  markDirty();
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -642,6 +654,116 @@ SedDataGenerator::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedDataGenerator to the vector.
+ */
+void
+SedDataGenerator::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedDataGenerator::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedDataGenerator::getAttribute(const std::string& attributeName,
+                               std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedDataGenerator::setAttribute(const std::string& attributeName,
+                               const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedDataGenerator::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedDataGenerator::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedBase::getChildObjects(children);
+
+  children.push_back(&mVariables);
+  children.push_back(&mParameters);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -680,8 +802,49 @@ SedDataGenerator::writeElements(XMLOutputStream& stream) const
 bool
 SedDataGenerator::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedDataGenerator::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
 
+  footprint.addString(mId);
+  footprint.addString(mName);
+  footprint.addMath(mMath);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedDataGenerator::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
 }
 
 
@@ -739,7 +902,7 @@ SedDataGenerator::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -979,6 +1142,8 @@ SedListOfDataGenerators::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedDataGenerator*>(item);
@@ -1016,15 +1181,12 @@ SedListOfDataGenerators::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedDataGenerator in this SedListOfDataGenerators
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfDataGenerators::createObject(XMLInputStream& stream)
+SedListOfDataGenerators::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "dataGenerator")
@@ -1037,6 +1199,18 @@ SedListOfDataGenerators::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedDataGenerator in this SedListOfDataGenerators
+ */
+SedBase*
+SedListOfDataGenerators::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -213,7 +213,9 @@ SedDataSet::isSetDataReference() const
 int
 SedDataSet::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -223,6 +225,8 @@ SedDataSet::setId(const std::string& id)
 int
 SedDataSet::setLabel(const std::string& label)
 {
+  markDirty();
+
   {
     mLabel = label;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -236,6 +240,8 @@ SedDataSet::setLabel(const std::string& label)
 int
 SedDataSet::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -249,13 +255,15 @@ SedDataSet::setName(const std::string& name)
 int
 SedDataSet::setDataReference(const std::string& dataReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(dataReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mDataReference = dataReference;
+      mDataReference = internString(dataReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -267,6 +275,8 @@ SedDataSet::setDataReference(const std::string& dataReference)
 int
 SedDataSet::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -286,6 +296,8 @@ SedDataSet::unsetId()
 int
 SedDataSet::unsetLabel()
 {
+  markDirty();
+
   mLabel.erase();
 
   if (mLabel.empty() == true)
@@ -305,6 +317,8 @@ SedDataSet::unsetLabel()
 int
 SedDataSet::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -324,6 +338,8 @@ SedDataSet::unsetName()
 int
 SedDataSet::unsetDataReference()
 {
+  markDirty();
+
   mDataReference.erase();
 
   if (mDataReference.empty() == true)
@@ -379,6 +395,143 @@ SedDataSet::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedDataSet to the vector.
+ */
+void
+SedDataSet::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("label");
+  names.push_back("name");
+  names.push_back("dataReference");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedDataSet::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "label")
+    {
+      return isSetLabel();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+  else if (attributeName == "dataReference")
+    {
+      return isSetDataReference();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedDataSet::getAttribute(const std::string& attributeName,
+                         std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "label")
+    {
+      if (isSetLabel() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mLabel;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "dataReference")
+    {
+      if (isSetDataReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mDataReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedDataSet::setAttribute(const std::string& attributeName,
+                         const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "label")
+    {
+      return setLabel(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+  else if (attributeName == "dataReference")
+    {
+      return setDataReference(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedDataSet::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "label")
+    {
+      return unsetLabel();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+  else if (attributeName == "dataReference")
+    {
+      return unsetDataReference();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -402,8 +555,51 @@ SedDataSet::writeElements(XMLOutputStream& stream) const
 bool
 SedDataSet::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
 
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedDataSet::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mLabel);
+  footprint.addString(mName);
+  footprint.addString(mDataReference);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedDataSet::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
+  reinternString(mDataReference);
 }
 
 
@@ -461,7 +657,7 @@ SedDataSet::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -510,7 +706,7 @@ SedDataSet::readAttributes(const XMLAttributes& attributes,
   //
   // dataReference SIdRef   ( use = "required" )
   //
-  assigned = attributes.readInto("dataReference", mDataReference, getErrorLog(), true);
+  assigned = readInto(attributes, "dataReference", mDataReference, true);
 
   if (assigned == true)
     {
@@ -711,6 +907,8 @@ SedListOfDataSets::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedDataSet*>(item);
@@ -748,15 +946,12 @@ SedListOfDataSets::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedDataSet in this SedListOfDataSets
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfDataSets::createObject(XMLInputStream& stream)
+SedListOfDataSets::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "dataSet")
@@ -769,6 +964,18 @@ SedListOfDataSets::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedDataSet in this SedListOfDataSets
+ */
+SedBase*
+SedListOfDataSets::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -205,7 +205,9 @@ SedDataSource::isSetIndexSet() const
 int
 SedDataSource::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -215,6 +217,8 @@ SedDataSource::setId(const std::string& id)
 int
 SedDataSource::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -228,6 +232,8 @@ SedDataSource::setName(const std::string& name)
 int
 SedDataSource::setIndexSet(const std::string& indexSet)
 {
+  markDirty();
+
   {
     mIndexSet = indexSet;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -241,6 +247,8 @@ SedDataSource::setIndexSet(const std::string& indexSet)
 int
 SedDataSource::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -260,6 +268,8 @@ SedDataSource::unsetId()
 int
 SedDataSource::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -279,6 +289,8 @@ SedDataSource::unsetName()
 int
 SedDataSource::unsetIndexSet()
 {
+  markDirty();
+
   mIndexSet.erase();
 
   if (mIndexSet.empty() == true)
@@ -494,6 +506,135 @@ SedDataSource::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedDataSource to the vector.
+ */
+void
+SedDataSource::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+  names.push_back("indexSet");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedDataSource::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+  else if (attributeName == "indexSet")
+    {
+      return isSetIndexSet();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedDataSource::getAttribute(const std::string& attributeName,
+                            std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "indexSet")
+    {
+      if (isSetIndexSet() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mIndexSet;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedDataSource::setAttribute(const std::string& attributeName,
+                            const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+  else if (attributeName == "indexSet")
+    {
+      return setIndexSet(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedDataSource::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+  else if (attributeName == "indexSet")
+    {
+      return unsetIndexSet();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedDataSource::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedBase::getChildObjects(children);
+
+  children.push_back(&mSlices);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -522,8 +663,49 @@ SedDataSource::writeElements(XMLOutputStream& stream) const
 bool
 SedDataSource::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
 
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedDataSource::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mName);
+  footprint.addString(mIndexSet);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedDataSource::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
 }
 
 
@@ -581,7 +763,7 @@ SedDataSource::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "optional" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), false);
+  assigned = readInto(attributes, "id", mId, false);
 
   if (assigned == true)
     {
@@ -809,6 +991,8 @@ SedListOfDataSources::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedDataSource*>(item);
@@ -846,15 +1030,12 @@ SedListOfDataSources::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedDataSource in this SedListOfDataSources
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfDataSources::createObject(XMLInputStream& stream)
+SedListOfDataSources::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "dataSource")
@@ -867,6 +1048,18 @@ SedListOfDataSources::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedDataSource in this SedListOfDataSources
+ */
+SedBase*
+SedListOfDataSources::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -0,0 +1,406 @@
+/**
+ * @file   SedDependencyGraph.cpp
+ * @brief  References between the elements of a SedDocument
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedTypes.h>
+
+#include <algorithm>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Orders the units of partition() by decreasing size; units of the same
+ * size keep the order of the document.
+ */
+struct SedUnitIsLarger
+{
+  SedUnitIsLarger(const std::vector<size_t>& sizes) : sizes(sizes) { }
+
+  bool operator()(size_t lhs, size_t rhs) const
+  {
+    return sizes[lhs] > sizes[rhs];
+  }
+
+  const std::vector<size_t>& sizes;
+};
+
+/** @endcond */
+
+
+SedDependencyGraph::SedDependencyGraph(const SedDocument* document)
+  : mDocument(document)
+  , mDataDescriptions()
+  , mSimulations()
+  , mModels()
+  , mTasks()
+  , mDataGenerators()
+  , mOutputs()
+{
+  if (document == NULL) return;
+
+  index(mDataDescriptions, document->getListOfDataDescriptions());
+  index(mSimulations, document->getListOfSimulations());
+  index(mModels, document->getListOfModels());
+  index(mTasks, document->getListOfTasks());
+  index(mDataGenerators, document->getListOfDataGenerators());
+  index(mOutputs, document->getListOfOutputs());
+}
+
+
+const SedDocument*
+SedDependencyGraph::getDocument() const
+{
+  return mDocument;
+}
+
+
+const SedBase*
+SedDependencyGraph::getElementById(const std::string& id) const
+{
+  const IdMap* maps[] = { &mModels, &mSimulations, &mTasks,
+                          &mDataGenerators, &mOutputs, &mDataDescriptions
+                        };
+
+  for (size_t i = 0; i < sizeof(maps) / sizeof(maps[0]); ++i)
+    {
+      const SedBase* object = lookup(*maps[i], id);
+      if (object != NULL) return object;
+    }
+
+  return NULL;
+}
+
+
+void
+SedDependencyGraph::getClosure(const SedBase* object,
+                               std::vector<const SedBase*>& objects) const
+{
+  std::set<const SedBase*> seen(objects.begin(), objects.end());
+  addToClosure(object, objects, seen);
+}
+
+
+SedDocument*
+SedDependencyGraph::extract(const std::vector<const SedBase*>& roots) const
+{
+  if (mDocument == NULL) return NULL;
+
+  std::vector<const SedBase*> closure;
+  std::set<const SedBase*> keep;
+
+  for (size_t i = 0; i < roots.size(); ++i)
+    addToClosure(roots[i], closure, keep);
+
+  SedDocument* result = new SedDocument(mDocument->getSedNamespaces());
+
+  if (mDocument->getNamespaces() != NULL)
+    result->setNamespaces(mDocument->getNamespaces());
+
+  if (mDocument->isSetMetaId())
+    result->setMetaId(mDocument->getMetaId());
+
+  if (mDocument->isSetNotes())
+    result->setNotes(mDocument->getNotes());
+
+  if (mDocument->isSetAnnotation())
+    result->setAnnotation(mDocument->getAnnotation());
+
+  // both documents list their top level lists in the same order
+  std::vector<const SedBase*> from, to;
+  mDocument->getChildObjects(from);
+  result->getChildObjects(to);
+
+  for (size_t i = 0; i < from.size() && i < to.size(); ++i)
+    {
+      const SedListOf* source = static_cast<const SedListOf*>(from[i]);
+      SedListOf* target = const_cast<SedListOf*>(static_cast<const SedListOf*>(to[i]));
+
+      for (unsigned int n = 0; n < source->size(); ++n)
+        {
+          if (keep.find(source->get(n)) != keep.end())
+            target->append(source->get(n));
+        }
+    }
+
+  return result;
+}
+
+
+SedDocument*
+SedDependencyGraph::extract(const std::vector<std::string>& ids) const
+{
+  std::vector<const SedBase*> roots;
+
+  for (size_t i = 0; i < ids.size(); ++i)
+    {
+      const SedBase* object = getElementById(ids[i]);
+      if (object == NULL) return NULL;
+
+      roots.push_back(object);
+    }
+
+  return extract(roots);
+}
+
+
+void
+SedDependencyGraph::partition(unsigned int numShards,
+                              std::vector<SedDocument*>& shards) const
+{
+  if (mDocument == NULL || numShards == 0) return;
+
+  // the units of work: all outputs, then whatever no output refers to
+  std::vector<const SedBase*> units;
+  std::vector<size_t> sizes;
+  std::set<const SedBase*> covered;
+
+  const SedListOf* lists[] = { mDocument->getListOfOutputs(),
+                               mDocument->getListOfDataGenerators(),
+                               mDocument->getListOfTasks()
+                             };
+
+  for (size_t l = 0; l < sizeof(lists) / sizeof(lists[0]); ++l)
+    {
+      for (unsigned int n = 0; n < lists[l]->size(); ++n)
+        {
+          const SedBase* unit = lists[l]->get(n);
+          if (covered.find(unit) != covered.end()) continue;
+
+          std::vector<const SedBase*> closure;
+          std::set<const SedBase*> seen;
+          addToClosure(unit, closure, seen);
+
+          covered.insert(closure.begin(), closure.end());
+          units.push_back(unit);
+          sizes.push_back(closure.size());
+        }
+    }
+
+  std::vector<size_t> order(units.size());
+
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+
+  std::stable_sort(order.begin(), order.end(), SedUnitIsLarger(sizes));
+
+  std::vector<size_t> loads(numShards, 0);
+  std::vector<size_t> shardOf(units.size(), 0);
+
+  for (size_t i = 0; i < order.size(); ++i)
+    {
+      size_t smallest = 0;
+
+      for (size_t s = 1; s < numShards; ++s)
+        {
+          if (loads[s] < loads[smallest]) smallest = s;
+        }
+
+      shardOf[order[i]] = smallest;
+      loads[smallest] += sizes[order[i]];
+    }
+
+  for (unsigned int s = 0; s < numShards; ++s)
+    {
+      // the units of a shard keep their order in the document
+      std::vector<const SedBase*> roots;
+
+      for (size_t i = 0; i < units.size(); ++i)
+        {
+          if (shardOf[i] == s) roots.push_back(units[i]);
+        }
+
+      shards.push_back(extract(roots));
+    }
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+void
+SedDependencyGraph::index(IdMap& ids, const SedBase* list)
+{
+  const SedListOf* items = static_cast<const SedListOf*>(list);
+
+  for (unsigned int n = 0; n < items->size(); ++n)
+    {
+      std::string id;
+
+      // the first element with an id wins, as in SedListOf::get()
+      if (items->get(n)->getAttribute("id", id) == LIBSEDML_OPERATION_SUCCESS)
+        ids.insert(std::make_pair(id, items->get(n)));
+    }
+}
+
+
+const SedBase*
+SedDependencyGraph::lookup(const IdMap& ids, const std::string& id) const
+{
+  IdMap::const_iterator it = ids.find(id);
+  return it != ids.end() ? it->second : NULL;
+}
+
+
+/*
+ * Adds the object to the closure and follows the references made by it and
+ * by the objects it contains.
+ */
+void
+SedDependencyGraph::addToClosure(const SedBase* object,
+                                 std::vector<const SedBase*>& objects,
+                                 std::set<const SedBase*>& seen) const
+{
+  if (object == NULL || !seen.insert(object).second) return;
+
+  objects.push_back(object);
+
+  static const char* const dataReferences[] =
+  {
+    "dataReference", "xDataReference", "yDataReference", "zDataReference"
+  };
+
+  std::vector<const SedBase*> pending(1, object);
+
+  while (!pending.empty())
+    {
+      const SedBase* current = pending.back();
+      pending.pop_back();
+
+      std::string value;
+
+      if (current->getAttribute("modelReference", value) == LIBSEDML_OPERATION_SUCCESS)
+        addToClosure(lookup(mModels, value), objects, seen);
+
+      if (current->getAttribute("simulationReference", value) == LIBSEDML_OPERATION_SUCCESS)
+        addToClosure(lookup(mSimulations, value), objects, seen);
+
+      if (current->getAttribute("taskReference", value) == LIBSEDML_OPERATION_SUCCESS)
+        addToClosure(lookup(mTasks, value), objects, seen);
+
+      if (current->getTypeCode() == SEDML_TASK_SUBTASK
+          && current->getAttribute("task", value) == LIBSEDML_OPERATION_SUCCESS)
+        addToClosure(lookup(mTasks, value), objects, seen);
+
+      // a model may be derived from another model of the same document,
+      // or read from one of its data descriptions
+      if (current->getTypeCode() == SEDML_MODEL
+          && current->getAttribute("source", value) == LIBSEDML_OPERATION_SUCCESS
+          && !value.empty() && value[0] == '#')
+        {
+          const SedBase* source = lookup(mModels, value.substr(1));
+
+          if (source == NULL)
+            source = lookup(mDataDescriptions, value.substr(1));
+
+          addToClosure(source, objects, seen);
+        }
+
+      for (size_t i = 0; i < sizeof(dataReferences) / sizeof(dataReferences[0]); ++i)
+        {
+          if (current->getAttribute(dataReferences[i], value) == LIBSEDML_OPERATION_SUCCESS)
+            addToClosure(lookup(mDataGenerators, value), objects, seen);
+        }
+
+      std::vector<const SedBase*> children;
+      current->getChildObjects(children);
+      pending.insert(pending.end(), children.rbegin(), children.rend());
+    }
+}
+
+/** @endcond */
+
+
+/**
+ * Creates a new SedDocument_t structure with copies of the elements with
+ * the given ids and everything they depend on.  Returns NULL if an id is
+ * unknown.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedDependencyGraph_extract(const SedDocument_t * sd,
+                           const char ** ids,
+                           unsigned int numIds)
+{
+  if (sd == NULL || (ids == NULL && numIds > 0)) return NULL;
+
+  std::vector<std::string> list;
+
+  for (unsigned int i = 0; i < numIds; ++i)
+    {
+      if (ids[i] == NULL) return NULL;
+
+      list.push_back(ids[i]);
+    }
+
+  SedDependencyGraph graph(sd);
+  return graph.extract(list);
+}
+
+
+/**
+ * Splits the given SedDocument_t structure into numShards self-contained
+ * documents, which are stored in the array shards.  The caller owns the
+ * new documents.
+ */
+LIBSEDML_EXTERN
+int
+SedDependencyGraph_partition(const SedDocument_t * sd,
+                             unsigned int numShards,
+                             SedDocument_t ** shards)
+{
+  if (sd == NULL || shards == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  SedDependencyGraph graph(sd);
+  std::vector<SedDocument*> result;
+  graph.partition(numShards, result);
+
+  for (size_t i = 0; i < result.size(); ++i)
+    shards[i] = result[i];
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
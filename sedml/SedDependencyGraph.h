@@ -0,0 +1,222 @@
+/**
+ * @file   SedDependencyGraph.h
+ * @brief  References between the elements of a SedDocument
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedDependencyGraph
+ * @ingroup Core
+ * @brief Follows the references between the elements of a SedDocument.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * An output depends on the data generators it plots or reports, a data
+ * generator on the tasks and models its variables refer to, a task on its
+ * model and simulation, a repeated task on its sub-tasks and the models
+ * its set values change, and a model on the model or data description
+ * named by a <code>source="#id"</code>.  getClosure() collects everything
+ * an element depends on.
+ *
+ * extract() builds the smallest document that can still run a given set of
+ * outputs or tasks: a copy of their closure and nothing else.  partition()
+ * spreads all outputs of a document over a number of such documents, with
+ * about the same number of elements in each, so that they can be run on
+ * separate machines.
+ *
+ * The ids of the document are indexed when the SedDependencyGraph is
+ * created; the document must not be changed while it is in use.
+ */
+
+#ifndef SedDependencyGraph_h
+#define SedDependencyGraph_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedDependencyGraph
+{
+public:
+
+  /**
+   * Creates a new SedDependencyGraph for the given document.
+   *
+   * @param document the document; it is not copied and has to outlive this
+   * object.
+   */
+  SedDependencyGraph(const SedDocument* document);
+
+
+  /**
+   * @return the document of this SedDependencyGraph.
+   */
+  const SedDocument* getDocument() const;
+
+
+  /**
+   * Returns the top level element (model, simulation, task, data
+   * generator, output or data description) with the given id.
+   *
+   * @param id the id of the element.
+   *
+   * @return the element, or @c NULL if there is none.
+   */
+  const SedBase* getElementById(const std::string& id) const;
+
+
+  /**
+   * Adds the given element and every top level element it depends on,
+   * directly or indirectly, to @p objects.  The order is deterministic and
+   * the element itself comes first; elements already in @p objects are
+   * not added again.
+   *
+   * @param object the element, which has to be part of the document.
+   * @param objects the vector to which the elements are appended.
+   */
+  void getClosure(const SedBase* object,
+                  std::vector<const SedBase*>& objects) const;
+
+
+  /**
+   * Creates a new document with copies of the given elements and
+   * everything they depend on.  The elements keep their ids and their
+   * order in the document; the namespaces, notes and annotation of the
+   * document are copied as well.
+   *
+   * @param roots the top level elements that have to be kept.
+   *
+   * @return the new document, owned by the caller.
+   */
+  SedDocument* extract(const std::vector<const SedBase*>& roots) const;
+
+
+  /**
+   * Creates a new document with copies of the outputs, tasks or data
+   * generators with the given ids and everything they depend on.
+   *
+   * @param ids the ids of the elements that have to be kept.
+   *
+   * @return the new document, owned by the caller, or @c NULL if one of
+   * the ids does not name an element of the document.
+   */
+  SedDocument* extract(const std::vector<std::string>& ids) const;
+
+
+  /**
+   * Splits the document into @p numShards self-contained documents.
+   *
+   * Every output is put into exactly one shard, together with everything
+   * it depends on; tasks and data generators no output refers to are
+   * treated like outputs.  Shards are filled largest first, each time
+   * into the shard with the fewest elements so far.  Elements that
+   * several outputs depend on are copied into every shard that needs
+   * them.
+   *
+   * @param numShards the number of shards.
+   * @param shards the vector to which the new documents are appended.
+   * Exactly @p numShards documents are added; some may be empty if the
+   * document has fewer outputs.  The caller owns the documents.
+   */
+  void partition(unsigned int numShards,
+                 std::vector<SedDocument*>& shards) const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  typedef std::map<std::string, const SedBase*> IdMap;
+
+  void index(IdMap& ids, const SedBase* list);
+
+  void addToClosure(const SedBase* object,
+                    std::vector<const SedBase*>& objects,
+                    std::set<const SedBase*>& seen) const;
+
+  const SedBase* lookup(const IdMap& ids, const std::string& id) const;
+
+  const SedDocument* mDocument;
+
+  IdMap mDataDescriptions;
+  IdMap mSimulations;
+  IdMap mModels;
+  IdMap mTasks;
+  IdMap mDataGenerators;
+  IdMap mOutputs;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+LIBSEDML_EXTERN
+SedDocument_t *
+SedDependencyGraph_extract(const SedDocument_t * sd,
+                           const char ** ids,
+                           unsigned int numIds);
+
+LIBSEDML_EXTERN
+int
+SedDependencyGraph_partition(const SedDocument_t * sd,
+                             unsigned int numShards,
+                             SedDocument_t ** shards);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+#endif  /* SedDependencyGraph_h */
@@ -54,6 +54,11 @@ SedDocument::SedDocument(unsigned int level, unsigned int version)
   , mIsSetLevel(false)
   , mVersion(SEDML_INT_MAX)
   , mIsSetVersion(false)
+  , mFragmentGeneration(0)
+  , mStringPool()
+  , mTrace(NULL)
+  , mLazyNotesAndAnnotations(false)
+  , mElementFilter(NULL)
   , mDataDescriptions(level, version)
   , mSimulations(level, version)
   , mModels(level, version)
@@ -86,6 +91,11 @@ SedDocument::SedDocument(SedNamespaces* sedns)
   , mIsSetLevel(false)
   , mVersion(SEDML_INT_MAX)
   , mIsSetVersion(false)
+  , mFragmentGeneration(0)
+  , mStringPool()
+  , mTrace(NULL)
+  , mLazyNotesAndAnnotations(false)
+  , mElementFilter(NULL)
   , mDataDescriptions(sedns)
   , mSimulations(sedns)
   , mModels(sedns)
@@ -114,6 +124,11 @@ SedDocument::SedDocument(SedNamespaces* sedns)
  */
 SedDocument::SedDocument(const SedDocument& orig)
   : SedBase(orig)
+  , mFragmentGeneration(0)
+  , mStringPool()
+  , mTrace(NULL)
+  , mLazyNotesAndAnnotations(false)
+  , mElementFilter(NULL)
 {
   setSedDocument(this);
 
@@ -128,7 +143,7 @@ SedDocument::SedDocument(const SedDocument& orig)
   mDataGenerators  = orig.mDataGenerators;
   mOutputs  = orig.mOutputs;
 
-  // connect to child objects
+  // connect to child objects, which interns their strings in mStringPool
   connectToChild();
 }
 
@@ -144,6 +159,7 @@ SedDocument::operator=(const SedDocument& rhs)
       SedBase::operator=(rhs);
 
       setSedDocument(this);
+      ++mFragmentGeneration;
 
       mLevel  = rhs.mLevel;
       mIsSetLevel  = rhs.mIsSetLevel;
@@ -156,7 +172,7 @@ SedDocument::operator=(const SedDocument& rhs)
       mDataGenerators  = rhs.mDataGenerators;
       mOutputs  = rhs.mOutputs;
 
-      // connect to child objects
+      // connect to child objects, which interns their strings in mStringPool
       connectToChild();
     }
 
@@ -228,6 +244,8 @@ SedDocument::isSetVersion() const
 int
 SedDocument::setLevel(int level)
 {
+  invalidateXMLFragments();
+
   mLevel = level;
   mIsSetLevel = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -240,6 +258,8 @@ SedDocument::setLevel(int level)
 int
 SedDocument::setVersion(int version)
 {
+  invalidateXMLFragments();
+
   mVersion = version;
   mIsSetVersion = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -252,6 +272,8 @@ SedDocument::setVersion(int version)
 int
 SedDocument::unsetLevel()
 {
+  invalidateXMLFragments();
+
   mLevel = SEDML_INT_MAX;
   mIsSetLevel = false;
 
@@ -272,6 +294,8 @@ SedDocument::unsetLevel()
 int
 SedDocument::unsetVersion()
 {
+  invalidateXMLFragments();
+
   mVersion = SEDML_INT_MAX;
   mIsSetVersion = false;
 
@@ -1216,6 +1240,130 @@ SedDocument::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedDocument to the vector.
+ */
+void
+SedDocument::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("level");
+  names.push_back("version");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedDocument::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "level")
+    {
+      return isSetLevel();
+    }
+  else if (attributeName == "version")
+    {
+      return isSetVersion();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedDocument::getAttribute(const std::string& attributeName,
+                          std::string& value) const
+{
+  if (attributeName == "level")
+    {
+      if (isSetLevel() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mLevel);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "version")
+    {
+      if (isSetVersion() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mVersion);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedDocument::setAttribute(const std::string& attributeName,
+                          const std::string& value)
+{
+  if (attributeName == "level")
+    {
+      int parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setLevel(parsed);
+    }
+  else if (attributeName == "version")
+    {
+      int parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setVersion(parsed);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedDocument::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "level")
+    {
+      return unsetLevel();
+    }
+  else if (attributeName == "version")
+    {
+      return unsetVersion();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedDocument::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedBase::getChildObjects(children);
+
+  children.push_back(&mDataDescriptions);
+  children.push_back(&mSimulations);
+  children.push_back(&mModels);
+  children.push_back(&mTasks);
+  children.push_back(&mDataGenerators);
+  children.push_back(&mOutputs);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -1269,8 +1417,36 @@ SedDocument::writeElements(XMLOutputStream& stream) const
 bool
 SedDocument::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+
+  acceptChildren(v);
+
+  v.leave(*this);
 
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedDocument::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  // the errors of the log, with their messages
+  for (unsigned int n = 0; n < mErrorLog.getNumErrors(); ++n)
+    {
+      const SedError* error = mErrorLog.getError(n);
+      footprint.addOther(sizeof(SedError) + sizeof(void*)
+                         + SedMemoryFootprint::getHeapBytes(error->getMessage()));
+    }
 }
 
 
@@ -1496,6 +1672,94 @@ SedDocument::getNamespaces() const
 {
   return mSedNamespaces->getNamespaces();
 }
+
+
+/*
+ * Discards all XML fragments cached on objects of this document.
+ */
+void
+SedDocument::invalidateXMLFragments()
+{
+  ++mFragmentGeneration;
+  markDirty();
+}
+
+
+/*
+ * Creates an immutable copy of this document for concurrent readers.
+ */
+SedFrozenDocument*
+SedDocument::freeze() const
+{
+  return new SedFrozenDocument(this);
+}
+
+
+SedStringPool&
+SedDocument::getStringPool()
+{
+  return mStringPool;
+}
+
+
+const SedStringPool&
+SedDocument::getStringPool() const
+{
+  return mStringPool;
+}
+
+
+void
+SedDocument::setTrace(SedTrace* trace)
+{
+  mTrace = trace;
+}
+
+
+SedTrace*
+SedDocument::getTrace() const
+{
+  return mTrace;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+unsigned int
+SedDocument::getFragmentGeneration() const
+{
+  return mFragmentGeneration;
+}
+
+
+void
+SedDocument::setLazyNotesAndAnnotations(bool lazy)
+{
+  mLazyNotesAndAnnotations = lazy;
+}
+
+
+bool
+SedDocument::getLazyNotesAndAnnotations() const
+{
+  return mLazyNotesAndAnnotations;
+}
+
+
+void
+SedDocument::setElementFilter(SedElementFilter* filter)
+{
+  mElementFilter = filter;
+}
+
+
+SedElementFilter*
+SedDocument::getElementFilter() const
+{
+  return mElementFilter;
+}
+
+/** @endcond doxygen-libsedml-internal */
 /**
  * write comments
  */
@@ -57,12 +57,16 @@
 #include <sedml/SedTask.h>
 #include <sedml/SedDataGenerator.h>
 #include <sedml/SedOutput.h>
+#include <sedml/SedTrace.h>
+#include <sedml/SedElementFilter.h>
 
 
 
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
+class SedFrozenDocument;
+
 
 class LIBSEDML_EXTERN SedDocument : public SedBase
 {
@@ -73,6 +77,11 @@ protected:
   bool          mIsSetLevel;
   int           mVersion;
   bool          mIsSetVersion;
+  unsigned int  mFragmentGeneration;
+  SedStringPool mStringPool;
+  SedTrace*     mTrace;
+  bool          mLazyNotesAndAnnotations;
+  SedElementFilter* mElementFilter;
   SedListOfDataDescriptions   mDataDescriptions;
   SedListOfSimulations   mSimulations;
   SedListOfModels   mModels;
@@ -1136,6 +1145,81 @@ public:
   virtual bool hasRequiredElements() const;
 
 
+  /**
+   * Adds the names of the attributes of this SedDocument object to @p names, in
+   * the order in which they are written.
+   *
+   * @param names the vector to which the attribute names are appended.
+   */
+  virtual void getAttributeNames(std::vector<std::string>& names) const;
+
+
+  /**
+   * Predicate returning @c true if the attribute with the given name is set
+   * on this SedDocument object.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   *
+   * @return @c true if the attribute is set, @c false otherwise.
+   */
+  virtual bool isSetAttribute(const std::string& attributeName) const;
+
+
+  /**
+   * Returns the value of the attribute with the given name as a string,
+   * formatted the way it is written in SED-ML.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   * @param value the string that receives the value of the attribute.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int getAttribute(const std::string& attributeName,
+                           std::string& value) const;
+
+
+  /**
+   * Sets the attribute with the given name on this SedDocument object from its
+   * string form, as it would be read from SED-ML.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   * @param value the value of the attribute.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int setAttribute(const std::string& attributeName,
+                           const std::string& value);
+
+
+  /**
+   * Unsets the attribute with the given name on this SedDocument object.
+   *
+   * @param attributeName the name of the attribute, as used in SED-ML.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int unsetAttribute(const std::string& attributeName);
+
+
+  /**
+   * Adds the SEDML objects directly contained in this SedDocument object to
+   * @p children, in the order in which they are written.
+   *
+   * @param children the vector to which the child objects are appended.
+   */
+  virtual void getChildObjects(std::vector<const SedBase*>& children) const;
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -1160,6 +1244,17 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Charges the memory this object owns to the footprint.
+   */
+  virtual void addMemoryFootprint(SedMemoryFootprint& footprint) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -1303,6 +1398,114 @@ public:
    */
   virtual XMLNamespaces* getNamespaces() const;
 
+
+  /**
+   * Discards the XML fragments cached on all objects of this document by
+   * a SedWriter with fragment caching enabled, so that the next write
+   * serializes the whole document again.
+   *
+   * This happens automatically whenever the level, version or namespaces
+   * of the document change.
+   *
+   * @see SedWriter::setCacheFragments(bool cache)
+   */
+  void invalidateXMLFragments();
+
+
+  /**
+   * Creates an immutable, compact copy of this document that any number of
+   * threads can read at the same time without locks.
+   *
+   * @return the frozen copy, owned by the caller.
+   *
+   * @see SedFrozenDocument
+   */
+  SedFrozenDocument* freeze() const;
+
+
+  /**
+   * Returns the pool in which the ids, references, KiSAO ids, targets and
+   * symbols of the objects of this document are interned.
+   *
+   * @return the SedStringPool of this document.
+   */
+  SedStringPool& getStringPool();
+
+
+  /**
+   * Returns the pool in which the ids, references, KiSAO ids, targets and
+   * symbols of the objects of this document are interned.
+   *
+   * @return the SedStringPool of this document.
+   */
+  const SedStringPool& getStringPool() const;
+
+
+  /**
+   * Sets the trace into which reading and writing the objects of this
+   * document record their timers and counters.
+   *
+   * SedReader and SedWriter set their own trace for the duration of a
+   * read or write; a trace set here is used by any other reading or
+   * writing, e.g. by SedBase::toSed().  The trace is not owned by the
+   * document and is not copied with it.
+   *
+   * @param trace the SedTrace, or @c NULL to stop tracing.
+   *
+   * @see SedTrace
+   */
+  void setTrace(SedTrace* trace);
+
+
+  /**
+   * Returns the trace into which reading and writing the objects of this
+   * document record their timers and counters.
+   *
+   * @return the SedTrace, or @c NULL if this document is not traced.
+   */
+  SedTrace* getTrace() const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * @return the generation of the XML fragments cached on objects of this
+   * document; a cached fragment is only valid for the generation it was
+   * created in.
+   */
+  unsigned int getFragmentGeneration() const;
+
+
+  /**
+   * Sets whether the objects of this document keep the notes and
+   * annotations they read as text, to be parsed when first used.  Set by
+   * SedReader for the duration of a read.
+   */
+  void setLazyNotesAndAnnotations(bool lazy);
+
+
+  /**
+   * @return true if the objects of this document keep the notes and
+   * annotations they read as text.
+   */
+  bool getLazyNotesAndAnnotations() const;
+
+
+  /**
+   * Sets the filter deciding which elements the objects of this document
+   * skip while reading.  Set by SedReader for the duration of a read.
+   */
+  void setElementFilter(SedElementFilter* filter);
+
+
+  /**
+   * @return the filter deciding which elements are skipped while reading,
+   * or @c NULL if everything is read.
+   */
+  SedElementFilter* getElementFilter() const;
+
+  /** @endcond doxygen-libsedml-internal */
+
 protected:
   /**
    *
@@ -0,0 +1,414 @@
+/**
+ * @file   SedDocumentMerger.cpp
+ * @brief  Merges Sed documents
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedDocumentMerger.h>
+#include <sedml/SedTypes.h>
+
+#include <sstream>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The attributes that refer to the id of another element.
+ */
+static const char* const REFERENCE_ATTRIBUTES[] =
+{
+  "id", "modelReference", "simulationReference", "taskReference",
+  "dataReference", "xDataReference", "yDataReference", "zDataReference",
+  "range", "task"
+};
+
+static const unsigned int NUM_REFERENCE_ATTRIBUTES = 10;
+
+/* the same types as SedDocumentMerger::IdSet and RenameMap */
+typedef LIBSEDML_UNORDERED_NAMESPACE::unordered_set<std::string> NameSet;
+typedef LIBSEDML_UNORDERED_NAMESPACE::unordered_map<std::string, std::string> NameMap;
+
+
+static const ASTNode*
+getMathOf(const SedBase* object)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_CHANGE_COMPUTECHANGE:
+      return static_cast<const SedComputeChange*>(object)->getMath();
+
+    case SEDML_DATAGENERATOR:
+      return static_cast<const SedDataGenerator*>(object)->getMath();
+
+    case SEDML_TASK_SETVALUE:
+      return static_cast<const SedSetValue*>(object)->getMath();
+
+    case SEDML_RANGE_FUNCTIONALRANGE:
+      return static_cast<const SedFunctionalRange*>(object)->getMath();
+
+    default:
+      return NULL;
+    }
+}
+
+
+/*
+ * Returns whether the id of the object is only visible in the math of its
+ * parent: the variables and parameters.
+ */
+static bool
+isLocal(const SedBase* object)
+{
+  return object->getTypeCode() == SEDML_VARIABLE
+         || object->getTypeCode() == SEDML_PARAMETER;
+}
+
+
+/*
+ * Adds the ids of the variables and parameters of object to locals.
+ */
+static void
+collectLocalIds(const SedBase* object, NameSet& locals)
+{
+  std::vector<const SedBase*> children;
+  object->getChildObjects(children);
+  std::string id;
+
+  for (size_t i = 0; i < children.size(); ++i)
+    {
+      if (isLocal(children[i]))
+        {
+          if (children[i]->getAttribute("id", id) == LIBSEDML_OPERATION_SUCCESS)
+            locals.insert(id);
+        }
+      else if (children[i]->getTypeCode() == SEDML_LIST_OF)
+        {
+          // the variables and parameters are held in lists
+          collectLocalIds(children[i], locals);
+        }
+    }
+}
+
+
+/*
+ * Renames the names in the math that are not in locals; returns true if
+ * one was changed.
+ */
+static bool
+renameNames(ASTNode* node, const NameMap& renamed, const NameSet& locals)
+{
+  bool changed = false;
+  std::vector<ASTNode*> pending(1, node);
+
+  while (!pending.empty())
+    {
+      ASTNode* current = pending.back();
+      pending.pop_back();
+
+      if (current->getType() == AST_NAME && current->getName() != NULL
+          && locals.find(current->getName()) == locals.end())
+        {
+          NameMap::const_iterator it = renamed.find(current->getName());
+
+          if (it != renamed.end())
+            {
+              current->setName(it->second.c_str());
+              changed = true;
+            }
+        }
+
+      for (unsigned int i = 0; i < current->getNumChildren(); ++i)
+        pending.push_back(current->getChild(i));
+    }
+
+  return changed;
+}
+
+/** @endcond */
+
+
+SedDocumentMerger::SedDocumentMerger(SedDocument* target)
+  : mTarget(target)
+  , mIds()
+  , mIsSetIds(false)
+{
+}
+
+
+SedDocument*
+SedDocumentMerger::getTarget() const
+{
+  return mTarget;
+}
+
+
+int
+SedDocumentMerger::merge(SedDocument* source,
+                         std::map<std::string, std::string>* renamed)
+{
+  if (mTarget == NULL || source == NULL || source == mTarget)
+    return LIBSEDML_INVALID_OBJECT;
+
+  if (source->getLevel() != mTarget->getLevel())
+    return LIBSEDML_LEVEL_MISMATCH;
+
+  if (source->getVersion() != mTarget->getVersion())
+    return LIBSEDML_VERSION_MISMATCH;
+
+  // a prefix bound to different namespaces in both documents cannot be
+  // declared on the target; reject it before anything is changed
+  XMLNamespaces* sourceNamespaces = source->getNamespaces();
+  XMLNamespaces* targetNamespaces = mTarget->getNamespaces();
+
+  if (sourceNamespaces != NULL && targetNamespaces != NULL)
+    {
+      for (int i = 0; i < sourceNamespaces->getNumNamespaces(); ++i)
+        {
+          const std::string prefix = sourceNamespaces->getPrefix(i);
+
+          if (targetNamespaces->hasPrefix(prefix)
+              && targetNamespaces->getURI(prefix) != sourceNamespaces->getURI(i))
+            return LIBSEDML_NAMESPACES_MISMATCH;
+        }
+    }
+
+  if (!mIsSetIds)
+    {
+      collectIds(mTarget, mIds);
+      mIsSetIds = true;
+    }
+
+  // give every id of the source that is taken in the target a new name
+  // that is used in neither document
+  IdSet sourceIds;
+  IdSet sourceLocalIds;
+  collectIds(source, sourceIds, &sourceLocalIds);
+
+  RenameMap renames;
+
+  for (IdSet::const_iterator it = sourceIds.begin();
+       it != sourceIds.end(); ++it)
+    {
+      if (mIds.find(*it) == mIds.end()) continue;
+
+      std::string candidate;
+
+      for (unsigned int n = 1; ; ++n)
+        {
+          std::ostringstream name;
+          name << *it << '_' << n;
+          candidate = name.str();
+
+          // a local id of the same name would hide the new one in math
+          if (mIds.find(candidate) == mIds.end()
+              && sourceIds.find(candidate) == sourceIds.end()
+              && sourceLocalIds.find(candidate) == sourceLocalIds.end())
+            break;
+        }
+
+      renames[*it] = candidate;
+      mIds.insert(candidate);
+    }
+
+  mIds.insert(sourceIds.begin(), sourceIds.end());
+
+  if (!renames.empty())
+    renameReferences(source, renames);
+
+  // declare the prefixes the moved elements may use in their targets
+  if (sourceNamespaces != NULL && targetNamespaces != NULL)
+    {
+      for (int i = 0; i < sourceNamespaces->getNumNamespaces(); ++i)
+        {
+          const std::string prefix = sourceNamespaces->getPrefix(i);
+
+          if (!targetNamespaces->hasPrefix(prefix))
+            targetNamespaces->add(sourceNamespaces->getURI(i), prefix);
+        }
+    }
+
+  // both documents list their top level lists in the same order
+  std::vector<const SedBase*> from, to;
+  source->getChildObjects(from);
+  mTarget->getChildObjects(to);
+
+  for (size_t i = 0; i < from.size() && i < to.size(); ++i)
+    {
+      // the lists are members of documents that are not const
+      SedListOf* fromList = const_cast<SedListOf*>(static_cast<const SedListOf*>(from[i]));
+      SedListOf* toList = const_cast<SedListOf*>(static_cast<const SedListOf*>(to[i]));
+
+      std::vector<SedBase*> items;
+      items.reserve(fromList->size());
+
+      for (unsigned int n = 0; n < fromList->size(); ++n)
+        items.push_back(fromList->get(n));
+
+      fromList->clear(false);
+
+      for (size_t n = 0; n < items.size(); ++n)
+        toList->appendAndOwn(items[n]);
+    }
+
+  if (renamed != NULL)
+    {
+      renamed->clear();
+      renamed->insert(renames.begin(), renames.end());
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedDocumentMerger::merge(const std::vector<SedDocument*>& sources)
+{
+  for (size_t i = 0; i < sources.size(); ++i)
+    {
+      int result = merge(sources[i]);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS)
+        return result;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+void
+SedDocumentMerger::collectIds(const SedBase* object,
+                              IdSet& ids, IdSet* localIds) const
+{
+  std::vector<const SedBase*> pending(1, object);
+  std::string id;
+
+  while (!pending.empty())
+    {
+      const SedBase* current = pending.back();
+      pending.pop_back();
+
+      if (current->getAttribute("id", id) == LIBSEDML_OPERATION_SUCCESS)
+        {
+          if (!isLocal(current))
+            ids.insert(id);
+          else if (localIds != NULL)
+            localIds->insert(id);
+        }
+
+      current->getChildObjects(pending);
+    }
+}
+
+
+void
+SedDocumentMerger::renameReferences(SedBase* object,
+                                    const RenameMap& renamed) const
+{
+  std::vector<const SedBase*> pending(1, object);
+  std::string value;
+
+  while (!pending.empty())
+    {
+      // all objects belong to the source document, which is not const
+      SedBase* current = const_cast<SedBase*>(pending.back());
+      pending.pop_back();
+
+      // the ids of variables and parameters are never renamed
+      for (unsigned int i = isLocal(current) ? 1 : 0; i < NUM_REFERENCE_ATTRIBUTES; ++i)
+        {
+          if (current->getAttribute(REFERENCE_ATTRIBUTES[i], value) != LIBSEDML_OPERATION_SUCCESS)
+            continue;
+
+          RenameMap::const_iterator it = renamed.find(value);
+
+          if (it != renamed.end())
+            current->setAttribute(REFERENCE_ATTRIBUTES[i], it->second);
+        }
+
+      if (current->getTypeCode() == SEDML_MODEL
+          && current->getAttribute("source", value) == LIBSEDML_OPERATION_SUCCESS
+          && !value.empty() && value[0] == '#')
+        {
+          RenameMap::const_iterator it = renamed.find(value.substr(1));
+
+          if (it != renamed.end())
+            current->setAttribute("source", "#" + it->second);
+        }
+
+      // the math is owned by current, so it may be changed in place
+      const ASTNode* math = getMathOf(current);
+
+      if (math != NULL)
+        {
+          IdSet locals;
+          collectLocalIds(current, locals);
+
+          if (renameNames(const_cast<ASTNode*>(math), renamed, locals))
+            current->markDirty();
+        }
+
+      current->getChildObjects(pending);
+    }
+}
+
+/** @endcond */
+
+
+/**
+ * Moves all elements of the SedDocument_t structure source into target,
+ * renaming ids that are already used in target.  The ids of target are
+ * collected on every call; use SedDocumentMerger to merge many documents.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentMerger_merge(SedDocument_t * target, SedDocument_t * source)
+{
+  if (target == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  SedDocumentMerger merger(target);
+  return merger.merge(source);
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
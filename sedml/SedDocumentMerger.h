@@ -0,0 +1,184 @@
+/**
+ * @file   SedDocumentMerger.h
+ * @brief  Merges Sed documents
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedDocumentMerger
+ * @ingroup Core
+ * @brief Moves the elements of several SedDocuments into one.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * merge() moves the models, simulations, tasks, data generators, outputs
+ * and data descriptions of a document to the end of the corresponding
+ * lists of the target document, without copying them.  The source
+ * document is left empty.
+ *
+ * An id of the source document that is already used in the target (by any
+ * element, at any depth) is replaced by a new one formed by appending
+ * <code>_1</code>, <code>_2</code>, ...  All references to it in the
+ * source document are changed as well: the attributes modelReference,
+ * simulationReference, taskReference, dataReference, xDataReference,
+ * yDataReference, zDataReference, range and task, model sources of the
+ * form <code>#id</code>, and the names in math.  The ids of variables and
+ * parameters are local to the math of their parent: they are neither
+ * renamed nor compared with the ids of the target, and names in math that
+ * refer to them are left unchanged.
+ *
+ * A namespace prefix that both documents bind to different URIs cannot be
+ * declared on the target; merge() then fails with
+ * @link OperationReturnValues_t#LIBSEDML_NAMESPACES_MISMATCH LIBSEDML_NAMESPACES_MISMATCH @endlink
+ * and neither document is changed.
+ *
+ * The ids of the target are collected once, when the first document is
+ * merged, and kept in a hash set, so merging many documents takes time
+ * linear in their total size.  The target must not be changed by other
+ * means between calls to merge().
+ */
+
+#ifndef SedDocumentMerger_h
+#define SedDocumentMerger_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/common/unordered.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedDocumentMerger
+{
+public:
+
+  /**
+   * Creates a new SedDocumentMerger that merges into the given document.
+   *
+   * @param target the document that receives the elements; it has to
+   * outlive this object.
+   */
+  SedDocumentMerger(SedDocument* target);
+
+
+  /**
+   * @return the document that receives the elements.
+   */
+  SedDocument* getTarget() const;
+
+
+  /**
+   * Moves all elements of @p source into the target document, renaming
+   * ids that are already in use.  Namespace declarations of @p source whose
+   * prefix is not declared in the target are added to it; if a prefix is
+   * declared by both documents with different URIs, nothing is changed.
+   *
+   * @param source the document whose elements are moved; it is left
+   * without elements and still has to be deleted by the caller.
+   * @param renamed if not @c NULL, receives the ids that were changed,
+   * mapped to their new values.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_LEVEL_MISMATCH LIBSEDML_LEVEL_MISMATCH @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_VERSION_MISMATCH LIBSEDML_VERSION_MISMATCH @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_NAMESPACES_MISMATCH LIBSEDML_NAMESPACES_MISMATCH @endlink
+   */
+  int merge(SedDocument* source,
+            std::map<std::string, std::string>* renamed = NULL);
+
+
+  /**
+   * Merges each of the given documents in turn.
+   *
+   * @param sources the documents whose elements are moved.
+   *
+   * @return the result of the first merge that failed, or
+   * @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink.
+   */
+  int merge(const std::vector<SedDocument*>& sources);
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  typedef LIBSEDML_UNORDERED_NAMESPACE::unordered_set<std::string> IdSet;
+  typedef LIBSEDML_UNORDERED_NAMESPACE::unordered_map<std::string,
+          std::string> RenameMap;
+
+  void collectIds(const SedBase* object, IdSet& ids,
+                  IdSet* localIds = NULL) const;
+
+  void renameReferences(SedBase* object, const RenameMap& renamed) const;
+
+  SedDocument* mTarget;
+  IdSet mIds;
+  bool mIsSetIds;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+LIBSEDML_EXTERN
+int
+SedDocumentMerger_merge(SedDocument_t * target, SedDocument_t * source);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+#endif  /* SedDocumentMerger_h */
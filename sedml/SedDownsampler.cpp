@@ -0,0 +1,468 @@
+/**
+ * @file   SedDownsampler.cpp
+ * @brief  Downsampling of the series of curves and surfaces
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedDownsampler.h>
+#include <sedml/SedTypes.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <sbml/util/util.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Converts a value to its coordinate on a linear or logarithmic axis;
+ * returns false if it cannot be shown.
+ */
+static bool
+toAxis(double value, bool log, double& coordinate)
+{
+  if (!util_isFinite(value) || (log && value <= 0)) return false;
+
+  coordinate = log ? log10(value) : value;
+  return true;
+}
+
+/** @endcond */
+
+
+SedDownsampler::SedDownsampler(unsigned int maxPoints,
+                               unsigned long expectedPoints,
+                               SedDownsampleMethod_t method)
+  : mMethod(method)
+  , mBucketSize(1)
+  , mLogX(false)
+  , mLogY(false)
+  , mLogZ(false)
+{
+  init(maxPoints, expectedPoints);
+}
+
+
+SedDownsampler::SedDownsampler(const SedCurve* curve, unsigned int maxPoints,
+                               unsigned long expectedPoints,
+                               SedDownsampleMethod_t method)
+  : mMethod(method)
+  , mBucketSize(1)
+  , mLogX(false)
+  , mLogY(false)
+  , mLogZ(false)
+{
+  init(maxPoints, expectedPoints);
+
+  if (curve == NULL) return;
+
+  bool logZ = curve->getTypeCode() == SEDML_OUTPUT_SURFACE
+              && static_cast<const SedSurface*>(curve)->getLogZ();
+
+  setLog(curve->getLogX(), curve->getLogY(), logZ);
+}
+
+
+void
+SedDownsampler::setLog(bool logX, bool logY, bool logZ)
+{
+  mLogX = logX;
+  mLogY = logY;
+  mLogZ = logZ;
+}
+
+
+SedDownsampleMethod_t
+SedDownsampler::getMethod() const
+{
+  return mMethod;
+}
+
+
+unsigned long
+SedDownsampler::getBucketSize() const
+{
+  return mBucketSize;
+}
+
+
+int
+SedDownsampler::addPoints(const double* x, const double* y, const double* z,
+                          unsigned int n)
+{
+  if (x == NULL || y == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  mIsSurface = z != NULL;
+  Point point;
+
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      point.x = x[i];
+      point.y = y[i];
+      point.z = z != NULL ? z[i] : 0;
+
+      if (!toAxis(point.x, mLogX, point.u) || !toAxis(point.y, mLogY, point.v)
+          || !toAxis(point.z, z != NULL && mLogZ, point.w))
+        continue;
+
+      point.index = mNumAdded++;
+      addPoint(point);
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+void
+SedDownsampler::finish()
+{
+  if (mMethod == SEDML_DOWNSAMPLE_MINMAX)
+    {
+      flushMinMax();
+    }
+  else
+    {
+      if (!mNext.empty())
+        {
+          if (!mCurrent.empty()) select(getAverage(mNext));
+          mCurrent.swap(mNext);
+          mNext.clear();
+        }
+
+      // the last bucket is compared with the last point
+      if (!mCurrent.empty()) select(mHasLast ? mLast : mAnchor);
+
+      if (mHasLast) emit(mLast);
+    }
+
+  mNumAdded = 0;
+  mHasAnchor = false;
+  mHasLast = false;
+  mCurrent.clear();
+  mNext.clear();
+  mBucketCount = 0;
+}
+
+
+unsigned int
+SedDownsampler::getNumPoints() const
+{
+  return (unsigned int)mX.size();
+}
+
+
+void
+SedDownsampler::takePoints(std::vector<double>& x, std::vector<double>& y,
+                           std::vector<double>& z)
+{
+  x.clear();
+  y.clear();
+  z.clear();
+  x.swap(mX);
+  y.swap(mY);
+  z.swap(mZ);
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+void
+SedDownsampler::init(unsigned int maxPoints, unsigned long expectedPoints)
+{
+  if (maxPoints < 4) maxPoints = 4;
+
+  if (mMethod == SEDML_DOWNSAMPLE_MINMAX)
+    {
+      // up to four points per bucket
+      unsigned long numBuckets = maxPoints / 4;
+      mBucketSize = (expectedPoints + numBuckets - 1) / numBuckets;
+    }
+  else
+    {
+      // the first and last point are kept outside the buckets
+      unsigned long numBuckets = maxPoints - 2;
+      unsigned long inner = expectedPoints > 2 ? expectedPoints - 2 : 0;
+      mBucketSize = (inner + numBuckets - 1) / numBuckets;
+    }
+
+  if (mBucketSize == 0) mBucketSize = 1;
+
+  mNumAdded = 0;
+  mIsSurface = false;
+  mHasAnchor = false;
+  mHasLast = false;
+  mBucketCount = 0;
+
+  if (mMethod == SEDML_DOWNSAMPLE_LTTB)
+    {
+      mCurrent.reserve(mBucketSize);
+      mNext.reserve(mBucketSize);
+    }
+}
+
+
+void
+SedDownsampler::addPoint(const Point& point)
+{
+  if (mMethod == SEDML_DOWNSAMPLE_MINMAX)
+    {
+      if (mBucketCount == 0)
+        {
+          mFirst = mMin = mMax = point;
+        }
+      else
+        {
+          double value = mIsSurface ? point.w : point.v;
+          double min = mIsSurface ? mMin.w : mMin.v;
+          double max = mIsSurface ? mMax.w : mMax.v;
+
+          if (value < min) mMin = point;
+          if (value > max) mMax = point;
+        }
+
+      mLatest = point;
+
+      if (++mBucketCount == mBucketSize) flushMinMax();
+      return;
+    }
+
+  if (!mHasAnchor)
+    {
+      emit(point);
+      mAnchor = point;
+      mHasAnchor = true;
+      return;
+    }
+
+  // the latest point is held back, since the last one is kept anyway
+  if (mHasLast) addToBucket(mLast);
+
+  mLast = point;
+  mHasLast = true;
+}
+
+
+void
+SedDownsampler::addToBucket(const Point& point)
+{
+  mNext.push_back(point);
+
+  if (mNext.size() < mBucketSize) return;
+
+  if (!mCurrent.empty()) select(getAverage(mNext));
+
+  mCurrent.swap(mNext);
+  mNext.clear();
+}
+
+
+SedDownsampler::Point
+SedDownsampler::getAverage(const std::vector<Point>& points) const
+{
+  Point average = points.front();
+  average.u = average.v = average.w = 0;
+
+  for (size_t i = 0; i < points.size(); ++i)
+    {
+      average.u += points[i].u;
+      average.v += points[i].v;
+      average.w += points[i].w;
+    }
+
+  average.u /= points.size();
+  average.v /= points.size();
+  average.w /= points.size();
+
+  return average;
+}
+
+
+/*
+ * Keeps the point of the current bucket that forms the largest triangle
+ * with the last point kept and the given point.
+ */
+void
+SedDownsampler::select(const Point& next)
+{
+  size_t best = 0;
+  double bestArea = -1;
+
+  for (size_t i = 0; i < mCurrent.size(); ++i)
+    {
+      const Point& p = mCurrent[i];
+
+      double ax = p.u - mAnchor.u, ay = p.v - mAnchor.v, az = p.w - mAnchor.w;
+      double bx = next.u - mAnchor.u, by = next.v - mAnchor.v, bz = next.w - mAnchor.w;
+
+      // twice the area, as the length of the cross product
+      double cx = ay * bz - az * by;
+      double cy = az * bx - ax * bz;
+      double cz = ax * by - ay * bx;
+      double area = cx * cx + cy * cy + cz * cz;
+
+      if (area > bestArea)
+        {
+          bestArea = area;
+          best = i;
+        }
+    }
+
+  emit(mCurrent[best]);
+  mAnchor = mCurrent[best];
+  mCurrent.clear();
+}
+
+
+void
+SedDownsampler::flushMinMax()
+{
+  if (mBucketCount == 0) return;
+
+  Point points[4] = { mFirst, mMin, mMax, mLatest };
+  unsigned long last = 0;
+  bool emitted = false;
+
+  // in the order of the series, each point once
+  for (int n = 0; n < 4; ++n)
+    {
+      int next = -1;
+
+      for (int k = 0; k < 4; ++k)
+        {
+          if ((!emitted || points[k].index > last)
+              && (next < 0 || points[k].index < points[next].index))
+            next = k;
+        }
+
+      if (next < 0) break;
+
+      emit(points[next]);
+      last = points[next].index;
+      emitted = true;
+    }
+
+  mBucketCount = 0;
+}
+
+
+void
+SedDownsampler::emit(const Point& point)
+{
+  mX.push_back(point.x);
+  mY.push_back(point.y);
+  mZ.push_back(point.z);
+}
+
+/** @endcond */
+
+
+SedPlotDownsampler::SedPlotDownsampler(const SedOutput* output,
+                                       unsigned int maxPoints,
+                                       unsigned long expectedPoints,
+                                       SedDownsampleMethod_t method)
+  : mDownsamplers()
+{
+  if (output == NULL) return;
+
+  if (output->getTypeCode() == SEDML_OUTPUT_PLOT2D)
+    {
+      const SedPlot2D* plot = static_cast<const SedPlot2D*>(output);
+
+      for (unsigned int n = 0; n < plot->getNumCurves(); ++n)
+        {
+          const SedCurve* curve = plot->getCurve(n);
+          delete mDownsamplers[curve->getId()];
+          mDownsamplers[curve->getId()] =
+            new SedDownsampler(curve, maxPoints, expectedPoints, method);
+        }
+    }
+  else if (output->getTypeCode() == SEDML_OUTPUT_PLOT3D)
+    {
+      const SedPlot3D* plot = static_cast<const SedPlot3D*>(output);
+
+      for (unsigned int n = 0; n < plot->getNumSurfaces(); ++n)
+        {
+          const SedSurface* surface = plot->getSurface(n);
+          delete mDownsamplers[surface->getId()];
+          mDownsamplers[surface->getId()] =
+            new SedDownsampler(surface, maxPoints, expectedPoints, method);
+        }
+    }
+}
+
+
+SedPlotDownsampler::~SedPlotDownsampler()
+{
+  std::map<std::string, SedDownsampler*>::iterator it = mDownsamplers.begin();
+
+  for (; it != mDownsamplers.end(); ++it)
+    delete it->second;
+}
+
+
+unsigned int
+SedPlotDownsampler::getNumSeries() const
+{
+  return (unsigned int)mDownsamplers.size();
+}
+
+
+SedDownsampler*
+SedPlotDownsampler::getDownsampler(const std::string& id)
+{
+  std::map<std::string, SedDownsampler*>::iterator it = mDownsamplers.find(id);
+  return it != mDownsamplers.end() ? it->second : NULL;
+}
+
+
+void
+SedPlotDownsampler::finish()
+{
+  std::map<std::string, SedDownsampler*>::iterator it = mDownsamplers.begin();
+
+  for (; it != mDownsamplers.end(); ++it)
+    it->second->finish();
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
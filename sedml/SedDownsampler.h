@@ -0,0 +1,312 @@
+/**
+ * @file   SedDownsampler.h
+ * @brief  Downsampling of the series of curves and surfaces
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedDownsampler
+ * @ingroup Core
+ * @brief Reduces a series of points to a given number while keeping its
+ * shape, reading it in chunks.
+ *
+ * @class SedPlotDownsampler
+ * @ingroup Core
+ * @brief A SedDownsampler for each curve or surface of a plot.
+ *
+ * <em style='color: #555'>These classes of objects are defined by libSed
+ * only and have no direct equivalent in terms of Sed components.</em>
+ *
+ * Simulations can produce millions of points per curve, of which a
+ * viewer shows a few thousand.  A SedDownsampler receives the series in
+ * chunks through addPoints() and keeps at most two buckets of points in
+ * memory, so the full series is never held.  Two methods are available:
+ *
+ * @li SEDML_DOWNSAMPLE_LTTB (largest triangle three buckets) keeps the
+ * first and the last point and, from each bucket, the point that forms
+ * the largest triangle with the point kept before it and the average of
+ * the next bucket.  For surfaces the triangle is measured in three
+ * dimensions.
+ * @li SEDML_DOWNSAMPLE_MINMAX keeps the first, last, smallest and largest
+ * point of each bucket (by y, or by z for surfaces), so no peak is lost.
+ *
+ * The size of the buckets follows from the expected number of points; a
+ * longer series yields proportionally more points.  When an axis is
+ * logarithmic, points are compared in log space and points that cannot
+ * be shown on it (not positive) are dropped, as are NaN points.  The
+ * points that are kept are returned with their original values.
+ */
+
+#ifndef SedDownsampler_h
+#define SedDownsampler_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * The methods a SedDownsampler can use.
+ */
+typedef enum
+{
+    SEDML_DOWNSAMPLE_LTTB         /*!< Largest triangle three buckets */
+  , SEDML_DOWNSAMPLE_MINMAX       /*!< First, last, minimum and maximum of each bucket */
+} SedDownsampleMethod_t;
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedCurve;
+class SedOutput;
+
+
+class LIBSEDML_EXTERN SedDownsampler
+{
+public:
+
+  /**
+   * Creates a new SedDownsampler.
+   *
+   * @param maxPoints the number of points to keep, at least 4.
+   * @param expectedPoints the number of points of the series, from which
+   * the size of the buckets is computed.
+   * @param method the method to use.
+   */
+  SedDownsampler(unsigned int maxPoints, unsigned long expectedPoints,
+                 SedDownsampleMethod_t method = SEDML_DOWNSAMPLE_LTTB);
+
+
+  /**
+   * Creates a new SedDownsampler for a curve or surface, taking the
+   * logarithmic axes from it.
+   *
+   * @param curve the SedCurve or SedSurface.
+   * @param maxPoints the number of points to keep, at least 4.
+   * @param expectedPoints the number of points of the series.
+   * @param method the method to use.
+   */
+  SedDownsampler(const SedCurve* curve, unsigned int maxPoints,
+                 unsigned long expectedPoints,
+                 SedDownsampleMethod_t method = SEDML_DOWNSAMPLE_LTTB);
+
+
+  /**
+   * Sets whether the axes are logarithmic; must be called before the
+   * first point is added.
+   */
+  void setLog(bool logX, bool logY, bool logZ = false);
+
+
+  /**
+   * @return the method used.
+   */
+  SedDownsampleMethod_t getMethod() const;
+
+
+  /**
+   * @return the number of points per bucket.
+   */
+  unsigned long getBucketSize() const;
+
+
+  /**
+   * Adds the next chunk of the series.
+   *
+   * @param x the x values.
+   * @param y the y values.
+   * @param z the z values, or @c NULL for a curve.
+   * @param n the number of points in the chunk.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p x or @p y is @c NULL
+   */
+  int addPoints(const double* x, const double* y, const double* z,
+                unsigned int n);
+
+
+  /**
+   * Ends the series, emitting the points still held back.  Afterwards a
+   * new series can be added.
+   */
+  void finish();
+
+
+  /**
+   * @return the number of points kept and not yet taken.
+   */
+  unsigned int getNumPoints() const;
+
+
+  /**
+   * Moves the points kept so far to the given vectors, replacing their
+   * contents, so they can be passed on while the series is still read.
+   *
+   * @param x receives the x values.
+   * @param y receives the y values.
+   * @param z receives the z values; all 0 for a curve.
+   */
+  void takePoints(std::vector<double>& x, std::vector<double>& y,
+                  std::vector<double>& z);
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Point
+  {
+    double x, y, z;     // the values
+    double u, v, w;     // the coordinates on the plot
+    unsigned long index;
+  };
+
+  void init(unsigned int maxPoints, unsigned long expectedPoints);
+
+  void addPoint(const Point& point);
+
+  void addToBucket(const Point& point);
+
+  Point getAverage(const std::vector<Point>& points) const;
+
+  void select(const Point& next);
+
+  void flushMinMax();
+
+  void emit(const Point& point);
+
+  SedDownsampleMethod_t mMethod;
+  unsigned long mBucketSize;
+  bool mLogX;
+  bool mLogY;
+  bool mLogZ;
+
+  unsigned long mNumAdded;
+  bool mIsSurface;
+
+  // largest triangle three buckets
+  bool mHasAnchor;
+  Point mAnchor;
+  bool mHasLast;
+  Point mLast;
+  std::vector<Point> mCurrent;
+  std::vector<Point> mNext;
+
+  // minimum and maximum: the candidates of the current bucket
+  unsigned long mBucketCount;
+  Point mFirst;
+  Point mLatest;
+  Point mMin;
+  Point mMax;
+
+  std::vector<double> mX;
+  std::vector<double> mY;
+  std::vector<double> mZ;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedPlotDownsampler
+{
+public:
+
+  /**
+   * Creates a SedDownsampler for each curve of a SedPlot2D or surface of
+   * a SedPlot3D.
+   *
+   * @param output the plot; other outputs have no series to downsample.
+   * @param maxPoints the number of points to keep per series.
+   * @param expectedPoints the number of points of each series.
+   * @param method the method to use.
+   */
+  SedPlotDownsampler(const SedOutput* output, unsigned int maxPoints,
+                     unsigned long expectedPoints,
+                     SedDownsampleMethod_t method = SEDML_DOWNSAMPLE_LTTB);
+
+
+  /**
+   * Destroys this object and its downsamplers.
+   */
+  ~SedPlotDownsampler();
+
+
+  /**
+   * @return the number of curves or surfaces.
+   */
+  unsigned int getNumSeries() const;
+
+
+  /**
+   * @param id the id of a curve or surface.
+   *
+   * @return its downsampler, or @c NULL if the plot has no such element.
+   */
+  SedDownsampler* getDownsampler(const std::string& id);
+
+
+  /**
+   * Finishes the series of all curves or surfaces.
+   */
+  void finish();
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  std::map<std::string, SedDownsampler*> mDownsamplers;
+
+  /** @endcond */
+
+private:
+  SedPlotDownsampler(const SedPlotDownsampler&);
+  SedPlotDownsampler& operator=(const SedPlotDownsampler&);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedDownsampler_h */
@@ -0,0 +1,260 @@
+/**
+ * @file   SedElementFilter.cpp
+ * @brief  Element types kept by a selective read
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedElementFilter.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/operationReturnValues.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The element names of the Sed objects and lists, with the type code of
+ * the object (of the list items) and the type code it specializes.
+ */
+struct SedElementType
+{
+  const char* name;
+  int typeCode;
+  int baseTypeCode;
+};
+
+
+static const SedElementType SED_ELEMENT_TYPES[] =
+{
+  { "model",                     SEDML_MODEL,                         SEDML_MODEL },
+  { "changeAttribute",           SEDML_CHANGE_ATTRIBUTE,              SEDML_CHANGE },
+  { "removeXML",                 SEDML_CHANGE_REMOVEXML,              SEDML_CHANGE },
+  { "computeChange",             SEDML_CHANGE_COMPUTECHANGE,          SEDML_CHANGE },
+  { "addXML",                    SEDML_CHANGE_ADDXML,                 SEDML_CHANGE },
+  { "changeXML",                 SEDML_CHANGE_CHANGEXML,              SEDML_CHANGE },
+  { "dataGenerator",             SEDML_DATAGENERATOR,                 SEDML_DATAGENERATOR },
+  { "variable",                  SEDML_VARIABLE,                      SEDML_VARIABLE },
+  { "parameter",                 SEDML_PARAMETER,                     SEDML_PARAMETER },
+  { "task",                      SEDML_TASK,                          SEDML_TASK },
+  { "subTask",                   SEDML_TASK_SUBTASK,                  SEDML_TASK_SUBTASK },
+  { "setValue",                  SEDML_TASK_SETVALUE,                 SEDML_TASK_SETVALUE },
+  { "repeatedTask",              SEDML_TASK_REPEATEDTASK,             SEDML_TASK },
+  { "dataSet",                   SEDML_OUTPUT_DATASET,                SEDML_OUTPUT_DATASET },
+  { "curve",                     SEDML_OUTPUT_CURVE,                  SEDML_OUTPUT_CURVE },
+  { "surface",                   SEDML_OUTPUT_SURFACE,                SEDML_OUTPUT_SURFACE },
+  { "report",                    SEDML_OUTPUT_REPORT,                 SEDML_OUTPUT },
+  { "plot2D",                    SEDML_OUTPUT_PLOT2D,                 SEDML_OUTPUT },
+  { "plot3D",                    SEDML_OUTPUT_PLOT3D,                 SEDML_OUTPUT },
+  { "algorithm",                 SEDML_SIMULATION_ALGORITHM,          SEDML_SIMULATION_ALGORITHM },
+  { "uniformTimeCourse",         SEDML_SIMULATION_UNIFORMTIMECOURSE,  SEDML_SIMULATION },
+  { "algorithmParameter",        SEDML_SIMULATION_ALGORITHM_PARAMETER, SEDML_SIMULATION_ALGORITHM_PARAMETER },
+  { "oneStep",                   SEDML_SIMULATION_ONESTEP,            SEDML_SIMULATION },
+  { "steadyState",               SEDML_SIMULATION_STEADYSTATE,        SEDML_SIMULATION },
+  { "uniformRange",              SEDML_RANGE_UNIFORMRANGE,            SEDML_RANGE },
+  { "vectorRange",               SEDML_RANGE_VECTORRANGE,             SEDML_RANGE },
+  { "functionalRange",           SEDML_RANGE_FUNCTIONALRANGE,         SEDML_RANGE },
+  { "dataDescription",           SEDML_DATA_DESCRIPTION,              SEDML_DATA_DESCRIPTION },
+  { "dataSource",                SEDML_DATA_SOURCE,                   SEDML_DATA_SOURCE },
+  { "slice",                     SEDML_DATA_SLICE,                    SEDML_DATA_SLICE },
+  { NULL,                        SEDML_UNKNOWN,                       SEDML_UNKNOWN }
+};
+
+
+/*
+ * The lists hold the items of either type; <listOfChanges> is used both
+ * by models and by repeated tasks.
+ */
+static const SedElementType SED_LIST_TYPES[] =
+{
+  { "listOfModels",              SEDML_MODEL,                         SEDML_MODEL },
+  { "listOfChanges",             SEDML_CHANGE,                        SEDML_TASK_SETVALUE },
+  { "listOfDataGenerators",      SEDML_DATAGENERATOR,                 SEDML_DATAGENERATOR },
+  { "listOfVariables",           SEDML_VARIABLE,                      SEDML_VARIABLE },
+  { "listOfParameters",          SEDML_PARAMETER,                     SEDML_PARAMETER },
+  { "listOfTasks",               SEDML_TASK,                          SEDML_TASK },
+  { "listOfSubTasks",            SEDML_TASK_SUBTASK,                  SEDML_TASK_SUBTASK },
+  { "listOfOutputs",             SEDML_OUTPUT,                        SEDML_OUTPUT },
+  { "listOfDataSets",            SEDML_OUTPUT_DATASET,                SEDML_OUTPUT_DATASET },
+  { "listOfCurves",              SEDML_OUTPUT_CURVE,                  SEDML_OUTPUT_CURVE },
+  { "listOfSurfaces",            SEDML_OUTPUT_SURFACE,                SEDML_OUTPUT_SURFACE },
+  { "listOfSimulations",         SEDML_SIMULATION,                    SEDML_SIMULATION },
+  { "listOfAlgorithmParameters", SEDML_SIMULATION_ALGORITHM_PARAMETER, SEDML_SIMULATION_ALGORITHM_PARAMETER },
+  { "listOfRanges",              SEDML_RANGE,                         SEDML_RANGE },
+  { "listOfFunctionalRanges",    SEDML_RANGE_FUNCTIONALRANGE,         SEDML_RANGE_FUNCTIONALRANGE },
+  { "listOfDataDescriptions",    SEDML_DATA_DESCRIPTION,              SEDML_DATA_DESCRIPTION },
+  { "listOfDataSources",         SEDML_DATA_SOURCE,                   SEDML_DATA_SOURCE },
+  { "listOfSlices",              SEDML_DATA_SLICE,                    SEDML_DATA_SLICE },
+  { NULL,                        SEDML_UNKNOWN,                       SEDML_UNKNOWN }
+};
+
+
+static const SedElementType*
+findElementType(const SedElementType* types, const std::string& name)
+{
+  for (; types->name != NULL; ++types)
+    {
+      if (name == types->name) return types;
+    }
+
+  return NULL;
+}
+
+
+SedElementFilter::SedElementFilter()
+  : mTypes()
+  , mLists()
+  , mListDepth(0)
+  , mNumSkipped(0)
+{
+}
+
+
+int
+SedElementFilter::addType(int typeCode)
+{
+  for (const SedElementType* type = SED_ELEMENT_TYPES; type->name != NULL; ++type)
+    {
+      if (type->typeCode == typeCode || type->baseTypeCode == typeCode)
+        {
+          mTypes.insert(typeCode);
+          return LIBSEDML_OPERATION_SUCCESS;
+        }
+    }
+
+  return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+}
+
+
+int
+SedElementFilter::addList(const std::string& listName)
+{
+  if (findElementType(SED_LIST_TYPES, listName) == NULL)
+    {
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+  mLists.insert(listName);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+void
+SedElementFilter::clear()
+{
+  mTypes.clear();
+  mLists.clear();
+  reset();
+}
+
+
+bool
+SedElementFilter::isEmpty() const
+{
+  return mTypes.empty() && mLists.empty();
+}
+
+
+bool
+SedElementFilter::isReadType(int typeCode) const
+{
+  return mTypes.find(typeCode) != mTypes.end();
+}
+
+
+bool
+SedElementFilter::isSkipped(const std::string& name) const
+{
+  if (mListDepth > 0 || isEmpty()) return false;
+
+  const SedElementType* type = findElementType(SED_ELEMENT_TYPES, name);
+
+  if (type == NULL)
+    {
+      type = findElementType(SED_LIST_TYPES, name);
+
+      if (type == NULL) return false;
+
+      if (mLists.find(name) != mLists.end()) return false;
+    }
+
+  return !isReadType(type->typeCode) && !isReadType(type->baseTypeCode);
+}
+
+
+void
+SedElementFilter::beginElement(const std::string& name)
+{
+  if (mListDepth > 0 || mLists.find(name) != mLists.end())
+    {
+      ++mListDepth;
+    }
+}
+
+
+void
+SedElementFilter::endElement()
+{
+  if (mListDepth > 0)
+    {
+      --mListDepth;
+    }
+}
+
+
+void
+SedElementFilter::addSkipped()
+{
+  ++mNumSkipped;
+}
+
+
+unsigned int
+SedElementFilter::getNumSkipped() const
+{
+  return mNumSkipped;
+}
+
+
+void
+SedElementFilter::reset()
+{
+  mListDepth = 0;
+  mNumSkipped = 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,170 @@
+/**
+ * @file   SedElementFilter.h
+ * @brief  Element types kept by a selective read
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedElementFilter
+ * @ingroup Core
+ * @brief Decides which child elements SedBase::read() skips.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedReader with types or lists to read (SedReader::addTypeToRead(),
+ * SedReader::addListToRead()) attaches its SedElementFilter to the
+ * document it reads.  Before creating the object for a child element,
+ * SedBase::read() asks the filter whether the element is needed; elements
+ * that are not are passed over with XMLInputStream::skipPastEnd(), so no
+ * object is created for them or for anything they contain.
+ *
+ * The decision is taken on the element name alone:
+ * @li an object is read if its type code, or the type code of the class
+ * it specializes (e.g. #SEDML_SIMULATION for a
+ * <code>&lt;uniformTimeCourse&gt;</code>), was added;
+ * @li a list is read if it was added by name, in which case everything in
+ * it is read, or if the type of its items was added;
+ * @li elements that are not Sed objects, such as notes, annotations and
+ * math, are always read.
+ */
+
+#ifndef SedElementFilter_h
+#define SedElementFilter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <set>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+class LIBSEDML_EXTERN SedElementFilter
+{
+public:
+
+  SedElementFilter();
+
+
+  /**
+   * Adds a type code whose objects are read.
+   *
+   * @return LIBSEDML_OPERATION_SUCCESS, or LIBSEDML_INVALID_ATTRIBUTE_VALUE
+   * if @p typeCode is not the type code of a Sed object.
+   */
+  int addType(int typeCode);
+
+
+  /**
+   * Adds the name of a list that is read with everything in it.
+   *
+   * @return LIBSEDML_OPERATION_SUCCESS, or LIBSEDML_INVALID_ATTRIBUTE_VALUE
+   * if @p listName is not the element name of a Sed list.
+   */
+  int addList(const std::string& listName);
+
+
+  /**
+   * Removes all types and lists, so that everything is read again.
+   */
+  void clear();
+
+
+  /**
+   * @return true if no types or lists were added, i.e. nothing is skipped.
+   */
+  bool isEmpty() const;
+
+
+  /**
+   * @return true if the child element @p name is to be skipped.
+   */
+  bool isSkipped(const std::string& name) const;
+
+
+  /**
+   * Records that the object for the element @p name is about to be read.
+   * Must be paired with endElement() around SedBase::read() of every
+   * object that is not skipped.
+   */
+  void beginElement(const std::string& name);
+
+
+  /**
+   * Records that the object of the matching beginElement() has been read.
+   */
+  void endElement();
+
+
+  /**
+   * Counts an element skipped by SedBase::read().
+   */
+  void addSkipped();
+
+
+  /**
+   * @return the number of elements skipped since the last reset().
+   */
+  unsigned int getNumSkipped() const;
+
+
+  /**
+   * Clears the state of a previous read.
+   */
+  void reset();
+
+
+protected:
+
+  bool isReadType(int typeCode) const;
+
+  std::set<int> mTypes;
+  std::set<std::string> mLists;
+  unsigned int mListDepth;
+  unsigned int mNumSkipped;
+};
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedElementFilter_h */
@@ -0,0 +1,503 @@
+/**
+ * @file   SedEvaluationPlan.cpp
+ * @brief  Shared evaluation of the data generators of a document
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedEvaluationPlan.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedParameter.h>
+#include <sedml/SedVariable.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+SedEvaluationPlan::SedEvaluationPlan(const SedDocument* document)
+  : mDataGenerators()
+  , mOutputs()
+  , mColumns()
+  , mColumnIndex()
+  , mVariableColumns()
+  , mNodes()
+  , mArguments()
+  , mOperations()
+  , mNodeIndex()
+  , mNumVariables(0)
+  , mNumUnsharedOperations(0)
+  , mValues()
+  , mArgumentValues()
+{
+  if (document != NULL)
+    {
+      for (unsigned int i = 0; i < document->getNumDataGenerators(); ++i)
+        {
+          mDataGenerators.push_back(document->getDataGenerator(i));
+        }
+    }
+
+  build();
+}
+
+
+SedEvaluationPlan::SedEvaluationPlan(
+  const std::vector<const SedDataGenerator*>& dataGenerators)
+  : mDataGenerators(dataGenerators)
+  , mOutputs()
+  , mColumns()
+  , mColumnIndex()
+  , mVariableColumns()
+  , mNodes()
+  , mArguments()
+  , mOperations()
+  , mNodeIndex()
+  , mNumVariables(0)
+  , mNumUnsharedOperations(0)
+  , mValues()
+  , mArgumentValues()
+{
+  build();
+}
+
+
+unsigned int
+SedEvaluationPlan::getNumDataGenerators() const
+{
+  return (unsigned int)mDataGenerators.size();
+}
+
+
+const SedDataGenerator*
+SedEvaluationPlan::getDataGenerator(unsigned int n) const
+{
+  return n < mDataGenerators.size() ? mDataGenerators[n] : NULL;
+}
+
+
+bool
+SedEvaluationPlan::isPlanned(unsigned int n) const
+{
+  return n < mOutputs.size() && mOutputs[n] >= 0;
+}
+
+
+unsigned int
+SedEvaluationPlan::getNumColumns() const
+{
+  return (unsigned int)mColumns.size();
+}
+
+
+const SedVariable*
+SedEvaluationPlan::getColumn(unsigned int n) const
+{
+  return n < mColumns.size() ? mColumns[n] : NULL;
+}
+
+
+int
+SedEvaluationPlan::getColumnIndex(const SedVariable* variable) const
+{
+  std::map<const SedVariable*, unsigned int>::const_iterator it =
+    mVariableColumns.find(variable);
+
+  return it != mVariableColumns.end() ? (int)it->second : -1;
+}
+
+
+unsigned int
+SedEvaluationPlan::getNumVariables() const
+{
+  return mNumVariables;
+}
+
+
+unsigned int
+SedEvaluationPlan::getNumOperations() const
+{
+  unsigned int count = 0;
+
+  for (unsigned int i = 0; i < mOperations.size(); ++i)
+    {
+      if (mNodes[mOperations[i]].type != AST_NAME) ++count;
+    }
+
+  return count;
+}
+
+
+unsigned int
+SedEvaluationPlan::getNumUnsharedOperations() const
+{
+  return mNumUnsharedOperations;
+}
+
+
+int
+SedEvaluationPlan::evaluate(const double* const* columns,
+                            unsigned int numSamples,
+                            double* const* results) const
+{
+  if (numSamples > 0 && columns == NULL && !mColumns.empty())
+    {
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  for (unsigned int c = 0; c < mColumns.size(); ++c)
+    {
+      if (numSamples > 0 && columns[c] == NULL) return LIBSEDML_INVALID_OBJECT;
+    }
+
+  if (results == NULL) return LIBSEDML_OPERATION_SUCCESS;
+
+  const double nan = numeric_limits<double>::quiet_NaN();
+
+  // constants keep their value over all samples
+  for (unsigned int i = 0; i < mNodes.size(); ++i)
+    {
+      if (mNodes[i].type == AST_REAL) mValues[i] = mNodes[i].value;
+    }
+
+  double* values = mValues.empty() ? NULL : &mValues[0];
+  double* args = mArgumentValues.empty() ? NULL : &mArgumentValues[0];
+
+  for (unsigned int s = 0; s < numSamples; ++s)
+    {
+      std::vector<unsigned int>::const_iterator it = mOperations.begin();
+
+      for (; it != mOperations.end(); ++it)
+        {
+          const Node& node = mNodes[*it];
+
+          if (node.type == AST_NAME)
+            {
+              values[*it] = columns[node.first][s];
+              continue;
+            }
+
+          for (unsigned int a = 0; a < node.numArgs; ++a)
+            {
+              args[a] = values[mArguments[node.first + a]];
+            }
+
+          SedCompiledMath::applyOperator(node.type, args, node.numArgs,
+                                         values[*it]);
+        }
+
+      for (unsigned int d = 0; d < mOutputs.size(); ++d)
+        {
+          if (results[d] == NULL) continue;
+
+          results[d][s] = mOutputs[d] >= 0 ? values[mOutputs[d]] : nan;
+        }
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the variables and adds the math of each data generator whose
+ * math compiles.
+ */
+void
+SedEvaluationPlan::build()
+{
+  mOutputs.assign(mDataGenerators.size(), -1);
+
+  for (unsigned int d = 0; d < mDataGenerators.size(); ++d)
+    {
+      const SedDataGenerator* dg = mDataGenerators[d];
+
+      if (dg == NULL || dg->getMath() == NULL) continue;
+
+      // first check that the math compiles over the ids of the variables
+      // and parameters, so that nothing is added for a data generator
+      // that cannot be evaluated
+      std::map<std::string, unsigned int> names;
+
+      for (unsigned int i = 0; i < dg->getNumParameters(); ++i)
+        {
+          names[dg->getParameter(i)->getId()] = 0;
+        }
+
+      for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+        {
+          names[dg->getVariable(i)->getId()] = 0;
+        }
+
+      SedCompiledMath check;
+
+      if (check.compile(dg->getMath(), names) != LIBSEDML_OPERATION_SUCCESS)
+        {
+          continue;
+        }
+
+      std::map<std::string, double> parameters;
+
+      for (unsigned int i = 0; i < dg->getNumParameters(); ++i)
+        {
+          const SedParameter* parameter = dg->getParameter(i);
+          parameters[parameter->getId()] = parameter->isSetValue()
+            ? parameter->getValue() : numeric_limits<double>::quiet_NaN();
+        }
+
+      std::map<std::string, unsigned int> columns;
+
+      for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+        {
+          const SedVariable* variable = dg->getVariable(i);
+          const std::string key = variable->getTaskReference() + '\n'
+            + variable->getModelReference() + '\n'
+            + variable->getTarget() + '\n' + variable->getSymbol();
+
+          std::map<std::string, unsigned int>::iterator it =
+            mColumnIndex.find(key);
+
+          if (it == mColumnIndex.end())
+            {
+              it = mColumnIndex.insert(
+                     make_pair(key, (unsigned int)mColumns.size())).first;
+              mColumns.push_back(variable);
+            }
+
+          columns[variable->getId()] = it->second;
+          mVariableColumns[variable] = it->second;
+        }
+
+      mNumVariables += dg->getNumVariables();
+
+      unsigned int numOperations = 0;
+      mOutputs[d] = addNode(dg->getMath(), columns, parameters, numOperations);
+      mNumUnsharedOperations += numOperations;
+    }
+
+  mValues.assign(mNodes.size(), 0.0);
+
+  unsigned int maxArgs = 1;
+
+  for (unsigned int i = 0; i < mNodes.size(); ++i)
+    {
+      if (mNodes[i].numArgs > maxArgs) maxArgs = mNodes[i].numArgs;
+    }
+
+  mArgumentValues.assign(maxArgs, 0.0);
+}
+
+
+/*
+ * Returns the node holding the value of the given math, adding the nodes
+ * that are not there yet; subexpressions over constants are folded.
+ */
+int
+SedEvaluationPlan::addNode(const ASTNode* node,
+                           const std::map<std::string, unsigned int>& columns,
+                           const std::map<std::string, double>& parameters,
+                           unsigned int& numOperations)
+{
+  Node result;
+  result.type = AST_REAL;
+  result.numArgs = 0;
+  result.first = 0;
+  result.value = 0;
+
+  std::vector<unsigned int> arguments;
+
+  switch (node->getType())
+    {
+    case AST_INTEGER:
+      result.value = (double)node->getInteger();
+      break;
+
+    case AST_REAL:
+    case AST_REAL_E:
+    case AST_RATIONAL:
+      result.value = node->getReal();
+      break;
+
+    case AST_CONSTANT_E:
+      result.value = exp(1.0);
+      break;
+
+    case AST_CONSTANT_PI:
+      result.value = 4.0 * atan(1.0);
+      break;
+
+    case AST_CONSTANT_TRUE:
+      result.value = 1;
+      break;
+
+    case AST_CONSTANT_FALSE:
+      result.value = 0;
+      break;
+
+    case AST_NAME:
+      {
+        const std::string name = node->getName() != NULL ? node->getName() : "";
+        std::map<std::string, unsigned int>::const_iterator column =
+          columns.find(name);
+
+        if (column != columns.end())
+          {
+            result.type = AST_NAME;
+            result.first = column->second;
+          }
+        else
+          {
+            std::map<std::string, double>::const_iterator parameter =
+              parameters.find(name);
+
+            if (parameter == parameters.end()) return -1;
+
+            result.value = parameter->second;
+          }
+      }
+      break;
+
+    default:
+      {
+        bool constant = true;
+
+        for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+          {
+            int child = addNode(node->getChild(i), columns, parameters,
+                                numOperations);
+
+            if (child < 0) return -1;
+
+            arguments.push_back((unsigned int)child);
+            constant = constant && mNodes[child].type == AST_REAL;
+          }
+
+        ++numOperations;
+
+        result.type = node->getType();
+        result.numArgs = (unsigned int)arguments.size();
+
+        if (constant)
+          {
+            std::vector<double> values(arguments.size() + 1, 0.0);
+
+            for (unsigned int i = 0; i < arguments.size(); ++i)
+              {
+                values[i] = mNodes[arguments[i]].value;
+              }
+
+            if (!SedCompiledMath::applyOperator(result.type, &values[0],
+                                                result.numArgs, result.value))
+              {
+                return -1;
+              }
+
+            result.type = AST_REAL;
+            result.numArgs = 0;
+            arguments.clear();
+          }
+      }
+      break;
+    }
+
+  ostringstream key;
+  key.precision(17);
+
+  if (result.type == AST_REAL)
+    {
+      key << "r" << result.value;
+    }
+  else if (result.type == AST_NAME)
+    {
+      key << "c" << result.first;
+    }
+  else
+    {
+      key << "o" << (int)result.type;
+
+      for (unsigned int i = 0; i < arguments.size(); ++i)
+        {
+          key << ' ' << arguments[i];
+        }
+    }
+
+  return (int)intern(key.str(), result, arguments);
+}
+
+
+/*
+ * Returns the node with the given key, adding it if there is none.
+ */
+unsigned int
+SedEvaluationPlan::intern(const std::string& key, const Node& node,
+                          const std::vector<unsigned int>& arguments)
+{
+  std::map<std::string, unsigned int>::const_iterator it =
+    mNodeIndex.find(key);
+
+  if (it != mNodeIndex.end()) return it->second;
+
+  unsigned int index = (unsigned int)mNodes.size();
+  mNodes.push_back(node);
+
+  if (node.type != AST_REAL && node.type != AST_NAME)
+    {
+      mNodes.back().first = (unsigned int)mArguments.size();
+      mArguments.insert(mArguments.end(), arguments.begin(), arguments.end());
+    }
+
+  // columns are copied and operations computed once per sample, in the
+  // order in which they were added, which has arguments first
+  if (node.type != AST_REAL) mOperations.push_back(index);
+
+  mNodeIndex[key] = index;
+  return index;
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
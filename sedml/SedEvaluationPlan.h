@@ -0,0 +1,237 @@
+/**
+ * @file   SedEvaluationPlan.h
+ * @brief  Shared evaluation of the data generators of a document
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedEvaluationPlan
+ * @ingroup Core
+ * @brief One program that evaluates a set of data generators, fetching
+ * each variable and computing each subexpression once.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * The data generators of a document often share variables (the same
+ * target of the same task) and subexpressions (a normalisation used by
+ * several curves).  A SedEvaluationPlan interns the variables by task,
+ * model, target and symbol, so that each distinct variable becomes one
+ * column of input, and hash-conses the math of all data generators into
+ * one graph, so that structurally equal subexpressions over the same
+ * columns become one node.  Parameters are replaced by their values and
+ * subexpressions over constants are folded.
+ *
+ * evaluate() takes the columns of a number of samples and computes, per
+ * sample, every node of the graph once and in order, writing the value of
+ * each data generator.  A data generator whose math refers to an unknown
+ * name or uses an unsupported construct (see SedCompiledMath) is not part
+ * of the plan and yields NaN.
+ *
+ * Operands are kept in their order, so every data generator yields the
+ * same value it would yield on its own.  evaluate() uses buffers held by
+ * the object, so one plan must not be evaluated by several threads at
+ * once.
+ */
+
+#ifndef SedEvaluationPlan_h
+#define SedEvaluationPlan_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sbml/math/ASTNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDataGenerator;
+class SedDocument;
+class SedVariable;
+
+
+class LIBSEDML_EXTERN SedEvaluationPlan
+{
+public:
+
+  /**
+   * Creates the plan of all data generators of a document.
+   *
+   * @param document the SedDocument.
+   */
+  SedEvaluationPlan(const SedDocument* document);
+
+
+  /**
+   * Creates the plan of the given data generators.
+   *
+   * @param dataGenerators the SedDataGenerator objects, in the order of
+   * their results.
+   */
+  SedEvaluationPlan(const std::vector<const SedDataGenerator*>& dataGenerators);
+
+
+  /**
+   * @return the number of data generators.
+   */
+  unsigned int getNumDataGenerators() const;
+
+
+  /**
+   * @return the nth data generator, or @c NULL if there is none.
+   */
+  const SedDataGenerator* getDataGenerator(unsigned int n) const;
+
+
+  /**
+   * @return @c true if the nth data generator is part of the plan, i.e. its
+   * math could be compiled.
+   */
+  bool isPlanned(unsigned int n) const;
+
+
+  /**
+   * @return the number of distinct variables, i.e. of input columns.
+   */
+  unsigned int getNumColumns() const;
+
+
+  /**
+   * @return the first variable that was interned as the nth column, or
+   * @c NULL if there is none; its task, model, target and symbol tell which
+   * data the column holds.
+   */
+  const SedVariable* getColumn(unsigned int n) const;
+
+
+  /**
+   * @return the column of a variable of one of the data generators, or
+   * @c -1 if the variable is not part of the plan.
+   */
+  int getColumnIndex(const SedVariable* variable) const;
+
+
+  /**
+   * @return the number of variables of all planned data generators, before
+   * they were interned.
+   */
+  unsigned int getNumVariables() const;
+
+
+  /**
+   * @return the number of distinct operations computed per sample.
+   */
+  unsigned int getNumOperations() const;
+
+
+  /**
+   * @return the number of operations the planned data generators would
+   * compute per sample if each were evaluated on its own.
+   */
+  unsigned int getNumUnsharedOperations() const;
+
+
+  /**
+   * Evaluates the data generators for a number of samples.
+   *
+   * @param columns an array of getNumColumns() arrays, each holding the
+   * values of one column for all samples.
+   * @param numSamples the number of samples.
+   * @param results an array of getNumDataGenerators() arrays, each
+   * receiving the values of one data generator for all samples; an entry
+   * may be @c NULL if that data generator is not needed.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a column is @c NULL
+   */
+  int evaluate(const double* const* columns, unsigned int numSamples,
+               double* const* results) const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Node
+  {
+    ASTNodeType_t type;     // AST_REAL: constant; AST_NAME: column
+    unsigned int numArgs;
+    unsigned int first;     // column, or first argument in mArguments
+    double value;
+  };
+
+  void build();
+
+  int addNode(const ASTNode* node,
+              const std::map<std::string, unsigned int>& columns,
+              const std::map<std::string, double>& parameters,
+              unsigned int& numOperations);
+
+  unsigned int intern(const std::string& key, const Node& node,
+                      const std::vector<unsigned int>& arguments);
+
+  std::vector<const SedDataGenerator*> mDataGenerators;
+  std::vector<int> mOutputs;
+
+  std::vector<const SedVariable*> mColumns;
+  std::map<std::string, unsigned int> mColumnIndex;
+  std::map<const SedVariable*, unsigned int> mVariableColumns;
+
+  std::vector<Node> mNodes;
+  std::vector<unsigned int> mArguments;
+  std::vector<unsigned int> mOperations;
+  std::map<std::string, unsigned int> mNodeIndex;
+
+  unsigned int mNumVariables;
+  unsigned int mNumUnsharedOperations;
+
+  mutable std::vector<double> mValues;
+  mutable std::vector<double> mArgumentValues;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedEvaluationPlan_h */
@@ -0,0 +1,176 @@
+/**
+ * @file   SedFragmentOutputStream.cpp
+ * @brief  XMLOutputStream reusing XML fragments cached on Sed objects
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedFragmentOutputStream.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+SedFragmentBuffer::SedFragmentBuffer()
+  : std::streambuf()
+  , mBuffer()
+{
+}
+
+
+const std::string&
+SedFragmentBuffer::str() const
+{
+  return mBuffer;
+}
+
+
+SedFragmentBuffer::int_type
+SedFragmentBuffer::overflow(int_type c)
+{
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      mBuffer.push_back(traits_type::to_char_type(c));
+    }
+
+  return traits_type::not_eof(c);
+}
+
+
+std::streamsize
+SedFragmentBuffer::xsputn(const char* s, std::streamsize n)
+{
+  mBuffer.append(s, static_cast<size_t>(n));
+  return n;
+}
+
+
+SedRawOutputStream::SedRawOutputStream(std::ostream& stream,
+    const std::string& encoding,
+    bool writeXMLDecl,
+    const std::string& programName,
+    const std::string& programVersion)
+  : XMLOutputStream(stream, encoding, writeXMLDecl, programName, programVersion)
+{
+}
+
+
+void
+SedRawOutputStream::closeStartElement()
+{
+  if (mInStart)
+    {
+      mInStart = false;
+      mStream << '>';
+      upIndent();
+    }
+}
+
+
+void
+SedRawOutputStream::writeRaw(const std::string& xml)
+{
+  closeStartElement();
+
+  if (mInText && mSkipNextIndentation)
+    {
+      mSkipNextIndentation = false;
+    }
+  else
+    {
+      writeIndent();
+    }
+
+  mStream.write(xml.data(), static_cast<std::streamsize>(xml.size()));
+}
+
+
+SedFragmentOutputStream::SedFragmentOutputStream(std::ostream& stream,
+    SedFragmentBuffer& buffer,
+    const std::string& encoding,
+    bool writeXMLDecl,
+    const std::string& programName,
+    const std::string& programVersion)
+  : SedRawOutputStream(stream, encoding, writeXMLDecl, programName,
+                       programVersion)
+  , mBuffer(buffer)
+{
+}
+
+
+bool
+SedFragmentOutputStream::canUseFragments() const
+{
+  return !mInText;
+}
+
+
+unsigned int
+SedFragmentOutputStream::getIndent() const
+{
+  return mIndent;
+}
+
+
+/*
+ * Does what XMLOutputStream::startElement would do before writing the
+ * indentation of the new element, so that the fragment starts with it.
+ */
+size_t
+SedFragmentOutputStream::beginFragment()
+{
+  closeStartElement();
+
+  mStream.flush();
+  return mBuffer.str().size();
+}
+
+
+void
+SedFragmentOutputStream::endFragment(size_t start, std::string& fragment) const
+{
+  mStream.flush();
+  fragment.assign(mBuffer.str(), start, std::string::npos);
+}
+
+
+void
+SedFragmentOutputStream::writeFragment(const std::string& fragment)
+{
+  mStream.write(fragment.data(), static_cast<std::streamsize>(fragment.size()));
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
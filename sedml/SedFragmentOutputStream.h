@@ -0,0 +1,204 @@
+/**
+ * @file   SedFragmentOutputStream.h
+ * @brief  XMLOutputStream reusing XML fragments cached on Sed objects
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedFragmentOutputStream
+ * @ingroup Core
+ * @brief XMLOutputStream used by SedWriter when fragment caching is enabled.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * All output is collected in a SedFragmentBuffer, so that SedBase::write()
+ * can remember the exact text produced for the items of the top-level
+ * lists (models, tasks, outputs, ...).  When such an item is written again
+ * and has not been modified in the meantime, its cached text is copied to
+ * the buffer instead of being serialized again.  The document and its
+ * lists are always serialized, and the objects inside an item are part of
+ * its text, so the cache holds at most one copy of the document.
+ *
+ * SedRawOutputStream, its base class, is the XMLOutputStream used by
+ * SedWriter otherwise; it can copy notes and annotations that were kept
+ * as text by SedReader::setLazyNotesAndAnnotations() to the output
+ * without parsing them.
+ */
+
+#ifndef SedFragmentOutputStream_h
+#define SedFragmentOutputStream_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sbml/xml/XMLOutputStream.h>
+
+
+#ifdef __cplusplus
+
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/**
+ * Unbuffered std::streambuf appending everything written to it to a
+ * std::string, so that the current output position is always known.
+ */
+class LIBSEDML_EXTERN SedFragmentBuffer : public std::streambuf
+{
+public:
+
+  SedFragmentBuffer();
+
+  /**
+   * @return the text written so far.
+   */
+  const std::string& str() const;
+
+protected:
+
+  virtual int_type overflow(int_type c);
+
+  virtual std::streamsize xsputn(const char* s, std::streamsize n);
+
+private:
+
+  std::string mBuffer;
+};
+
+
+class LIBSEDML_EXTERN SedRawOutputStream : public XMLOutputStream
+{
+public:
+
+  /**
+   * Creates a new SedRawOutputStream writing to @p stream.
+   */
+  SedRawOutputStream(std::ostream& stream,
+                     const std::string& encoding = "UTF-8",
+                     bool writeXMLDecl = true,
+                     const std::string& programName = "",
+                     const std::string& programVersion = "");
+
+
+  /**
+   * Writes the text of a complete element, e.g. a <notes> element kept
+   * unparsed by SedBase, as the next child of the current element.  The
+   * text is written as it is; only the indentation in front of it is
+   * added.
+   */
+  void writeRaw(const std::string& xml);
+
+
+protected:
+
+  /**
+   * Closes a pending start tag of the current element, as
+   * XMLOutputStream::startElement would do before writing a child.
+   */
+  void closeStartElement();
+};
+
+
+class LIBSEDML_EXTERN SedFragmentOutputStream : public SedRawOutputStream
+{
+public:
+
+  /**
+   * Creates a new SedFragmentOutputStream writing to @p stream, which has
+   * to be an std::ostream constructed on @p buffer.
+   */
+  SedFragmentOutputStream(std::ostream& stream,
+                          SedFragmentBuffer& buffer,
+                          const std::string& encoding = "UTF-8",
+                          bool writeXMLDecl = true,
+                          const std::string& programName = "",
+                          const std::string& programVersion = "");
+
+
+  /**
+   * The indentation level of the elements whose text is cached: the items
+   * of the lists of the <sedML> element.
+   */
+  static const unsigned int CACHED_INDENT = 2;
+
+
+  /**
+   * @return true if the next element can be written from (or into) the
+   * fragment cache, i.e. the stream is not in the middle of text content.
+   */
+  bool canUseFragments() const;
+
+
+  /**
+   * @return the current indentation level.
+   */
+  unsigned int getIndent() const;
+
+
+  /**
+   * Closes a pending start tag of the parent element and returns the
+   * position at which the next element will start.
+   */
+  size_t beginFragment();
+
+
+  /**
+   * Copies the text written since @p start into @p fragment.
+   */
+  void endFragment(size_t start, std::string& fragment) const;
+
+
+  /**
+   * Writes a previously cached fragment in place of the element that
+   * produced it.  Must be preceded by a call to beginFragment().
+   */
+  void writeFragment(const std::string& fragment);
+
+
+protected:
+
+  SedFragmentBuffer& mBuffer;
+};
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedFragmentOutputStream_h */
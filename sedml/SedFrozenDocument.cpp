@@ -0,0 +1,607 @@
+/**
+ * @file   SedFrozenDocument.cpp
+ * @brief  An immutable copy of a SedDocument for concurrent readers
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedFrozenDocument.h>
+#include <sedml/SedTypes.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include <sbml/math/L3FormulaFormatter.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of a frozen document while it is built.
+ */
+class SedFrozenStringPool
+{
+public:
+  SedFrozenStringPool(std::vector<char>& characters,
+                      std::vector<unsigned int>& strings)
+    : mCharacters(characters), mStrings(strings), mIndex()
+  {
+    intern("");
+  }
+
+  unsigned int intern(const std::string& value)
+  {
+    std::map<std::string, unsigned int>::const_iterator it =
+      mIndex.find(value);
+
+    if (it != mIndex.end()) return it->second;
+
+    unsigned int index = (unsigned int)mStrings.size();
+    mStrings.push_back((unsigned int)mCharacters.size());
+    mCharacters.insert(mCharacters.end(), value.begin(), value.end());
+    mCharacters.push_back('\0');
+    mIndex[value] = index;
+    return index;
+  }
+
+private:
+  std::vector<char>& mCharacters;
+  std::vector<unsigned int>& mStrings;
+  std::map<std::string, unsigned int> mIndex;
+};
+
+
+/*
+ * Orders objects by type code, keeping document order within a type.
+ */
+struct SedFrozenTypeOrder
+{
+  const std::vector<const SedBase*>* objects;
+
+  bool operator()(unsigned int a, unsigned int b) const
+  {
+    return (*objects)[a]->getTypeCode() < (*objects)[b]->getTypeCode();
+  }
+};
+
+
+/*
+ * Orders (id, element) pairs by id, then by the position of the element
+ * in the document.
+ */
+struct SedFrozenIdOrder
+{
+  const char* characters;
+  const unsigned int* strings;
+  const unsigned int* documentOrder;
+
+  bool operator()(const std::pair<unsigned int, unsigned int>& a,
+                  const std::pair<unsigned int, unsigned int>& b) const
+  {
+    int result = strcmp(characters + strings[a.first],
+                        characters + strings[b.first]);
+
+    if (result != 0) return result < 0;
+
+    return documentOrder[a.second] < documentOrder[b.second];
+  }
+};
+
+
+/*
+ * Appends an object and everything it contains in document order.
+ */
+static void
+collectObjects(const SedBase* object, unsigned int parent,
+               std::vector<const SedBase*>& objects,
+               std::vector<unsigned int>& parents)
+{
+  unsigned int index = (unsigned int)objects.size();
+  objects.push_back(object);
+  parents.push_back(parent);
+
+  std::vector<const SedBase*> children;
+  object->getChildObjects(children);
+
+  for (size_t i = 0; i < children.size(); ++i)
+    {
+      if (children[i] != NULL)
+        collectObjects(children[i], index, objects, parents);
+    }
+}
+
+
+static const ASTNode*
+getObjectMath(const SedBase* object)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_CHANGE_COMPUTECHANGE:
+      return static_cast<const SedComputeChange*>(object)->getMath();
+
+    case SEDML_DATAGENERATOR:
+      return static_cast<const SedDataGenerator*>(object)->getMath();
+
+    case SEDML_TASK_SETVALUE:
+      return static_cast<const SedSetValue*>(object)->getMath();
+
+    case SEDML_RANGE_FUNCTIONALRANGE:
+      return static_cast<const SedFunctionalRange*>(object)->getMath();
+
+    default:
+      return NULL;
+    }
+}
+
+
+static const XMLNode*
+getObjectNewXML(const SedBase* object)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_CHANGE_ADDXML:
+      return static_cast<const SedAddXML*>(object)->getNewXML();
+
+    case SEDML_CHANGE_CHANGEXML:
+      return static_cast<const SedChangeXML*>(object)->getNewXML();
+
+    default:
+      return NULL;
+    }
+}
+
+
+/*
+ * @return true if the named attribute holds the id of another element:
+ * the ...Reference attributes, the task of a sub-task, the range of a
+ * repeated task or set value and a source of the form #id.
+ */
+static bool
+isReference(const std::string& name, const std::string& value)
+{
+  static const std::string suffix = "Reference";
+
+  if (name.size() > suffix.size()
+      && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+    return true;
+
+  if (name == "task" || name == "range") return true;
+
+  return name == "source" && !value.empty() && value[0] == '#';
+}
+
+/** @endcond */
+
+
+const unsigned int SedFrozenDocument::npos = (unsigned int)-1;
+
+
+SedFrozenDocument::SedFrozenDocument(const SedDocument* document)
+  : mElements()
+  , mChildren()
+  , mAttributes()
+  , mValues()
+  , mCharacters()
+  , mStrings()
+  , mIds()
+  , mRoot(npos)
+{
+  SedFrozenStringPool pool(mCharacters, mStrings);
+
+  if (document == NULL) return;
+
+  std::vector<const SedBase*> objects;
+  std::vector<unsigned int> parents;
+  collectObjects(document, npos, objects, parents);
+
+  const unsigned int n = (unsigned int)objects.size();
+
+  // group the elements by type code
+  std::vector<unsigned int> order(n);
+
+  for (unsigned int i = 0; i < n; ++i) order[i] = i;
+
+  SedFrozenTypeOrder typeOrder;
+  typeOrder.objects = &objects;
+  std::stable_sort(order.begin(), order.end(), typeOrder);
+
+  std::vector<unsigned int> position(n);
+
+  for (unsigned int k = 0; k < n; ++k) position[order[k]] = k;
+
+  std::vector<std::vector<unsigned int> > children(n);
+
+  for (unsigned int i = 1; i < n; ++i) children[parents[i]].push_back(i);
+
+  mElements.resize(n);
+  std::vector<std::string> names;
+  std::string value;
+
+  for (unsigned int k = 0; k < n; ++k)
+    {
+      const unsigned int original = order[k];
+      const SedBase* object = objects[original];
+      Element& element = mElements[k];
+
+      element.typeCode = object->getTypeCode();
+      element.elementName = pool.intern(object->getElementName());
+      element.id = pool.intern(object->getId());
+      element.parent = parents[original] == npos ? npos
+                       : position[parents[original]];
+
+      element.firstChild = (unsigned int)mChildren.size();
+      element.numChildren = (unsigned int)children[original].size();
+
+      for (unsigned int c = 0; c < element.numChildren; ++c)
+        mChildren.push_back(position[children[original][c]]);
+
+      element.firstAttribute = (unsigned int)mAttributes.size();
+      names.clear();
+      object->getAttributeNames(names);
+
+      for (size_t a = 0; a < names.size(); ++a)
+        {
+          if (!object->isSetAttribute(names[a])
+              || object->getAttribute(names[a], value) != LIBSEDML_OPERATION_SUCCESS)
+            continue;
+
+          Attribute attribute;
+          attribute.name = pool.intern(names[a]);
+          attribute.value = pool.intern(value);
+          attribute.reference = isReference(names[a], value) ? 0 : npos;
+          mAttributes.push_back(attribute);
+        }
+
+      element.numAttributes =
+        (unsigned int)mAttributes.size() - element.firstAttribute;
+
+      element.math = 0;
+      const ASTNode* math = getObjectMath(object);
+
+      if (math != NULL)
+        {
+          char* formula = SBML_formulaToL3String(math);
+
+          if (formula != NULL)
+            {
+              element.math = pool.intern(formula);
+              free(formula);
+            }
+        }
+
+      const XMLNode* xml = getObjectNewXML(object);
+      element.newXML = xml != NULL ? pool.intern(xml->toXMLString()) : 0;
+      element.notes = object->isSetNotes()
+                      ? pool.intern(object->getNotes()->toXMLString()) : 0;
+      element.annotation = object->isSetAnnotation()
+                           ? pool.intern(object->getAnnotation()->toXMLString()) : 0;
+
+      element.firstValue = (unsigned int)mValues.size();
+      element.numValues = 0;
+
+      if (element.typeCode == SEDML_RANGE_VECTORRANGE)
+        {
+          const std::vector<double>& values =
+            static_cast<const SedVectorRange*>(object)->getValues();
+          mValues.insert(mValues.end(), values.begin(), values.end());
+          element.numValues = (unsigned int)values.size();
+        }
+
+      if (element.id != 0) mIds.push_back(make_pair(element.id, k));
+    }
+
+  mRoot = position[0];
+
+  SedFrozenIdOrder idOrder;
+  idOrder.characters = &mCharacters[0];
+  idOrder.strings = &mStrings[0];
+  idOrder.documentOrder = &order[0];
+  std::sort(mIds.begin(), mIds.end(), idOrder);
+
+  // resolve the references now that all ids are known
+  for (size_t a = 0; a < mAttributes.size(); ++a)
+    {
+      Attribute& attribute = mAttributes[a];
+
+      if (attribute.reference == npos) continue;
+
+      const char* target = getString(attribute.value);
+
+      if (target[0] == '#' && strcmp(getString(attribute.name), "source") == 0)
+        ++target;
+
+      attribute.reference = getElementBySId(target);
+    }
+}
+
+
+unsigned int
+SedFrozenDocument::getNumElements() const
+{
+  return (unsigned int)mElements.size();
+}
+
+
+unsigned int
+SedFrozenDocument::getRoot() const
+{
+  return mRoot;
+}
+
+
+unsigned int
+SedFrozenDocument::getNumElementsOfType(int typeCode) const
+{
+  unsigned int first = findFirstOfType(typeCode);
+  unsigned int last = findFirstOfType(typeCode + 1);
+  return last - first;
+}
+
+
+unsigned int
+SedFrozenDocument::getElementOfType(int typeCode, unsigned int n) const
+{
+  if (n >= getNumElementsOfType(typeCode)) return npos;
+
+  return findFirstOfType(typeCode) + n;
+}
+
+
+unsigned int
+SedFrozenDocument::getElementBySId(const std::string& id) const
+{
+  if (id.empty()) return npos;
+
+  // binary search for the first entry not less than the id
+  size_t low = 0;
+  size_t high = mIds.size();
+
+  while (low < high)
+    {
+      size_t middle = low + (high - low) / 2;
+
+      if (strcmp(getString(mIds[middle].first), id.c_str()) < 0)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+
+  if (low < mIds.size() && id == getString(mIds[low].first))
+    return mIds[low].second;
+
+  return npos;
+}
+
+
+int
+SedFrozenDocument::getTypeCode(unsigned int element) const
+{
+  return element < mElements.size() ? mElements[element].typeCode
+         : (int)SEDML_UNKNOWN;
+}
+
+
+const char*
+SedFrozenDocument::getElementName(unsigned int element) const
+{
+  return getString(element < mElements.size()
+                   ? mElements[element].elementName : 0);
+}
+
+
+const char*
+SedFrozenDocument::getId(unsigned int element) const
+{
+  return getString(element < mElements.size() ? mElements[element].id : 0);
+}
+
+
+unsigned int
+SedFrozenDocument::getParent(unsigned int element) const
+{
+  return element < mElements.size() ? mElements[element].parent : npos;
+}
+
+
+unsigned int
+SedFrozenDocument::getNumChildren(unsigned int element) const
+{
+  return element < mElements.size() ? mElements[element].numChildren : 0;
+}
+
+
+unsigned int
+SedFrozenDocument::getChild(unsigned int element, unsigned int n) const
+{
+  if (n >= getNumChildren(element)) return npos;
+
+  return mChildren[mElements[element].firstChild + n];
+}
+
+
+unsigned int
+SedFrozenDocument::getNumAttributes(unsigned int element) const
+{
+  return element < mElements.size() ? mElements[element].numAttributes : 0;
+}
+
+
+const char*
+SedFrozenDocument::getAttributeName(unsigned int element, unsigned int n) const
+{
+  if (n >= getNumAttributes(element)) return getString(0);
+
+  return getString(mAttributes[mElements[element].firstAttribute + n].name);
+}
+
+
+const char*
+SedFrozenDocument::getAttributeValue(unsigned int element, unsigned int n) const
+{
+  if (n >= getNumAttributes(element)) return getString(0);
+
+  return getString(mAttributes[mElements[element].firstAttribute + n].value);
+}
+
+
+const char*
+SedFrozenDocument::getAttribute(unsigned int element,
+                                const std::string& name) const
+{
+  for (unsigned int n = 0; n < getNumAttributes(element); ++n)
+    {
+      const Attribute& attribute =
+        mAttributes[mElements[element].firstAttribute + n];
+
+      if (name == getString(attribute.name)) return getString(attribute.value);
+    }
+
+  return NULL;
+}
+
+
+unsigned int
+SedFrozenDocument::getReference(unsigned int element,
+                                const std::string& name) const
+{
+  for (unsigned int n = 0; n < getNumAttributes(element); ++n)
+    {
+      const Attribute& attribute =
+        mAttributes[mElements[element].firstAttribute + n];
+
+      if (name == getString(attribute.name)) return attribute.reference;
+    }
+
+  return npos;
+}
+
+
+const char*
+SedFrozenDocument::getMath(unsigned int element) const
+{
+  return getString(element < mElements.size() ? mElements[element].math : 0);
+}
+
+
+const char*
+SedFrozenDocument::getNewXML(unsigned int element) const
+{
+  return getString(element < mElements.size() ? mElements[element].newXML : 0);
+}
+
+
+const char*
+SedFrozenDocument::getNotes(unsigned int element) const
+{
+  return getString(element < mElements.size() ? mElements[element].notes : 0);
+}
+
+
+const char*
+SedFrozenDocument::getAnnotation(unsigned int element) const
+{
+  return getString(element < mElements.size()
+                   ? mElements[element].annotation : 0);
+}
+
+
+unsigned int
+SedFrozenDocument::getNumValues(unsigned int element) const
+{
+  return element < mElements.size() ? mElements[element].numValues : 0;
+}
+
+
+const double*
+SedFrozenDocument::getValues(unsigned int element) const
+{
+  if (getNumValues(element) == 0) return NULL;
+
+  return &mValues[mElements[element].firstValue];
+}
+
+
+unsigned int
+SedFrozenDocument::getNumStrings() const
+{
+  return (unsigned int)mStrings.size();
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+const char*
+SedFrozenDocument::getString(unsigned int index) const
+{
+  return &mCharacters[mStrings[index]];
+}
+
+
+/*
+ * Returns the first element whose type code is not less than the given
+ * one; elements are sorted by type code.
+ */
+unsigned int
+SedFrozenDocument::findFirstOfType(int typeCode) const
+{
+  size_t low = 0;
+  size_t high = mElements.size();
+
+  while (low < high)
+    {
+      size_t middle = low + (high - low) / 2;
+
+      if (mElements[middle].typeCode < typeCode)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+
+  return (unsigned int)low;
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
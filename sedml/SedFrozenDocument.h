@@ -0,0 +1,304 @@
+/**
+ * @file   SedFrozenDocument.h
+ * @brief  An immutable copy of a SedDocument for concurrent readers
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedFrozenDocument
+ * @ingroup Core
+ * @brief An immutable, compact copy of a SedDocument that many threads
+ * can read at the same time.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * Objects of a SedDocument are not safe to share between threads: they
+ * hold user data, set parent pointers lazily and look up ids through
+ * non-const methods.  SedDocument::freeze() copies a document into a
+ * SedFrozenDocument, which is never modified after it is created and has
+ * no mutable or lazily computed state, so any number of threads can
+ * traverse it and look up ids without locks.
+ *
+ * Every object of the document (including the lists) becomes an element
+ * identified by an index.  Elements are stored in one array, grouped by
+ * type code and in document order within a type, so that all elements
+ * of a type are contiguous.  Strings are interned in one pool; attribute
+ * values that reference another element by id (the <code>...Reference</code>
+ * attributes, <code>task</code>, <code>range</code> and <code>#id</code>
+ * sources) are resolved to its index.
+ * Math is kept as an infix formula, XML content, notes and annotations as
+ * XML text and the values of vector ranges as numbers.
+ *
+ * The frozen copy does not change when the document does; freeze the
+ * document again to see the changes.
+ */
+
+#ifndef SedFrozenDocument_h
+#define SedFrozenDocument_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedFrozenDocument
+{
+public:
+
+  /**
+   * The index returned when there is no such element.
+   */
+  static const unsigned int npos;
+
+
+  /**
+   * Creates a frozen copy of a document.
+   *
+   * @param document the SedDocument.
+   *
+   * @see SedDocument::freeze()
+   */
+  SedFrozenDocument(const SedDocument* document);
+
+
+  /**
+   * @return the number of elements.
+   */
+  unsigned int getNumElements() const;
+
+
+  /**
+   * @return the index of the element for the document itself, or @c npos
+   * if the copy was made of @c NULL.
+   */
+  unsigned int getRoot() const;
+
+
+  /**
+   * @return the number of elements with the given type code.
+   */
+  unsigned int getNumElementsOfType(int typeCode) const;
+
+
+  /**
+   * @return the nth element with the given type code in document order, or
+   * @c npos if there is none.
+   */
+  unsigned int getElementOfType(int typeCode, unsigned int n) const;
+
+
+  /**
+   * @return the element with the given id, or @c npos if there is none.
+   * If several elements share the id, the first in document order is
+   * returned.
+   */
+  unsigned int getElementBySId(const std::string& id) const;
+
+
+  /**
+   * @return the type code of an element, or @c SEDML_UNKNOWN.
+   */
+  int getTypeCode(unsigned int element) const;
+
+
+  /**
+   * @return the XML name of an element.
+   */
+  const char* getElementName(unsigned int element) const;
+
+
+  /**
+   * @return the id of an element, or an empty string.
+   */
+  const char* getId(unsigned int element) const;
+
+
+  /**
+   * @return the element containing an element, or @c npos for the root.
+   */
+  unsigned int getParent(unsigned int element) const;
+
+
+  /**
+   * @return the number of elements directly contained in an element.
+   */
+  unsigned int getNumChildren(unsigned int element) const;
+
+
+  /**
+   * @return the nth element directly contained in an element, in document
+   * order, or @c npos if there is none.
+   */
+  unsigned int getChild(unsigned int element, unsigned int n) const;
+
+
+  /**
+   * @return the number of attributes set on an element.
+   */
+  unsigned int getNumAttributes(unsigned int element) const;
+
+
+  /**
+   * @return the name of the nth attribute of an element.
+   */
+  const char* getAttributeName(unsigned int element, unsigned int n) const;
+
+
+  /**
+   * @return the value of the nth attribute of an element.
+   */
+  const char* getAttributeValue(unsigned int element, unsigned int n) const;
+
+
+  /**
+   * @return the value of the named attribute of an element, or @c NULL if
+   * it is not set.
+   */
+  const char* getAttribute(unsigned int element, const std::string& name) const;
+
+
+  /**
+   * @return the element referenced by the named attribute of an element,
+   * or @c npos if the attribute is not a reference or names no element.
+   */
+  unsigned int getReference(unsigned int element, const std::string& name) const;
+
+
+  /**
+   * @return the math of an element as an infix formula, or an empty
+   * string.
+   */
+  const char* getMath(unsigned int element) const;
+
+
+  /**
+   * @return the new XML of a SedAddXML or SedChangeXML as text, or an
+   * empty string.
+   */
+  const char* getNewXML(unsigned int element) const;
+
+
+  /**
+   * @return the notes of an element as XML text, or an empty string.
+   */
+  const char* getNotes(unsigned int element) const;
+
+
+  /**
+   * @return the annotation of an element as XML text, or an empty string.
+   */
+  const char* getAnnotation(unsigned int element) const;
+
+
+  /**
+   * @return the number of values of a SedVectorRange.
+   */
+  unsigned int getNumValues(unsigned int element) const;
+
+
+  /**
+   * @return the values of a SedVectorRange, or @c NULL.
+   */
+  const double* getValues(unsigned int element) const;
+
+
+  /**
+   * @return the number of distinct strings in the pool.
+   */
+  unsigned int getNumStrings() const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Element
+  {
+    int typeCode;
+    unsigned int elementName;
+    unsigned int id;
+    unsigned int parent;
+    unsigned int firstChild;
+    unsigned int numChildren;
+    unsigned int firstAttribute;
+    unsigned int numAttributes;
+    unsigned int math;
+    unsigned int newXML;
+    unsigned int notes;
+    unsigned int annotation;
+    unsigned int firstValue;
+    unsigned int numValues;
+  };
+
+  struct Attribute
+  {
+    unsigned int name;
+    unsigned int value;
+    unsigned int reference;
+  };
+
+  const char* getString(unsigned int index) const;
+
+  unsigned int findFirstOfType(int typeCode) const;
+
+  std::vector<Element> mElements;
+  std::vector<unsigned int> mChildren;
+  std::vector<Attribute> mAttributes;
+  std::vector<double> mValues;
+
+  std::vector<char> mCharacters;
+  std::vector<unsigned int> mStrings;
+
+  // (id, element), sorted by id
+  std::vector<std::pair<unsigned int, unsigned int> > mIds;
+
+  unsigned int mRoot;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedFrozenDocument_h */
@@ -187,13 +187,15 @@ SedFunctionalRange::isSetMath() const
 int
 SedFunctionalRange::setRange(const std::string& range)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(range)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mRange = range;
+      mRange = internString(range);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -205,6 +207,8 @@ SedFunctionalRange::setRange(const std::string& range)
 int
 SedFunctionalRange::setMath(ASTNode* math)
 {
+  markDirty();
+
   if (mMath == math)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -240,6 +244,8 @@ SedFunctionalRange::setMath(ASTNode* math)
 int
 SedFunctionalRange::unsetRange()
 {
+  markDirty();
+
   mRange.erase();
 
   if (mRange.empty() == true)
@@ -259,6 +265,8 @@ SedFunctionalRange::unsetRange()
 int
 SedFunctionalRange::unsetMath()
 {
+  markDirty();
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -594,6 +602,96 @@ SedFunctionalRange::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedFunctionalRange to the vector.
+ */
+void
+SedFunctionalRange::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedRange::getAttributeNames(names);
+
+  names.push_back("range");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedFunctionalRange::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "range")
+    {
+      return isSetRange();
+    }
+
+  return SedRange::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedFunctionalRange::getAttribute(const std::string& attributeName,
+                                 std::string& value) const
+{
+  if (attributeName == "range")
+    {
+      if (isSetRange() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mRange;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedRange::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedFunctionalRange::setAttribute(const std::string& attributeName,
+                                 const std::string& value)
+{
+  if (attributeName == "range")
+    {
+      return setRange(value);
+    }
+
+  return SedRange::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedFunctionalRange::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "range")
+    {
+      return unsetRange();
+    }
+
+  return SedRange::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedFunctionalRange::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedRange::getChildObjects(children);
+
+  children.push_back(&mVariables);
+  children.push_back(&mParameters);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -632,8 +730,48 @@ SedFunctionalRange::writeElements(XMLOutputStream& stream) const
 bool
 SedFunctionalRange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedFunctionalRange::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedRange::addMemoryFootprint(footprint);
+
+  footprint.addString(mRange);
+  footprint.addMath(mMath);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedFunctionalRange::internStrings()
+{
+  SedRange::internStrings();
 
+  reinternString(mRange);
 }
 
 
@@ -690,7 +828,7 @@ SedFunctionalRange::readAttributes(const XMLAttributes& attributes,
   //
   // range SIdRef   ( use = "required" )
   //
-  assigned = attributes.readInto("range", mRange, getErrorLog(), true);
+  assigned = readInto(attributes, "range", mRange, true);
 
   if (assigned == true)
     {
@@ -912,6 +1050,8 @@ SedListOfFunctionalRanges::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedFunctionalRange*>(item);
@@ -949,15 +1089,12 @@ SedListOfFunctionalRanges::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedFunctionalRange in this SedListOfFunctionalRanges
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfFunctionalRanges::createObject(XMLInputStream& stream)
+SedListOfFunctionalRanges::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "functionalRange")
@@ -970,6 +1107,18 @@ SedListOfFunctionalRanges::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedFunctionalRange in this SedListOfFunctionalRanges
+ */
+SedBase*
+SedListOfFunctionalRanges::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
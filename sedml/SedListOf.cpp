@@ -136,7 +136,9 @@ SedListOf::accept(SedVisitor& v) const
 {
   v.visit(*this, getItemTypeCode());
 
-  for (unsigned int n = 0 ; n < mItems.size() && mItems[n]->accept(v); ++n) ;
+  // an item whose children are skipped does not end the list
+  for (unsigned int n = 0 ; n < mItems.size(); ++n)
+    mItems[n]->accept(v);
 
   v.leave(*this, getItemTypeCode());
 
@@ -144,6 +146,23 @@ SedListOf::accept(SedVisitor& v) const
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedListOf::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addList(mItems.capacity());
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /*
  * @return a (deep) copy of this SedListOf items.
  */
@@ -177,6 +196,8 @@ SedListOf::isValidTypeForList(SedBase * item) const
 int
 SedListOf::insertAndOwn(int location, SedBase* item)
 {
+  markDirty();
+
   /* no list elements yet */
   if (this->getItemTypeCode() == SEDML_UNKNOWN)
     {
@@ -214,6 +235,8 @@ SedListOf::append(const SedBase* item)
 int
 SedListOf::appendAndOwn(SedBase* item)
 {
+  markDirty();
+
   /* no list elements yet */
   if (this->getItemTypeCode() == SEDML_UNKNOWN)
     {
@@ -385,8 +408,13 @@ SedListOf::getAllElements()
 void
 SedListOf::clear(bool doDelete)
 {
+  markDirty();
+
   if (doDelete)
     for_each(mItems.begin(), mItems.end(), Delete());
+  else
+    for (unsigned int i = 0; i < mItems.size(); ++i)
+      mItems[i]->connectToParent(NULL);
 
   mItems.clear();
 }
@@ -412,7 +440,12 @@ SedListOf::remove(unsigned int n)
 {
   SedBase* item = get(n);
 
-  if (item != NULL) mItems.erase(mItems.begin() + n);
+  if (item != NULL)
+    {
+      mItems.erase(mItems.begin() + n);
+      item->connectToParent(NULL);
+      markDirty();
+    }
 
   return item;
 }
@@ -535,6 +568,16 @@ SedListOf::getElementName() const
 }
 
 
+/*
+ * Adds the items of this SedListOf to the vector.
+ */
+void
+SedListOf::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  children.insert(children.end(), mItems.begin(), mItems.end());
+}
+
+
 /**
  * Used by SedListOf::writeElements().
  */
@@ -168,6 +168,17 @@ public:
   virtual bool accept(SedVisitor& v) const;
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Charges the memory this object owns to the footprint.
+   */
+  virtual void addMemoryFootprint(SedMemoryFootprint& footprint) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /**
    * Creates and returns a deep copy of this SedListOf.
    *
@@ -495,6 +506,14 @@ public:
   virtual const std::string& getElementName() const;
 
 
+  /**
+   * Adds the items of this SedListOf to @p children, in order.
+   *
+   * @param children the vector to which the items are appended.
+   */
+  virtual void getChildObjects(std::vector<const SedBase*>& children) const;
+
+
   /** @cond doxygen-libsbml-internal */
   /**
    * Subclasses should override this method to write out their contained
@@ -0,0 +1,488 @@
+/**
+ * @file   SedMemoryFootprint.cpp
+ * @brief  Memory used by Sed objects, per type code
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedMemoryFootprint.h>
+#include <sedml/SedTypes.h>
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include <sbml/math/ASTNode.h>
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLTriple.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The size of the most derived class of an object.
+ */
+static size_t
+getObjectSize(const SedBase* object)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_DOCUMENT:                      return sizeof(SedDocument);
+    case SEDML_MODEL:                         return sizeof(SedModel);
+    case SEDML_CHANGE_ATTRIBUTE:              return sizeof(SedChangeAttribute);
+    case SEDML_CHANGE_REMOVEXML:              return sizeof(SedRemoveXML);
+    case SEDML_CHANGE_COMPUTECHANGE:          return sizeof(SedComputeChange);
+    case SEDML_CHANGE_ADDXML:                 return sizeof(SedAddXML);
+    case SEDML_CHANGE_CHANGEXML:              return sizeof(SedChangeXML);
+    case SEDML_DATAGENERATOR:                 return sizeof(SedDataGenerator);
+    case SEDML_VARIABLE:                      return sizeof(SedVariable);
+    case SEDML_PARAMETER:                     return sizeof(SedParameter);
+    case SEDML_TASK:                          return sizeof(SedTask);
+    case SEDML_TASK_SUBTASK:                  return sizeof(SedSubTask);
+    case SEDML_TASK_SETVALUE:                 return sizeof(SedSetValue);
+    case SEDML_TASK_REPEATEDTASK:             return sizeof(SedRepeatedTask);
+    case SEDML_OUTPUT_DATASET:                return sizeof(SedDataSet);
+    case SEDML_OUTPUT_CURVE:                  return sizeof(SedCurve);
+    case SEDML_OUTPUT_SURFACE:                return sizeof(SedSurface);
+    case SEDML_OUTPUT_REPORT:                 return sizeof(SedReport);
+    case SEDML_OUTPUT_PLOT2D:                 return sizeof(SedPlot2D);
+    case SEDML_OUTPUT_PLOT3D:                 return sizeof(SedPlot3D);
+    case SEDML_SIMULATION_ALGORITHM:          return sizeof(SedAlgorithm);
+    case SEDML_SIMULATION_UNIFORMTIMECOURSE:  return sizeof(SedUniformTimeCourse);
+    case SEDML_SIMULATION_ALGORITHM_PARAMETER:return sizeof(SedAlgorithmParameter);
+    case SEDML_SIMULATION_ONESTEP:            return sizeof(SedOneStep);
+    case SEDML_SIMULATION_STEADYSTATE:        return sizeof(SedSteadyState);
+    case SEDML_RANGE_UNIFORMRANGE:            return sizeof(SedUniformRange);
+    case SEDML_RANGE_VECTORRANGE:             return sizeof(SedVectorRange);
+    case SEDML_RANGE_FUNCTIONALRANGE:         return sizeof(SedFunctionalRange);
+    case SEDML_DATA_DESCRIPTION:              return sizeof(SedDataDescription);
+    case SEDML_DATA_SOURCE:                   return sizeof(SedDataSource);
+    case SEDML_DATA_SLICE:                    return sizeof(SedSlice);
+    case SEDML_LIST_OF:                       return sizeof(SedListOf);
+    default:                                  return sizeof(SedBase);
+    }
+}
+
+
+/*
+ * The bytes of a node of a balanced tree or list holding the given value.
+ */
+static size_t
+getNodeBytes(size_t value)
+{
+  return value + 4 * sizeof(void*);
+}
+
+/** @endcond */
+
+
+SedMemoryFootprint::SedMemoryFootprint()
+  : mTypes()
+  , mSeen()
+  , mCurrent(NULL)
+  , mObjectBytes(0)
+  , mStringBytes(0)
+  , mSharedStringBytes(0)
+  , mNamespaceBytes(0)
+  , mMathBytes(0)
+  , mXMLBytes(0)
+  , mValueBytes(0)
+  , mListBytes(0)
+  , mOtherBytes(0)
+{
+}
+
+
+void
+SedMemoryFootprint::add(const SedBase* object)
+{
+  if (object == NULL) return;
+
+  // objects with the parent they are held in, if it is counted
+  vector<pair<const SedBase*, const SedBase*> > stack;
+  stack.push_back(make_pair(object, (const SedBase*)NULL));
+
+  while (!stack.empty())
+    {
+      const SedBase* current = stack.back().first;
+      const SedBase* parent = stack.back().second;
+      stack.pop_back();
+
+      if (!mSeen.insert(current).second) continue;
+
+      mCurrent = &mTypes[current->getTypeCode()];
+      ++mCurrent->numObjects;
+
+      // members such as lists are part of the size of their parent
+      const char* address = reinterpret_cast<const char*>(current);
+      const char* start = reinterpret_cast<const char*>(parent);
+      bool embedded = parent != NULL && address >= start
+                      && address < start + getObjectSize(parent);
+
+      if (!embedded) charge(mObjectBytes, getObjectSize(current));
+
+      current->addMemoryFootprint(*this);
+
+      vector<const SedBase*> children;
+      current->getChildObjects(children);
+
+      for (size_t n = children.size(); n > 0; --n)
+        stack.push_back(make_pair(children[n - 1], current));
+    }
+
+  mCurrent = NULL;
+}
+
+
+size_t
+SedMemoryFootprint::getTotalBytes() const
+{
+  return mObjectBytes + mStringBytes + mSharedStringBytes + mNamespaceBytes
+         + mMathBytes + mXMLBytes + mValueBytes + mListBytes + mOtherBytes;
+}
+
+
+unsigned int
+SedMemoryFootprint::getNumObjects() const
+{
+  unsigned int numObjects = 0;
+
+  for (map<int, Entry>::const_iterator it = mTypes.begin();
+       it != mTypes.end(); ++it)
+    numObjects += it->second.numObjects;
+
+  return numObjects;
+}
+
+
+unsigned int
+SedMemoryFootprint::getNumTypeCodes() const
+{
+  return (unsigned int)mTypes.size();
+}
+
+
+int
+SedMemoryFootprint::getTypeCode(unsigned int n) const
+{
+  if (n >= mTypes.size()) return SEDML_UNKNOWN;
+
+  map<int, Entry>::const_iterator it = mTypes.begin();
+  advance(it, n);
+  return it->first;
+}
+
+
+unsigned int
+SedMemoryFootprint::getNumObjects(int typeCode) const
+{
+  map<int, Entry>::const_iterator it = mTypes.find(typeCode);
+  return it != mTypes.end() ? it->second.numObjects : 0;
+}
+
+
+size_t
+SedMemoryFootprint::getBytes(int typeCode) const
+{
+  map<int, Entry>::const_iterator it = mTypes.find(typeCode);
+  return it != mTypes.end() ? it->second.bytes : 0;
+}
+
+
+size_t
+SedMemoryFootprint::getObjectBytes() const
+{
+  return mObjectBytes;
+}
+
+
+size_t
+SedMemoryFootprint::getStringBytes() const
+{
+  return mStringBytes;
+}
+
+
+size_t
+SedMemoryFootprint::getSharedStringBytes() const
+{
+  return mSharedStringBytes;
+}
+
+
+size_t
+SedMemoryFootprint::getNamespaceBytes() const
+{
+  return mNamespaceBytes;
+}
+
+
+size_t
+SedMemoryFootprint::getMathBytes() const
+{
+  return mMathBytes;
+}
+
+
+size_t
+SedMemoryFootprint::getXMLBytes() const
+{
+  return mXMLBytes;
+}
+
+
+size_t
+SedMemoryFootprint::getValueBytes() const
+{
+  return mValueBytes;
+}
+
+
+size_t
+SedMemoryFootprint::getListBytes() const
+{
+  return mListBytes;
+}
+
+
+size_t
+SedMemoryFootprint::getOtherBytes() const
+{
+  return mOtherBytes;
+}
+
+
+std::string
+SedMemoryFootprint::toString() const
+{
+  ostringstream text;
+
+  text << left << setw(24) << "type" << right << setw(10) << "objects"
+       << setw(14) << "bytes" << "\n";
+
+  for (map<int, Entry>::const_iterator it = mTypes.begin();
+       it != mTypes.end(); ++it)
+    {
+      text << left << setw(24) << SedTypeCode_toString(it->first)
+           << right << setw(10) << it->second.numObjects
+           << setw(14) << it->second.bytes << "\n";
+    }
+
+  text << "\n" << left
+       << setw(24) << "objects" << right << setw(24) << mObjectBytes << "\n" << left
+       << setw(24) << "strings" << right << setw(24) << mStringBytes << "\n" << left
+       << setw(24) << "shared strings" << right << setw(24) << mSharedStringBytes << "\n" << left
+       << setw(24) << "namespaces" << right << setw(24) << mNamespaceBytes << "\n" << left
+       << setw(24) << "math" << right << setw(24) << mMathBytes << "\n" << left
+       << setw(24) << "xml" << right << setw(24) << mXMLBytes << "\n" << left
+       << setw(24) << "values" << right << setw(24) << mValueBytes << "\n" << left
+       << setw(24) << "lists" << right << setw(24) << mListBytes << "\n" << left
+       << setw(24) << "other" << right << setw(24) << mOtherBytes << "\n" << left
+       << setw(24) << "total" << right << setw(24) << getTotalBytes() << "\n";
+
+  return text.str();
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+void
+SedMemoryFootprint::charge(size_t& category, size_t bytes)
+{
+  category += bytes;
+  if (mCurrent != NULL) mCurrent->bytes += bytes;
+}
+
+
+size_t
+SedMemoryFootprint::getHeapBytes(const std::string& value)
+{
+  const char* data = value.data();
+  const char* start = reinterpret_cast<const char*>(&value);
+
+  // short strings are stored inside the string object
+  if (value.capacity() == 0 || (data >= start && data < start + sizeof(value)))
+    return 0;
+
+  return value.capacity() + 1;
+}
+
+
+void
+SedMemoryFootprint::addString(const std::string& value)
+{
+  charge(mStringBytes, getHeapBytes(value));
+}
+
+
+void
+SedMemoryFootprint::addString(const SedString& value)
+{
+  const SedString::Rep* rep = value.mRep;
+  if (rep == NULL || !mSeen.insert(rep).second) return;
+
+  size_t bytes = sizeof(SedString::Rep) + getHeapBytes(rep->value);
+
+  if (rep->pool != NULL)
+    {
+      // shared by the document; its entry in the pool is counted as well
+      mSharedStringBytes += getNodeBytes(sizeof(const std::string*)
+                                         + sizeof(SedString::Rep*)) + bytes;
+    }
+  else
+    {
+      charge(mStringBytes, bytes);
+    }
+}
+
+
+void
+SedMemoryFootprint::addNamespaces(const SedNamespaces* namespaces)
+{
+  if (namespaces == NULL || !mSeen.insert(namespaces).second) return;
+
+  size_t bytes = sizeof(SedNamespaces);
+  const XMLNamespaces* xmlns =
+    const_cast<SedNamespaces*>(namespaces)->getNamespaces();
+
+  if (xmlns != NULL)
+    {
+      bytes += sizeof(XMLNamespaces);
+
+      for (int n = 0; n < xmlns->getNumNamespaces(); ++n)
+        {
+          bytes += sizeof(pair<string, string>);
+          bytes += xmlns->getURI(n).size() + xmlns->getPrefix(n).size();
+        }
+    }
+
+  charge(mNamespaceBytes, bytes);
+}
+
+
+size_t
+SedMemoryFootprint::getMathNodeBytes(const ASTNode* math) const
+{
+  // the node, the list of its children and its name
+  size_t bytes = sizeof(ASTNode) + getNodeBytes(0);
+
+  if ((math->isName() || math->isFunction()) && math->getName() != NULL)
+    bytes += strlen(math->getName()) + 1;
+
+  for (unsigned int n = 0; n < math->getNumChildren(); ++n)
+    bytes += getNodeBytes(sizeof(void*)) + getMathNodeBytes(math->getChild(n));
+
+  return bytes;
+}
+
+
+void
+SedMemoryFootprint::addMath(const ASTNode* math)
+{
+  if (math == NULL || !mSeen.insert(math).second) return;
+
+  charge(mMathBytes, getMathNodeBytes(math));
+}
+
+
+size_t
+SedMemoryFootprint::getXMLNodeBytes(const XMLNode* xml) const
+{
+  size_t bytes = getHeapBytes(xml->getName()) + getHeapBytes(xml->getURI())
+                 + getHeapBytes(xml->getPrefix())
+                 + getHeapBytes(xml->getCharacters());
+
+  for (int n = 0; n < xml->getAttributesLength(); ++n)
+    {
+      bytes += sizeof(XMLTriple) + sizeof(string)
+               + xml->getAttrName(n).size() + xml->getAttrURI(n).size()
+               + xml->getAttrPrefix(n).size() + xml->getAttrValue(n).size();
+    }
+
+  for (int n = 0; n < xml->getNamespacesLength(); ++n)
+    {
+      bytes += sizeof(pair<string, string>)
+               + xml->getNamespaceURI(n).size()
+               + xml->getNamespacePrefix(n).size();
+    }
+
+  // children are held by value
+  for (unsigned int n = 0; n < xml->getNumChildren(); ++n)
+    bytes += sizeof(XMLNode) + getXMLNodeBytes(&xml->getChild(n));
+
+  return bytes;
+}
+
+
+void
+SedMemoryFootprint::addXML(const XMLNode* xml)
+{
+  if (xml == NULL || !mSeen.insert(xml).second) return;
+
+  charge(mXMLBytes, sizeof(XMLNode) + getXMLNodeBytes(xml));
+}
+
+
+void
+SedMemoryFootprint::addValues(const std::vector<double>& values)
+{
+  charge(mValueBytes, values.capacity() * sizeof(double));
+}
+
+
+void
+SedMemoryFootprint::addList(size_t capacity)
+{
+  charge(mListBytes, capacity * sizeof(void*));
+}
+
+
+void
+SedMemoryFootprint::addOther(size_t bytes)
+{
+  charge(mOtherBytes, bytes);
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,272 @@
+/**
+ * @file   SedMemoryFootprint.h
+ * @brief  Memory used by Sed objects, per type code
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedMemoryFootprint
+ * @ingroup Core
+ * @brief Estimates the memory used by Sed objects, per type code.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * SedBase::getMemoryFootprint() returns the footprint of an object and
+ * everything below it.  Each object is charged with its own size and with
+ * what it owns: strings, its copy of the SedNamespaces, math, notes,
+ * annotations and other XML content, the values of vector ranges and the
+ * item vectors of lists.  The bytes are added up per type code and per
+ * kind of content.  Lists are charged to @c SEDML_LIST_OF; lists held
+ * inside their parent object only add their items, as their own size is
+ * part of the parent.
+ *
+ * Strings interned in the SedStringPool of a document are shared by every
+ * object that uses them, so they are not charged to any object: they are
+ * counted once, with the pool, under getSharedStringBytes().
+ *
+ * Sizes of libSBML objects (ASTNode, XMLNode) and of heap blocks are
+ * estimates: allocator overhead is ignored and strings are charged their
+ * capacity when it does not fit into the string object itself.
+ */
+
+#ifndef SedMemoryFootprint_h
+#define SedMemoryFootprint_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedNamespaces;
+class SedString;
+
+
+class LIBSEDML_EXTERN SedMemoryFootprint
+{
+public:
+
+  /**
+   * Creates an empty footprint.
+   */
+  SedMemoryFootprint();
+
+
+  /**
+   * Adds an object and everything below it.  Objects that were already
+   * added, e.g. by adding their parent, are not counted again.
+   *
+   * @param object the object.
+   */
+  void add(const SedBase* object);
+
+
+  /**
+   * @return the total number of bytes.
+   */
+  size_t getTotalBytes() const;
+
+
+  /**
+   * @return the number of objects counted.
+   */
+  unsigned int getNumObjects() const;
+
+
+  /**
+   * @return the number of type codes for which objects were counted.
+   */
+  unsigned int getNumTypeCodes() const;
+
+
+  /**
+   * Returns the nth type code for which objects were counted, in
+   * ascending order.
+   *
+   * @param n the index.
+   *
+   * @return the type code, or @c SEDML_UNKNOWN if @p n is out of range.
+   */
+  int getTypeCode(unsigned int n) const;
+
+
+  /**
+   * @param typeCode the type code, e.g. @c SEDML_DATAGENERATOR.
+   *
+   * @return the number of objects counted with the given type code.
+   */
+  unsigned int getNumObjects(int typeCode) const;
+
+
+  /**
+   * @param typeCode the type code, e.g. @c SEDML_DATAGENERATOR.
+   *
+   * @return the bytes charged to objects with the given type code.
+   */
+  size_t getBytes(int typeCode) const;
+
+
+  /**
+   * @return the bytes of the objects themselves.
+   */
+  size_t getObjectBytes() const;
+
+
+  /**
+   * @return the bytes of strings owned by objects.
+   */
+  size_t getStringBytes() const;
+
+
+  /**
+   * @return the bytes of the interned strings, counted once each, and of
+   * the pools that hold them.
+   */
+  size_t getSharedStringBytes() const;
+
+
+  /**
+   * @return the bytes of the SedNamespaces of the objects.
+   */
+  size_t getNamespaceBytes() const;
+
+
+  /**
+   * @return the bytes of math.
+   */
+  size_t getMathBytes() const;
+
+
+  /**
+   * @return the bytes of notes, annotations and other XML content.
+   */
+  size_t getXMLBytes() const;
+
+
+  /**
+   * @return the bytes of numeric values, e.g. of vector ranges.
+   */
+  size_t getValueBytes() const;
+
+
+  /**
+   * @return the bytes of the item vectors of lists.
+   */
+  size_t getListBytes() const;
+
+
+  /**
+   * @return the bytes of everything else, e.g. error logs.
+   */
+  size_t getOtherBytes() const;
+
+
+  /**
+   * @return a table of the bytes per type code and per kind of content.
+   */
+  std::string toString() const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+#ifndef SWIG
+
+  /*
+   * Used by SedBase::addMemoryFootprint() and its overrides to charge
+   * what an object owns to the object being counted.
+   */
+  void addString(const std::string& value);
+  void addString(const SedString& value);
+  void addNamespaces(const SedNamespaces* namespaces);
+  void addMath(const ASTNode* math);
+  void addXML(const XMLNode* xml);
+  void addValues(const std::vector<double>& values);
+  void addList(size_t capacity);
+  void addOther(size_t bytes);
+
+  /*
+   * The heap bytes of a string, 0 if it fits into the string object.
+   */
+  static size_t getHeapBytes(const std::string& value);
+
+#endif /* !SWIG */
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Entry
+  {
+    Entry() : numObjects(0), bytes(0) {}
+    unsigned int numObjects;
+    size_t bytes;
+  };
+
+  void charge(size_t& category, size_t bytes);
+  size_t getXMLNodeBytes(const XMLNode* xml) const;
+  size_t getMathNodeBytes(const ASTNode* math) const;
+
+  std::map<int, Entry> mTypes;
+  std::set<const void*> mSeen;
+  Entry* mCurrent;
+
+  size_t mObjectBytes;
+  size_t mStringBytes;
+  size_t mSharedStringBytes;
+  size_t mNamespaceBytes;
+  size_t mMathBytes;
+  size_t mXMLBytes;
+  size_t mValueBytes;
+  size_t mListBytes;
+  size_t mOtherBytes;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedMemoryFootprint_h */
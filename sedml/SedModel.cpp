@@ -229,7 +229,9 @@ SedModel::isSetSource() const
 int
 SedModel::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -239,6 +241,8 @@ SedModel::setId(const std::string& id)
 int
 SedModel::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -252,6 +256,8 @@ SedModel::setName(const std::string& name)
 int
 SedModel::setLanguage(const std::string& language)
 {
+  markDirty();
+
   {
     mLanguage = language;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -265,6 +271,8 @@ SedModel::setLanguage(const std::string& language)
 int
 SedModel::setSource(const std::string& source)
 {
+  markDirty();
+
   {
     mSource = source;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -278,6 +286,8 @@ SedModel::setSource(const std::string& source)
 int
 SedModel::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -297,6 +307,8 @@ SedModel::unsetId()
 int
 SedModel::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -316,6 +328,8 @@ SedModel::unsetName()
 int
 SedModel::unsetLanguage()
 {
+  markDirty();
+
   mLanguage.erase();
 
   if (mLanguage.empty() == true)
@@ -335,6 +349,8 @@ SedModel::unsetLanguage()
 int
 SedModel::unsetSource()
 {
+  markDirty();
+
   mSource.erase();
 
   if (mSource.empty() == true)
@@ -625,6 +641,155 @@ SedModel::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedModel to the vector.
+ */
+void
+SedModel::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+  names.push_back("language");
+  names.push_back("source");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedModel::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+  else if (attributeName == "language")
+    {
+      return isSetLanguage();
+    }
+  else if (attributeName == "source")
+    {
+      return isSetSource();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedModel::getAttribute(const std::string& attributeName,
+                       std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "language")
+    {
+      if (isSetLanguage() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mLanguage;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "source")
+    {
+      if (isSetSource() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mSource;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedModel::setAttribute(const std::string& attributeName,
+                       const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+  else if (attributeName == "language")
+    {
+      return setLanguage(value);
+    }
+  else if (attributeName == "source")
+    {
+      return setSource(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedModel::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+  else if (attributeName == "language")
+    {
+      return unsetLanguage();
+    }
+  else if (attributeName == "source")
+    {
+      return unsetSource();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedModel::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedBase::getChildObjects(children);
+
+  children.push_back(&mChanges);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -653,8 +818,50 @@ SedModel::writeElements(XMLOutputStream& stream) const
 bool
 SedModel::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
 
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedModel::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mName);
+  footprint.addString(mLanguage);
+  footprint.addString(mSource);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedModel::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
 }
 
 
@@ -713,7 +920,7 @@ SedModel::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -959,6 +1166,8 @@ SedListOfModels::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedModel*>(item);
@@ -996,15 +1205,12 @@ SedListOfModels::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedModel in this SedListOfModels
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfModels::createObject(XMLInputStream& stream)
+SedListOfModels::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "model")
@@ -1017,6 +1223,18 @@ SedListOfModels::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedModel in this SedListOfModels
+ */
+SedBase*
+SedListOfModels::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
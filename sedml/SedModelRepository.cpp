@@ -0,0 +1,485 @@
+/**
+ * @file   SedModelRepository.cpp
+ * @brief  Shared model sources and the models derived from them
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedModelRepository.h>
+#include <sedml/SedChangeEngine.h>
+#include <sedml/SedTypes.h>
+
+#include <sbml/xml/XMLInputStream.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+static unsigned int
+indexOfChild(const XMLNode* parent, const XMLNode* node)
+{
+  unsigned int n = 0;
+
+  while (n < parent->getNumChildren() && &parent->getChild(n) != node)
+    ++n;
+
+  return n;
+}
+
+
+static bool
+isStructural(const SedChange* change)
+{
+  int type = change->getTypeCode();
+
+  return type == SEDML_CHANGE_ADDXML || type == SEDML_CHANGE_REMOVEXML
+         || type == SEDML_CHANGE_CHANGEXML;
+}
+
+/** @endcond */
+
+
+SedDerivedModel::SedDerivedModel(const SedModel* model, XMLNode* xml,
+                                 SedTargetResolver* resolver)
+  : mModel(model)
+  , mXML(xml)
+  , mResolver(resolver)
+  , mOwnsXML(false)
+  , mValues()
+  , mNumFailed(0)
+{
+}
+
+
+SedDerivedModel::~SedDerivedModel()
+{
+  if (mOwnsXML)
+    {
+      delete mResolver;
+      delete mXML;
+    }
+}
+
+
+const SedModel*
+SedDerivedModel::getModel() const
+{
+  return mModel;
+}
+
+
+const XMLNode*
+SedDerivedModel::getXML() const
+{
+  return mXML;
+}
+
+
+bool
+SedDerivedModel::hasOwnXML() const
+{
+  return mOwnsXML;
+}
+
+
+unsigned int
+SedDerivedModel::getNumChangedValues() const
+{
+  return (unsigned int)mValues.size();
+}
+
+
+unsigned int
+SedDerivedModel::getNumFailed() const
+{
+  return mNumFailed;
+}
+
+
+bool
+SedDerivedModel::getValue(const std::string& target, std::string& value) const
+{
+  Key key;
+
+  return lookup(target, key) && getValue(key, value);
+}
+
+
+XMLNode*
+SedDerivedModel::createXML() const
+{
+  XMLNode* copy = mXML->clone();
+  std::map<Key, std::string>::const_iterator it = mValues.begin();
+
+  for (; it != mValues.end(); ++it)
+    {
+      // find the copy of the node by its child indices, innermost first
+      std::vector<unsigned int> path;
+      const XMLNode* node = it->first.first;
+
+      for (XMLNode* parent = mResolver->getParent(node); parent != NULL;
+           parent = mResolver->getParent(node))
+        {
+          path.push_back(indexOfChild(parent, node));
+          node = parent;
+        }
+
+      XMLNode* target = copy;
+
+      for (size_t k = path.size(); k > 0; --k)
+        target = &target->getChild(path[k - 1]);
+
+      SedTargetHandle(target, it->first.second.second,
+                      it->first.second.first).setValue(it->second);
+    }
+
+  return copy;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+bool
+SedDerivedModel::lookup(const std::string& target, Key& key) const
+{
+  const SedTargetHandle* handle = mResolver->resolve(target);
+
+  if (handle == NULL || !handle->isAttribute()) return false;
+
+  key = Key(handle->getNode(), std::make_pair(handle->getAttributeURI(),
+                                              handle->getAttributeName()));
+  return true;
+}
+
+
+bool
+SedDerivedModel::getValue(const Key& key, std::string& value) const
+{
+  std::map<Key, std::string>::const_iterator it = mValues.find(key);
+
+  if (it != mValues.end())
+    {
+      value = it->second;
+      return true;
+    }
+
+  if (!key.first->hasAttr(key.second.second, key.second.first)) return false;
+
+  value = key.first->getAttrValue(key.second.second, key.second.first);
+  return true;
+}
+
+
+bool
+SedDerivedModel::compute(const SedComputeChange* change,
+                         std::string& value) const
+{
+  std::map<std::string, double> values;
+
+  for (unsigned int n = 0; n < change->getNumParameters(); ++n)
+    {
+      const SedParameter* parameter = change->getParameter(n);
+      values[parameter->getId()] = parameter->getValue();
+    }
+
+  for (unsigned int n = 0; n < change->getNumVariables(); ++n)
+    {
+      const SedVariable* variable = change->getVariable(n);
+      Key key;
+      std::string text;
+
+      // only the model being derived can be read
+      if (variable->isSetModelReference()
+          && variable->getModelReference() != mModel->getId())
+        return false;
+
+      if (!lookup(variable->getTarget(), key) || !getValue(key, text)
+          || !SedBase::attributeValueFromString(text, values[variable->getId()]))
+        return false;
+    }
+
+  double result;
+
+  if (SedChangeEngine::evaluate(change->getMath(), values, result)
+      != LIBSEDML_OPERATION_SUCCESS)
+    return false;
+
+  value = SedBase::attributeValueToString(result);
+  return true;
+}
+
+
+/*
+ * Records the value set by an attribute or compute change.
+ */
+void
+SedDerivedModel::apply(const SedChange* change)
+{
+  Key key;
+  std::string value;
+  bool applied = lookup(change->getTarget(), key);
+
+  if (applied && change->getTypeCode() == SEDML_CHANGE_ATTRIBUTE)
+    value = static_cast<const SedChangeAttribute*>(change)->getNewValue();
+  else if (applied && change->getTypeCode() == SEDML_CHANGE_COMPUTECHANGE)
+    applied = compute(static_cast<const SedComputeChange*>(change), value);
+  else
+    applied = false;
+
+  if (applied)
+    mValues[key] = value;
+  else
+    ++mNumFailed;
+}
+
+
+void
+SedDerivedModel::setOwnXML(XMLNode* xml, const XMLNamespaces* namespaces)
+{
+  if (mOwnsXML)
+    {
+      delete mResolver;
+      delete mXML;
+    }
+
+  mXML = xml;
+  mResolver = new SedTargetResolver(xml, namespaces);
+  mOwnsXML = true;
+  mValues.clear();
+}
+
+/** @endcond */
+
+
+SedModelRepository::SedModelRepository(const SedDocument* document,
+                                       const std::string& baseDirectory)
+  : mDocument(document)
+  , mBaseDirectory(baseDirectory)
+  , mSources()
+  , mModels()
+  , mDeriving()
+{
+}
+
+
+SedModelRepository::~SedModelRepository()
+{
+  std::map<std::string, SedDerivedModel*>::iterator model = mModels.begin();
+
+  for (; model != mModels.end(); ++model)
+    delete model->second;
+
+  std::map<std::string, std::pair<XMLNode*, SedTargetResolver*> >::iterator
+    source = mSources.begin();
+
+  for (; source != mSources.end(); ++source)
+    {
+      delete source->second.second;
+      delete source->second.first;
+    }
+}
+
+
+const SedDocument*
+SedModelRepository::getDocument() const
+{
+  return mDocument;
+}
+
+
+int
+SedModelRepository::addSource(const std::string& source, XMLNode* xml)
+{
+  if (xml == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  if (mSources.find(source) != mSources.end())
+    return LIBSEDML_DUPLICATE_OBJECT_ID;
+
+  mSources[source] = std::make_pair(xml,
+                       new SedTargetResolver(xml, mDocument->getNamespaces()));
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+const XMLNode*
+SedModelRepository::getSource(const std::string& source)
+{
+  std::map<std::string, std::pair<XMLNode*, SedTargetResolver*> >::iterator
+    it = mSources.find(source);
+
+  if (it != mSources.end()) return it->second.first;
+
+  // sources that cannot be loaded are remembered as well
+  XMLNode* xml = loadSource(source);
+  SedTargetResolver* resolver = NULL;
+
+  if (xml != NULL)
+    resolver = new SedTargetResolver(xml, mDocument->getNamespaces());
+
+  mSources[source] = std::make_pair(xml, resolver);
+  return xml;
+}
+
+
+unsigned int
+SedModelRepository::getNumSources() const
+{
+  unsigned int count = 0;
+  std::map<std::string, std::pair<XMLNode*, SedTargetResolver*> >::const_iterator
+    it = mSources.begin();
+
+  for (; it != mSources.end(); ++it)
+    {
+      if (it->second.first != NULL) ++count;
+    }
+
+  return count;
+}
+
+
+const SedDerivedModel*
+SedModelRepository::getModel(const std::string& id)
+{
+  return derive(id);
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+XMLNode*
+SedModelRepository::loadSource(const std::string& source)
+{
+  std::string path = source;
+
+  if (!mBaseDirectory.empty() && !source.empty() && source[0] != '/'
+      && source[0] != '\\' && (source.size() < 2 || source[1] != ':'))
+    path = mBaseDirectory + "/" + source;
+
+  XMLInputStream stream(path.c_str(), true);
+
+  while (stream.isGood() && !stream.peek().isStart())
+    stream.next();
+
+  if (!stream.isGood()) return NULL;
+
+  XMLNode* xml = new XMLNode(stream);
+
+  if (stream.isError())
+    {
+      delete xml;
+      return NULL;
+    }
+
+  return xml;
+}
+
+
+/*
+ * Derives the model with the given id, and the models its source refers
+ * to.  Failures, including cycles, are remembered as NULL.
+ */
+SedDerivedModel*
+SedModelRepository::derive(const std::string& id)
+{
+  std::map<std::string, SedDerivedModel*>::const_iterator it = mModels.find(id);
+
+  if (it != mModels.end()) return it->second;
+
+  const SedModel* model = mDocument->getModel(id);
+
+  // a model that is being derived already is part of a cycle
+  if (model == NULL || mDeriving.find(id) != mDeriving.end()) return NULL;
+
+  const std::string& source = model->getSource();
+  SedDerivedModel* derived = NULL;
+
+  mDeriving.insert(id);
+
+  if (!source.empty() && source[0] == '#')
+    {
+      SedDerivedModel* base = derive(source.substr(1));
+
+      if (base != NULL)
+        {
+          derived = new SedDerivedModel(model, base->mXML, base->mResolver);
+          derived->mValues = base->mValues;
+          derived->mNumFailed = base->mNumFailed;
+        }
+    }
+  else if (getSource(source) != NULL)
+    {
+      const std::pair<XMLNode*, SedTargetResolver*>& base = mSources[source];
+      derived = new SedDerivedModel(model, base.first, base.second);
+    }
+
+  mDeriving.erase(id);
+  mModels[id] = derived;
+
+  if (derived == NULL) return NULL;
+
+  const SedListOfChanges* changes = model->getListOfChanges();
+  bool structural = false;
+
+  for (unsigned int n = 0; n < changes->size() && !structural; ++n)
+    structural = isStructural(static_cast<const SedChange*>(changes->get(n)));
+
+  if (!structural)
+    {
+      for (unsigned int n = 0; n < changes->size(); ++n)
+        derived->apply(static_cast<const SedChange*>(changes->get(n)));
+
+      return derived;
+    }
+
+  // copy the tree and apply all changes to the copy
+  XMLNode* xml = derived->createXML();
+  SedChangeEngine engine(xml, mDocument->getNamespaces());
+  engine.apply(changes);
+
+  derived->setOwnXML(xml, mDocument->getNamespaces());
+  derived->mNumFailed += engine.getNumFailed();
+
+  return derived;
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,306 @@
+/**
+ * @file   SedModelRepository.h
+ * @brief  Shared model sources and the models derived from them
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedDerivedModel
+ * @ingroup Core
+ * @brief A SedModel with its changes applied to a shared source.
+ *
+ * @class SedModelRepository
+ * @ingroup Core
+ * @brief Loads the sources of the models of a SedDocument once and
+ * derives the models from them.
+ *
+ * <em style='color: #555'>These classes of objects are defined by libSed
+ * only and have no direct equivalent in terms of Sed components.</em>
+ *
+ * The source of a SedModel is either a file (or another location) or a
+ * reference <code>#id</code> to another model, from which it is derived
+ * by applying its changes.  SedModelRepository parses each distinct
+ * source once and resolves references to other models without following
+ * cycles.
+ *
+ * A SedDerivedModel does not copy the XML it is derived from.  As long as
+ * its changes (and those of the models it derives from) only set attribute
+ * values, it consists of the shared tree and a table of the changed
+ * values, so its size depends on the number of changes and not on the
+ * size of the model.  Only a model with SedAddXML, SedRemoveXML or
+ * SedChangeXML changes gets a tree of its own, which models derived from
+ * it share in turn.  createXML() produces a complete copy when one is
+ * needed, for example to hand the model to a simulator.
+ *
+ * The variables of a SedComputeChange are read from the model being
+ * derived; a variable whose modelReference names another model makes the
+ * change fail.
+ *
+ * Sources are read from files, relative to a base directory; loadSource()
+ * can be overridden to fetch them from elsewhere, and addSource()
+ * registers sources that are already parsed.
+ */
+
+#ifndef SedModelRepository_h
+#define SedModelRepository_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sedml/SedTargetResolver.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedChange;
+class SedComputeChange;
+class SedDocument;
+class SedModel;
+class SedModelRepository;
+
+
+class LIBSEDML_EXTERN SedDerivedModel
+{
+public:
+
+  /**
+   * Destroys this SedDerivedModel, and its tree if it has one of its own.
+   */
+  ~SedDerivedModel();
+
+
+  /**
+   * @return the SedModel this object was derived from.
+   */
+  const SedModel* getModel() const;
+
+
+  /**
+   * @return the tree the changed values apply to.  It is shared with the
+   * source and other models unless hasOwnXML() returns @c true.
+   */
+  const XMLNode* getXML() const;
+
+
+  /**
+   * @return @c true if this model has a tree of its own, because it (or a
+   * model it derives from) adds, removes or replaces XML.
+   */
+  bool hasOwnXML() const;
+
+
+  /**
+   * @return the number of attribute values that differ from the tree
+   * returned by getXML().
+   */
+  unsigned int getNumChangedValues() const;
+
+
+  /**
+   * @return the number of changes that could not be applied to this model
+   * and to the models it derives from.
+   */
+  unsigned int getNumFailed() const;
+
+
+  /**
+   * Reads the value of the attribute selected by the given target, taking
+   * the changed values into account.
+   *
+   * @param target the XPath expression selecting an attribute.
+   * @param value receives the value.
+   *
+   * @return @c true if the target selects an attribute that has a value.
+   */
+  bool getValue(const std::string& target, std::string& value) const;
+
+
+  /**
+   * @return a complete copy of the XML of this model with all changes
+   * applied.  The caller owns the returned object.
+   */
+  XMLNode* createXML() const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  friend class SedModelRepository;
+
+  typedef std::pair<XMLNode*, std::pair<std::string, std::string> > Key;
+
+  SedDerivedModel(const SedModel* model, XMLNode* xml,
+                  SedTargetResolver* resolver);
+
+  bool lookup(const std::string& target, Key& key) const;
+
+  bool getValue(const Key& key, std::string& value) const;
+
+  bool compute(const SedComputeChange* change, std::string& value) const;
+
+  void apply(const SedChange* change);
+
+  void setOwnXML(XMLNode* xml, const XMLNamespaces* namespaces);
+
+  const SedModel* mModel;
+  XMLNode* mXML;
+  SedTargetResolver* mResolver;
+  bool mOwnsXML;
+
+  // (node, (attribute uri, attribute name)) -> value
+  std::map<Key, std::string> mValues;
+
+  unsigned int mNumFailed;
+
+  /** @endcond */
+
+private:
+  SedDerivedModel(const SedDerivedModel&);
+  SedDerivedModel& operator=(const SedDerivedModel&);
+};
+
+
+class LIBSEDML_EXTERN SedModelRepository
+{
+public:
+
+  /**
+   * Creates a new SedModelRepository for the models of a document.
+   *
+   * @param document the document; it has to outlive this object and its
+   * models must not change while it is in use.
+   * @param baseDirectory the directory relative to which sources are
+   * read; if empty, they are read relative to the working directory.
+   */
+  SedModelRepository(const SedDocument* document,
+                     const std::string& baseDirectory = "");
+
+
+  /**
+   * Destroys this SedModelRepository and all sources and models it holds.
+   */
+  virtual ~SedModelRepository();
+
+
+  /**
+   * @return the document whose models are derived.
+   */
+  const SedDocument* getDocument() const;
+
+
+  /**
+   * Registers the parsed XML of a source, so that it is not loaded.
+   *
+   * @param source the source, as given in the models.
+   * @param xml the root element of the source; this object takes ownership
+   * of it.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_DUPLICATE_OBJECT_ID LIBSEDML_DUPLICATE_OBJECT_ID @endlink
+   * if the source is already known
+   */
+  int addSource(const std::string& source, XMLNode* xml);
+
+
+  /**
+   * @param source the source, as given in the models.
+   *
+   * @return the parsed source, loading it on first use, or @c NULL if it
+   * cannot be loaded.
+   */
+  const XMLNode* getSource(const std::string& source);
+
+
+  /**
+   * @return the number of distinct sources loaded or registered.
+   */
+  unsigned int getNumSources() const;
+
+
+  /**
+   * Returns the model with the given id, deriving it (and the models it
+   * references) on first use.
+   *
+   * @param id the id of a SedModel of the document.
+   *
+   * @return the derived model, or @c NULL if there is no such model, its
+   * source cannot be loaded or its references form a cycle.  The object
+   * is owned by this repository.
+   */
+  const SedDerivedModel* getModel(const std::string& id);
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Loads and parses a source; called once per distinct source.  The
+   * default reads the file at the source, relative to the base directory.
+   *
+   * @return the root element, owned by the caller, or @c NULL on failure.
+   */
+  virtual XMLNode* loadSource(const std::string& source);
+
+  SedDerivedModel* derive(const std::string& id);
+
+  const SedDocument* mDocument;
+  std::string mBaseDirectory;
+
+  std::map<std::string, std::pair<XMLNode*, SedTargetResolver*> > mSources;
+  std::map<std::string, SedDerivedModel*> mModels;
+  std::set<std::string> mDeriving;
+
+  /** @endcond */
+
+private:
+  SedModelRepository(const SedModelRepository&);
+  SedModelRepository& operator=(const SedModelRepository&);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedModelRepository_h */
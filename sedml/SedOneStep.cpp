@@ -145,6 +145,8 @@ SedOneStep::isSetStep() const
 int
 SedOneStep::setStep(double step)
 {
+  markDirty();
+
   mStep = step;
   mIsSetStep = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -157,6 +159,8 @@ SedOneStep::setStep(double step)
 int
 SedOneStep::unsetStep()
 {
+  markDirty();
+
   mStep = numeric_limits<double>::quiet_NaN();
   mIsSetStep = false;
 
@@ -221,6 +225,88 @@ SedOneStep::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedOneStep to the vector.
+ */
+void
+SedOneStep::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedSimulation::getAttributeNames(names);
+
+  names.push_back("step");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedOneStep::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "step")
+    {
+      return isSetStep();
+    }
+
+  return SedSimulation::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedOneStep::getAttribute(const std::string& attributeName,
+                         std::string& value) const
+{
+  if (attributeName == "step")
+    {
+      if (isSetStep() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mStep);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedSimulation::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedOneStep::setAttribute(const std::string& attributeName,
+                         const std::string& value)
+{
+  if (attributeName == "step")
+    {
+      double parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setStep(parsed);
+    }
+
+  return SedSimulation::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedOneStep::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "step")
+    {
+      return unsetStep();
+    }
+
+  return SedSimulation::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -244,8 +330,13 @@ SedOneStep::writeElements(XMLOutputStream& stream) const
 bool
 SedOneStep::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
 
+  return result;
 }
 
 
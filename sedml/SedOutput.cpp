@@ -177,7 +177,9 @@ SedOutput::isSetName() const
 int
 SedOutput::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -187,6 +189,8 @@ SedOutput::setId(const std::string& id)
 int
 SedOutput::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -200,6 +204,8 @@ SedOutput::setName(const std::string& name)
 int
 SedOutput::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -219,6 +225,8 @@ SedOutput::unsetId()
 int
 SedOutput::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -307,6 +315,103 @@ SedOutput::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedOutput to the vector.
+ */
+void
+SedOutput::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedOutput::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedOutput::getAttribute(const std::string& attributeName,
+                        std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedOutput::setAttribute(const std::string& attributeName,
+                        const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedOutput::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -330,8 +435,48 @@ SedOutput::writeElements(XMLOutputStream& stream) const
 bool
 SedOutput::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
 
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedOutput::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mName);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedOutput::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
 }
 
 
@@ -387,7 +532,7 @@ SedOutput::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -633,6 +778,8 @@ SedListOfOutputs::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedOutput*>(item);
@@ -670,15 +817,12 @@ SedListOfOutputs::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedOutput in this SedListOfOutputs
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfOutputs::createObject(XMLInputStream& stream)
+SedListOfOutputs::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "report")
@@ -703,6 +847,18 @@ SedListOfOutputs::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedOutput in this SedListOfOutputs
+ */
+SedBase*
+SedListOfOutputs::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -0,0 +1,363 @@
+/**
+ * @file   SedParallelVisitor.cpp
+ * @brief  Runs a visitor over the lists of a document on several threads
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedParallelVisitor.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedListOf.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+namespace
+{
+
+/*
+ * A run of consecutive items of a top-level list, or a single top-level
+ * child that is not a list, with the clone that visits it.
+ */
+struct Chunk
+{
+  size_t child;
+  const SedListOf* list;
+  const SedBase* object;
+  unsigned int begin;
+  unsigned int end;
+  SedMergeableVisitor* visitor;
+  bool failed;
+};
+
+
+void
+visitChunk(Chunk& chunk)
+{
+  try
+    {
+      if (chunk.list == NULL)
+        {
+          chunk.object->accept(*chunk.visitor);
+          return;
+        }
+
+      for (unsigned int n = chunk.begin; n < chunk.end; ++n)
+        chunk.list->get(n)->accept(*chunk.visitor);
+    }
+  catch (...)
+    {
+      chunk.failed = true;
+    }
+}
+
+
+/*
+ * The chunks and the index of the next one to visit, shared by the
+ * worker threads.
+ */
+struct WorkQueue
+{
+  vector<Chunk>* chunks;
+  size_t next;
+#ifdef _WIN32
+  CRITICAL_SECTION lock;
+#else
+  pthread_mutex_t lock;
+#endif
+};
+
+
+void
+runWorker(WorkQueue& queue)
+{
+  for (;;)
+    {
+#ifdef _WIN32
+      EnterCriticalSection(&queue.lock);
+#else
+      pthread_mutex_lock(&queue.lock);
+#endif
+      size_t index = queue.next++;
+#ifdef _WIN32
+      LeaveCriticalSection(&queue.lock);
+#else
+      pthread_mutex_unlock(&queue.lock);
+#endif
+
+      if (index >= queue.chunks->size()) return;
+
+      visitChunk((*queue.chunks)[index]);
+    }
+}
+
+
+#ifdef _WIN32
+DWORD WINAPI
+workerEntry(LPVOID queue)
+{
+  runWorker(*static_cast<WorkQueue*>(queue));
+  return 0;
+}
+#else
+extern "C" void*
+workerEntry(void* queue)
+{
+  runWorker(*static_cast<WorkQueue*>(queue));
+  return NULL;
+}
+#endif
+
+
+/*
+ * Visits the chunks on the calling thread and numThreads - 1 more.  If a
+ * thread cannot be started the others take over its share.
+ */
+void
+runThreads(vector<Chunk>& chunks, unsigned int numThreads)
+{
+  WorkQueue queue;
+  queue.chunks = &chunks;
+  queue.next = 0;
+
+#ifdef _WIN32
+  InitializeCriticalSection(&queue.lock);
+  vector<HANDLE> threads;
+  for (unsigned int n = 1; n < numThreads; ++n)
+    {
+      HANDLE thread = CreateThread(NULL, 0, workerEntry, &queue, 0, NULL);
+      if (thread == NULL) break;
+      threads.push_back(thread);
+    }
+
+  runWorker(queue);
+
+  for (size_t n = 0; n < threads.size(); ++n)
+    {
+      WaitForSingleObject(threads[n], INFINITE);
+      CloseHandle(threads[n]);
+    }
+  DeleteCriticalSection(&queue.lock);
+#else
+  pthread_mutex_init(&queue.lock, NULL);
+  vector<pthread_t> threads;
+  for (unsigned int n = 1; n < numThreads; ++n)
+    {
+      pthread_t thread;
+      if (pthread_create(&thread, NULL, workerEntry, &queue) != 0) break;
+      threads.push_back(thread);
+    }
+
+  runWorker(queue);
+
+  for (size_t n = 0; n < threads.size(); ++n)
+    pthread_join(threads[n], NULL);
+  pthread_mutex_destroy(&queue.lock);
+#endif
+}
+
+}
+
+/** @endcond */
+
+
+SedMergeableVisitor::~SedMergeableVisitor()
+{
+}
+
+
+SedParallelVisitor::SedParallelVisitor(unsigned int numThreads,
+                                       unsigned int chunkSize)
+  : mNumThreads(numThreads)
+  , mChunkSize(chunkSize == 0 ? 1 : chunkSize)
+{
+}
+
+
+unsigned int
+SedParallelVisitor::getNumThreads() const
+{
+  return mNumThreads == 0 ? getHardwareConcurrency() : mNumThreads;
+}
+
+
+void
+SedParallelVisitor::setNumThreads(unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+unsigned int
+SedParallelVisitor::getChunkSize() const
+{
+  return mChunkSize;
+}
+
+
+void
+SedParallelVisitor::setChunkSize(unsigned int chunkSize)
+{
+  mChunkSize = chunkSize == 0 ? 1 : chunkSize;
+}
+
+
+int
+SedParallelVisitor::run(const SedDocument* document,
+                        SedMergeableVisitor& visitor) const
+{
+  if (document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  visitor.visit(*document);
+
+  vector<const SedBase*> children;
+  document->getChildObjects(children);
+
+  vector<Chunk> chunks;
+  for (size_t n = 0; n < children.size(); ++n)
+    {
+      Chunk chunk = { n, NULL, children[n], 0, 0, NULL, false };
+      const SedListOf* list = dynamic_cast<const SedListOf*>(children[n]);
+      if (list == NULL)
+        {
+          chunks.push_back(chunk);
+          continue;
+        }
+
+      chunk.list = list;
+      for (unsigned int begin = 0; begin < list->size(); begin += mChunkSize)
+        {
+          chunk.begin = begin;
+          chunk.end = list->size() - begin > mChunkSize
+                      ? begin + mChunkSize : list->size();
+          chunks.push_back(chunk);
+        }
+    }
+
+  // clones are made here, so clone() need not be thread safe
+  bool failed = false;
+  for (size_t n = 0; n < chunks.size() && !failed; ++n)
+    {
+      try
+        {
+          chunks[n].visitor = visitor.clone();
+        }
+      catch (...)
+        {
+        }
+      failed = chunks[n].visitor == NULL;
+    }
+
+  if (!failed)
+    {
+      unsigned int numThreads = getNumThreads();
+      if (numThreads > chunks.size()) numThreads = (unsigned int)chunks.size();
+
+      if (numThreads <= 1)
+        {
+          for (size_t n = 0; n < chunks.size(); ++n)
+            visitChunk(chunks[n]);
+        }
+      else
+        {
+          runThreads(chunks, numThreads);
+        }
+
+      for (size_t n = 0; n < chunks.size(); ++n)
+        failed = failed || chunks[n].failed;
+    }
+
+  if (!failed)
+    {
+      size_t n = 0;
+      for (size_t child = 0; child < children.size(); ++child)
+        {
+          const SedListOf* list = dynamic_cast<const SedListOf*>(children[child]);
+          if (list != NULL)
+            visitor.visit(*list, list->getItemTypeCode());
+
+          for (; n < chunks.size() && chunks[n].child == child; ++n)
+            visitor.merge(*chunks[n].visitor);
+
+          if (list != NULL)
+            visitor.leave(*list, list->getItemTypeCode());
+        }
+    }
+
+  visitor.leave(*document);
+
+  for (size_t n = 0; n < chunks.size(); ++n)
+    delete chunks[n].visitor;
+
+  return failed ? LIBSEDML_OPERATION_FAILED : LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+SedParallelVisitor::getHardwareConcurrency()
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  long count = (long)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+  long count = 1;
+#endif
+  return count < 1 ? 1 : (unsigned int)count;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
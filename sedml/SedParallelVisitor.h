@@ -0,0 +1,204 @@
+/**
+ * @file   SedParallelVisitor.h
+ * @brief  Runs a visitor over the lists of a document on several threads
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedMergeableVisitor
+ * @ingroup Core
+ * @brief A SedVisitor that can be copied and whose copies can be merged.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * SedParallelVisitor gives each chunk of work its own copy of the visitor,
+ * made with clone(), and merges the copies back into the original with
+ * merge() once all threads are done.  A visitor that collects results,
+ * such as a validator gathering errors or a pass counting elements, only
+ * has to say how to combine two partial results.
+ *
+ * @class SedParallelVisitor
+ * @ingroup Core
+ * @brief Runs a SedMergeableVisitor over a SedDocument on several threads.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * The top-level lists of a document (the models, simulations, tasks,
+ * data generators, outputs and so on) do not depend on each other, and
+ * neither do the items of a list.  run() cuts the items of every
+ * top-level list into chunks of getChunkSize() items, so that small lists
+ * are one chunk each and large lists are shared, and hands the chunks to
+ * getNumThreads() worker threads.  Each chunk is visited with its own
+ * clone of the visitor; the clones are merged into the given visitor in
+ * document order, so the result does not depend on how the chunks were
+ * scheduled.
+ *
+ * The given visitor itself receives visit() for the document before it
+ * is cloned, then visit() and leave() for each top-level list around the
+ * merges of its chunks, and finally leave() for the document, all on the
+ * calling thread; the clones receive the items of the lists and
+ * everything below them.  The document must not be modified while run()
+ * executes.
+ */
+
+#ifndef SedParallelVisitor_h
+#define SedParallelVisitor_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <sedml/SedVisitor.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedMergeableVisitor : public SedVisitor
+{
+public:
+
+  /**
+   * Destructor.
+   */
+  virtual ~SedMergeableVisitor();
+
+
+  /**
+   * Creates a visitor with the same configuration as this one and no
+   * results yet.  It is called on the thread that called
+   * SedParallelVisitor::run().
+   *
+   * @return the new visitor, owned by the caller.
+   */
+  virtual SedMergeableVisitor* clone() const = 0;
+
+
+  /**
+   * Adds the results collected by another visitor, created with clone(),
+   * to the results of this one.  It is called on the thread that called
+   * SedParallelVisitor::run(), in document order.
+   *
+   * @param other the visitor whose results are added.
+   */
+  virtual void merge(const SedMergeableVisitor& other) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedParallelVisitor
+{
+public:
+
+  /**
+   * Creates a new SedParallelVisitor.
+   *
+   * @param numThreads the number of worker threads; 0 uses one thread per
+   * processor.
+   * @param chunkSize the largest number of list items visited as one piece
+   * of work; 0 is taken as 1.
+   */
+  SedParallelVisitor(unsigned int numThreads = 0, unsigned int chunkSize = 64);
+
+
+  /**
+   * @return the number of worker threads used by run().
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * @param numThreads the number of worker threads; 0 uses one thread per
+   * processor.
+   */
+  void setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * @return the largest number of list items visited as one piece of work.
+   */
+  unsigned int getChunkSize() const;
+
+
+  /**
+   * @param chunkSize the largest number of list items visited as one piece
+   * of work; 0 is taken as 1.
+   */
+  void setChunkSize(unsigned int chunkSize);
+
+
+  /**
+   * Visits the document with @p visitor and clones of it, and merges the
+   * clones into @p visitor.  With a single thread, or a single chunk, the
+   * chunks are visited on the calling thread.
+   *
+   * @param document the document to visit.
+   * @param visitor the visitor that receives the merged results.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p document is @c NULL
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if a clone could not be created or a visitor threw an exception;
+   * nothing is merged in that case.
+   */
+  int run(const SedDocument* document, SedMergeableVisitor& visitor) const;
+
+
+  /**
+   * @return the number of processors available, at least 1.
+   */
+  static unsigned int getHardwareConcurrency();
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  unsigned int mNumThreads;
+  unsigned int mChunkSize;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedParallelVisitor_h */
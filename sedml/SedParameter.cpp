@@ -193,7 +193,9 @@ SedParameter::isSetValue() const
 int
 SedParameter::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -203,6 +205,8 @@ SedParameter::setId(const std::string& id)
 int
 SedParameter::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -216,6 +220,8 @@ SedParameter::setName(const std::string& name)
 int
 SedParameter::setValue(double value)
 {
+  markDirty();
+
   mValue = value;
   mIsSetValue = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -228,6 +234,8 @@ SedParameter::setValue(double value)
 int
 SedParameter::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -247,6 +255,8 @@ SedParameter::unsetId()
 int
 SedParameter::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -266,6 +276,8 @@ SedParameter::unsetName()
 int
 SedParameter::unsetValue()
 {
+  markDirty();
+
   mValue = numeric_limits<double>::quiet_NaN();
   mIsSetValue = false;
 
@@ -319,6 +331,128 @@ SedParameter::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedParameter to the vector.
+ */
+void
+SedParameter::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+  names.push_back("value");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedParameter::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+  else if (attributeName == "value")
+    {
+      return isSetValue();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedParameter::getAttribute(const std::string& attributeName,
+                           std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "value")
+    {
+      if (isSetValue() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mValue);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedParameter::setAttribute(const std::string& attributeName,
+                           const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+  else if (attributeName == "value")
+    {
+      double parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setValue(parsed);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedParameter::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+  else if (attributeName == "value")
+    {
+      return unsetValue();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -342,8 +476,48 @@ SedParameter::writeElements(XMLOutputStream& stream) const
 bool
 SedParameter::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedParameter::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mName);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedParameter::internStrings()
+{
+  SedBase::internStrings();
 
+  reinternString(mId);
 }
 
 
@@ -400,7 +574,7 @@ SedParameter::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -618,6 +792,8 @@ SedListOfParameters::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedParameter*>(item);
@@ -655,15 +831,12 @@ SedListOfParameters::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedParameter in this SedListOfParameters
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfParameters::createObject(XMLInputStream& stream)
+SedListOfParameters::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "parameter")
@@ -676,6 +849,18 @@ SedListOfParameters::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedParameter in this SedListOfParameters
+ */
+SedBase*
+SedListOfParameters::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
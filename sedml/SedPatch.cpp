@@ -0,0 +1,1370 @@
+/**
+ * @file   SedPatch.cpp
+ * @brief  Structural differences between Sed documents
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedPatch.h>
+#include <sedml/SedTypes.h>
+
+#include <sbml/math/MathML.h>
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLOutputStream.h>
+#include <sbml/util/util.h>
+
+#include <numl/DimensionDescription.h>
+
+#include <cstdlib>
+#include <map>
+#include <sstream>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The kinds of content compared besides attributes and children, in the
+ * order in which they are compared.
+ */
+static const char* const CONTENT_KINDS[] =
+{
+  "notes", "annotation", "math", "newXML", "values", "dimensionDescription"
+};
+
+static const unsigned int NUM_CONTENT_KINDS = 6;
+
+
+/*
+ * The keywords of the text form, indexed by SedEditType_t.
+ */
+static const char* const EDIT_KEYWORDS[] =
+{
+  "set", "unset", "content", "uncontent", "insert", "remove", "order"
+};
+
+static const unsigned int NUM_EDIT_KEYWORDS = 7;
+
+
+static const ASTNode*
+getMathOf(const SedBase* object)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_CHANGE_COMPUTECHANGE:
+      return static_cast<const SedComputeChange*>(object)->getMath();
+
+    case SEDML_DATAGENERATOR:
+      return static_cast<const SedDataGenerator*>(object)->getMath();
+
+    case SEDML_TASK_SETVALUE:
+      return static_cast<const SedSetValue*>(object)->getMath();
+
+    case SEDML_RANGE_FUNCTIONALRANGE:
+      return static_cast<const SedFunctionalRange*>(object)->getMath();
+
+    default:
+      return NULL;
+    }
+}
+
+
+static int
+setMathOf(SedBase* object, ASTNode* math)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_CHANGE_COMPUTECHANGE:
+      return static_cast<SedComputeChange*>(object)->setMath(math);
+
+    case SEDML_DATAGENERATOR:
+      return static_cast<SedDataGenerator*>(object)->setMath(math);
+
+    case SEDML_TASK_SETVALUE:
+      return static_cast<SedSetValue*>(object)->setMath(math);
+
+    case SEDML_RANGE_FUNCTIONALRANGE:
+      return static_cast<SedFunctionalRange*>(object)->setMath(math);
+
+    default:
+      return LIBSEDML_INVALID_OBJECT;
+    }
+}
+
+
+static const XMLNode*
+getNewXMLOf(const SedBase* object)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_CHANGE_ADDXML:
+      return static_cast<const SedAddXML*>(object)->getNewXML();
+
+    case SEDML_CHANGE_CHANGEXML:
+      return static_cast<const SedChangeXML*>(object)->getNewXML();
+
+    default:
+      return NULL;
+    }
+}
+
+
+static int
+setNewXMLOf(SedBase* object, XMLNode* xml)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_CHANGE_ADDXML:
+      return static_cast<SedAddXML*>(object)->setNewXML(xml);
+
+    case SEDML_CHANGE_CHANGEXML:
+      return static_cast<SedChangeXML*>(object)->setNewXML(xml);
+
+    default:
+      return LIBSEDML_INVALID_OBJECT;
+    }
+}
+
+
+/*
+ * Returns true and the content of the given kind as text if the object
+ * has such content.
+ */
+static bool
+getContent(const SedBase* object, const std::string& kind, std::string& value)
+{
+  if (kind == "notes")
+    {
+      if (!object->isSetNotes()) return false;
+
+      value = object->getNotesString();
+      return true;
+    }
+  else if (kind == "annotation")
+    {
+      if (!object->isSetAnnotation()) return false;
+
+      value = object->getAnnotationString();
+      return true;
+    }
+  else if (kind == "math")
+    {
+      const ASTNode* math = getMathOf(object);
+      if (math == NULL) return false;
+
+      char* text = writeMathMLToString(math);
+      if (text == NULL) return false;
+
+      value = text;
+      free(text);
+      return true;
+    }
+  else if (kind == "newXML")
+    {
+      const XMLNode* xml = getNewXMLOf(object);
+      if (xml == NULL) return false;
+
+      value = XMLNode::convertXMLNodeToString(xml);
+      return true;
+    }
+  else if (kind == "values")
+    {
+      if (object->getTypeCode() != SEDML_RANGE_VECTORRANGE) return false;
+
+      const std::vector<double>& values =
+        static_cast<const SedVectorRange*>(object)->getValues();
+      if (values.empty()) return false;
+
+      value.clear();
+
+      for (size_t i = 0; i < values.size(); ++i)
+        {
+          if (i > 0) value += ' ';
+
+          value += SedBase::attributeValueToString(values[i]);
+        }
+
+      return true;
+    }
+  else if (kind == "dimensionDescription")
+    {
+      if (object->getTypeCode() != SEDML_DATA_DESCRIPTION) return false;
+
+      const DimensionDescription* description =
+        static_cast<const SedDataDescription*>(object)->getDimensionDescription();
+      if (description == NULL) return false;
+
+      std::ostringstream text;
+      XMLOutputStringStream stream(text, "UTF-8", false);
+      description->write(stream);
+      value = text.str();
+      return true;
+    }
+
+  return false;
+}
+
+
+/*
+ * Sets or, if value is NULL, unsets the content of the given kind.
+ */
+static int
+setContent(SedDocument* document, SedBase* object,
+           const std::string& kind, const std::string* value)
+{
+  if (kind == "notes")
+    {
+      return value != NULL ? object->setNotes(*value) : object->unsetNotes();
+    }
+  else if (kind == "annotation")
+    {
+      return value != NULL ? object->setAnnotation(*value)
+                           : object->unsetAnnotation();
+    }
+  else if (kind == "math")
+    {
+      if (value == NULL) return setMathOf(object, NULL);
+
+      ASTNode* math = readMathMLFromString(value->c_str());
+      if (math == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      int result = setMathOf(object, math);
+      delete math;
+      return result;
+    }
+  else if (kind == "newXML")
+    {
+      if (value == NULL) return setNewXMLOf(object, NULL);
+
+      XMLNode* xml = XMLNode::convertStringToXMLNode(*value,
+                                                     document->getNamespaces());
+      if (xml == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      int result = setNewXMLOf(object, xml);
+      delete xml;
+      return result;
+    }
+  else if (kind == "values")
+    {
+      if (object->getTypeCode() != SEDML_RANGE_VECTORRANGE)
+        return LIBSEDML_INVALID_OBJECT;
+
+      SedVectorRange* range = static_cast<SedVectorRange*>(object);
+
+      if (value == NULL) return range->clearValues();
+
+      std::vector<double> values;
+      std::istringstream stream(*value);
+      std::string token;
+
+      while (stream >> token)
+        {
+          double number;
+
+          if (!SedBase::attributeValueFromString(token, number))
+            return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+          values.push_back(number);
+        }
+
+      return range->setValues(values);
+    }
+  else if (kind == "dimensionDescription")
+    {
+      if (object->getTypeCode() != SEDML_DATA_DESCRIPTION)
+        return LIBSEDML_INVALID_OBJECT;
+
+      SedDataDescription* data = static_cast<SedDataDescription*>(object);
+
+      if (value == NULL) return data->unsetDimensionDescription();
+
+      // read the way SedDataDescription::readOtherXML does
+      XMLInputStream stream(value->c_str(), false);
+      if (!stream.isGood()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      const XMLToken token = stream.next();
+      stream.skipText();
+
+      DimensionDescription description;
+      description.read(stream);
+      stream.skipPastEnd(token);
+
+      return data->setDimensionDescription(&description);
+    }
+
+  return LIBSEDML_OPERATION_FAILED;
+}
+
+
+static std::string
+childPath(const std::string& path, const std::string& step)
+{
+  return path == "/" ? path + step : path + "/" + step;
+}
+
+
+static std::string
+indexStep(size_t index)
+{
+  std::ostringstream step;
+  step << '#' << index;
+  return step.str();
+}
+
+
+static const SedBase*
+findChild(const std::vector<const SedBase*>& children, const std::string& name)
+{
+  for (size_t i = 0; i < children.size(); ++i)
+    {
+      if (children[i]->getElementName() == name)
+        return children[i];
+    }
+
+  return NULL;
+}
+
+
+static void diffList(const SedListOf* base, const SedListOf* target,
+                     const std::string& path, std::vector<SedEdit>& edits);
+
+
+/*
+ * Records the attribute and content differences of two objects of the
+ * same element; base is NULL for an object that is new.
+ */
+static void
+diffFields(const SedBase* base, const SedBase* target,
+           const std::string& path, std::vector<SedEdit>& edits)
+{
+  std::vector<std::string> names;
+  target->getAttributeNames(names);
+
+  for (size_t i = 0; i < names.size(); ++i)
+    {
+      std::string baseValue, targetValue;
+      bool targetSet = target->getAttribute(names[i], targetValue)
+                       == LIBSEDML_OPERATION_SUCCESS;
+      bool baseSet = base != NULL && base->getAttribute(names[i], baseValue)
+                     == LIBSEDML_OPERATION_SUCCESS;
+
+      if (targetSet && (!baseSet || baseValue != targetValue))
+        edits.push_back(SedEdit(SEDML_EDIT_SET_ATTRIBUTE, path, names[i],
+                                targetValue));
+      else if (!targetSet && baseSet)
+        edits.push_back(SedEdit(SEDML_EDIT_UNSET_ATTRIBUTE, path, names[i]));
+    }
+
+  for (unsigned int i = 0; i < NUM_CONTENT_KINDS; ++i)
+    {
+      const std::string kind = CONTENT_KINDS[i];
+      std::string baseValue, targetValue;
+      bool targetSet = getContent(target, kind, targetValue);
+      bool baseSet = base != NULL && getContent(base, kind, baseValue);
+
+      if (targetSet && (!baseSet || baseValue != targetValue))
+        edits.push_back(SedEdit(SEDML_EDIT_SET_CONTENT, path, kind,
+                                targetValue));
+      else if (!targetSet && baseSet)
+        edits.push_back(SedEdit(SEDML_EDIT_UNSET_CONTENT, path, kind));
+    }
+}
+
+
+/*
+ * Records the differences between two objects of the same element and
+ * everything they contain; base is NULL for an object that is new.
+ */
+static void
+diffObjects(const SedBase* base, const SedBase* target,
+            const std::string& path, std::vector<SedEdit>& edits)
+{
+  diffFields(base, target, path, edits);
+
+  std::vector<const SedBase*> baseChildren, targetChildren;
+  if (base != NULL) base->getChildObjects(baseChildren);
+  target->getChildObjects(targetChildren);
+
+  for (size_t i = 0; i < baseChildren.size(); ++i)
+    {
+      const std::string& name = baseChildren[i]->getElementName();
+
+      if (baseChildren[i]->getTypeCode() != SEDML_LIST_OF
+          && findChild(targetChildren, name) == NULL)
+        edits.push_back(SedEdit(SEDML_EDIT_REMOVE, path, name));
+    }
+
+  for (size_t i = 0; i < targetChildren.size(); ++i)
+    {
+      const SedBase* child = targetChildren[i];
+      const std::string& name = child->getElementName();
+      const SedBase* match = findChild(baseChildren, name);
+
+      if (child->getTypeCode() == SEDML_LIST_OF)
+        {
+          diffList(static_cast<const SedListOf*>(match),
+                   static_cast<const SedListOf*>(child),
+                   childPath(path, name), edits);
+          continue;
+        }
+
+      if (match == NULL)
+        edits.push_back(SedEdit(SEDML_EDIT_INSERT, path, name));
+
+      diffObjects(match, child, childPath(path, name), edits);
+    }
+}
+
+
+static std::string
+getItemId(const SedBase* item)
+{
+  std::string id;
+
+  if (item->getAttribute("id", id) != LIBSEDML_OPERATION_SUCCESS)
+    id.clear();
+
+  return id;
+}
+
+
+static bool
+isUnique(const std::map<std::string, unsigned int>& counts,
+         const std::string& id)
+{
+  std::map<std::string, unsigned int>::const_iterator it = counts.find(id);
+  return it == counts.end() || it->second <= 1;
+}
+
+
+/*
+ * Records the differences between two lists.  Items are matched by id
+ * where the id is unique in both lists, the others by position among the
+ * items of the same element name.  Edits of matched items come first and
+ * address them as they are in base; then unmatched items are removed from
+ * the back, the rest is rearranged if needed, and new items are inserted
+ * in ascending order, so that every index is valid when it is used.
+ */
+static void
+diffList(const SedListOf* base, const SedListOf* target,
+         const std::string& path, std::vector<SedEdit>& edits)
+{
+  diffFields(base, target, path, edits);
+
+  const unsigned int numBase = base != NULL ? base->size() : 0;
+  const unsigned int numTarget = target->size();
+
+  std::vector<std::string> baseIds(numBase), targetIds(numTarget);
+  std::map<std::string, unsigned int> baseCounts, targetCounts;
+
+  for (unsigned int i = 0; i < numBase; ++i)
+    {
+      baseIds[i] = getItemId(base->get(i));
+      if (!baseIds[i].empty()) ++baseCounts[baseIds[i]];
+    }
+
+  for (unsigned int j = 0; j < numTarget; ++j)
+    {
+      targetIds[j] = getItemId(target->get(j));
+      if (!targetIds[j].empty()) ++targetCounts[targetIds[j]];
+    }
+
+  std::vector<std::string> baseKeys(numBase);
+  std::map<std::string, unsigned int> baseById;
+  std::map<std::string, std::vector<unsigned int> > baseByName;
+
+  for (unsigned int i = 0; i < numBase; ++i)
+    {
+      const std::string& id = baseIds[i];
+
+      if (!id.empty() && isUnique(baseCounts, id) && isUnique(targetCounts, id))
+        {
+          baseKeys[i] = "@" + id;
+          baseById[id] = i;
+        }
+      else
+        {
+          baseKeys[i] = indexStep(i);
+          baseByName[base->get(i)->getElementName()].push_back(i);
+        }
+    }
+
+  std::vector<int> matches(numTarget, -1);
+  std::vector<bool> matched(numBase, false);
+  std::map<std::string, size_t> used;
+
+  for (unsigned int j = 0; j < numTarget; ++j)
+    {
+      const std::string& id = targetIds[j];
+      const std::string& name = target->get(j)->getElementName();
+
+      if (!id.empty() && isUnique(baseCounts, id) && isUnique(targetCounts, id))
+        {
+          std::map<std::string, unsigned int>::const_iterator it =
+            baseById.find(id);
+
+          if (it != baseById.end()
+              && base->get(it->second)->getElementName() == name)
+            matches[j] = (int)it->second;
+        }
+      else
+        {
+          std::vector<unsigned int>& candidates = baseByName[name];
+          size_t& next = used[name];
+
+          if (next < candidates.size())
+            matches[j] = (int)candidates[next++];
+        }
+
+      if (matches[j] >= 0)
+        {
+          matched[matches[j]] = true;
+          diffObjects(base->get(matches[j]), target->get(j),
+                      childPath(path, baseKeys[matches[j]]), edits);
+        }
+    }
+
+  for (unsigned int i = numBase; i > 0; --i)
+    {
+      if (!matched[i - 1])
+        edits.push_back(SedEdit(SEDML_EDIT_REMOVE, path, baseKeys[i - 1]));
+    }
+
+  std::vector<unsigned int> positions(numBase, 0);
+  unsigned int numKept = 0;
+
+  for (unsigned int i = 0; i < numBase; ++i)
+    {
+      if (matched[i]) positions[i] = numKept++;
+    }
+
+  SedEdit reorder(SEDML_EDIT_REORDER, path);
+  bool inOrder = true;
+
+  for (unsigned int j = 0; j < numTarget; ++j)
+    {
+      if (matches[j] < 0) continue;
+
+      unsigned int position = positions[matches[j]];
+      if (position != reorder.getOrder().size()) inOrder = false;
+
+      reorder.getOrder().push_back(position);
+    }
+
+  if (!inOrder) edits.push_back(reorder);
+
+  for (unsigned int j = 0; j < numTarget; ++j)
+    {
+      if (matches[j] >= 0) continue;
+
+      SedEdit insert(SEDML_EDIT_INSERT, path, target->get(j)->getElementName());
+      insert.setIndex(j);
+      edits.push_back(insert);
+
+      diffObjects(NULL, target->get(j), childPath(path, indexStep(j)), edits);
+    }
+}
+
+
+/*
+ * Fields of the text form are separated by single spaces; spaces, line
+ * breaks and the escape character itself are written as %XX.
+ */
+static std::string
+escapeField(const std::string& text)
+{
+  static const char* const hex = "0123456789ABCDEF";
+  std::string result;
+  result.reserve(text.size());
+
+  for (std::string::const_iterator it = text.begin(); it != text.end(); ++it)
+    {
+      unsigned char c = (unsigned char)*it;
+
+      if (c == '%' || c == ' ' || c == '\t' || c == '\n' || c == '\r')
+        {
+          result += '%';
+          result += hex[c >> 4];
+          result += hex[c & 15];
+        }
+      else
+        {
+          result += *it;
+        }
+    }
+
+  return result;
+}
+
+
+static bool
+unescapeField(const std::string& text, std::string& result)
+{
+  result.clear();
+  result.reserve(text.size());
+
+  for (size_t i = 0; i < text.size(); ++i)
+    {
+      if (text[i] != '%')
+        {
+          result += text[i];
+          continue;
+        }
+
+      if (i + 2 >= text.size()) return false;
+
+      int value = 0;
+
+      for (size_t k = i + 1; k <= i + 2; ++k)
+        {
+          char c = text[k];
+          value *= 16;
+
+          if (c >= '0' && c <= '9') value += c - '0';
+          else if (c >= 'A' && c <= 'F') value += c - 'A' + 10;
+          else if (c >= 'a' && c <= 'f') value += c - 'a' + 10;
+          else return false;
+        }
+
+      result += (char)value;
+      i += 2;
+    }
+
+  return true;
+}
+
+
+/*
+ * Performs the edits of a patch on one document.  Lookups by id go through
+ * a per list index that is built on first use and dropped when the list
+ * changes, so a patch is applied in time close to linear in its size.
+ */
+class SedPatchApplier
+{
+public:
+
+  SedPatchApplier(SedDocument* document)
+    : mDocument(document)
+  {
+  }
+
+
+  int apply(const SedEdit& edit)
+  {
+    SedBase* object = resolve(edit.getPath());
+    if (object == NULL) return LIBSEDML_INVALID_OBJECT;
+
+    switch (edit.getType())
+      {
+      case SEDML_EDIT_SET_ATTRIBUTE:
+        if (edit.getName() == "id") forgetIndex(object->getParentSedObject());
+        return object->setAttribute(edit.getName(), edit.getValue());
+
+      case SEDML_EDIT_UNSET_ATTRIBUTE:
+        if (edit.getName() == "id") forgetIndex(object->getParentSedObject());
+        return object->unsetAttribute(edit.getName());
+
+      case SEDML_EDIT_SET_CONTENT:
+        return setContent(mDocument, object, edit.getName(), &edit.getValue());
+
+      case SEDML_EDIT_UNSET_CONTENT:
+        return setContent(mDocument, object, edit.getName(), NULL);
+
+      case SEDML_EDIT_INSERT:
+        return insert(object, edit);
+
+      case SEDML_EDIT_REMOVE:
+        return remove(object, edit.getName());
+
+      case SEDML_EDIT_REORDER:
+        return reorder(object, edit.getOrder());
+      }
+
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+
+protected:
+
+  SedBase* resolve(const std::string& path)
+  {
+    if (path.empty() || path[0] != '/') return NULL;
+
+    SedBase* current = mDocument;
+    size_t start = 1;
+
+    while (current != NULL && start < path.size())
+      {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos) end = path.size();
+
+        current = getChild(current, path.substr(start, end - start));
+        start = end + 1;
+      }
+
+    return current;
+  }
+
+
+  SedBase* getChild(SedBase* parent, const std::string& step)
+  {
+    if (step.empty()) return NULL;
+
+    if (step[0] == '#' || step[0] == '@')
+      {
+        if (parent->getTypeCode() != SEDML_LIST_OF) return NULL;
+
+        SedListOf* list = static_cast<SedListOf*>(parent);
+
+        if (step[0] == '#')
+          {
+            int index;
+
+            if (!SedBase::attributeValueFromString(step.substr(1), index)
+                || index < 0)
+              return NULL;
+
+            return list->get((unsigned int)index);
+          }
+
+        std::map<const SedBase*, IdIndex>::iterator it = mIndices.find(list);
+
+        if (it == mIndices.end())
+          {
+            it = mIndices.insert(std::make_pair(list, IdIndex())).first;
+
+            for (unsigned int i = 0; i < list->size(); ++i)
+              {
+                std::string id = getItemId(list->get(i));
+
+                if (!id.empty())
+                  it->second.insert(std::make_pair(id, list->get(i)));
+              }
+          }
+
+        IdIndex::const_iterator item = it->second.find(step.substr(1));
+        return item != it->second.end() ? item->second : NULL;
+      }
+
+    std::vector<const SedBase*> children;
+    parent->getChildObjects(children);
+
+    // the children are owned by parent, which is not const
+    return const_cast<SedBase*>(findChild(children, step));
+  }
+
+
+  int insert(SedBase* parent, const SedEdit& edit)
+  {
+    if (!edit.isSetIndex())
+      {
+        return parent->createChildObject(edit.getName()) != NULL
+               ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_INVALID_OBJECT;
+      }
+
+    if (parent->getTypeCode() != SEDML_LIST_OF) return LIBSEDML_INVALID_OBJECT;
+
+    SedListOf* list = static_cast<SedListOf*>(parent);
+    if (edit.getIndex() > list->size()) return LIBSEDML_OPERATION_FAILED;
+
+    SedBase* item = list->createChildObject(edit.getName());
+    if (item == NULL) return LIBSEDML_INVALID_OBJECT;
+
+    forgetIndex(list);
+
+    if (edit.getIndex() + 1 < list->size())
+      {
+        list->remove(list->size() - 1);
+        return list->insertAndOwn((int)edit.getIndex(), item);
+      }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+  int remove(SedBase* parent, const std::string& key)
+  {
+    SedBase* child = getChild(parent, key);
+    if (child == NULL) return LIBSEDML_INVALID_OBJECT;
+
+    forgetSubtree(child);
+
+    if (parent->getTypeCode() == SEDML_LIST_OF)
+      {
+        SedListOf* list = static_cast<SedListOf*>(parent);
+        forgetIndex(list);
+
+        for (unsigned int i = 0; i < list->size(); ++i)
+          {
+            if (list->get(i) == child)
+              {
+                delete list->remove(i);
+                return LIBSEDML_OPERATION_SUCCESS;
+              }
+          }
+
+        return LIBSEDML_OPERATION_FAILED;
+      }
+
+    SedSimulation* simulation = dynamic_cast<SedSimulation*>(parent);
+
+    if (simulation != NULL && key == "algorithm")
+      return simulation->unsetAlgorithm();
+
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+
+  int reorder(SedBase* parent, const std::vector<unsigned int>& order)
+  {
+    if (parent->getTypeCode() != SEDML_LIST_OF) return LIBSEDML_INVALID_OBJECT;
+
+    SedListOf* list = static_cast<SedListOf*>(parent);
+    if (order.size() != list->size()) return LIBSEDML_OPERATION_FAILED;
+
+    std::vector<bool> seen(order.size(), false);
+
+    for (size_t i = 0; i < order.size(); ++i)
+      {
+        if (order[i] >= order.size() || seen[order[i]])
+          return LIBSEDML_OPERATION_FAILED;
+
+        seen[order[i]] = true;
+      }
+
+    std::vector<SedBase*> items(order.size());
+
+    for (unsigned int i = 0; i < list->size(); ++i)
+      items[i] = list->get(i);
+
+    list->clear(false);
+
+    for (size_t i = 0; i < order.size(); ++i)
+      list->appendAndOwn(items[order[i]]);
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+  void forgetIndex(const SedBase* list)
+  {
+    if (list != NULL) mIndices.erase(list);
+  }
+
+
+  /*
+   * Drops the indices of the lists inside an object that is about to be
+   * deleted, so that a new list at the same address is not mistaken for it.
+   */
+  void forgetSubtree(const SedBase* object)
+  {
+    if (mIndices.empty()) return;
+
+    forgetIndex(object);
+
+    std::vector<const SedBase*> children;
+    object->getChildObjects(children);
+
+    for (size_t i = 0; i < children.size(); ++i)
+      forgetSubtree(children[i]);
+  }
+
+
+  typedef std::map<std::string, SedBase*> IdIndex;
+
+  SedDocument* mDocument;
+  std::map<const SedBase*, IdIndex> mIndices;
+};
+
+/** @endcond */
+
+
+SedEdit::SedEdit(SedEditType_t type,
+                 const std::string& path,
+                 const std::string& name,
+                 const std::string& value)
+  : mType(type)
+  , mPath(path)
+  , mName(name)
+  , mValue(value)
+  , mIndex(0)
+  , mIsSetIndex(false)
+  , mOrder()
+{
+}
+
+
+SedEditType_t
+SedEdit::getType() const
+{
+  return mType;
+}
+
+
+const std::string&
+SedEdit::getPath() const
+{
+  return mPath;
+}
+
+
+const std::string&
+SedEdit::getName() const
+{
+  return mName;
+}
+
+
+const std::string&
+SedEdit::getValue() const
+{
+  return mValue;
+}
+
+
+void
+SedEdit::setIndex(unsigned int index)
+{
+  mIndex = index;
+  mIsSetIndex = true;
+}
+
+
+unsigned int
+SedEdit::getIndex() const
+{
+  return mIndex;
+}
+
+
+bool
+SedEdit::isSetIndex() const
+{
+  return mIsSetIndex;
+}
+
+
+const std::vector<unsigned int>&
+SedEdit::getOrder() const
+{
+  return mOrder;
+}
+
+
+std::vector<unsigned int>&
+SedEdit::getOrder()
+{
+  return mOrder;
+}
+
+
+std::string
+SedEdit::toString() const
+{
+  std::ostringstream line;
+  line << EDIT_KEYWORDS[mType] << ' ' << escapeField(mPath);
+
+  switch (mType)
+    {
+    case SEDML_EDIT_SET_ATTRIBUTE:
+    case SEDML_EDIT_SET_CONTENT:
+      line << ' ' << escapeField(mName) << ' ' << escapeField(mValue);
+      break;
+
+    case SEDML_EDIT_INSERT:
+      line << ' ' << escapeField(mName);
+      if (mIsSetIndex) line << ' ' << mIndex;
+      break;
+
+    case SEDML_EDIT_REORDER:
+      for (size_t i = 0; i < mOrder.size(); ++i)
+        line << ' ' << mOrder[i];
+      break;
+
+    default:
+      line << ' ' << escapeField(mName);
+      break;
+    }
+
+  return line.str();
+}
+
+
+SedPatch::SedPatch()
+  : mEdits()
+{
+}
+
+
+SedPatch*
+SedPatch::createDiff(const SedDocument* base, const SedDocument* target)
+{
+  if (base == NULL || target == NULL) return NULL;
+
+  SedPatch* patch = new SedPatch();
+  diffObjects(base, target, "/", patch->mEdits);
+  return patch;
+}
+
+
+SedPatch*
+SedPatch::fromString(const std::string& text)
+{
+  SedPatch* patch = new SedPatch();
+  std::istringstream lines(text);
+  std::string line;
+
+  while (std::getline(lines, line))
+    {
+      if (!line.empty() && line[line.size() - 1] == '\r')
+        line.erase(line.size() - 1);
+
+      if (line.empty() || line[0] == '#') continue;
+
+      std::vector<std::string> fields;
+      size_t start = 0;
+
+      while (true)
+        {
+          size_t end = line.find(' ', start);
+          std::string field;
+
+          if (!unescapeField(line.substr(start, end == std::string::npos
+                                                ? std::string::npos
+                                                : end - start), field))
+            {
+              delete patch;
+              return NULL;
+            }
+
+          fields.push_back(field);
+
+          if (end == std::string::npos) break;
+
+          start = end + 1;
+        }
+
+      unsigned int type = 0;
+
+      while (type < NUM_EDIT_KEYWORDS && fields[0] != EDIT_KEYWORDS[type])
+        ++type;
+
+      bool valid = type < NUM_EDIT_KEYWORDS && fields.size() >= 2;
+
+      if (valid)
+        {
+          switch ((SedEditType_t)type)
+            {
+            case SEDML_EDIT_SET_ATTRIBUTE:
+            case SEDML_EDIT_SET_CONTENT:
+              valid = fields.size() == 4;
+              break;
+
+            case SEDML_EDIT_INSERT:
+              valid = fields.size() == 3 || fields.size() == 4;
+              break;
+
+            case SEDML_EDIT_REORDER:
+              break;
+
+            default:
+              valid = fields.size() == 3;
+              break;
+            }
+        }
+
+      if (!valid)
+        {
+          delete patch;
+          return NULL;
+        }
+
+      SedEditType_t editType = (SedEditType_t)type;
+
+      if (editType == SEDML_EDIT_REORDER)
+        {
+          SedEdit edit(editType, fields[1]);
+
+          for (size_t i = 2; i < fields.size() && valid; ++i)
+            {
+              int position;
+              valid = SedBase::attributeValueFromString(fields[i], position)
+                      && position >= 0;
+              edit.getOrder().push_back((unsigned int)position);
+            }
+
+          patch->mEdits.push_back(edit);
+        }
+      else
+        {
+          SedEdit edit(editType, fields[1], fields[2],
+                       fields.size() == 4 && editType != SEDML_EDIT_INSERT
+                       ? fields[3] : std::string());
+
+          if (editType == SEDML_EDIT_INSERT && fields.size() == 4)
+            {
+              int index;
+              valid = SedBase::attributeValueFromString(fields[3], index)
+                      && index >= 0;
+              edit.setIndex((unsigned int)index);
+            }
+
+          patch->mEdits.push_back(edit);
+        }
+
+      if (!valid)
+        {
+          delete patch;
+          return NULL;
+        }
+    }
+
+  return patch;
+}
+
+
+std::string
+SedPatch::toString() const
+{
+  std::string text;
+
+  for (size_t i = 0; i < mEdits.size(); ++i)
+    {
+      text += mEdits[i].toString();
+      text += '\n';
+    }
+
+  return text;
+}
+
+
+int
+SedPatch::apply(SedDocument* document) const
+{
+  if (document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  // the edits are tried on a copy first, so that a failing edit leaves the
+  // document as it was; objects of the document keep their addresses
+  SedDocument* copy = document->clone();
+  SedPatchApplier trial(copy);
+
+  for (size_t i = 0; i < mEdits.size(); ++i)
+    {
+      int result = trial.apply(mEdits[i]);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS)
+        {
+          delete copy;
+          return result;
+        }
+    }
+
+  delete copy;
+
+  SedPatchApplier applier(document);
+
+  for (size_t i = 0; i < mEdits.size(); ++i)
+    {
+      int result = applier.apply(mEdits[i]);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS)
+        return result;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+void
+SedPatch::addEdit(const SedEdit& edit)
+{
+  mEdits.push_back(edit);
+}
+
+
+unsigned int
+SedPatch::getNumEdits() const
+{
+  return (unsigned int)mEdits.size();
+}
+
+
+const SedEdit*
+SedPatch::getEdit(unsigned int n) const
+{
+  return n < mEdits.size() ? &mEdits[n] : NULL;
+}
+
+
+bool
+SedPatch::isEmpty() const
+{
+  return mEdits.empty();
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+unsigned int
+SedPatch::getNumContentKinds()
+{
+  return NUM_CONTENT_KINDS;
+}
+
+
+const char*
+SedPatch::getContentKind(unsigned int n)
+{
+  return n < NUM_CONTENT_KINDS ? CONTENT_KINDS[n] : NULL;
+}
+
+
+bool
+SedPatch::getObjectContent(const SedBase* object, const std::string& kind,
+                           std::string& value)
+{
+  return object != NULL && getContent(object, kind, value);
+}
+
+
+int
+SedPatch::setObjectContent(SedDocument* document, SedBase* object,
+                           const std::string& kind, const std::string* value)
+{
+  if (document == NULL || object == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return setContent(document, object, kind, value);
+}
+
+
+const ASTNode*
+SedPatch::getObjectMath(const SedBase* object)
+{
+  return object != NULL ? getMathOf(object) : NULL;
+}
+
+
+int
+SedPatch::setObjectMath(SedBase* object, const ASTNode* math)
+{
+  if (object == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  // the setters copy the math
+  return setMathOf(object, const_cast<ASTNode*>(math));
+}
+
+/** @endcond */
+
+
+/**
+ * Computes the edits that turn one SedDocument_t structure into another.
+ * The returned SedPatch_t is owned by the caller.
+ */
+LIBSEDML_EXTERN
+SedPatch_t *
+SedPatch_createDiff(const SedDocument_t * base, const SedDocument_t * target)
+{
+  return SedPatch::createDiff(base, target);
+}
+
+
+/**
+ * Reads a SedPatch_t structure from its text form; returns NULL if the
+ * text is malformed.
+ */
+LIBSEDML_EXTERN
+SedPatch_t *
+SedPatch_fromString(const char * text)
+{
+  if (text == NULL) return NULL;
+
+  return SedPatch::fromString(text);
+}
+
+
+/**
+ * Returns the text form of the given SedPatch_t structure.  The returned
+ * string is owned by the caller.
+ */
+LIBSEDML_EXTERN
+char *
+SedPatch_toString(const SedPatch_t * sp)
+{
+  if (sp == NULL) return NULL;
+
+  return safe_strdup(sp->toString().c_str());
+}
+
+
+/**
+ * Applies the given SedPatch_t structure to a SedDocument_t structure.
+ */
+LIBSEDML_EXTERN
+int
+SedPatch_apply(const SedPatch_t * sp, SedDocument_t * sd)
+{
+  if (sp == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return sp->apply(sd);
+}
+
+
+/**
+ * Returns the number of edits in the given SedPatch_t structure.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedPatch_getNumEdits(const SedPatch_t * sp)
+{
+  return (sp != NULL) ? sp->getNumEdits() : 0;
+}
+
+
+/**
+ * Frees the given SedPatch_t structure.
+ */
+LIBSEDML_EXTERN
+void
+SedPatch_free(SedPatch_t * sp)
+{
+  delete sp;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
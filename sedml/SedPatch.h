@@ -0,0 +1,386 @@
+/**
+ * @file   SedPatch.h
+ * @brief  Structural differences between Sed documents
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedEdit
+ * @ingroup Core
+ * @brief A single operation of a SedPatch.
+ *
+ * @class SedPatch
+ * @ingroup Core
+ * @brief An edit script that turns one SedDocument into another.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * createDiff() compares two documents structurally and records the
+ * differences as a list of SedEdit operations; apply() performs them on
+ * the first document in place, after which it writes the same SED-ML as the
+ * second one.  apply() changes the document only if every edit succeeds.
+ *
+ * Objects are located by a path from the document, for example
+ * <code>/listOfTasks/\@task1/listOfSubTasks/#0</code>.  A path step is the
+ * element name of a list or of a single child (such as "algorithm"),
+ * followed for list items by either <code>\@id</code> or
+ * <code>#index</code>.  Items of a list are matched by id where the id is
+ * unique in both lists, and by position among the items of the same element
+ * name otherwise, so the comparison takes time close to linear in the size
+ * of the documents.
+ *
+ * Attributes are compared by their SED-ML text.  Math is carried as
+ * MathML, the XML of change elements and the NuML dimension description as
+ * XML, vector range values as a list of numbers.  Notes and annotations are
+ * compared as text.
+ *
+ * A patch can be written to and read from a compact line based text form
+ * with toString() and fromString().
+ */
+
+#ifndef SedPatch_h
+#define SedPatch_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * The operations a SedEdit can perform.
+ */
+typedef enum
+{
+    SEDML_EDIT_SET_ATTRIBUTE      /*!< Sets an attribute to a value */
+  , SEDML_EDIT_UNSET_ATTRIBUTE    /*!< Unsets an attribute */
+  , SEDML_EDIT_SET_CONTENT        /*!< Sets math, XML, values, notes or annotation */
+  , SEDML_EDIT_UNSET_CONTENT      /*!< Unsets math, XML, values, notes or annotation */
+  , SEDML_EDIT_INSERT             /*!< Creates a list item or a single child */
+  , SEDML_EDIT_REMOVE             /*!< Removes a list item or a single child */
+  , SEDML_EDIT_REORDER            /*!< Rearranges the items of a list */
+} SedEditType_t;
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+#include <sbml/math/ASTNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedEdit
+{
+public:
+
+  /**
+   * Creates a new SedEdit.
+   *
+   * @param type the operation.
+   * @param path the path of the object the operation applies to; for list
+   * operations, the path of the list.
+   * @param name the attribute name, the content kind ("notes",
+   * "annotation", "math", "newXML", "values" or "dimensionDescription"),
+   * the element name of the object to insert, or the key of the object to
+   * remove.
+   * @param value the new attribute value or content.
+   */
+  SedEdit(SedEditType_t type,
+          const std::string& path,
+          const std::string& name = "",
+          const std::string& value = "");
+
+
+  /**
+   * @return the operation of this SedEdit.
+   */
+  SedEditType_t getType() const;
+
+
+  /**
+   * @return the path of the object this SedEdit applies to.
+   */
+  const std::string& getPath() const;
+
+
+  /**
+   * @return the name of the attribute, content, element or key.
+   */
+  const std::string& getName() const;
+
+
+  /**
+   * @return the new value, for SEDML_EDIT_SET_ATTRIBUTE and
+   * SEDML_EDIT_SET_CONTENT.
+   */
+  const std::string& getValue() const;
+
+
+  /**
+   * Sets the position at which a SEDML_EDIT_INSERT creates its item.
+   *
+   * @param index the position in the list.
+   */
+  void setIndex(unsigned int index);
+
+
+  /**
+   * @return the position at which a SEDML_EDIT_INSERT creates its item.
+   */
+  unsigned int getIndex() const;
+
+
+  /**
+   * @return @c true if this SedEdit inserts into a list, @c false if it
+   * creates a single child.
+   */
+  bool isSetIndex() const;
+
+
+  /**
+   * Returns the new arrangement of a SEDML_EDIT_REORDER: item @em i of the
+   * list afterwards is the item at position <code>getOrder()[i]</code>
+   * before.
+   */
+  const std::vector<unsigned int>& getOrder() const;
+
+
+  /**
+   * @return the new arrangement of a SEDML_EDIT_REORDER, for modification.
+   */
+  std::vector<unsigned int>& getOrder();
+
+
+  /**
+   * @return this SedEdit as one line of the text form of a SedPatch,
+   * without the line break.
+   */
+  std::string toString() const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  SedEditType_t mType;
+  std::string mPath;
+  std::string mName;
+  std::string mValue;
+  unsigned int mIndex;
+  bool mIsSetIndex;
+  std::vector<unsigned int> mOrder;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedPatch
+{
+public:
+
+  /**
+   * Creates a new, empty SedPatch.
+   */
+  SedPatch();
+
+
+  /**
+   * Computes the edits that turn @p base into @p target.
+   *
+   * @param base the original document.
+   * @param target the modified document.
+   *
+   * @return the patch; it is empty if the documents do not differ.  The
+   * caller owns the returned object.
+   */
+  static SedPatch* createDiff(const SedDocument* base,
+                              const SedDocument* target);
+
+
+  /**
+   * Reads a patch from its text form, as written by toString().
+   *
+   * @param text the text form of a patch.
+   *
+   * @return the patch, or @c NULL if @p text is malformed.  The caller owns
+   * the returned object.
+   */
+  static SedPatch* fromString(const std::string& text);
+
+
+  /**
+   * @return the text form of this patch: one edit per line.
+   */
+  std::string toString() const;
+
+
+  /**
+   * Applies the edits of this patch, in order, to the given document.
+   * The edits are first tried on a copy of the document; if one of them
+   * fails, its result is returned and the document is left unchanged.
+   * Otherwise they are applied to the document itself, so pointers to its
+   * objects stay valid unless an edit removes them.
+   *
+   * @param document the document to modify.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  int apply(SedDocument* document) const;
+
+
+  /**
+   * Adds a copy of the given edit to the end of this patch.
+   *
+   * @param edit the edit to add.
+   */
+  void addEdit(const SedEdit& edit);
+
+
+  /**
+   * @return the number of edits in this patch.
+   */
+  unsigned int getNumEdits() const;
+
+
+  /**
+   * @return the edit with index @p n, or @c NULL if there is none.
+   */
+  const SedEdit* getEdit(unsigned int n) const;
+
+
+  /**
+   * @return @c true if this patch contains no edits.
+   */
+  bool isEmpty() const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+#ifndef SWIG
+
+  /*
+   * The content of an object besides its attributes and children, as
+   * compared and edited by patches: "notes", "annotation", "math",
+   * "newXML", "values" and "dimensionDescription", in that order.
+   */
+  static unsigned int getNumContentKinds();
+  static const char* getContentKind(unsigned int n);
+
+  /*
+   * Returns true and the content of the given kind as text if the object
+   * has such content.
+   */
+  static bool getObjectContent(const SedBase* object, const std::string& kind,
+                               std::string& value);
+
+  /*
+   * Sets or, if value is NULL, unsets the content of the given kind.
+   */
+  static int setObjectContent(SedDocument* document, SedBase* object,
+                              const std::string& kind,
+                              const std::string* value);
+
+  /*
+   * The math of data generators, compute changes, set values and
+   * functional ranges; NULL for other objects.  setObjectMath() copies
+   * the given math.
+   */
+  static const ASTNode* getObjectMath(const SedBase* object);
+  static int setObjectMath(SedBase* object, const ASTNode* math);
+
+#endif /* !SWIG */
+
+  /** @endcond */
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  std::vector<SedEdit> mEdits;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+LIBSEDML_EXTERN
+SedPatch_t *
+SedPatch_createDiff(const SedDocument_t * base, const SedDocument_t * target);
+
+LIBSEDML_EXTERN
+SedPatch_t *
+SedPatch_fromString(const char * text);
+
+LIBSEDML_EXTERN
+char *
+SedPatch_toString(const SedPatch_t * sp);
+
+LIBSEDML_EXTERN
+int
+SedPatch_apply(const SedPatch_t * sp, SedDocument_t * sd);
+
+LIBSEDML_EXTERN
+unsigned int
+SedPatch_getNumEdits(const SedPatch_t * sp);
+
+LIBSEDML_EXTERN
+void
+SedPatch_free(SedPatch_t * sp);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+#endif  /* SedPatch_h */
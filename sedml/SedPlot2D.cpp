@@ -189,6 +189,8 @@ SedPlot2D::isSetLogY() const
 int
 SedPlot2D::setLogX(bool logX)
 {
+  markDirty();
+
   mLogX = logX;
   mIsSetLogX = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -201,6 +203,8 @@ SedPlot2D::setLogX(bool logX)
 int
 SedPlot2D::setLogY(bool logY)
 {
+  markDirty();
+
   mLogY = logY;
   mIsSetLogY = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -213,6 +217,8 @@ SedPlot2D::setLogY(bool logY)
 int
 SedPlot2D::unsetLogX()
 {
+  markDirty();
+
   mLogX = false;
   mIsSetLogX = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -225,6 +231,8 @@ SedPlot2D::unsetLogX()
 int
 SedPlot2D::unsetLogY()
 {
+  markDirty();
+
   mLogY = false;
   mIsSetLogY = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -430,6 +438,125 @@ SedPlot2D::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedPlot2D to the vector.
+ */
+void
+SedPlot2D::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedOutput::getAttributeNames(names);
+
+  names.push_back("logX");
+  names.push_back("logY");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedPlot2D::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "logX")
+    {
+      return isSetLogX();
+    }
+  else if (attributeName == "logY")
+    {
+      return isSetLogY();
+    }
+
+  return SedOutput::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedPlot2D::getAttribute(const std::string& attributeName,
+                        std::string& value) const
+{
+  if (attributeName == "logX")
+    {
+      if (isSetLogX() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mLogX);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "logY")
+    {
+      if (isSetLogY() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mLogY);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedOutput::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedPlot2D::setAttribute(const std::string& attributeName,
+                        const std::string& value)
+{
+  if (attributeName == "logX")
+    {
+      bool parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setLogX(parsed);
+    }
+  else if (attributeName == "logY")
+    {
+      bool parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setLogY(parsed);
+    }
+
+  return SedOutput::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedPlot2D::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "logX")
+    {
+      return unsetLogX();
+    }
+  else if (attributeName == "logY")
+    {
+      return unsetLogY();
+    }
+
+  return SedOutput::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedPlot2D::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedOutput::getChildObjects(children);
+
+  children.push_back(&mCurves);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -458,8 +585,13 @@ SedPlot2D::writeElements(XMLOutputStream& stream) const
 bool
 SedPlot2D::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
 
+  return result;
 }
 
 
@@ -326,6 +326,18 @@ SedPlot3D::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedPlot3D::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedOutput::getChildObjects(children);
+
+  children.push_back(&mSurfaces);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -354,8 +366,13 @@ SedPlot3D::writeElements(XMLOutputStream& stream) const
 bool
 SedPlot3D::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
 
+  return result;
 }
 
 
@@ -0,0 +1,270 @@
+/**
+ * @file   SedPreparedTaskChanges.cpp
+ * @brief  Set values of a repeated task prepared for fast application
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedPreparedTaskChanges.h>
+#include <sedml/SedTypes.h>
+
+#include <limits>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+SedPreparedTaskChanges::SedPreparedTaskChanges(const SedRepeatedTask* task)
+  : mRangeIds()
+  , mSetValues()
+  , mInputs()
+  , mVariables()
+  , mValues()
+  , mTask(task)
+{
+  if (task == NULL) return;
+
+  std::map<std::string, unsigned int> ranges;
+
+  for (unsigned int n = 0; n < task->getNumRanges(); ++n)
+    {
+      ranges[task->getRange(n)->getId()] = n;
+      mRangeIds.push_back(task->getRange(n)->getId());
+      mInputs.push_back(0);
+    }
+
+  mSetValues.resize(task->getNumTaskChanges());
+  mValues.resize(mSetValues.size(), numeric_limits<double>::quiet_NaN());
+
+  for (unsigned int n = 0; n < mSetValues.size(); ++n)
+    {
+      const SedSetValue* setValue = task->getTaskChange(n);
+      Prepared& prepared = mSetValues[n];
+      prepared.setValue = setValue;
+      prepared.location = NULL;
+
+      // parameters and variables hide ranges of the same name
+      std::map<std::string, unsigned int> inputs = ranges;
+
+      for (unsigned int i = 0; i < setValue->getNumParameters(); ++i)
+        {
+          inputs[setValue->getParameter(i)->getId()] = (unsigned int)mInputs.size();
+          mInputs.push_back(setValue->getParameter(i)->getValue());
+        }
+
+      for (unsigned int i = 0; i < setValue->getNumVariables(); ++i)
+        {
+          const SedVariable* variable = setValue->getVariable(i);
+          inputs[variable->getId()] = (unsigned int)mInputs.size();
+          Variable input = { variable, setValue, (unsigned int)mInputs.size() };
+          mVariables.push_back(input);
+          mInputs.push_back(numeric_limits<double>::quiet_NaN());
+        }
+
+      prepared.math.compile(setValue->getMath(), inputs);
+    }
+}
+
+
+const SedRepeatedTask*
+SedPreparedTaskChanges::getTask() const
+{
+  return mTask;
+}
+
+
+unsigned int
+SedPreparedTaskChanges::getNumRanges() const
+{
+  return (unsigned int)mRangeIds.size();
+}
+
+
+const std::string&
+SedPreparedTaskChanges::getRangeId(unsigned int n) const
+{
+  static const std::string empty;
+  return n < mRangeIds.size() ? mRangeIds[n] : empty;
+}
+
+
+unsigned int
+SedPreparedTaskChanges::getNumSetValues() const
+{
+  return (unsigned int)mSetValues.size();
+}
+
+
+const SedSetValue*
+SedPreparedTaskChanges::getSetValue(unsigned int n) const
+{
+  return n < mSetValues.size() ? mSetValues[n].setValue : NULL;
+}
+
+
+bool
+SedPreparedTaskChanges::isCompiled(unsigned int n) const
+{
+  return n < mSetValues.size() && mSetValues[n].math.isCompiled();
+}
+
+
+int
+SedPreparedTaskChanges::bindModel(const std::string& modelReference,
+                                  SedTargetResolver* resolver)
+{
+  if (resolver == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  bool resolved = true;
+
+  for (size_t n = 0; n < mSetValues.size(); ++n)
+    {
+      Prepared& prepared = mSetValues[n];
+
+      if (prepared.setValue->getModelReference() != modelReference) continue;
+
+      const SedTargetHandle* handle = NULL;
+
+      if (prepared.setValue->isSetTarget())
+        handle = resolver->resolve(prepared.setValue->getTarget());
+
+      if (handle != NULL)
+        prepared.handle = *handle;
+      else
+        resolved = false;
+    }
+
+  // variables without a model of their own refer to that of the set value
+  for (size_t n = 0; n < mVariables.size(); ++n)
+    {
+      const SedVariable* variable = mVariables[n].variable;
+      const std::string& model = variable->isSetModelReference()
+                                 ? variable->getModelReference()
+                                 : mVariables[n].setValue->getModelReference();
+
+      if (model != modelReference) continue;
+
+      const SedTargetHandle* handle = variable->isSetTarget()
+                                      ? resolver->resolve(variable->getTarget()) : NULL;
+
+      if (handle == NULL || !handle->isAttribute()
+          || !SedBase::attributeValueFromString(handle->getValue(),
+                                                mInputs[mVariables[n].input]))
+        resolved = false;
+    }
+
+  return resolved ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+int
+SedPreparedTaskChanges::bindValue(unsigned int n, double* location)
+{
+  if (n >= mSetValues.size()) return LIBSEDML_INDEX_EXCEEDS_SIZE;
+
+  mSetValues[n].location = location;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+const SedTargetHandle*
+SedPreparedTaskChanges::getHandle(unsigned int n) const
+{
+  if (n >= mSetValues.size() || !mSetValues[n].handle.isValid()) return NULL;
+
+  return &mSetValues[n].handle;
+}
+
+
+int
+SedPreparedTaskChanges::apply(const double* rangeValues)
+{
+  size_t numRanges = mRangeIds.size();
+
+  if (rangeValues == NULL && numRanges > 0) return LIBSEDML_INVALID_OBJECT;
+
+  for (size_t n = 0; n < numRanges; ++n)
+    mInputs[n] = rangeValues[n];
+
+  const double* inputs = mInputs.empty() ? NULL : &mInputs[0];
+
+  for (size_t n = 0; n < mSetValues.size(); ++n)
+    {
+      const Prepared& prepared = mSetValues[n];
+
+      if (!prepared.math.isCompiled()) continue;
+
+      double value = prepared.math.evaluate(inputs);
+      mValues[n] = value;
+
+      if (prepared.location != NULL) *prepared.location = value;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+double
+SedPreparedTaskChanges::getValue(unsigned int n) const
+{
+  return n < mValues.size() ? mValues[n] : numeric_limits<double>::quiet_NaN();
+}
+
+
+unsigned int
+SedPreparedTaskChanges::writeValues() const
+{
+  unsigned int count = 0;
+
+  for (size_t n = 0; n < mSetValues.size(); ++n)
+    {
+      const SedTargetHandle& handle = mSetValues[n].handle;
+
+      if (!handle.isAttribute() || !mSetValues[n].math.isCompiled()) continue;
+
+      if (handle.setValue(SedBase::attributeValueToString(mValues[n]))
+          == LIBSEDML_OPERATION_SUCCESS)
+        ++count;
+    }
+
+  return count;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,256 @@
+/**
+ * @file   SedPreparedTaskChanges.h
+ * @brief  Set values of a repeated task prepared for fast application
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedPreparedTaskChanges
+ * @ingroup Core
+ * @brief The SedSetValue objects of a SedRepeatedTask, resolved and
+ * compiled once for all iterations.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * Each iteration of a SedRepeatedTask applies its list of task changes.
+ * SedPreparedTaskChanges does the work that is the same for every
+ * iteration up front: it compiles the math of each SedSetValue into a
+ * SedCompiledMath whose inputs are the values of the ranges of the task,
+ * the parameters of the set value and its variables, and it resolves the
+ * targets to SedTargetHandle objects once per model (bindModel()).
+ * Variables are read from the model when it is bound.
+ *
+ * apply() then takes the range values of one iteration, evaluates all set
+ * values and stores the results, writing each also to a location given
+ * with bindValue(), typically the corresponding entry of a simulator's
+ * parameter vector.  It allocates nothing unless the math of a set value
+ * is nested more deeply than SedCompiledMath::STACK_BUFFER_SIZE.
+ * writeValues() writes the current results into the model XML, for tools
+ * that simulate from XML.
+ */
+
+#ifndef SedPreparedTaskChanges_h
+#define SedPreparedTaskChanges_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedTargetResolver.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedRepeatedTask;
+class SedSetValue;
+class SedVariable;
+
+
+class LIBSEDML_EXTERN SedPreparedTaskChanges
+{
+public:
+
+  /**
+   * Prepares the task changes of the given repeated task and compiles
+   * their math.
+   *
+   * @param task the repeated task; it has to outlive this object and must
+   * not change while it is in use.
+   */
+  SedPreparedTaskChanges(const SedRepeatedTask* task);
+
+
+  /**
+   * @return the repeated task.
+   */
+  const SedRepeatedTask* getTask() const;
+
+
+  /**
+   * @return the number of ranges of the task, which is the number of
+   * values apply() expects.
+   */
+  unsigned int getNumRanges() const;
+
+
+  /**
+   * @param n the index of the range.
+   *
+   * @return the id of the nth range; apply() expects its value at index
+   * @p n.
+   */
+  const std::string& getRangeId(unsigned int n) const;
+
+
+  /**
+   * @return the number of set values.
+   */
+  unsigned int getNumSetValues() const;
+
+
+  /**
+   * @param n the index of the set value.
+   *
+   * @return the nth set value, or @c NULL if there is no such set value.
+   */
+  const SedSetValue* getSetValue(unsigned int n) const;
+
+
+  /**
+   * @param n the index of the set value.
+   *
+   * @return @c true if the math of the nth set value could be compiled.
+   * Set values whose math uses names other than the ranges, parameters and
+   * variables, or unsupported constructs, are skipped by apply().
+   */
+  bool isCompiled(unsigned int n) const;
+
+
+  /**
+   * Resolves the targets of the set values that refer to the given model,
+   * and reads the values of the variables that refer to it.
+   *
+   * @param modelReference the id of the model.
+   * @param resolver the resolver of the XML of the model; it has to
+   * outlive this object.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if a target or variable of that model could not be resolved
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   */
+  int bindModel(const std::string& modelReference, SedTargetResolver* resolver);
+
+
+  /**
+   * Makes apply() write the value of a set value to the given location.
+   *
+   * @param n the index of the set value.
+   * @param location where to write the value, or @c NULL.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INDEX_EXCEEDS_SIZE LIBSEDML_INDEX_EXCEEDS_SIZE @endlink
+   */
+  int bindValue(unsigned int n, double* location);
+
+
+  /**
+   * @param n the index of the set value.
+   *
+   * @return the handle of the target of the nth set value, or @c NULL if
+   * its model is not bound or the target could not be resolved.
+   */
+  const SedTargetHandle* getHandle(unsigned int n) const;
+
+
+  /**
+   * Evaluates all set values for one iteration.
+   *
+   * @param rangeValues the values of the ranges, in the order of
+   * getRangeId().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p rangeValues is @c NULL but the task has ranges
+   */
+  int apply(const double* rangeValues);
+
+
+  /**
+   * @param n the index of the set value.
+   *
+   * @return the value of the nth set value computed by the last call to
+   * apply(), or NaN.
+   */
+  double getValue(unsigned int n) const;
+
+
+  /**
+   * Writes the values computed by the last call to apply() to the targets
+   * resolved by bindModel().
+   *
+   * @return the number of values written.
+   */
+  unsigned int writeValues() const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Prepared
+  {
+    const SedSetValue* setValue;
+    SedCompiledMath math;
+    SedTargetHandle handle;
+    double* location;
+  };
+
+  struct Variable
+  {
+    const SedVariable* variable;
+    const SedSetValue* setValue;
+    unsigned int input;
+  };
+
+  std::vector<std::string> mRangeIds;
+  std::vector<Prepared> mSetValues;
+
+  // the ranges first, then the parameters and variables of each set value
+  std::vector<double> mInputs;
+  std::vector<Variable> mVariables;
+
+  std::vector<double> mValues;
+
+  const SedRepeatedTask* mTask;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedPreparedTaskChanges_h */
@@ -44,10 +44,14 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedError.h>
 #include <sedml/SedReader.h>
+#include <sedml/SedTrace.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/InputDecompressor.h>
 
+#include <cstring>
+#include <fstream>
+
 /** @cond doxygen-ignored */
 
 using namespace std;
@@ -60,6 +64,9 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new SedReader and returns it.
  */
 SedReader::SedReader()
+  : mTrace(NULL)
+  , mLazyNotesAndAnnotations(false)
+  , mElementFilter()
 {
 }
 
@@ -72,6 +79,89 @@ SedReader::~SedReader()
 }
 
 
+/*
+ * Sets the trace into which the documents read are recorded.
+ */
+void
+SedReader::setTrace(SedTrace* trace)
+{
+  mTrace = trace;
+}
+
+
+/*
+ * @return the trace into which the documents read are recorded.
+ */
+SedTrace*
+SedReader::getTrace() const
+{
+  return mTrace;
+}
+
+
+/*
+ * Sets whether notes and annotations are kept as text until first used.
+ */
+int
+SedReader::setLazyNotesAndAnnotations(bool lazy)
+{
+  mLazyNotesAndAnnotations = lazy;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if notes and annotations are kept as text until first used.
+ */
+bool
+SedReader::getLazyNotesAndAnnotations() const
+{
+  return mLazyNotesAndAnnotations;
+}
+
+
+/*
+ * Adds a type of object to read; all other types are skipped.
+ */
+int
+SedReader::addTypeToRead(int typeCode)
+{
+  return mElementFilter.addType(typeCode);
+}
+
+
+/*
+ * Adds a list to read with everything in it; all other lists are skipped.
+ */
+int
+SedReader::addListToRead(const std::string& listName)
+{
+  return mElementFilter.addList(listName);
+}
+
+
+/*
+ * Reads all elements again.
+ */
+int
+SedReader::clearElementsToRead()
+{
+  mElementFilter.clear();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if elements other than the types and lists added are
+ * skipped.
+ */
+bool
+SedReader::isSetElementsToRead() const
+{
+  return !mElementFilter.isEmpty();
+}
+
+
 /*
  * Reads an Sed document from the given file.  If filename does not exist
  * or is not an Sed file, an error will be logged.  Errors can be
@@ -227,6 +317,31 @@ SedReader::readInternal(const char* content, bool isFile)
   //  d->setURI(content);
   //}
 
+  // the objects read find the trace through their document
+  d->setTrace(mTrace);
+  d->setLazyNotesAndAnnotations(mLazyNotesAndAnnotations);
+
+  if (!mElementFilter.isEmpty())
+    {
+      mElementFilter.reset();
+      d->setElementFilter(&mElementFilter);
+    }
+
+  SedTraceScope scope(mTrace, SedTrace::PHASE_DOCUMENT, "read");
+
+  if (mTrace != NULL && content != NULL)
+    {
+      if (!isFile)
+        {
+          scope.addBytes(strlen(content));
+        }
+      else
+        {
+          ifstream file(content, ios::in | ios::binary | ios::ate);
+          if (file) scope.addBytes((uint64_t)file.tellg());
+        }
+    }
+
   if (isFile && content != NULL && (util_file_exists(content) == false))
     {
       d->getErrorLog()->logError(XMLFileUnreadable);
@@ -289,6 +404,10 @@ SedReader::readInternal(const char* content, bool isFile)
         }
     }
 
+  d->setTrace(NULL);
+  d->setLazyNotesAndAnnotations(false);
+  d->setElementFilter(NULL);
+
   return d;
 }
 /** @endcond */
@@ -319,6 +438,78 @@ SedReader_free(SedReader_t *sr)
 }
 
 
+/**
+ * Sets whether the given SedReader_t structure keeps the notes and
+ * annotations of the documents it reads as text until they are first used.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_setLazyNotesAndAnnotations(SedReader_t *sr, int lazy)
+{
+  if (sr != NULL)
+    return sr->setLazyNotesAndAnnotations(lazy != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * @return @c 1 if the given SedReader_t structure keeps notes and
+ * annotations as text, @c 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_getLazyNotesAndAnnotations(const SedReader_t *sr)
+{
+  return (sr != NULL) ? static_cast<int>(sr->getLazyNotesAndAnnotations()) : 0;
+}
+
+
+/**
+ * Adds a type of object that the given SedReader_t structure reads; once
+ * a type or a list has been added, all other elements are skipped.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_addTypeToRead(SedReader_t *sr, int typeCode)
+{
+  if (sr != NULL)
+    return sr->addTypeToRead(typeCode);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Adds a list that the given SedReader_t structure reads with everything
+ * in it; once a type or a list has been added, all other elements are
+ * skipped.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_addListToRead(SedReader_t *sr, const char *listName)
+{
+  if (sr != NULL && listName != NULL)
+    return sr->addListToRead(listName);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Makes the given SedReader_t structure read documents completely again.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_clearElementsToRead(SedReader_t *sr)
+{
+  if (sr != NULL)
+    return sr->clearElementsToRead();
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
 /**
  * Reads an Sed document from the given file.  If filename does not exist
  * or is not an Sed file, an error will be logged.  Errors can be
@@ -96,6 +96,7 @@
 
 #include <sedml/common/extern.h>
 #include <sedml/common/sedmlfwd.h>
+#include <sedml/SedElementFilter.h>
 #include <sbml/util/util.h>
 
 
@@ -107,6 +108,7 @@
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
 class SedDocument;
+class SedTrace;
 
 
 class LIBSEDML_EXTERN SedReader
@@ -128,6 +130,128 @@ public:
   virtual ~SedReader();
 
 
+  /**
+   * Sets the trace into which this SedReader records the timers and
+   * counters of the documents it reads.
+   *
+   * @param trace the SedTrace, which is not owned by this SedReader, or
+   * @c NULL to stop tracing.
+   *
+   * @see SedTrace
+   */
+  void setTrace(SedTrace* trace);
+
+
+  /**
+   * @return the trace of this SedReader, or @c NULL if it does not trace.
+   */
+  SedTrace* getTrace() const;
+
+
+  /**
+   * Sets whether the documents read by this SedReader keep the
+   * <code>&lt;notes&gt;</code> and <code>&lt;annotation&gt;</code>
+   * elements of their objects as text instead of parsing them.
+   *
+   * The text is parsed when the notes or annotation of an object are first
+   * requested, e.g. by SedBase::getNotes() or SedBase::getAnnotation(), or
+   * changed.  Until then, SedWriter copies it to its output as it was read,
+   * so that documents that are read and written again without looking at
+   * their notes and annotations pay for neither.  The namespaces of the
+   * top level elements of annotations are still checked while reading, so
+   * the error log of the document is complete when it is returned.
+   *
+   * The text is parsed by the first call of getNotes(), getAnnotation() or
+   * a method that uses them.  Parsing is done once, under a lock, so a
+   * document read this way can be read by several threads at once like any
+   * other.
+   *
+   * @param lazy whether notes and annotations are kept as text; the
+   * default is @c false.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   *
+   * @see getLazyNotesAndAnnotations()
+   */
+  int setLazyNotesAndAnnotations(bool lazy);
+
+
+  /**
+   * @return @c true if this SedReader keeps notes and annotations as
+   * text, @c false otherwise.
+   *
+   * @see setLazyNotesAndAnnotations(bool lazy)
+   */
+  bool getLazyNotesAndAnnotations() const;
+
+
+  /**
+   * Adds a type of object that the documents read by this SedReader
+   * contain; once a type or a list has been added, objects of all other
+   * types are skipped while reading.
+   *
+   * Skipped elements are passed over by the XML tokenizer: no objects are
+   * created for them or for anything they contain, and no errors are
+   * logged about them.  An object is only read if the object containing it
+   * is, so e.g. reading the KiSAO ids of the simulations takes
+   * #SEDML_SIMULATION and #SEDML_SIMULATION_ALGORITHM.  The type codes of
+   * abstract classes select all their subclasses, e.g. #SEDML_SIMULATION
+   * selects <code>&lt;uniformTimeCourse&gt;</code>,
+   * <code>&lt;oneStep&gt;</code> and <code>&lt;steadyState&gt;</code>.
+   * Lists are read when the type of their items is, and notes,
+   * annotations and math are read with the object containing them.
+   *
+   * @param typeCode the SedTypeCode_t of the objects to read.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   *
+   * @see addListToRead(const std::string& listName)
+   * @see clearElementsToRead()
+   */
+  int addTypeToRead(int typeCode);
+
+
+  /**
+   * Adds a list, e.g. <code>"listOfModels"</code>, that the documents read
+   * by this SedReader contain together with everything in it; once a type
+   * or a list has been added, everything else is skipped while reading.
+   *
+   * @param listName the element name of the list.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   *
+   * @see addTypeToRead(int typeCode)
+   * @see clearElementsToRead()
+   */
+  int addListToRead(const std::string& listName);
+
+
+  /**
+   * Removes all types and lists added, so that documents are read
+   * completely again.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int clearElementsToRead();
+
+
+  /**
+   * @return @c true if types or lists to read were added, i.e. this
+   * SedReader skips the other elements, @c false otherwise.
+   */
+  bool isSetElementsToRead() const;
+
+
   /**
    * Reads an Sed document from a file.
    *
@@ -460,6 +584,10 @@ protected:
    */
   SedDocument* readInternal(const char* content, bool isFile = true);
 
+  SedTrace* mTrace;
+  bool mLazyNotesAndAnnotations;
+  SedElementFilter mElementFilter;
+
   /** @endcond */
 };
 
@@ -490,6 +618,51 @@ void
 SedReader_free(SedReader_t *sr);
 
 
+/**
+ * Sets whether the given SedReader_t structure keeps the notes and
+ * annotations of the documents it reads as text until they are first used.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_setLazyNotesAndAnnotations(SedReader_t *sr, int lazy);
+
+
+/**
+ * @return @c 1 if the given SedReader_t structure keeps notes and
+ * annotations as text, @c 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_getLazyNotesAndAnnotations(const SedReader_t *sr);
+
+
+/**
+ * Adds a type of object that the given SedReader_t structure reads; once
+ * a type or a list has been added, all other elements are skipped.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_addTypeToRead(SedReader_t *sr, int typeCode);
+
+
+/**
+ * Adds a list that the given SedReader_t structure reads with everything
+ * in it; once a type or a list has been added, all other elements are
+ * skipped.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_addListToRead(SedReader_t *sr, const char *listName);
+
+
+/**
+ * Makes the given SedReader_t structure read documents completely again.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_clearElementsToRead(SedReader_t *sr);
+
+
 /**
  * Reads an Sed document from the given file.  If filename does not exist
  * or is not an Sed file, an error will be logged.  Errors can be
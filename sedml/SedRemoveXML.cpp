@@ -181,8 +181,13 @@ SedRemoveXML::writeElements(XMLOutputStream& stream) const
 bool
 SedRemoveXML::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
 
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
 }
 
 
@@ -193,13 +193,15 @@ SedRepeatedTask::isSetResetModel() const
 int
 SedRepeatedTask::setRangeId(const std::string& rangeId)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(rangeId)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mRangeId = rangeId;
+      mRangeId = internString(rangeId);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -211,6 +213,8 @@ SedRepeatedTask::setRangeId(const std::string& rangeId)
 int
 SedRepeatedTask::setResetModel(bool resetModel)
 {
+  markDirty();
+
   mResetModel = resetModel;
   mIsSetResetModel = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -223,6 +227,8 @@ SedRepeatedTask::setResetModel(bool resetModel)
 int
 SedRepeatedTask::unsetRangeId()
 {
+  markDirty();
+
   mRangeId.erase();
 
   if (mRangeId.empty() == true)
@@ -242,6 +248,8 @@ SedRepeatedTask::unsetRangeId()
 int
 SedRepeatedTask::unsetResetModel()
 {
+  markDirty();
+
   mResetModel = false;
   mIsSetResetModel = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -737,6 +745,122 @@ SedRepeatedTask::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedRepeatedTask to the vector.
+ */
+void
+SedRepeatedTask::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedTask::getAttributeNames(names);
+
+  names.push_back("range");
+  names.push_back("resetModel");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedRepeatedTask::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "range")
+    {
+      return isSetRangeId();
+    }
+  else if (attributeName == "resetModel")
+    {
+      return isSetResetModel();
+    }
+
+  return SedTask::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedRepeatedTask::getAttribute(const std::string& attributeName,
+                              std::string& value) const
+{
+  if (attributeName == "range")
+    {
+      if (isSetRangeId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mRangeId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "resetModel")
+    {
+      if (isSetResetModel() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mResetModel);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedTask::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedRepeatedTask::setAttribute(const std::string& attributeName,
+                              const std::string& value)
+{
+  if (attributeName == "range")
+    {
+      return setRangeId(value);
+    }
+  else if (attributeName == "resetModel")
+    {
+      bool parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setResetModel(parsed);
+    }
+
+  return SedTask::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedRepeatedTask::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "range")
+    {
+      return unsetRangeId();
+    }
+  else if (attributeName == "resetModel")
+    {
+      return unsetResetModel();
+    }
+
+  return SedTask::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedRepeatedTask::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedTask::getChildObjects(children);
+
+  children.push_back(&mRanges);
+  children.push_back(&mTaskChanges);
+  children.push_back(&mSubTasks);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -775,8 +899,47 @@ SedRepeatedTask::writeElements(XMLOutputStream& stream) const
 bool
 SedRepeatedTask::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedRepeatedTask::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedTask::addMemoryFootprint(footprint);
+
+  footprint.addString(mRangeId);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedRepeatedTask::internStrings()
+{
+  SedTask::internStrings();
 
+  reinternString(mRangeId);
 }
 
 
@@ -835,7 +998,7 @@ SedRepeatedTask::readAttributes(const XMLAttributes& attributes,
   //
   // rangeId SIdRef   ( use = "optional" )
   //
-  assigned = attributes.readInto("range", mRangeId, getErrorLog(), false);
+  assigned = readInto(attributes, "range", mRangeId, false);
 
   if (assigned == true)
     {
@@ -326,6 +326,18 @@ SedReport::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedReport::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedOutput::getChildObjects(children);
+
+  children.push_back(&mDataSets);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -354,8 +366,13 @@ SedReport::writeElements(XMLOutputStream& stream) const
 bool
 SedReport::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
 
+  return result;
 }
 
 
@@ -319,6 +319,15 @@ public:
   virtual bool hasRequiredElements() const;
 
 
+  /**
+   * Adds the SEDML objects directly contained in this SedReport object to
+   * @p children, in the order in which they are written.
+   *
+   * @param children the vector to which the child objects are appended.
+   */
+  virtual void getChildObjects(std::vector<const SedBase*>& children) const;
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
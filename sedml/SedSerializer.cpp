@@ -0,0 +1,708 @@
+/**
+ * @file   SedSerializer.cpp
+ * @brief  Compact serialization of Sed objects
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedSerializer.h>
+#include <sedml/SedTypes.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include <sbml/math/ASTNode.h>
+#include <sbml/xml/XMLNamespaces.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+namespace
+{
+
+/*
+ * The serialized form is a sequence of
+ *
+ *   numbers: decimal digits, then ';'
+ *   strings: the byte length, then ':' and the bytes the first time a
+ *            string occurs; its index among the strings so far, then '#',
+ *            each time after that
+ *
+ * It starts with the magic string, the path from the document to the
+ * serialized object as child indices, the level and version and the
+ * namespaces of the document, followed by the document itself.  Each
+ * object is written as its element name, its attributes as name and value
+ * pairs, 0 or 1 followed by its math, its other content as kind and text
+ * pairs, and its children.  Empty lists without attributes are left out.
+ */
+const char* const MAGIC = "sedml-serialized-1";
+
+
+class Writer
+{
+public:
+  string data;
+
+  void number(long value)
+  {
+    char text[32];
+    sprintf(text, "%ld;", value);
+    data += text;
+  }
+
+  void str(const string& value)
+  {
+    map<string, long>::const_iterator it = mIndices.find(value);
+    char text[32];
+
+    if (it != mIndices.end())
+      {
+        sprintf(text, "%ld#", it->second);
+        data += text;
+        return;
+      }
+
+    long index = (long)mIndices.size();
+    mIndices.insert(make_pair(value, index));
+    sprintf(text, "%lu:", (unsigned long)value.size());
+    data += text;
+    data += value;
+  }
+
+  void math(const ASTNode* node)
+  {
+    ASTNodeType_t type = node->getType();
+    number((long)type);
+
+    if (type == AST_INTEGER)
+      {
+        number(node->getInteger());
+      }
+    else if (type == AST_RATIONAL)
+      {
+        number(node->getNumerator());
+        number(node->getDenominator());
+      }
+    else if (type == AST_REAL_E)
+      {
+        str(SedBase::attributeValueToString(node->getMantissa()));
+        number(node->getExponent());
+      }
+    else if (type == AST_REAL)
+      {
+        str(SedBase::attributeValueToString(node->getReal()));
+      }
+    else if (node->isName() || type == AST_FUNCTION
+             || type == AST_FUNCTION_DELAY)
+      {
+        str(node->getName() != NULL ? node->getName() : "");
+      }
+
+    number((long)node->getNumChildren());
+
+    for (unsigned int n = 0; n < node->getNumChildren(); ++n)
+      math(node->getChild(n));
+  }
+
+  void object(const SedBase* object)
+  {
+    str(object->getElementName());
+
+    vector<string> names;
+    object->getAttributeNames(names);
+    vector<string> values(names.size());
+    long numSet = 0;
+
+    for (size_t n = 0; n < names.size(); ++n)
+      {
+        if (object->isSetAttribute(names[n])
+            && object->getAttribute(names[n], values[n])
+               == LIBSEDML_OPERATION_SUCCESS)
+          ++numSet;
+        else
+          names[n].clear();
+      }
+
+    number(numSet);
+
+    for (size_t n = 0; n < names.size(); ++n)
+      {
+        if (names[n].empty()) continue;
+
+        str(names[n]);
+        str(values[n]);
+      }
+
+    const ASTNode* math = SedPatch::getObjectMath(object);
+    number(math != NULL ? 1 : 0);
+    if (math != NULL) this->math(math);
+
+    vector<const char*> kinds;
+    vector<string> contents;
+    string content;
+
+    for (unsigned int n = 0; n < SedPatch::getNumContentKinds(); ++n)
+      {
+        const char* kind = SedPatch::getContentKind(n);
+        if (string(kind) == "math") continue;
+
+        if (SedPatch::getObjectContent(object, kind, content))
+          {
+            kinds.push_back(kind);
+            contents.push_back(content);
+          }
+      }
+
+    number((long)kinds.size());
+
+    for (size_t n = 0; n < kinds.size(); ++n)
+      {
+        str(kinds[n]);
+        str(contents[n]);
+      }
+
+    vector<const SedBase*> children;
+    object->getChildObjects(children);
+
+    vector<const SedBase*> written;
+    for (size_t n = 0; n < children.size(); ++n)
+      {
+        if (!isEmptyList(children[n])) written.push_back(children[n]);
+      }
+
+    number((long)written.size());
+
+    for (size_t n = 0; n < written.size(); ++n)
+      this->object(written[n]);
+  }
+
+  static bool isEmptyList(const SedBase* object)
+  {
+    if (object->getTypeCode() != SEDML_LIST_OF) return false;
+
+    const SedListOf* list = static_cast<const SedListOf*>(object);
+    return list->size() == 0 && !list->isSetMetaId() && !list->isSetNotes()
+           && !list->isSetAnnotation();
+  }
+
+private:
+  map<string, long> mIndices;
+};
+
+
+class Reader
+{
+public:
+  Reader(const string& data) : mData(data), mPos(0), mGood(true) {}
+
+  bool good() const { return mGood; }
+
+  long number()
+  {
+    long value = 0;
+    char terminator = 0;
+    if (!digits(value, terminator) || terminator != ';') mGood = false;
+    return value;
+  }
+
+  const string& str()
+  {
+    static const string empty;
+    long value = 0;
+    char terminator = 0;
+
+    if (!digits(value, terminator) || value < 0)
+      {
+        mGood = false;
+        return empty;
+      }
+
+    if (terminator == '#')
+      {
+        if ((size_t)value >= mStrings.size())
+          {
+            mGood = false;
+            return empty;
+          }
+
+        return mStrings[(size_t)value];
+      }
+
+    if (terminator != ':' || mData.size() - mPos < (size_t)value)
+      {
+        mGood = false;
+        return empty;
+      }
+
+    mStrings.push_back(mData.substr(mPos, (size_t)value));
+    mPos += (size_t)value;
+    return mStrings.back();
+  }
+
+  ASTNode* math()
+  {
+    ASTNodeType_t type = (ASTNodeType_t)number();
+    if (!mGood) return NULL;
+
+    ASTNode* node = new ASTNode(type);
+
+    if (type == AST_INTEGER)
+      {
+        node->setValue(number());
+      }
+    else if (type == AST_RATIONAL)
+      {
+        long numerator = number();
+        node->setValue(numerator, number());
+      }
+    else if (type == AST_REAL_E)
+      {
+        double mantissa = 0;
+        SedBase::attributeValueFromString(str(), mantissa);
+        node->setValue(mantissa, number());
+      }
+    else if (type == AST_REAL)
+      {
+        double value = 0;
+        if (!SedBase::attributeValueFromString(str(), value)) mGood = false;
+        node->setValue(value);
+      }
+    else if (node->isName() || type == AST_FUNCTION
+             || type == AST_FUNCTION_DELAY)
+      {
+        const string& name = str();
+        if (!name.empty()) node->setName(name.c_str());
+      }
+
+    long numChildren = number();
+
+    for (long n = 0; n < numChildren && mGood; ++n)
+      {
+        ASTNode* child = math();
+        if (child != NULL) node->addChild(child);
+      }
+
+    if (!mGood)
+      {
+        delete node;
+        return NULL;
+      }
+
+    return node;
+  }
+
+  /*
+   * Reads the record of an object into the existing object.
+   */
+  void object(SedDocument* document, SedBase* object)
+  {
+    long numAttributes = number();
+
+    for (long n = 0; n < numAttributes && mGood; ++n)
+      {
+        string name = str();
+        const string& value = str();
+
+        if (mGood && object->setAttribute(name, value)
+                     != LIBSEDML_OPERATION_SUCCESS)
+          mGood = false;
+      }
+
+    if (number() == 1 && mGood)
+      {
+        ASTNode* math = this->math();
+
+        if (math == NULL
+            || SedPatch::setObjectMath(object, math)
+               != LIBSEDML_OPERATION_SUCCESS)
+          mGood = false;
+
+        delete math;
+      }
+
+    long numContents = number();
+
+    for (long n = 0; n < numContents && mGood; ++n)
+      {
+        string kind = str();
+        const string& content = str();
+
+        if (mGood && SedPatch::setObjectContent(document, object, kind, &content)
+                     != LIBSEDML_OPERATION_SUCCESS)
+          mGood = false;
+      }
+
+    long numChildren = number();
+
+    for (long n = 0; n < numChildren && mGood; ++n)
+      {
+        const string& name = str();
+        if (!mGood) return;
+
+        SedBase* child = findList(object, name);
+        if (child == NULL) child = object->createChildObject(name);
+
+        if (child == NULL)
+          {
+            mGood = false;
+            return;
+          }
+
+        this->object(document, child);
+      }
+  }
+
+  size_t getPosition() const { return mPos; }
+
+private:
+  bool digits(long& value, char& terminator)
+  {
+    bool negative = mPos < mData.size() && mData[mPos] == '-';
+    if (negative) ++mPos;
+
+    size_t start = mPos;
+    value = 0;
+
+    while (mPos < mData.size() && mData[mPos] >= '0' && mData[mPos] <= '9')
+      value = value * 10 + (mData[mPos++] - '0');
+
+    if (mPos == start || mPos >= mData.size()) return false;
+
+    if (negative) value = -value;
+    terminator = mData[mPos++];
+    return true;
+  }
+
+  /*
+   * The list with the given element name among the children of object;
+   * lists are created with their parent and cannot be created again.
+   */
+  static SedBase* findList(SedBase* object, const string& name)
+  {
+    vector<const SedBase*> children;
+    object->getChildObjects(children);
+
+    for (size_t n = 0; n < children.size(); ++n)
+      {
+        if (children[n]->getTypeCode() == SEDML_LIST_OF
+            && children[n]->getElementName() == name)
+          return const_cast<SedBase*>(children[n]);
+      }
+
+    return NULL;
+  }
+
+  const string& mData;
+  size_t mPos;
+  bool mGood;
+  vector<string> mStrings;
+};
+
+
+/*
+ * Reads the header up to the namespaces.
+ */
+bool
+readHeader(Reader& reader, vector<long>& path, long& level, long& version)
+{
+  if (reader.str() != MAGIC) return false;
+
+  long length = reader.number();
+  for (long n = 0; n < length && reader.good(); ++n)
+    path.push_back(reader.number());
+
+  level = reader.number();
+  version = reader.number();
+  return reader.good();
+}
+
+
+/*
+ * Appends to path the indices that lead from the document down to object,
+ * as positions among the children returned by getChildObjects().
+ */
+bool
+getPath(const SedBase* object, vector<long>& path)
+{
+  const SedBase* parent = object->getParentSedObject();
+  if (parent == NULL) return object->getTypeCode() == SEDML_DOCUMENT;
+
+  if (!getPath(parent, path)) return false;
+
+  vector<const SedBase*> children;
+  parent->getChildObjects(children);
+
+  for (size_t n = 0; n < children.size(); ++n)
+    {
+      if (children[n] == object)
+        {
+          path.push_back((long)n);
+          return true;
+        }
+    }
+
+  return false;
+}
+
+
+/*
+ * The top level element that contains object, or NULL.
+ */
+const SedBase*
+getTopLevelElement(const SedBase* object)
+{
+  while (object != NULL)
+    {
+      const SedBase* list = object->getParentSedObject();
+      if (list == NULL) return NULL;
+
+      const SedBase* parent = list->getParentSedObject();
+      if (parent != NULL && parent->getTypeCode() == SEDML_DOCUMENT)
+        return object;
+
+      object = list;
+    }
+
+  return NULL;
+}
+
+}
+
+/** @endcond */
+
+
+std::string
+SedSerializer::serialize(const SedBase* object)
+{
+  if (object == NULL) return "";
+
+  // the document that is written, and the object in it
+  const SedDocument* document = NULL;
+  const SedBase* target = object;
+  SedDocument* context = NULL;
+
+  if (object->getTypeCode() == SEDML_DOCUMENT)
+    {
+      document = static_cast<const SedDocument*>(object);
+    }
+  else if (object->getSedDocument() != NULL)
+    {
+      const SedBase* top = getTopLevelElement(object);
+      if (top == NULL) return "";
+
+      // the position of object below its top level element
+      vector<long> below;
+      vector<long> above;
+      if (!getPath(object, below) || !getPath(top, above)) return "";
+      below.erase(below.begin(), below.begin() + above.size());
+
+      SedDependencyGraph graph(object->getSedDocument());
+      context = graph.extract(vector<const SedBase*>(1, top));
+      if (context == NULL) return "";
+
+      // the copy keeps its place among the other copies of the same kind
+      const SedListOf* list =
+        static_cast<const SedListOf*>(top->getParentSedObject());
+      const SedBase* copy = NULL;
+      vector<const SedBase*> lists;
+      context->getChildObjects(lists);
+
+      for (size_t n = 0; n < lists.size() && copy == NULL; ++n)
+        {
+          if (lists[n]->getElementName() != list->getElementName()) continue;
+
+          const SedListOf* copies = static_cast<const SedListOf*>(lists[n]);
+          for (unsigned int i = 0; i < copies->size() && copy == NULL; ++i)
+            {
+              if (copies->get(i)->getId() == top->getId())
+                copy = copies->get(i);
+            }
+        }
+
+      if (copy == NULL)
+        {
+          delete context;
+          return "";
+        }
+
+      target = copy;
+      for (size_t n = 0; n < below.size() && target != NULL; ++n)
+        {
+          vector<const SedBase*> children;
+          target->getChildObjects(children);
+          target = (size_t)below[n] < children.size() ? children[below[n]] : NULL;
+        }
+
+      document = context;
+    }
+  else
+    {
+      // a detached top level element goes into the list that takes it
+      context = new SedDocument(object->getLevel(), object->getVersion());
+
+      vector<const SedBase*> lists;
+      context->getChildObjects(lists);
+
+      for (size_t n = 0; n < lists.size(); ++n)
+        {
+          SedListOf* list =
+            const_cast<SedListOf*>(static_cast<const SedListOf*>(lists[n]));
+
+          if (list->append(object) == LIBSEDML_OPERATION_SUCCESS)
+            {
+              target = list->get(list->size() - 1);
+              break;
+            }
+        }
+
+      document = context;
+      if (target == object) target = NULL;
+    }
+
+  vector<long> path;
+  if (target == NULL || !getPath(target, path))
+    {
+      delete context;
+      return "";
+    }
+
+  Writer writer;
+  writer.str(MAGIC);
+  writer.number((long)path.size());
+  for (size_t n = 0; n < path.size(); ++n)
+    writer.number(path[n]);
+
+  writer.number((long)document->getLevel());
+  writer.number((long)document->getVersion());
+
+  const XMLNamespaces* namespaces = document->getNamespaces();
+  int numNamespaces = namespaces != NULL ? namespaces->getNumNamespaces() : 0;
+  writer.number(numNamespaces);
+
+  for (int n = 0; n < numNamespaces; ++n)
+    {
+      writer.str(namespaces->getPrefix(n));
+      writer.str(namespaces->getURI(n));
+    }
+
+  writer.object(document);
+
+  delete context;
+  return writer.data;
+}
+
+
+SedDocument*
+SedSerializer::deserialize(const std::string& data)
+{
+  Reader reader(data);
+  vector<long> path;
+  long level = 0;
+  long version = 0;
+
+  if (!readHeader(reader, path, level, version) || level <= 0 || version <= 0)
+    return NULL;
+
+  SedDocument* document = new SedDocument((unsigned int)level,
+                                          (unsigned int)version);
+
+  long numNamespaces = reader.number();
+  XMLNamespaces namespaces;
+
+  for (long n = 0; n < numNamespaces && reader.good(); ++n)
+    {
+      string prefix = reader.str();
+      const string& uri = reader.str();
+      namespaces.add(uri, prefix);
+    }
+
+  if (numNamespaces > 0 && reader.good())
+    document->setNamespaces(&namespaces);
+
+  if (reader.good() && reader.str() != document->getElementName())
+    {
+      delete document;
+      return NULL;
+    }
+
+  reader.object(document, document);
+
+  if (!reader.good() || reader.getPosition() != data.size())
+    {
+      delete document;
+      return NULL;
+    }
+
+  return document;
+}
+
+
+SedBase*
+SedSerializer::getObject(SedDocument* document, const std::string& data)
+{
+  if (document == NULL) return NULL;
+
+  Reader reader(data);
+  vector<long> path;
+  long level = 0;
+  long version = 0;
+
+  if (!readHeader(reader, path, level, version)) return NULL;
+
+  SedBase* object = document;
+
+  for (size_t n = 0; n < path.size() && object != NULL; ++n)
+    {
+      vector<const SedBase*> children;
+      object->getChildObjects(children);
+
+      // the children are owned by object, which is not const
+      object = path[n] >= 0 && (size_t)path[n] < children.size()
+               ? const_cast<SedBase*>(children[(size_t)path[n]]) : NULL;
+    }
+
+  return object;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
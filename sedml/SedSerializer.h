@@ -0,0 +1,131 @@
+/**
+ * @file   SedSerializer.h
+ * @brief  Compact serialization of Sed objects
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedSerializer
+ * @ingroup Core
+ * @brief Writes Sed objects to a compact form that is much faster to read
+ * back than SED-ML.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * Handing a document to another process, as Python's pickle does for
+ * multiprocessing, does not need XML: the other side only has to rebuild
+ * the same objects.  serialize() writes the object tree with the generic
+ * attribute interface of SedBase, math as a prefix walk of its ASTNode
+ * tree and notes, annotations and other XML content as text.  Every
+ * string is written once and referred to by number afterwards, so the ids
+ * and references repeated all over a document cost little.  deserialize()
+ * creates the objects with createChildObject() and setAttribute(), which
+ * avoids the XML parser entirely except for notes, annotations and XML
+ * changes.
+ *
+ * An object inside a document is written together with what it needs: a
+ * document with a copy of the object and everything it depends on, as
+ * built by SedDependencyGraph::extract(), and the position of the copy in
+ * it.  deserialize() returns that document, and getObject() finds the
+ * copy.  A top level element that is not part of a document is written
+ * in a document of its own.
+ *
+ * The format is text, so it passes through every language binding as a
+ * string; it is not meant to be stored, and may change between releases.
+ */
+
+#ifndef SedSerializer_h
+#define SedSerializer_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedSerializer
+{
+public:
+
+  /**
+   * Writes an object, with the context it needs, to a string.
+   *
+   * @param object a document, an object inside a document, or a top level
+   * element (model, simulation, task, data generator, output or data
+   * description) that is not part of a document.
+   *
+   * @return the serialized form, or an empty string if @p object is
+   * @c NULL or cannot be serialized.
+   */
+  static std::string serialize(const SedBase* object);
+
+
+  /**
+   * Rebuilds the document written by serialize().
+   *
+   * @param data the serialized form.
+   *
+   * @return the document, owned by the caller, or @c NULL if @p data is
+   * malformed.
+   */
+  static SedDocument* deserialize(const std::string& data);
+
+
+  /**
+   * Finds the object that was passed to serialize() in the document
+   * rebuilt from its serialized form.
+   *
+   * @param document the document returned by deserialize() for @p data.
+   * @param data the serialized form.
+   *
+   * @return the object, which is owned by @p document and may be the
+   * document itself, or @c NULL if @p data is malformed.
+   */
+  static SedBase* getObject(SedDocument* document, const std::string& data);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedSerializer_h */
@@ -259,13 +259,15 @@ SedSetValue::isSetMath() const
 int
 SedSetValue::setRange(const std::string& range)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(range)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mRange = range;
+      mRange = internString(range);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -277,13 +279,15 @@ SedSetValue::setRange(const std::string& range)
 int
 SedSetValue::setModelReference(const std::string& modelReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(modelReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mModelReference = modelReference;
+      mModelReference = internString(modelReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -295,8 +299,10 @@ SedSetValue::setModelReference(const std::string& modelReference)
 int
 SedSetValue::setSymbol(const std::string& symbol)
 {
+  markDirty();
+
   {
-    mSymbol = symbol;
+    mSymbol = internString(symbol);
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -308,8 +314,10 @@ SedSetValue::setSymbol(const std::string& symbol)
 int
 SedSetValue::setTarget(const std::string& target)
 {
+  markDirty();
+
   {
-    mTarget = target;
+    mTarget = internString(target);
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -321,6 +329,8 @@ SedSetValue::setTarget(const std::string& target)
 int
 SedSetValue::setMath(ASTNode* math)
 {
+  markDirty();
+
   if (mMath == math)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -356,6 +366,8 @@ SedSetValue::setMath(ASTNode* math)
 int
 SedSetValue::unsetRange()
 {
+  markDirty();
+
   mRange.erase();
 
   if (mRange.empty() == true)
@@ -375,6 +387,8 @@ SedSetValue::unsetRange()
 int
 SedSetValue::unsetModelReference()
 {
+  markDirty();
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -394,6 +408,8 @@ SedSetValue::unsetModelReference()
 int
 SedSetValue::unsetSymbol()
 {
+  markDirty();
+
   mSymbol.erase();
 
   if (mSymbol.empty() == true)
@@ -413,6 +429,8 @@ SedSetValue::unsetSymbol()
 int
 SedSetValue::unsetTarget()
 {
+  markDirty();
+
   mTarget.erase();
 
   if (mTarget.empty() == true)
@@ -432,6 +450,8 @@ SedSetValue::unsetTarget()
 int
 SedSetValue::unsetMath()
 {
+  markDirty();
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -767,6 +787,156 @@ SedSetValue::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedSetValue to the vector.
+ */
+void
+SedSetValue::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("range");
+  names.push_back("modelReference");
+  names.push_back("symbol");
+  names.push_back("target");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedSetValue::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "range")
+    {
+      return isSetRange();
+    }
+  else if (attributeName == "modelReference")
+    {
+      return isSetModelReference();
+    }
+  else if (attributeName == "symbol")
+    {
+      return isSetSymbol();
+    }
+  else if (attributeName == "target")
+    {
+      return isSetTarget();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedSetValue::getAttribute(const std::string& attributeName,
+                          std::string& value) const
+{
+  if (attributeName == "range")
+    {
+      if (isSetRange() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mRange;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "modelReference")
+    {
+      if (isSetModelReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mModelReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "symbol")
+    {
+      if (isSetSymbol() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mSymbol;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "target")
+    {
+      if (isSetTarget() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mTarget;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedSetValue::setAttribute(const std::string& attributeName,
+                          const std::string& value)
+{
+  if (attributeName == "range")
+    {
+      return setRange(value);
+    }
+  else if (attributeName == "modelReference")
+    {
+      return setModelReference(value);
+    }
+  else if (attributeName == "symbol")
+    {
+      return setSymbol(value);
+    }
+  else if (attributeName == "target")
+    {
+      return setTarget(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedSetValue::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "range")
+    {
+      return unsetRange();
+    }
+  else if (attributeName == "modelReference")
+    {
+      return unsetModelReference();
+    }
+  else if (attributeName == "symbol")
+    {
+      return unsetSymbol();
+    }
+  else if (attributeName == "target")
+    {
+      return unsetTarget();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedSetValue::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedBase::getChildObjects(children);
+
+  children.push_back(&mVariables);
+  children.push_back(&mParameters);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -805,8 +975,54 @@ SedSetValue::writeElements(XMLOutputStream& stream) const
 bool
 SedSetValue::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedSetValue::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
 
+  footprint.addString(mRange);
+  footprint.addString(mModelReference);
+  footprint.addString(mSymbol);
+  footprint.addString(mTarget);
+  footprint.addMath(mMath);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedSetValue::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mRange);
+  reinternString(mModelReference);
+  reinternString(mSymbol);
+  reinternString(mTarget);
 }
 
 
@@ -866,7 +1082,7 @@ SedSetValue::readAttributes(const XMLAttributes& attributes,
   //
   // range SIdRef   ( use = "optional" )
   //
-  assigned = attributes.readInto("range", mRange, getErrorLog(), false);
+  assigned = readInto(attributes, "range", mRange, false);
 
   if (assigned == true)
     {
@@ -885,7 +1101,7 @@ SedSetValue::readAttributes(const XMLAttributes& attributes,
   //
   // modelReference SIdRef   ( use = "required" )
   //
-  assigned = attributes.readInto("modelReference", mModelReference, getErrorLog(), true);
+  assigned = readInto(attributes, "modelReference", mModelReference, true);
 
   if (assigned == true)
     {
@@ -904,7 +1120,7 @@ SedSetValue::readAttributes(const XMLAttributes& attributes,
   //
   // symbol string   ( use = "optional" )
   //
-  assigned = attributes.readInto("symbol", mSymbol, getErrorLog(), false);
+  assigned = readInto(attributes, "symbol", mSymbol, false);
 
   if (assigned == true)
     {
@@ -919,7 +1135,7 @@ SedSetValue::readAttributes(const XMLAttributes& attributes,
   //
   // target string   ( use = "optional" )
   //
-  assigned = attributes.readInto("target", mTarget, getErrorLog(), false);
+  assigned = readInto(attributes, "target", mTarget, false);
 
   if (assigned == true)
     {
@@ -1146,6 +1362,8 @@ SedListOfTaskChanges::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedSetValue*>(item);
@@ -1183,15 +1401,12 @@ SedListOfTaskChanges::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedSetValue in this SedListOfTaskChanges
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfTaskChanges::createObject(XMLInputStream& stream)
+SedListOfTaskChanges::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "setValue")
@@ -1204,6 +1419,18 @@ SedListOfTaskChanges::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedSetValue in this SedListOfTaskChanges
+ */
+SedBase*
+SedListOfTaskChanges::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -181,7 +181,11 @@ SedSimulation::getAlgorithm()
 SedAlgorithm*
 SedSimulation::createAlgorithm()
 {
-  mAlgorithm = new SedAlgorithm();
+  markDirty();
+
+  delete mAlgorithm;
+  mAlgorithm = new SedAlgorithm(getSedNamespaces());
+  mAlgorithm->connectToParent(this);
   return mAlgorithm;
 }
 
@@ -222,7 +226,9 @@ SedSimulation::isSetAlgorithm() const
 int
 SedSimulation::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -232,6 +238,8 @@ SedSimulation::setId(const std::string& id)
 int
 SedSimulation::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -245,6 +253,8 @@ SedSimulation::setName(const std::string& name)
 int
 SedSimulation::setAlgorithm(SedAlgorithm* algorithm)
 {
+  markDirty();
+
   if (mAlgorithm == algorithm)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -277,6 +287,8 @@ SedSimulation::setAlgorithm(SedAlgorithm* algorithm)
 int
 SedSimulation::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -296,6 +308,8 @@ SedSimulation::unsetId()
 int
 SedSimulation::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -315,6 +329,8 @@ SedSimulation::unsetName()
 int
 SedSimulation::unsetAlgorithm()
 {
+  markDirty();
+
   delete mAlgorithm;
   mAlgorithm = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -404,6 +420,130 @@ SedSimulation::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedSimulation to the vector.
+ */
+void
+SedSimulation::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedSimulation::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedSimulation::getAttribute(const std::string& attributeName,
+                            std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedSimulation::setAttribute(const std::string& attributeName,
+                            const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedSimulation::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
+/*
+ * Adds the directly contained SEDML objects to the vector.
+ */
+void
+SedSimulation::getChildObjects(std::vector<const SedBase*>& children) const
+{
+  SedBase::getChildObjects(children);
+
+  if (mAlgorithm != NULL) children.push_back(mAlgorithm);
+}
+
+
+/*
+ * Creates the child object for the given element name.
+ */
+SedBase*
+SedSimulation::createChildObject(const std::string& elementName)
+{
+  if (elementName == "algorithm")
+    {
+      return createAlgorithm();
+    }
+
+  return NULL;
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -432,8 +572,48 @@ SedSimulation::writeElements(XMLOutputStream& stream) const
 bool
 SedSimulation::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedSimulation::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mName);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedSimulation::internStrings()
+{
+  SedBase::internStrings();
 
+  reinternString(mId);
 }
 
 
@@ -492,7 +672,7 @@ SedSimulation::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -738,6 +918,8 @@ SedListOfSimulations::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedSimulation*>(item);
@@ -775,15 +957,12 @@ SedListOfSimulations::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedSimulation in this SedListOfSimulations
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfSimulations::createObject(XMLInputStream& stream)
+SedListOfSimulations::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "uniformTimeCourse")
@@ -808,6 +987,18 @@ SedListOfSimulations::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedSimulation in this SedListOfSimulations
+ */
+SedBase*
+SedListOfSimulations::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
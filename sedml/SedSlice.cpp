@@ -177,6 +177,8 @@ SedSlice::isSetValue() const
 int
 SedSlice::setReference(const std::string& reference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(reference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -195,6 +197,8 @@ SedSlice::setReference(const std::string& reference)
 int
 SedSlice::setValue(const std::string& value)
 {
+  markDirty();
+
   {
     mValue = value;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -208,6 +212,8 @@ SedSlice::setValue(const std::string& value)
 int
 SedSlice::unsetReference()
 {
+  markDirty();
+
   mReference.erase();
 
   if (mReference.empty() == true)
@@ -227,6 +233,8 @@ SedSlice::unsetReference()
 int
 SedSlice::unsetValue()
 {
+  markDirty();
+
   mValue.erase();
 
   if (mValue.empty() == true)
@@ -318,6 +326,103 @@ SedSlice::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedSlice to the vector.
+ */
+void
+SedSlice::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("reference");
+  names.push_back("value");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedSlice::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "reference")
+    {
+      return isSetReference();
+    }
+  else if (attributeName == "value")
+    {
+      return isSetValue();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedSlice::getAttribute(const std::string& attributeName,
+                       std::string& value) const
+{
+  if (attributeName == "reference")
+    {
+      if (isSetReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "value")
+    {
+      if (isSetValue() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mValue;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedSlice::setAttribute(const std::string& attributeName,
+                       const std::string& value)
+{
+  if (attributeName == "reference")
+    {
+      return setReference(value);
+    }
+  else if (attributeName == "value")
+    {
+      return setValue(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedSlice::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "reference")
+    {
+      return unsetReference();
+    }
+  else if (attributeName == "value")
+    {
+      return unsetValue();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -341,8 +446,31 @@ SedSlice::writeElements(XMLOutputStream& stream) const
 bool
 SedSlice::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
 
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedSlice::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mReference);
+  footprint.addString(mValue);
 }
 
 
@@ -608,6 +736,8 @@ SedListOfSlices::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedSlice*>(item);
@@ -645,15 +775,12 @@ SedListOfSlices::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedSlice in this SedListOfSlices
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfSlices::createObject(XMLInputStream& stream)
+SedListOfSlices::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "slice")
@@ -666,6 +793,18 @@ SedListOfSlices::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedSlice in this SedListOfSlices
+ */
+SedBase*
+SedListOfSlices::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -181,8 +181,13 @@ SedSteadyState::writeElements(XMLOutputStream& stream) const
 bool
 SedSteadyState::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
 
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
 }
 
 
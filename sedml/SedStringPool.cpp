@@ -0,0 +1,453 @@
+/**
+ * @file   SedStringPool.cpp
+ * @brief  Strings shared by the objects of a document
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedStringPool.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/** @cond doxygen-libsedml-internal */
+
+/* the pool does not purge before it holds this many strings */
+static const size_t MIN_PURGE_SIZE = 1024;
+
+
+/*
+ * Reference counts are shared by copies made on different threads, so
+ * they are only changed with these; both return the new count.
+ */
+static long
+incrementRefs(volatile long* refs)
+{
+#ifdef _WIN32
+  return InterlockedIncrement(refs);
+#else
+  return __sync_add_and_fetch(refs, 1);
+#endif
+}
+
+
+static long
+decrementRefs(volatile long* refs)
+{
+#ifdef _WIN32
+  return InterlockedDecrement(refs);
+#else
+  return __sync_sub_and_fetch(refs, 1);
+#endif
+}
+
+
+static const std::string&
+emptyString()
+{
+  static const std::string empty;
+  return empty;
+}
+
+/** @endcond */
+
+
+SedString::SedString()
+  : mRep(NULL)
+{
+}
+
+
+SedString::SedString(const char* value)
+  : mRep(NULL)
+{
+  *this = value;
+}
+
+
+SedString::SedString(const std::string& value)
+  : mRep(NULL)
+{
+  *this = value;
+}
+
+
+SedString::SedString(const SedString& orig)
+  : mRep(orig.mRep)
+{
+  if (mRep != NULL) incrementRefs(&mRep->refs);
+}
+
+
+SedString&
+SedString::operator=(const SedString& rhs)
+{
+  if (rhs.mRep != NULL) incrementRefs(&rhs.mRep->refs);
+
+  release();
+  mRep = rhs.mRep;
+  return *this;
+}
+
+
+SedString&
+SedString::operator=(const std::string& rhs)
+{
+  release();
+
+  if (!rhs.empty())
+    {
+      mRep = new Rep;
+      mRep->value = rhs;
+      mRep->refs = 1;
+      mRep->pool = NULL;
+    }
+
+  return *this;
+}
+
+
+SedString&
+SedString::operator=(const char* rhs)
+{
+  if (rhs == NULL || *rhs == '\0')
+    {
+      release();
+      return *this;
+    }
+
+  return *this = std::string(rhs);
+}
+
+
+SedString::~SedString()
+{
+  release();
+}
+
+
+SedString::operator const std::string&() const
+{
+  return str();
+}
+
+
+const std::string&
+SedString::str() const
+{
+  return mRep != NULL ? mRep->value : emptyString();
+}
+
+
+const char*
+SedString::c_str() const
+{
+  return str().c_str();
+}
+
+
+std::string::size_type
+SedString::size() const
+{
+  return mRep != NULL ? mRep->value.size() : 0;
+}
+
+
+bool
+SedString::empty() const
+{
+  return mRep == NULL;
+}
+
+
+void
+SedString::erase()
+{
+  release();
+}
+
+
+std::string::size_type
+SedString::find(char c, std::string::size_type pos) const
+{
+  return str().find(c, pos);
+}
+
+
+std::string
+SedString::substr(std::string::size_type pos, std::string::size_type n) const
+{
+  return str().substr(pos, n);
+}
+
+
+bool
+SedString::isSameAs(const SedString& other) const
+{
+  return mRep == other.mRep;
+}
+
+
+bool
+SedString::equals(const SedString& other) const
+{
+  if (mRep == other.mRep) return true;
+
+  if (mRep == NULL || other.mRep == NULL) return false;
+
+  // a pool holds each value once
+  if (mRep->pool != NULL && mRep->pool == other.mRep->pool) return false;
+
+  return mRep->value == other.mRep->value;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+SedString::SedString(Rep* rep)
+  : mRep(rep)
+{
+  if (mRep != NULL) incrementRefs(&mRep->refs);
+}
+
+
+void
+SedString::release()
+{
+  if (mRep != NULL && decrementRefs(&mRep->refs) == 0) delete mRep;
+
+  mRep = NULL;
+}
+
+/** @endcond */
+
+
+bool
+operator==(const SedString& lhs, const SedString& rhs)
+{
+  return lhs.equals(rhs);
+}
+
+
+bool
+operator==(const SedString& lhs, const std::string& rhs)
+{
+  return lhs.str() == rhs;
+}
+
+
+bool
+operator==(const std::string& lhs, const SedString& rhs)
+{
+  return lhs == rhs.str();
+}
+
+
+bool
+operator==(const SedString& lhs, const char* rhs)
+{
+  return rhs != NULL && strcmp(lhs.c_str(), rhs) == 0;
+}
+
+
+bool
+operator==(const char* lhs, const SedString& rhs)
+{
+  return rhs == lhs;
+}
+
+
+bool
+operator!=(const SedString& lhs, const SedString& rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+bool
+operator!=(const SedString& lhs, const std::string& rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+bool
+operator!=(const std::string& lhs, const SedString& rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+bool
+operator!=(const SedString& lhs, const char* rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+bool
+operator!=(const char* lhs, const SedString& rhs)
+{
+  return !(rhs == lhs);
+}
+
+
+SedStringPool::SedStringPool()
+  : mStrings()
+  , mEnabled(true)
+  , mPurgeSize(MIN_PURGE_SIZE)
+{
+}
+
+
+SedStringPool::~SedStringPool()
+{
+  std::map<const std::string*, SedString::Rep*, Less>::iterator it =
+    mStrings.begin();
+
+  for (; it != mStrings.end(); ++it)
+    {
+      SedString::Rep* rep = it->second;
+      rep->pool = NULL;
+
+      if (decrementRefs(&rep->refs) == 0) delete rep;
+    }
+}
+
+
+SedString
+SedStringPool::intern(const std::string& value)
+{
+  if (value.empty()) return SedString();
+
+  if (!mEnabled) return SedString(value);
+
+  std::map<const std::string*, SedString::Rep*, Less>::const_iterator it =
+    mStrings.find(&value);
+
+  if (it != mStrings.end()) return SedString(it->second);
+
+  // purging at twice the size left by the last purge keeps the cost
+  // constant per string and the unused strings fewer than the used ones
+  if (mStrings.size() >= mPurgeSize)
+    {
+      purge();
+      mPurgeSize = std::max(MIN_PURGE_SIZE, 2 * mStrings.size());
+    }
+
+  // the pool holds one reference
+  SedString::Rep* rep = new SedString::Rep;
+  rep->value = value;
+  rep->refs = 1;
+  rep->pool = this;
+  mStrings[&rep->value] = rep;
+
+  return SedString(rep);
+}
+
+
+void
+SedStringPool::setEnabled(bool enabled)
+{
+  mEnabled = enabled;
+}
+
+
+bool
+SedStringPool::isEnabled() const
+{
+  return mEnabled;
+}
+
+
+unsigned int
+SedStringPool::getNumStrings() const
+{
+  return (unsigned int)mStrings.size();
+}
+
+
+size_t
+SedStringPool::getNumCharacters() const
+{
+  size_t count = 0;
+  std::map<const std::string*, SedString::Rep*, Less>::const_iterator it =
+    mStrings.begin();
+
+  for (; it != mStrings.end(); ++it)
+    count += it->first->size();
+
+  return count;
+}
+
+
+unsigned int
+SedStringPool::purge()
+{
+  unsigned int count = 0;
+  std::map<const std::string*, SedString::Rep*, Less>::iterator it =
+    mStrings.begin();
+
+  while (it != mStrings.end())
+    {
+      if (it->second->refs > 1)
+        {
+          ++it;
+          continue;
+        }
+
+      delete it->second;
+      mStrings.erase(it++);
+      ++count;
+    }
+
+  return count;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,342 @@
+/**
+ * @file   SedStringPool.h
+ * @brief  Strings shared by the objects of a document
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedString
+ * @ingroup Core
+ * @brief An immutable string whose storage can be shared.
+ *
+ * @class SedStringPool
+ * @ingroup Core
+ * @brief Interns the ids and references of the objects of a document.
+ *
+ * <em style='color: #555'>These classes of objects are defined by libSed
+ * only and have no direct equivalent in terms of Sed components.</em>
+ *
+ * The same strings occur many times in a document: the id of a task is
+ * repeated by every variable, sub-task and set value that refers to it,
+ * and KiSAO ids, targets and symbols are repeated across data generators.
+ * Sed objects keep ids, references, KiSAO ids, targets and symbols as
+ * SedString values, which are a single pointer to reference counted
+ * storage; copies share that storage.
+ *
+ * Each SedDocument owns a SedStringPool.  Values read from a file or set
+ * on an object that belongs to a document are interned in its pool, so
+ * each distinct string is stored once per document.  Two strings interned
+ * in the same pool are equal if and only if they share storage, so
+ * comparing them is a pointer comparison.  Strings stay valid when the
+ * pool or the document is destroyed; only sharing ends.
+ *
+ * An object that is added to a document, including the objects of a copy
+ * of a document, interns its strings in the pool of that document again,
+ * so two documents never share storage.  A copy of an object that does
+ * not belong to a document shares the storage of the original until it
+ * is added to one.
+ *
+ * The reference counts are changed atomically, so several threads can
+ * copy the objects of a document that none of them changes, and release
+ * their copies, at the same time.  Interning is not synchronized: like
+ * the objects it serves, a pool is changed by one thread at a time.
+ *
+ * The pool keeps a string until purge() finds it unused.  intern()
+ * purges the pool whenever the number of strings has doubled since the
+ * last purge, so a document that is edited for a long time holds at most
+ * about twice as many strings as its objects use.
+ */
+
+#ifndef SedStringPool_h
+#define SedStringPool_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/libsedml-namespace.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedStringPool;
+
+
+class LIBSEDML_EXTERN SedString
+{
+public:
+
+  /**
+   * Creates an empty SedString.
+   */
+  SedString();
+
+
+  /**
+   * Creates a SedString holding a copy of the given value.
+   */
+  SedString(const char* value);
+
+
+  /**
+   * Creates a SedString holding a copy of the given value.
+   */
+  SedString(const std::string& value);
+
+
+  /**
+   * Creates a SedString sharing the storage of another.
+   */
+  SedString(const SedString& orig);
+
+
+  /**
+   * Assigns another SedString, sharing its storage.
+   */
+  SedString& operator=(const SedString& rhs);
+
+
+  /**
+   * Assigns a copy of the given value.
+   */
+  SedString& operator=(const std::string& rhs);
+
+
+  /**
+   * Assigns a copy of the given value.
+   */
+  SedString& operator=(const char* rhs);
+
+
+  /**
+   * Destroys this SedString.
+   */
+  ~SedString();
+
+
+  /**
+   * @return the value of this SedString.
+   */
+  operator const std::string&() const;
+
+
+  /**
+   * @return the value of this SedString.
+   */
+  const std::string& str() const;
+
+
+  /**
+   * @return the value of this SedString as a C string.
+   */
+  const char* c_str() const;
+
+
+  /**
+   * @return the number of characters of this SedString.
+   */
+  std::string::size_type size() const;
+
+
+  /**
+   * @return @c true if this SedString is empty.
+   */
+  bool empty() const;
+
+
+  /**
+   * Makes this SedString empty.
+   */
+  void erase();
+
+
+  /**
+   * @return the position of the first occurrence of @p c at or after
+   * @p pos, or @c std::string::npos.
+   */
+  std::string::size_type find(char c, std::string::size_type pos = 0) const;
+
+
+  /**
+   * @return the characters from @p pos on, at most @p n of them.
+   */
+  std::string substr(std::string::size_type pos = 0,
+                     std::string::size_type n = std::string::npos) const;
+
+
+  /**
+   * @return @c true if this SedString shares its storage with @p other,
+   * which implies that their values are equal.
+   */
+  bool isSameAs(const SedString& other) const;
+
+
+  /**
+   * @return @c true if the values of this SedString and @p other are
+   * equal; for strings interned in the same pool only their storage is
+   * compared.
+   */
+  bool equals(const SedString& other) const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  friend class SedStringPool;
+  friend class SedMemoryFootprint;
+
+  struct Rep
+  {
+    std::string value;
+    volatile long refs;
+    const SedStringPool* pool;
+  };
+
+  explicit SedString(Rep* rep);
+
+  void release();
+
+  Rep* mRep;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_EXTERN bool operator==(const SedString& lhs, const SedString& rhs);
+LIBSEDML_EXTERN bool operator==(const SedString& lhs, const std::string& rhs);
+LIBSEDML_EXTERN bool operator==(const std::string& lhs, const SedString& rhs);
+LIBSEDML_EXTERN bool operator==(const SedString& lhs, const char* rhs);
+LIBSEDML_EXTERN bool operator==(const char* lhs, const SedString& rhs);
+LIBSEDML_EXTERN bool operator!=(const SedString& lhs, const SedString& rhs);
+LIBSEDML_EXTERN bool operator!=(const SedString& lhs, const std::string& rhs);
+LIBSEDML_EXTERN bool operator!=(const std::string& lhs, const SedString& rhs);
+LIBSEDML_EXTERN bool operator!=(const SedString& lhs, const char* rhs);
+LIBSEDML_EXTERN bool operator!=(const char* lhs, const SedString& rhs);
+
+
+class LIBSEDML_EXTERN SedStringPool
+{
+public:
+
+  /**
+   * Creates a new, empty SedStringPool.
+   */
+  SedStringPool();
+
+
+  /**
+   * Destroys this SedStringPool; strings it interned remain valid.
+   */
+  ~SedStringPool();
+
+
+  /**
+   * Returns the interned copy of a value, adding it if it is not yet in
+   * this pool.
+   *
+   * @param value the value.
+   *
+   * @return the interned SedString, or an unshared one if interning is
+   * disabled.
+   */
+  SedString intern(const std::string& value);
+
+
+  /**
+   * Sets whether values are interned; when disabled, intern() returns a
+   * new SedString for every value.  Strings interned before are kept.
+   */
+  void setEnabled(bool enabled);
+
+
+  /**
+   * @return @c true if values are interned.
+   */
+  bool isEnabled() const;
+
+
+  /**
+   * @return the number of distinct strings in this pool.
+   */
+  unsigned int getNumStrings() const;
+
+
+  /**
+   * @return the number of characters of the distinct strings in this
+   * pool.
+   */
+  size_t getNumCharacters() const;
+
+
+  /**
+   * Removes the strings that are no longer used by any object.  This is
+   * done by intern() as the pool grows; calling it directly releases the
+   * memory earlier.
+   *
+   * @return the number of strings removed.
+   */
+  unsigned int purge();
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Less
+  {
+    bool operator()(const std::string* lhs, const std::string* rhs) const
+    {
+      return *lhs < *rhs;
+    }
+  };
+
+  // keys point to the value of the entry
+  std::map<const std::string*, SedString::Rep*, Less> mStrings;
+  bool mEnabled;
+  size_t mPurgeSize;
+
+  /** @endcond */
+
+private:
+  SedStringPool(const SedStringPool&);
+  SedStringPool& operator=(const SedStringPool&);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedStringPool_h */
@@ -169,6 +169,8 @@ SedSubTask::isSetTask() const
 int
 SedSubTask::setOrder(int order)
 {
+  markDirty();
+
   mOrder = order;
   mIsSetOrder = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -181,13 +183,15 @@ SedSubTask::setOrder(int order)
 int
 SedSubTask::setTask(const std::string& task)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(task)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mTask = task;
+      mTask = internString(task);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -199,6 +203,8 @@ SedSubTask::setTask(const std::string& task)
 int
 SedSubTask::unsetOrder()
 {
+  markDirty();
+
   mOrder = SEDML_INT_MAX;
   mIsSetOrder = false;
 
@@ -219,6 +225,8 @@ SedSubTask::unsetOrder()
 int
 SedSubTask::unsetTask()
 {
+  markDirty();
+
   mTask.erase();
 
   if (mTask.empty() == true)
@@ -271,6 +279,108 @@ SedSubTask::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedSubTask to the vector.
+ */
+void
+SedSubTask::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("order");
+  names.push_back("task");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedSubTask::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "order")
+    {
+      return isSetOrder();
+    }
+  else if (attributeName == "task")
+    {
+      return isSetTask();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedSubTask::getAttribute(const std::string& attributeName,
+                         std::string& value) const
+{
+  if (attributeName == "order")
+    {
+      if (isSetOrder() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mOrder);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "task")
+    {
+      if (isSetTask() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mTask;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedSubTask::setAttribute(const std::string& attributeName,
+                         const std::string& value)
+{
+  if (attributeName == "order")
+    {
+      int parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setOrder(parsed);
+    }
+  else if (attributeName == "task")
+    {
+      return setTask(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedSubTask::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "order")
+    {
+      return unsetOrder();
+    }
+  else if (attributeName == "task")
+    {
+      return unsetTask();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -294,8 +404,47 @@ SedSubTask::writeElements(XMLOutputStream& stream) const
 bool
 SedSubTask::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedSubTask::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mTask);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedSubTask::internStrings()
+{
+  SedBase::internStrings();
 
+  reinternString(mTask);
 }
 
 
@@ -356,7 +505,7 @@ SedSubTask::readAttributes(const XMLAttributes& attributes,
   //
   // task SIdRef   ( use = "required" )
   //
-  assigned = attributes.readInto("task", mTask, getErrorLog(), true);
+  assigned = readInto(attributes, "task", mTask, true);
 
   if (assigned == true)
     {
@@ -551,6 +700,8 @@ SedListOfSubTasks::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedSubTask*>(item);
@@ -588,15 +739,12 @@ SedListOfSubTasks::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedSubTask in this SedListOfSubTasks
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfSubTasks::createObject(XMLInputStream& stream)
+SedListOfSubTasks::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "subTask")
@@ -609,6 +757,18 @@ SedListOfSubTasks::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedSubTask in this SedListOfSubTasks
+ */
+SedBase*
+SedListOfSubTasks::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -169,6 +169,8 @@ SedSurface::isSetZDataReference() const
 int
 SedSurface::setLogZ(bool logZ)
 {
+  markDirty();
+
   mLogZ = logZ;
   mIsSetLogZ = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -181,13 +183,15 @@ SedSurface::setLogZ(bool logZ)
 int
 SedSurface::setZDataReference(const std::string& zDataReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(zDataReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mZDataReference = zDataReference;
+      mZDataReference = internString(zDataReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -199,6 +203,8 @@ SedSurface::setZDataReference(const std::string& zDataReference)
 int
 SedSurface::unsetLogZ()
 {
+  markDirty();
+
   mLogZ = false;
   mIsSetLogZ = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -211,6 +217,8 @@ SedSurface::unsetLogZ()
 int
 SedSurface::unsetZDataReference()
 {
+  markDirty();
+
   mZDataReference.erase();
 
   if (mZDataReference.empty() == true)
@@ -277,6 +285,108 @@ SedSurface::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedSurface to the vector.
+ */
+void
+SedSurface::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedCurve::getAttributeNames(names);
+
+  names.push_back("logZ");
+  names.push_back("zDataReference");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedSurface::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "logZ")
+    {
+      return isSetLogZ();
+    }
+  else if (attributeName == "zDataReference")
+    {
+      return isSetZDataReference();
+    }
+
+  return SedCurve::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedSurface::getAttribute(const std::string& attributeName,
+                         std::string& value) const
+{
+  if (attributeName == "logZ")
+    {
+      if (isSetLogZ() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mLogZ);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "zDataReference")
+    {
+      if (isSetZDataReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mZDataReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedCurve::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedSurface::setAttribute(const std::string& attributeName,
+                         const std::string& value)
+{
+  if (attributeName == "logZ")
+    {
+      bool parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setLogZ(parsed);
+    }
+  else if (attributeName == "zDataReference")
+    {
+      return setZDataReference(value);
+    }
+
+  return SedCurve::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedSurface::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "logZ")
+    {
+      return unsetLogZ();
+    }
+  else if (attributeName == "zDataReference")
+    {
+      return unsetZDataReference();
+    }
+
+  return SedCurve::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -300,8 +410,47 @@ SedSurface::writeElements(XMLOutputStream& stream) const
 bool
 SedSurface::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedSurface::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedCurve::addMemoryFootprint(footprint);
+
+  footprint.addString(mZDataReference);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedSurface::internStrings()
+{
+  SedCurve::internStrings();
 
+  reinternString(mZDataReference);
 }
 
 
@@ -362,7 +511,7 @@ SedSurface::readAttributes(const XMLAttributes& attributes,
   //
   // zDataReference SIdRef   ( use = "required" )
   //
-  assigned = attributes.readInto("zDataReference", mZDataReference, getErrorLog(), true);
+  assigned = readInto(attributes, "zDataReference", mZDataReference, true);
 
   if (assigned == true)
     {
@@ -557,6 +706,8 @@ SedListOfSurfaces::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedSurface*>(item);
@@ -594,15 +745,12 @@ SedListOfSurfaces::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedSurface in this SedListOfSurfaces
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfSurfaces::createObject(XMLInputStream& stream)
+SedListOfSurfaces::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "surface")
@@ -615,6 +763,18 @@ SedListOfSurfaces::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedSurface in this SedListOfSurfaces
+ */
+SedBase*
+SedListOfSurfaces::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
@@ -0,0 +1,819 @@
+/**
+ * @file   SedTargetResolver.cpp
+ * @brief  Compiled XPath targets and their resolution against model XML
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedTargetResolver.h>
+#include <sedml/common/operationReturnValues.h>
+#include <sedml/common/unordered.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+static void
+skipSpaces(const std::string& text, size_t& i)
+{
+  while (i < text.size() && (text[i] == ' ' || text[i] == '\t'))
+    ++i;
+}
+
+
+/*
+ * Splits a qualified name and looks up its prefix.  Element names without
+ * a known prefix match any namespace; attribute names without a prefix
+ * have none.
+ */
+static void
+resolveName(const std::string& qname, const XMLNamespaces* namespaces,
+            bool isElement, SedXPath::Step& step)
+{
+  size_t colon = qname.find(':');
+  std::string prefix;
+
+  if (colon == std::string::npos)
+    {
+      step.name = qname;
+    }
+  else
+    {
+      prefix = qname.substr(0, colon);
+      step.name = qname.substr(colon + 1);
+    }
+
+  step.uri.clear();
+  step.anyNamespace = isElement;
+
+  if (!prefix.empty() && namespaces != NULL && namespaces->hasPrefix(prefix))
+    {
+      step.uri = namespaces->getURI(prefix);
+      step.anyNamespace = false;
+    }
+}
+
+
+static bool
+matchesName(const XMLNode& node, const SedXPath::Step& step)
+{
+  if (!node.isElement()) return false;
+
+  if (step.name != "*" && node.getName() != step.name) return false;
+
+  return step.anyNamespace || node.getURI() == step.uri;
+}
+
+
+static bool
+matchesAttribute(const XMLNode& node, const SedXPath::Predicate& predicate)
+{
+  return node.hasAttr(predicate.name, predicate.uri)
+         && node.getAttrValue(predicate.name, predicate.uri) == predicate.value;
+}
+
+
+/** @endcond */
+
+
+SedXPath::SedXPath(const std::string& expression,
+                   const XMLNamespaces* namespaces)
+  : mExpression(expression)
+  , mSteps()
+  , mAttribute()
+  , mSelectsAttribute(false)
+  , mIsValid(false)
+{
+  mIsValid = parse(namespaces);
+}
+
+
+bool
+SedXPath::isValid() const
+{
+  return mIsValid;
+}
+
+
+const std::string&
+SedXPath::getExpression() const
+{
+  return mExpression;
+}
+
+
+unsigned int
+SedXPath::getNumSteps() const
+{
+  return (unsigned int)mSteps.size();
+}
+
+
+bool
+SedXPath::selectsAttribute() const
+{
+  return mSelectsAttribute;
+}
+
+
+const std::string&
+SedXPath::getAttributeName() const
+{
+  return mAttribute.name;
+}
+
+
+const std::string&
+SedXPath::getAttributeURI() const
+{
+  return mAttribute.uri;
+}
+
+
+std::string
+SedXPath::getIdPredicate(unsigned int& step) const
+{
+  for (size_t n = mSteps.size(); n > 0; --n)
+    {
+      const std::vector<Predicate>& predicates = mSteps[n - 1].predicates;
+
+      for (size_t i = 0; i < predicates.size(); ++i)
+        {
+          if (predicates[i].position == 0 && predicates[i].name == "id"
+              && predicates[i].uri.empty())
+            {
+              step = (unsigned int)(n - 1);
+              return predicates[i].value;
+            }
+        }
+    }
+
+  return "";
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+const SedXPath::Step&
+SedXPath::getStep(unsigned int n) const
+{
+  return mSteps[n];
+}
+
+
+bool
+SedXPath::parse(const XMLNamespaces* namespaces)
+{
+  const std::string& text = mExpression;
+  size_t i = 0;
+
+  if (text.empty() || text[0] != '/') return false;
+
+  while (i < text.size())
+    {
+      // nothing may follow the attribute step
+      if (text[i] != '/' || mSelectsAttribute) return false;
+
+      ++i;
+
+      bool isAttribute = i < text.size() && text[i] == '@';
+      if (isAttribute) ++i;
+
+      size_t start = i;
+
+      while (i < text.size() && text[i] != '/' && text[i] != '[')
+        ++i;
+
+      if (i == start) return false;
+
+      Step step;
+      resolveName(text.substr(start, i - start), namespaces, !isAttribute, step);
+
+      while (i < text.size() && text[i] == '[')
+        {
+          if (isAttribute) return false;
+
+          ++i;
+          skipSpaces(text, i);
+
+          Predicate predicate;
+          predicate.position = 0;
+
+          if (i < text.size() && text[i] == '@')
+            {
+              start = ++i;
+
+              while (i < text.size() && text[i] != '=' && text[i] != ' '
+                     && text[i] != ']')
+                ++i;
+
+              Step name;
+              resolveName(text.substr(start, i - start), namespaces, false, name);
+              predicate.name = name.name;
+              predicate.uri = name.uri;
+
+              skipSpaces(text, i);
+              if (i >= text.size() || text[i] != '=') return false;
+
+              ++i;
+              skipSpaces(text, i);
+              if (i >= text.size() || (text[i] != '\'' && text[i] != '"')) return false;
+
+              size_t end = text.find(text[i], i + 1);
+              if (end == std::string::npos) return false;
+
+              predicate.value = text.substr(i + 1, end - i - 1);
+              i = end + 1;
+            }
+          else
+            {
+              start = i;
+
+              while (i < text.size() && text[i] >= '0' && text[i] <= '9')
+                ++i;
+
+              if (i == start) return false;
+
+              predicate.position = (unsigned int)atoi(text.substr(start, i - start).c_str());
+              if (predicate.position == 0) return false;
+            }
+
+          skipSpaces(text, i);
+          if (i >= text.size() || text[i] != ']') return false;
+
+          ++i;
+          step.predicates.push_back(predicate);
+        }
+
+      if (isAttribute)
+        {
+          mAttribute = step;
+          mSelectsAttribute = true;
+        }
+      else
+        {
+          mSteps.push_back(step);
+        }
+    }
+
+  return !mSteps.empty();
+}
+
+/** @endcond */
+
+
+SedTargetHandle::SedTargetHandle()
+  : mNode(NULL)
+  , mAttributeName()
+  , mAttributeURI()
+{
+}
+
+
+SedTargetHandle::SedTargetHandle(XMLNode* node,
+                                 const std::string& attributeName,
+                                 const std::string& attributeURI)
+  : mNode(node)
+  , mAttributeName(attributeName)
+  , mAttributeURI(attributeURI)
+{
+}
+
+
+bool
+SedTargetHandle::isValid() const
+{
+  return mNode != NULL;
+}
+
+
+bool
+SedTargetHandle::isAttribute() const
+{
+  return mNode != NULL && !mAttributeName.empty();
+}
+
+
+XMLNode*
+SedTargetHandle::getNode() const
+{
+  return mNode;
+}
+
+
+const std::string&
+SedTargetHandle::getAttributeName() const
+{
+  return mAttributeName;
+}
+
+
+const std::string&
+SedTargetHandle::getAttributeURI() const
+{
+  return mAttributeURI;
+}
+
+
+std::string
+SedTargetHandle::getValue() const
+{
+  if (!isAttribute()) return "";
+
+  return mNode->getAttrValue(mAttributeName, mAttributeURI);
+}
+
+
+int
+SedTargetHandle::setValue(const std::string& value) const
+{
+  if (!isAttribute()) return LIBSEDML_INVALID_OBJECT;
+
+  // keep the prefix of an existing attribute
+  std::string prefix;
+
+  for (int i = 0; i < mNode->getAttributesLength(); ++i)
+    {
+      if (mNode->getAttrName(i) == mAttributeName
+          && mNode->getAttrURI(i) == mAttributeURI)
+        {
+          prefix = mNode->getAttrPrefix(i);
+          break;
+        }
+    }
+
+  mNode->addAttr(mAttributeName, value, mAttributeURI, prefix);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+SedTargetResolver::SedTargetResolver(XMLNode* model,
+                                     const XMLNamespaces* namespaces)
+  : mModel(model)
+  , mNamespaces(namespaces != NULL ? namespaces->clone() : NULL)
+  , mIsIndexed(false)
+  , mIds()
+  , mParents()
+  , mHandles()
+{
+}
+
+
+SedTargetResolver::~SedTargetResolver()
+{
+  delete mNamespaces;
+}
+
+
+XMLNode*
+SedTargetResolver::getModel() const
+{
+  return mModel;
+}
+
+
+const XMLNamespaces*
+SedTargetResolver::getNamespaces() const
+{
+  return mNamespaces;
+}
+
+
+const SedTargetHandle*
+SedTargetResolver::resolve(const std::string& target)
+{
+  HandleCache::iterator it = mHandles.find(target);
+
+  if (it == mHandles.end())
+    {
+      SedXPath path(target, mNamespaces);
+      std::vector<SedTargetHandle> handles;
+      resolveAll(path, handles);
+
+      // failures are cached as well
+      it = mHandles.insert(std::make_pair(target, handles.empty()
+                                          ? SedTargetHandle() : handles[0])).first;
+    }
+
+  return it->second.isValid() ? &it->second : NULL;
+}
+
+
+void
+SedTargetResolver::resolveAll(const SedXPath& path,
+                              std::vector<SedTargetHandle>& handles) const
+{
+  if (mModel == NULL || !path.isValid()) return;
+
+  std::vector<XMLNode*> current;
+  unsigned int first = 0;
+  unsigned int idStep = 0;
+  std::string id = path.getIdPredicate(idStep);
+
+  if (!id.empty())
+    {
+      // start from the elements with the id and check their ancestors
+      buildIndex();
+
+      IdIndex::const_iterator it = mIds.find(id);
+      if (it == mIds.end()) return;
+
+      for (size_t i = 0; i < it->second.size(); ++i)
+        {
+          XMLNode* node = it->second[i];
+          bool selected = true;
+
+          for (unsigned int k = idStep + 1; k > 0 && selected; --k)
+            {
+              XMLNode* parent = getParent(node);
+
+              if ((k == 1) != (parent == NULL)
+                  || !isSelected(node, parent, path.getStep(k - 1)))
+                selected = false;
+
+              node = parent;
+            }
+
+          if (selected) current.push_back(it->second[i]);
+        }
+
+      first = idStep + 1;
+    }
+  else
+    {
+      select(NULL, path.getStep(0), current);
+      first = 1;
+    }
+
+  for (unsigned int k = first; k < path.getNumSteps() && !current.empty(); ++k)
+    {
+      std::vector<XMLNode*> next;
+
+      for (size_t i = 0; i < current.size(); ++i)
+        select(current[i], path.getStep(k), next);
+
+      current.swap(next);
+    }
+
+  for (size_t i = 0; i < current.size(); ++i)
+    {
+      if (path.selectsAttribute())
+        handles.push_back(SedTargetHandle(current[i], path.getAttributeName(),
+                                          path.getAttributeURI()));
+      else
+        handles.push_back(SedTargetHandle(current[i]));
+    }
+}
+
+
+void
+SedTargetResolver::invalidate()
+{
+  mIsIndexed = false;
+  mIds.clear();
+  mParents.clear();
+  mHandles.clear();
+}
+
+
+void
+SedTargetResolver::invalidateChildren(const XMLNode* node)
+{
+  if (node == NULL) return;
+
+  // the parents of the remaining handles are looked up below
+  buildIndex();
+
+  LIBSEDML_UNORDERED_NAMESPACE::unordered_set<const XMLNode*> below;
+  std::vector<const XMLNode*> pending(1, node);
+
+  while (!pending.empty())
+    {
+      const XMLNode* current = pending.back();
+      pending.pop_back();
+
+      for (unsigned int n = 0; n < current->getNumChildren(); ++n)
+        {
+          const XMLNode* child = &current->getChild(n);
+
+          if (!child->isElement()) continue;
+
+          below.insert(child);
+          pending.push_back(child);
+          mParents.erase(child);
+
+          if (!child->hasAttr("id")) continue;
+
+          IdIndex::iterator it = mIds.find(child->getAttrValue("id"));
+          if (it == mIds.end()) continue;
+
+          std::vector<XMLNode*>& nodes = it->second;
+          nodes.erase(std::remove(nodes.begin(), nodes.end(), child), nodes.end());
+
+          if (nodes.empty()) mIds.erase(it);
+        }
+    }
+
+  // all elements selected by a target have the same depth, so the new
+  // elements below node can only change a target whose handle is deeper
+  // than node and comes after it.  Targets that selected nothing may
+  // select one of the new elements.
+  unsigned int depth = getDepth(node);
+  HandleCache::iterator it = mHandles.begin();
+
+  while (it != mHandles.end())
+    {
+      const XMLNode* selected = it->second.getNode();
+
+      if (selected == NULL || below.count(selected) > 0
+          || (getDepth(selected) > depth && !precedes(selected, node)))
+        mHandles.erase(it++);
+      else
+        ++it;
+    }
+}
+
+
+void
+SedTargetResolver::indexChildren(XMLNode* node)
+{
+  // an index that is not built yet will include the new elements
+  if (node == NULL || !mIsIndexed) return;
+
+  addToIndex(node);
+}
+
+
+unsigned int
+SedTargetResolver::getNumCached() const
+{
+  return (unsigned int)mHandles.size();
+}
+
+
+XMLNode*
+SedTargetResolver::getParent(const XMLNode* node) const
+{
+  buildIndex();
+
+  ParentIndex::const_iterator it = mParents.find(node);
+  return it != mParents.end() ? it->second : NULL;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+void
+SedTargetResolver::buildIndex() const
+{
+  if (mIsIndexed) return;
+
+  mIsIndexed = true;
+
+  if (mModel == NULL) return;
+
+  if (mModel->hasAttr("id"))
+    mIds[mModel->getAttrValue("id")].push_back(mModel);
+
+  addToIndex(mModel);
+}
+
+
+/*
+ * Adds the elements below node to the index.  The candidates of an id are
+ * kept in document order.
+ */
+void
+SedTargetResolver::addToIndex(XMLNode* node) const
+{
+  // children are pushed in reverse, so elements are visited in document
+  // order and can be appended to the candidates of their id
+  std::vector<XMLNode*> pending;
+
+  for (unsigned int n = node->getNumChildren(); n > 0; --n)
+    {
+      XMLNode* child = &node->getChild(n - 1);
+
+      if (child->isElement())
+        {
+          mParents[child] = node;
+          pending.push_back(child);
+        }
+    }
+
+  while (!pending.empty())
+    {
+      XMLNode* current = pending.back();
+      pending.pop_back();
+
+      if (current->hasAttr("id"))
+        {
+          std::vector<XMLNode*>& nodes = mIds[current->getAttrValue("id")];
+          size_t position = nodes.size();
+
+          // only ids that are not unique need this
+          while (position > 0 && precedes(current, nodes[position - 1]))
+            --position;
+
+          nodes.insert(nodes.begin() + position, current);
+        }
+
+      for (unsigned int n = current->getNumChildren(); n > 0; --n)
+        {
+          XMLNode* child = &current->getChild(n - 1);
+
+          if (child->isElement())
+            {
+              mParents[child] = current;
+              pending.push_back(child);
+            }
+        }
+    }
+}
+
+
+unsigned int
+SedTargetResolver::getDepth(const XMLNode* node) const
+{
+  unsigned int depth = 0;
+
+  for (node = getParent(node); node != NULL; node = getParent(node))
+    ++depth;
+
+  return depth;
+}
+
+
+/*
+ * Returns true if lhs comes before rhs in the document, or is rhs or one
+ * of its ancestors.
+ */
+bool
+SedTargetResolver::precedes(const XMLNode* lhs, const XMLNode* rhs) const
+{
+  std::vector<const XMLNode*> lhsPath;
+  std::vector<const XMLNode*> rhsPath;
+
+  for (const XMLNode* node = lhs; node != NULL; node = getParent(node))
+    lhsPath.push_back(node);
+
+  for (const XMLNode* node = rhs; node != NULL; node = getParent(node))
+    rhsPath.push_back(node);
+
+  size_t i = lhsPath.size();
+  size_t k = rhsPath.size();
+
+  while (i > 0 && k > 0 && lhsPath[i - 1] == rhsPath[k - 1])
+    {
+      --i;
+      --k;
+    }
+
+  if (i == 0) return true;
+  if (k == 0) return false;
+
+  // lhsPath[i - 1] and rhsPath[k - 1] are siblings
+  const XMLNode* parent = getParent(lhsPath[i - 1]);
+  if (parent == NULL) return false;
+
+  for (unsigned int n = 0; n < parent->getNumChildren(); ++n)
+    {
+      const XMLNode* child = &parent->getChild(n);
+
+      if (child == lhsPath[i - 1]) return true;
+      if (child == rhsPath[k - 1]) return false;
+    }
+
+  return false;
+}
+
+
+/*
+ * Returns true if the step, applied to parent (or to the document if
+ * parent is NULL), selects node.
+ */
+bool
+SedTargetResolver::isSelected(XMLNode* node, XMLNode* parent,
+                              const SedXPath::Step& step) const
+{
+  bool positional = false;
+
+  for (size_t i = 0; i < step.predicates.size(); ++i)
+    {
+      if (step.predicates[i].position != 0) positional = true;
+    }
+
+  if (!positional)
+    {
+      if (!matchesName(*node, step)) return false;
+
+      for (size_t i = 0; i < step.predicates.size(); ++i)
+        {
+          if (!matchesAttribute(*node, step.predicates[i])) return false;
+        }
+
+      return true;
+    }
+
+  // positions depend on the siblings
+  std::vector<XMLNode*> selected;
+  select(parent, step, selected);
+
+  return std::find(selected.begin(), selected.end(), node) != selected.end();
+}
+
+
+/*
+ * Appends the children of parent (or the root, if parent is NULL) that the
+ * step selects, applying the predicates in order.
+ */
+void
+SedTargetResolver::select(XMLNode* parent, const SedXPath::Step& step,
+                          std::vector<XMLNode*>& result) const
+{
+  std::vector<XMLNode*> candidates;
+
+  if (parent == NULL)
+    {
+      if (matchesName(*mModel, step)) candidates.push_back(mModel);
+    }
+  else
+    {
+      for (unsigned int n = 0; n < parent->getNumChildren(); ++n)
+        {
+          XMLNode& child = parent->getChild(n);
+          if (matchesName(child, step)) candidates.push_back(&child);
+        }
+    }
+
+  for (size_t i = 0; i < step.predicates.size() && !candidates.empty(); ++i)
+    {
+      const SedXPath::Predicate& predicate = step.predicates[i];
+
+      if (predicate.position != 0)
+        {
+          XMLNode* chosen = predicate.position <= candidates.size()
+                            ? candidates[predicate.position - 1] : NULL;
+          candidates.clear();
+          if (chosen != NULL) candidates.push_back(chosen);
+          continue;
+        }
+
+      std::vector<XMLNode*> kept;
+
+      for (size_t k = 0; k < candidates.size(); ++k)
+        {
+          if (matchesAttribute(*candidates[k], predicate))
+            kept.push_back(candidates[k]);
+        }
+
+      candidates.swap(kept);
+    }
+
+  result.insert(result.end(), candidates.begin(), candidates.end());
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,435 @@
+/**
+ * @file   SedTargetResolver.h
+ * @brief  Compiled XPath targets and their resolution against model XML
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedXPath
+ * @ingroup Core
+ * @brief A compiled SED-ML target.
+ *
+ * @class SedTargetHandle
+ * @ingroup Core
+ * @brief An element or attribute of a model selected by a target.
+ *
+ * @class SedTargetResolver
+ * @ingroup Core
+ * @brief Resolves the targets of changes and variables against one model.
+ *
+ * <em style='color: #555'>These classes of objects are defined by libSed
+ * only and have no direct equivalent in terms of Sed components.</em>
+ *
+ * The targets of SedChange, SedVariable and SedSetValue are XPath
+ * expressions into the XML of a model, almost always of the form
+ * <code>/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[\@id='k1']/\@value</code>.
+ * SedXPath parses such an expression once.  It supports absolute paths of
+ * element steps, optionally ending in an attribute step, where each
+ * element step may have any number of <code>[\@name='value']</code> and
+ * <code>[n]</code> predicates.  The element name may be <code>*</code>.
+ * Prefixes are looked up in the given namespaces; names without a prefix,
+ * or with a prefix that is not declared there, match elements of any
+ * namespace.
+ *
+ * A SedTargetResolver indexes the elements of one model tree by their
+ * "id" attribute.  A path with an <code>[\@id='...']</code> predicate is
+ * resolved by looking up the id and checking the ancestors of the
+ * candidates, instead of searching the tree.  Every target is compiled
+ * and resolved only once; the results are cached by the target string.
+ *
+ * Handles point into the model tree.  Changing attribute values through
+ * them is safe; adding or removing elements of the tree invalidates them.
+ * To change the children of one element, call invalidateChildren() on it
+ * before and indexChildren() after the change: only the elements below it
+ * are indexed again, and only handles into them are dropped.  After other
+ * changes of the tree, invalidate() has to be called.
+ */
+
+#ifndef SedTargetResolver_h
+#define SedTargetResolver_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/common/unordered.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLNamespaces.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedXPath
+{
+public:
+
+  /** @cond doxygen-libsedml-internal */
+
+  /*
+   * A predicate of a step: either an attribute comparison or a position.
+   */
+  struct Predicate
+  {
+    std::string name;
+    std::string uri;
+    std::string value;
+    unsigned int position;
+  };
+
+
+  /*
+   * An element step, or the final attribute step.
+   */
+  struct Step
+  {
+    std::string name;
+    std::string uri;
+    bool anyNamespace;
+    std::vector<Predicate> predicates;
+  };
+
+  /** @endcond */
+
+
+  /**
+   * Compiles the given target.
+   *
+   * @param expression the XPath expression.
+   * @param namespaces the namespaces used to resolve prefixes, usually
+   * those of the SedDocument; may be @c NULL.
+   */
+  SedXPath(const std::string& expression,
+           const XMLNamespaces* namespaces = NULL);
+
+
+  /**
+   * @return @c true if the expression could be compiled.
+   */
+  bool isValid() const;
+
+
+  /**
+   * @return the expression this SedXPath was compiled from.
+   */
+  const std::string& getExpression() const;
+
+
+  /**
+   * @return the number of element steps.
+   */
+  unsigned int getNumSteps() const;
+
+
+  /**
+   * @return @c true if the expression selects an attribute.
+   */
+  bool selectsAttribute() const;
+
+
+  /**
+   * @return the local name of the selected attribute, or an empty string.
+   */
+  const std::string& getAttributeName() const;
+
+
+  /**
+   * @return the namespace URI of the selected attribute, or an empty
+   * string.
+   */
+  const std::string& getAttributeURI() const;
+
+
+  /**
+   * Returns the value of the <code>[\@id='...']</code> predicate of the last
+   * element step that has one.
+   *
+   * @param step receives the index of that step.
+   *
+   * @return the id, or an empty string if no step has such a predicate.
+   */
+  std::string getIdPredicate(unsigned int& step) const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  const Step& getStep(unsigned int n) const;
+
+  /** @endcond */
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  bool parse(const XMLNamespaces* namespaces);
+
+  std::string mExpression;
+  std::vector<Step> mSteps;
+  Step mAttribute;
+  bool mSelectsAttribute;
+  bool mIsValid;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedTargetHandle
+{
+public:
+
+  /**
+   * Creates an invalid handle.
+   */
+  SedTargetHandle();
+
+
+  /**
+   * Creates a handle for an element or, if @p attributeName is not empty,
+   * for one of its attributes.
+   */
+  SedTargetHandle(XMLNode* node,
+                  const std::string& attributeName = "",
+                  const std::string& attributeURI = "");
+
+
+  /**
+   * @return @c true if this handle refers to an element.
+   */
+  bool isValid() const;
+
+
+  /**
+   * @return @c true if this handle refers to an attribute.
+   */
+  bool isAttribute() const;
+
+
+  /**
+   * @return the element this handle refers to, or that has the attribute.
+   */
+  XMLNode* getNode() const;
+
+
+  /**
+   * @return the local name of the attribute, or an empty string.
+   */
+  const std::string& getAttributeName() const;
+
+
+  /**
+   * @return the namespace URI of the attribute, or an empty string.
+   */
+  const std::string& getAttributeURI() const;
+
+
+  /**
+   * @return the value of the attribute, or an empty string if the
+   * attribute is not set or this handle refers to an element.
+   */
+  std::string getValue() const;
+
+
+  /**
+   * Sets the value of the attribute, adding the attribute if needed.
+   *
+   * @param value the new value.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   */
+  int setValue(const std::string& value) const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  XMLNode* mNode;
+  std::string mAttributeName;
+  std::string mAttributeURI;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedTargetResolver
+{
+public:
+
+  /**
+   * Creates a new SedTargetResolver for the given model tree.
+   *
+   * @param model the root element of the model XML; it is not copied and
+   * has to outlive this object.
+   * @param namespaces the namespaces used to resolve prefixes in targets,
+   * usually those of the SedDocument; they are copied.  May be @c NULL.
+   */
+  SedTargetResolver(XMLNode* model, const XMLNamespaces* namespaces = NULL);
+
+
+  /**
+   * Destroys this SedTargetResolver.
+   */
+  ~SedTargetResolver();
+
+
+  /**
+   * @return the root element of the model this resolver works on.
+   */
+  XMLNode* getModel() const;
+
+
+  /**
+   * @return the namespaces used to resolve prefixes in targets, or
+   * @c NULL if there are none.
+   */
+  const XMLNamespaces* getNamespaces() const;
+
+
+  /**
+   * Resolves the given target, compiling it and caching the result on
+   * first use.  A path ending in an attribute step resolves if the element
+   * exists, whether or not it has the attribute.
+   *
+   * @param target the XPath expression.
+   *
+   * @return the handle of the first selected node, or @c NULL if the
+   * target is malformed or selects nothing.  The handle is owned by this
+   * resolver.
+   */
+  const SedTargetHandle* resolve(const std::string& target);
+
+
+  /**
+   * Resolves a compiled path without using the cache.
+   *
+   * @param path the compiled path.
+   * @param handles the vector to which the handles of all selected nodes
+   * are appended, in document order.
+   */
+  void resolveAll(const SedXPath& path,
+                  std::vector<SedTargetHandle>& handles) const;
+
+
+  /**
+   * Drops the index and all cached handles.  Must be called after elements
+   * were added to or removed from the model tree.
+   */
+  void invalidate();
+
+
+  /**
+   * Removes the elements below the given one from the index and drops the
+   * cached handles that refer to them or to targets that selected nothing.
+   * Call this before the children of @p node are added, removed or
+   * replaced, and indexChildren() afterwards.
+   *
+   * @param node an element of the model tree.
+   */
+  void invalidateChildren(const XMLNode* node);
+
+
+  /**
+   * Adds the elements below the given one to the index, after their
+   * change was announced with invalidateChildren().
+   *
+   * @param node an element of the model tree.
+   */
+  void indexChildren(XMLNode* node);
+
+
+  /**
+   * @return the number of targets in the cache.
+   */
+  unsigned int getNumCached() const;
+
+
+  /**
+   * @param node an element of the model tree.
+   *
+   * @return the parent element of the given node, or @c NULL for the root
+   * and for nodes that are not in the tree.
+   */
+  XMLNode* getParent(const XMLNode* node) const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  void buildIndex() const;
+
+  void addToIndex(XMLNode* node) const;
+
+  unsigned int getDepth(const XMLNode* node) const;
+
+  bool precedes(const XMLNode* lhs, const XMLNode* rhs) const;
+
+  bool isSelected(XMLNode* node, XMLNode* parent, const SedXPath::Step& step) const;
+
+  void select(XMLNode* parent, const SedXPath::Step& step,
+              std::vector<XMLNode*>& result) const;
+
+  XMLNode* mModel;
+  XMLNamespaces* mNamespaces;
+
+  typedef LIBSEDML_UNORDERED_NAMESPACE::unordered_map<std::string,
+          std::vector<XMLNode*> > IdIndex;
+  typedef LIBSEDML_UNORDERED_NAMESPACE::unordered_map<const XMLNode*,
+          XMLNode*> ParentIndex;
+  typedef LIBSEDML_UNORDERED_NAMESPACE::unordered_map<std::string,
+          SedTargetHandle> HandleCache;
+
+  mutable bool mIsIndexed;
+  mutable IdIndex mIds;
+  mutable ParentIndex mParents;
+
+  HandleCache mHandles;
+
+  /** @endcond */
+
+private:
+  SedTargetResolver(const SedTargetResolver&);
+  SedTargetResolver& operator=(const SedTargetResolver&);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedTargetResolver_h */
@@ -225,7 +225,9 @@ SedTask::isSetSimulationReference() const
 int
 SedTask::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -235,6 +237,8 @@ SedTask::setId(const std::string& id)
 int
 SedTask::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -248,13 +252,15 @@ SedTask::setName(const std::string& name)
 int
 SedTask::setModelReference(const std::string& modelReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(modelReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mModelReference = modelReference;
+      mModelReference = internString(modelReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -266,13 +272,15 @@ SedTask::setModelReference(const std::string& modelReference)
 int
 SedTask::setSimulationReference(const std::string& simulationReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(simulationReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mSimulationReference = simulationReference;
+      mSimulationReference = internString(simulationReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -284,6 +292,8 @@ SedTask::setSimulationReference(const std::string& simulationReference)
 int
 SedTask::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -303,6 +313,8 @@ SedTask::unsetId()
 int
 SedTask::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -322,6 +334,8 @@ SedTask::unsetName()
 int
 SedTask::unsetModelReference()
 {
+  markDirty();
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -341,6 +355,8 @@ SedTask::unsetModelReference()
 int
 SedTask::unsetSimulationReference()
 {
+  markDirty();
+
   mSimulationReference.erase();
 
   if (mSimulationReference.empty() == true)
@@ -429,6 +445,143 @@ SedTask::hasRequiredElements() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedTask to the vector.
+ */
+void
+SedTask::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+  names.push_back("modelReference");
+  names.push_back("simulationReference");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedTask::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+  else if (attributeName == "modelReference")
+    {
+      return isSetModelReference();
+    }
+  else if (attributeName == "simulationReference")
+    {
+      return isSetSimulationReference();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedTask::getAttribute(const std::string& attributeName,
+                      std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "modelReference")
+    {
+      if (isSetModelReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mModelReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "simulationReference")
+    {
+      if (isSetSimulationReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mSimulationReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedTask::setAttribute(const std::string& attributeName,
+                      const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+  else if (attributeName == "modelReference")
+    {
+      return setModelReference(value);
+    }
+  else if (attributeName == "simulationReference")
+    {
+      return setSimulationReference(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedTask::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+  else if (attributeName == "modelReference")
+    {
+      return unsetModelReference();
+    }
+  else if (attributeName == "simulationReference")
+    {
+      return unsetSimulationReference();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -452,8 +605,52 @@ SedTask::writeElements(XMLOutputStream& stream) const
 bool
 SedTask::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
 
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedTask::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mName);
+  footprint.addString(mModelReference);
+  footprint.addString(mSimulationReference);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedTask::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
+  reinternString(mModelReference);
+  reinternString(mSimulationReference);
 }
 
 
@@ -511,7 +708,7 @@ SedTask::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -545,7 +742,7 @@ SedTask::readAttributes(const XMLAttributes& attributes,
   //
   // modelReference SIdRef   ( use = "optional" )
   //
-  assigned = attributes.readInto("modelReference", mModelReference, getErrorLog(), false);
+  assigned = readInto(attributes, "modelReference", mModelReference, false);
 
   if (assigned == true)
     {
@@ -564,7 +761,7 @@ SedTask::readAttributes(const XMLAttributes& attributes,
   //
   // simulationReference SIdRef   ( use = "optional" )
   //
-  assigned = attributes.readInto("simulationReference", mSimulationReference, getErrorLog(), false);
+  assigned = readInto(attributes, "simulationReference", mSimulationReference, false);
 
   if (assigned == true)
     {
@@ -783,6 +980,8 @@ SedListOfTasks::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedTask*>(item);
@@ -820,15 +1019,12 @@ SedListOfTasks::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedTask in this SedListOfTasks
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfTasks::createObject(XMLInputStream& stream)
+SedListOfTasks::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "task")
@@ -847,6 +1043,18 @@ SedListOfTasks::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedTask in this SedListOfTasks
+ */
+SedBase*
+SedListOfTasks::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
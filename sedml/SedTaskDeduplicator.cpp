@@ -0,0 +1,326 @@
+/**
+ * @file   SedTaskDeduplicator.cpp
+ * @brief  Groups of tasks doing the same work and a cache of their results
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedTaskDeduplicator.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModelRepository.h>
+#include <sedml/SedTask.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <sbml/xml/XMLNode.h>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+SedResultCache::~SedResultCache()
+{
+}
+
+
+SedFileResultCache::SedFileResultCache(const std::string& directory)
+  : mDirectory(directory)
+{
+}
+
+
+const std::string&
+SedFileResultCache::getDirectory() const
+{
+  return mDirectory;
+}
+
+
+std::string
+SedFileResultCache::getPath(const SedHash& key) const
+{
+  const std::string name = key.toString() + ".result";
+  return mDirectory.empty() ? name : mDirectory + "/" + name;
+}
+
+
+bool
+SedFileResultCache::lookup(const SedHash& key, std::string& result)
+{
+  ifstream stream(getPath(key).c_str(), ios::in | ios::binary);
+
+  if (!stream.is_open()) return false;
+
+  ostringstream contents;
+  contents << stream.rdbuf();
+
+  if (stream.bad()) return false;
+
+  result = contents.str();
+  return true;
+}
+
+
+int
+SedFileResultCache::store(const SedHash& key, const std::string& result)
+{
+  const std::string path = getPath(key);
+
+  // the temporary file lives next to the result, so that renaming it is
+  // atomic, and is named after the process and a stack address, which
+  // tell apart processes and threads storing the same result at once
+  int marker = 0;
+  ostringstream name;
+  name << path << '.' << getpid() << '.' << (const void*)&marker << ".tmp";
+  const std::string temporary = name.str();
+
+  {
+    ofstream stream(temporary.c_str(), ios::out | ios::binary | ios::trunc);
+
+    if (!stream.is_open())
+      {
+        remove(temporary.c_str());
+        return LIBSEDML_OPERATION_FAILED;
+      }
+
+    stream.write(result.data(), (streamsize)result.size());
+    stream.close();
+
+    if (stream.fail())
+      {
+        remove(temporary.c_str());
+        return LIBSEDML_OPERATION_FAILED;
+      }
+  }
+
+  // rename does not replace an existing file everywhere
+  if (rename(temporary.c_str(), path.c_str()) != 0)
+    {
+      remove(path.c_str());
+
+      if (rename(temporary.c_str(), path.c_str()) != 0)
+        {
+          remove(temporary.c_str());
+          return LIBSEDML_OPERATION_FAILED;
+        }
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+SedTaskDeduplicator::SedTaskDeduplicator(const SedDocument* document,
+                                         SedModelRepository* repository)
+  : mHashes()
+  , mClasses()
+  , mTaskClasses()
+  , mModelHashes()
+  , mCanonicalForm()
+  , mCache(NULL)
+{
+  if (document == NULL) return;
+
+  std::map<SedHash, unsigned int> classes;
+
+  // the document does not change while its tasks are hashed
+  SedDependencyGraph graph(document);
+
+  for (unsigned int i = 0; i < document->getNumTasks(); ++i)
+    {
+      const SedTask* task = document->getTask(i);
+      SedHash hash;
+      bool resolved = false;
+
+      if (repository != NULL && task->getTypeCode() == SEDML_TASK)
+        {
+          SedHash model = hashModel(repository, task->getModelReference(),
+                                    resolved);
+
+          if (resolved) hash = mCanonicalForm.hashTaskWork(task, model, &graph);
+        }
+
+      if (!resolved) hash = mCanonicalForm.hashTaskWork(task, &graph);
+
+      std::map<SedHash, unsigned int>::iterator it = classes.find(hash);
+
+      if (it == classes.end())
+        {
+          it = classes.insert(
+                 make_pair(hash, (unsigned int)mClasses.size())).first;
+          mHashes.push_back(hash);
+          mClasses.push_back(std::vector<const SedTask*>());
+        }
+
+      mClasses[it->second].push_back(task);
+      mTaskClasses[task->getId()] = it->second;
+    }
+}
+
+
+unsigned int
+SedTaskDeduplicator::getNumClasses() const
+{
+  return (unsigned int)mClasses.size();
+}
+
+
+SedHash
+SedTaskDeduplicator::getHash(unsigned int n) const
+{
+  return n < mHashes.size() ? mHashes[n] : SedHash();
+}
+
+
+unsigned int
+SedTaskDeduplicator::getNumTasks(unsigned int n) const
+{
+  return n < mClasses.size() ? (unsigned int)mClasses[n].size() : 0;
+}
+
+
+const SedTask*
+SedTaskDeduplicator::getTask(unsigned int n, unsigned int i) const
+{
+  if (n >= mClasses.size() || i >= mClasses[n].size()) return NULL;
+
+  return mClasses[n][i];
+}
+
+
+int
+SedTaskDeduplicator::getClassIndex(const std::string& taskId) const
+{
+  std::map<std::string, unsigned int>::const_iterator it =
+    mTaskClasses.find(taskId);
+
+  return it != mTaskClasses.end() ? (int)it->second : -1;
+}
+
+
+void
+SedTaskDeduplicator::setCache(SedResultCache* cache)
+{
+  mCache = cache;
+}
+
+
+SedResultCache*
+SedTaskDeduplicator::getCache() const
+{
+  return mCache;
+}
+
+
+bool
+SedTaskDeduplicator::lookup(const std::string& taskId,
+                            std::string& result) const
+{
+  int n = getClassIndex(taskId);
+
+  if (n < 0 || mCache == NULL) return false;
+
+  return mCache->lookup(mHashes[n], result);
+}
+
+
+int
+SedTaskDeduplicator::store(const std::string& taskId,
+                           const std::string& result)
+{
+  int n = getClassIndex(taskId);
+
+  if (n < 0 || mCache == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return mCache->store(mHashes[n], result);
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Returns the hash of the XML a model resolves to, once per model.  A
+ * model that cannot be derived, or whose changes could not all be applied,
+ * is not resolved.
+ */
+SedHash
+SedTaskDeduplicator::hashModel(SedModelRepository* repository,
+                               const std::string& id, bool& resolved)
+{
+  std::map<std::string, std::pair<bool, SedHash> >::iterator it =
+    mModelHashes.find(id);
+
+  if (it == mModelHashes.end())
+    {
+      std::pair<bool, SedHash> entry(false, SedHash());
+      const SedDerivedModel* model = repository->getModel(id);
+
+      if (model != NULL && model->getNumFailed() == 0)
+        {
+          XMLNode* xml = model->createXML();
+
+          if (xml != NULL)
+            {
+              entry.first = true;
+              entry.second = mCanonicalForm.hashXML(xml);
+              delete xml;
+            }
+        }
+
+      it = mModelHashes.insert(make_pair(id, entry)).first;
+    }
+
+  resolved = it->second.first;
+  return it->second.second;
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,288 @@
+/**
+ * @file   SedTaskDeduplicator.h
+ * @brief  Groups of tasks doing the same work and a cache of their results
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ *
+ * @class SedResultCache
+ * @ingroup Core
+ * @brief Stores the results of tasks under the hash of their work.
+ *
+ * @class SedFileResultCache
+ * @ingroup Core
+ * @brief A SedResultCache keeping one file per result in a directory.
+ *
+ * @class SedTaskDeduplicator
+ * @ingroup Core
+ * @brief Groups the tasks of a document that do the same work.
+ *
+ * <em style='color: #555'>These classes of objects are defined by libSed
+ * only and have no direct equivalent in terms of Sed components.</em>
+ *
+ * Documents often contain several tasks that simulate the same model
+ * with the same simulation, under different ids or through models that
+ * differ only in id.  SedTaskDeduplicator computes for each task the hash
+ * of its work (see SedCanonicalForm::hashTaskWork()) and groups tasks with
+ * equal hashes into classes, so that only one task per class has to be
+ * run.  When a SedModelRepository is given, the model of a task is
+ * identified by the hash of the XML it resolves to, so models reaching the
+ * same XML through different sources or changes are also recognised.
+ *
+ * Results are memoized through a SedResultCache, whose keys are the work
+ * hashes: they are stable across program runs, so a cache shared by a batch
+ * of documents runs identical work once.  The cache stores the results as
+ * opaque bytes and is implemented by the application; SedFileResultCache
+ * keeps them in files.
+ */
+
+#ifndef SedTaskDeduplicator_h
+#define SedTaskDeduplicator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sedml/SedCanonicalForm.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedModelRepository;
+class SedTask;
+
+
+class LIBSEDML_EXTERN SedResultCache
+{
+public:
+
+  /**
+   * Destroys this SedResultCache.
+   */
+  virtual ~SedResultCache();
+
+
+  /**
+   * Looks up the result stored under a key.
+   *
+   * @param key the hash of the work.
+   * @param result receives the result.
+   *
+   * @return @c true if a result was found.
+   */
+  virtual bool lookup(const SedHash& key, std::string& result) = 0;
+
+
+  /**
+   * Stores a result under a key, replacing any result stored before.
+   *
+   * @param key the hash of the work.
+   * @param result the result.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int store(const SedHash& key, const std::string& result) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedFileResultCache : public SedResultCache
+{
+public:
+
+  /**
+   * Creates a new SedFileResultCache.
+   *
+   * @param directory an existing directory, in which each result is kept
+   * in a file named after its key.
+   */
+  SedFileResultCache(const std::string& directory);
+
+
+  /**
+   * @return the directory of this cache.
+   */
+  const std::string& getDirectory() const;
+
+
+  /**
+   * @return the file in which the result with the given key is kept.
+   */
+  std::string getPath(const SedHash& key) const;
+
+
+  virtual bool lookup(const SedHash& key, std::string& result);
+
+
+  /**
+   * Stores a result; it is written to a temporary file of its own in the
+   * same directory that is then renamed, so other processes and threads
+   * never read a partial result nor write to the same temporary file.
+   * The temporary file is removed if the result cannot be stored.
+   */
+  virtual int store(const SedHash& key, const std::string& result);
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  std::string mDirectory;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedTaskDeduplicator
+{
+public:
+
+  /**
+   * Groups the tasks of a document.
+   *
+   * @param document the document, which must not change while this object
+   * is in use.
+   * @param repository a repository for the models of @p document, used to
+   * compare models by the XML they resolve to; if @c NULL, models are
+   * compared by their source and changes.
+   */
+  SedTaskDeduplicator(const SedDocument* document,
+                      SedModelRepository* repository = NULL);
+
+
+  /**
+   * @return the number of classes of tasks doing the same work.
+   */
+  unsigned int getNumClasses() const;
+
+
+  /**
+   * @return the hash of the work of the nth class.
+   */
+  SedHash getHash(unsigned int n) const;
+
+
+  /**
+   * @return the number of tasks of the nth class.
+   */
+  unsigned int getNumTasks(unsigned int n) const;
+
+
+  /**
+   * @return the ith task of the nth class, in document order, or @c NULL
+   * if there is none; the first task can be run for the whole class.
+   */
+  const SedTask* getTask(unsigned int n, unsigned int i) const;
+
+
+  /**
+   * @return the class of the task with the given id, or @c -1 if there is
+   * no such task.
+   */
+  int getClassIndex(const std::string& taskId) const;
+
+
+  /**
+   * Sets the cache in which results are memoized.
+   *
+   * @param cache the cache, which has to outlive this object, or @c NULL.
+   */
+  void setCache(SedResultCache* cache);
+
+
+  /**
+   * @return the cache in which results are memoized, or @c NULL.
+   */
+  SedResultCache* getCache() const;
+
+
+  /**
+   * Looks up the result of the work of the task with the given id.
+   *
+   * @param taskId the id of a task.
+   * @param result receives the result.
+   *
+   * @return @c true if a result was stored for this task or for another
+   * task of its class, in this or in an earlier run.
+   */
+  bool lookup(const std::string& taskId, std::string& result) const;
+
+
+  /**
+   * Stores the result of the work of the task with the given id, which
+   * is then the result of all tasks of its class.
+   *
+   * @param taskId the id of a task.
+   * @param result the result.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if there is no such task or no cache
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  int store(const std::string& taskId, const std::string& result);
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  SedHash hashModel(SedModelRepository* repository, const std::string& id,
+                    bool& resolved);
+
+  std::vector<SedHash> mHashes;
+  std::vector<std::vector<const SedTask*> > mClasses;
+  std::map<std::string, unsigned int> mTaskClasses;
+  std::map<std::string, std::pair<bool, SedHash> > mModelHashes;
+
+  SedCanonicalForm mCanonicalForm;
+  SedResultCache* mCache;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedTaskDeduplicator_h */
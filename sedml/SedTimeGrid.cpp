@@ -0,0 +1,204 @@
+/**
+ * @file   SedTimeGrid.cpp
+ * @brief  Output time grid of a uniform time course
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedTimeGrid.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <limits>
+
+#include <sbml/util/util.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+SedTimeGrid::SedTimeGrid(double start, double end, unsigned int numberOfPoints)
+  : mStart(start)
+  , mEnd(end)
+  , mNumIntervals(numberOfPoints)
+  , mIsValid(false)
+{
+  mIsValid = numberOfPoints > 0 && util_isFinite(start) && util_isFinite(end)
+             && start <= end;
+}
+
+
+SedTimeGrid::SedTimeGrid(const SedUniformTimeCourse* timeCourse)
+  : mStart(0)
+  , mEnd(0)
+  , mNumIntervals(0)
+  , mIsValid(false)
+{
+  if (timeCourse == NULL || timeCourse->getNumberOfPoints() < 0) return;
+
+  mStart = timeCourse->getOutputStartTime();
+  mEnd = timeCourse->getOutputEndTime();
+  mNumIntervals = (unsigned int)timeCourse->getNumberOfPoints();
+  mIsValid = mNumIntervals > 0 && util_isFinite(mStart) && util_isFinite(mEnd)
+             && mStart <= mEnd;
+}
+
+
+bool
+SedTimeGrid::isValid() const
+{
+  return mIsValid;
+}
+
+
+double
+SedTimeGrid::getStart() const
+{
+  return mStart;
+}
+
+
+double
+SedTimeGrid::getEnd() const
+{
+  return mEnd;
+}
+
+
+unsigned int
+SedTimeGrid::getNumIntervals() const
+{
+  return mNumIntervals;
+}
+
+
+unsigned int
+SedTimeGrid::getNumTimes() const
+{
+  return mIsValid ? mNumIntervals + 1 : 0;
+}
+
+
+double
+SedTimeGrid::getTime(unsigned int n) const
+{
+  if (!mIsValid || n > mNumIntervals) return numeric_limits<double>::quiet_NaN();
+
+  // weighting the ends instead of adding n steps to the start keeps the
+  // error of every time independent of n, and the last time exact
+  if (n == mNumIntervals) return mEnd;
+
+  double fraction = (double)n / mNumIntervals;
+  return mStart + (mEnd - mStart) * fraction;
+}
+
+
+void
+SedTimeGrid::getTimes(double* times) const
+{
+  if (times == NULL) return;
+
+  unsigned int numTimes = getNumTimes();
+
+  for (unsigned int n = 0; n < numTimes; ++n)
+    times[n] = getTime(n);
+}
+
+
+void
+SedTimeGrid::getTimes(std::vector<double>& times) const
+{
+  times.resize(getNumTimes());
+
+  if (!times.empty()) getTimes(&times[0]);
+}
+
+
+int
+SedTimeGrid::resample(const double* times, unsigned int numTimes,
+                      const double* values, unsigned int numColumns,
+                      double* result) const
+{
+  if (!mIsValid || times == NULL || values == NULL || result == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  for (unsigned int k = 1; k < numTimes; ++k)
+    {
+      if (times[k] < times[k - 1]) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+  const double nan = numeric_limits<double>::quiet_NaN();
+  unsigned int numGrid = getNumTimes();
+  unsigned int k = 0;
+
+  for (unsigned int n = 0; n < numGrid; ++n)
+    {
+      double t = getTime(n);
+      double* row = result + (size_t)n * numColumns;
+
+      // both time vectors increase, so the segment only moves forward
+      while (k + 1 < numTimes && times[k + 1] <= t)
+        ++k;
+
+      if (numTimes == 0 || t < times[0] || t > times[numTimes - 1])
+        {
+          for (unsigned int j = 0; j < numColumns; ++j) row[j] = nan;
+          continue;
+        }
+
+      const double* lower = values + (size_t)k * numColumns;
+
+      if (times[k] == t || k + 1 == numTimes)
+        {
+          for (unsigned int j = 0; j < numColumns; ++j) row[j] = lower[j];
+          continue;
+        }
+
+      const double* upper = lower + numColumns;
+      double w = (t - times[k]) / (times[k + 1] - times[k]);
+
+      for (unsigned int j = 0; j < numColumns; ++j)
+        row[j] = lower[j] + w * (upper[j] - lower[j]);
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
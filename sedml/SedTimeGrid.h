@@ -0,0 +1,195 @@
+/**
+ * @file   SedTimeGrid.h
+ * @brief  Output time grid of a uniform time course
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedTimeGrid
+ * @ingroup Core
+ * @brief The output times of a SedUniformTimeCourse, and resampling of
+ * simulation results onto them.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A uniform time course reports its results at numberOfPoints equal
+ * intervals from outputStartTime to outputEndTime, that is at
+ * numberOfPoints + 1 times.  Adding the step size repeatedly accumulates
+ * rounding errors over many points; SedTimeGrid computes every time
+ * directly from the interval index instead, so the first and last times
+ * are exactly the start and end time and the error of every time stays
+ * within a few roundings, however many points there are.
+ *
+ * resample() interpolates the output of a solver with adaptive steps
+ * linearly onto the grid.  Both time vectors are walked once, and all
+ * columns of a row are interpolated in one inner loop that the compiler
+ * can vectorize.
+ */
+
+#ifndef SedTimeGrid_h
+#define SedTimeGrid_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedUniformTimeCourse;
+
+
+class LIBSEDML_EXTERN SedTimeGrid
+{
+public:
+
+  /**
+   * Creates a new SedTimeGrid.
+   *
+   * @param start the first output time.
+   * @param end the last output time.
+   * @param numberOfPoints the number of intervals between them.
+   */
+  SedTimeGrid(double start, double end, unsigned int numberOfPoints);
+
+
+  /**
+   * Creates the SedTimeGrid of a uniform time course.
+   *
+   * @param timeCourse the time course; if it is @c NULL or its number of
+   * points is negative, the grid is invalid.
+   */
+  SedTimeGrid(const SedUniformTimeCourse* timeCourse);
+
+
+  /**
+   * @return @c true if the grid has at least one interval and finite
+   * start and end times with start <= end.
+   */
+  bool isValid() const;
+
+
+  /**
+   * @return the first output time.
+   */
+  double getStart() const;
+
+
+  /**
+   * @return the last output time.
+   */
+  double getEnd() const;
+
+
+  /**
+   * @return the number of intervals, the numberOfPoints of the time
+   * course.
+   */
+  unsigned int getNumIntervals() const;
+
+
+  /**
+   * @return the number of output times, one more than the number of
+   * intervals.
+   */
+  unsigned int getNumTimes() const;
+
+
+  /**
+   * @param n the index of the time, from 0 to getNumIntervals().
+   *
+   * @return the nth output time.
+   */
+  double getTime(unsigned int n) const;
+
+
+  /**
+   * Writes all output times.
+   *
+   * @param times an array with room for getNumTimes() values.
+   */
+  void getTimes(double* times) const;
+
+
+  /**
+   * @param times the vector that is filled with all output times.
+   */
+  void getTimes(std::vector<double>& times) const;
+
+
+  /**
+   * Interpolates results given at arbitrary increasing times linearly
+   * onto the grid.  Output times before the first or after the last given
+   * time get NaN.
+   *
+   * @param times the increasing times of the results.
+   * @param numTimes the number of times.
+   * @param values the results, one row of @p numColumns values per time.
+   * @param numColumns the number of values per time.
+   * @param result an array with room for getNumTimes() rows of
+   * @p numColumns values.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if the grid is invalid or an array is @c NULL
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the times decrease
+   */
+  int resample(const double* times, unsigned int numTimes,
+               const double* values, unsigned int numColumns,
+               double* result) const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  double mStart;
+  double mEnd;
+  unsigned int mNumIntervals;
+  bool mIsValid;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedTimeGrid_h */
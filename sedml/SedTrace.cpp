@@ -0,0 +1,387 @@
+/**
+ * @file   SedTrace.cpp
+ * @brief  Opt-in timers and counters for reading and writing
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ */
+
+#include <sedml/SedTrace.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#include <sys/time.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+const char* const SedTrace::PHASE_DOCUMENT = "document";
+const char* const SedTrace::PHASE_READ = "read";
+const char* const SedTrace::PHASE_CREATE_OBJECT = "createObject";
+const char* const SedTrace::PHASE_XML = "xml";
+const char* const SedTrace::PHASE_ERROR = "error";
+const char* const SedTrace::PHASE_WRITE = "write";
+
+
+SedTraceCounter::SedTraceCounter()
+  : phase()
+  , name()
+  , count(0)
+  , bytes(0)
+  , nanoseconds(0)
+  , selfNanoseconds(0)
+{
+}
+
+
+SedTrace::SedTrace()
+  : mCounters()
+  , mIndex()
+  , mNested()
+  , mEvents()
+  , mRecordEvents(false)
+  , mOrigin(0)
+  , mOutput(0)
+{
+}
+
+
+void
+SedTrace::setRecordEvents(bool record)
+{
+  mRecordEvents = record;
+}
+
+
+bool
+SedTrace::getRecordEvents() const
+{
+  return mRecordEvents;
+}
+
+
+void
+SedTrace::clear()
+{
+  mCounters.clear();
+  mIndex.clear();
+  mNested.clear();
+  mEvents.clear();
+  mOrigin = 0;
+  mOutput = 0;
+}
+
+
+unsigned int
+SedTrace::getNumCounters() const
+{
+  return (unsigned int)mCounters.size();
+}
+
+
+const SedTraceCounter*
+SedTrace::getCounter(unsigned int n) const
+{
+  return n < mCounters.size() ? &mCounters[n] : NULL;
+}
+
+
+const SedTraceCounter*
+SedTrace::getCounter(const std::string& phase, const std::string& name) const
+{
+  CounterIndex::const_iterator it = mIndex.find(make_pair(phase, name));
+  return it != mIndex.end() ? &mCounters[it->second] : NULL;
+}
+
+
+SedTraceCounter
+SedTrace::getTotal(const std::string& phase) const
+{
+  SedTraceCounter total;
+  total.phase = phase;
+  total.name = phase;
+
+  for (size_t n = 0; n < mCounters.size(); ++n)
+    {
+      const SedTraceCounter& counter = mCounters[n];
+      if (counter.phase != phase) continue;
+
+      total.count += counter.count;
+      total.bytes += counter.bytes;
+      total.nanoseconds += counter.nanoseconds;
+      total.selfNanoseconds += counter.selfNanoseconds;
+    }
+
+  return total;
+}
+
+
+unsigned int
+SedTrace::getNumEvents() const
+{
+  return (unsigned int)mEvents.size();
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+static void
+appendJsonString(string& out, const string& value)
+{
+  out += '"';
+
+  for (size_t n = 0; n < value.size(); ++n)
+    {
+      unsigned char c = (unsigned char)value[n];
+
+      if (c == '"' || c == '\\')
+        {
+          out += '\\';
+          out += (char)c;
+        }
+      else if (c < 0x20)
+        {
+          char escaped[8];
+          sprintf(escaped, "\\u%04x", c);
+          out += escaped;
+        }
+      else
+        {
+          out += (char)c;
+        }
+    }
+
+  out += '"';
+}
+
+
+static void
+appendMicroseconds(string& out, uint64_t nanoseconds)
+{
+  char text[40];
+  sprintf(text, "%lu.%03u", (unsigned long)(nanoseconds / 1000),
+          (unsigned int)(nanoseconds % 1000));
+  out += text;
+}
+
+/** @endcond */
+
+
+std::string
+SedTrace::toChromeTrace() const
+{
+  string out = "{\"traceEvents\":[";
+
+  for (size_t n = 0; n < mEvents.size(); ++n)
+    {
+      const Event& event = mEvents[n];
+      const SedTraceCounter& counter = mCounters[event.counter];
+
+      out += n == 0 ? "\n" : ",\n";
+      out += "{\"name\":";
+      appendJsonString(out, counter.name);
+      out += ",\"cat\":";
+      appendJsonString(out, counter.phase);
+      out += ",\"ph\":\"X\",\"ts\":";
+      appendMicroseconds(out, event.start - mOrigin);
+      out += ",\"dur\":";
+      appendMicroseconds(out, event.duration);
+      out += ",\"pid\":1,\"tid\":1}";
+    }
+
+  out += "\n],\"displayTimeUnit\":\"ns\"}\n";
+  return out;
+}
+
+
+bool
+SedTrace::writeChromeTrace(const std::string& filename) const
+{
+  ofstream file(filename.c_str(), ios::out | ios::binary);
+  if (!file) return false;
+
+  string text = toChromeTrace();
+  file.write(text.data(), (streamsize)text.size());
+  return file.good();
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+uint64_t
+SedTrace::now()
+{
+#ifdef _WIN32
+  static LARGE_INTEGER frequency = { 0 };
+  LARGE_INTEGER counter;
+
+  if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+
+  return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+#else
+  struct timeval time;
+  gettimeofday(&time, NULL);
+  return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_usec * 1000u;
+#endif
+}
+
+
+uint64_t
+SedTrace::begin()
+{
+  uint64_t start = now();
+  if (mOrigin == 0) mOrigin = start;
+
+  mNested.push_back(0);
+  return start;
+}
+
+
+void
+SedTrace::end(const char* phase, const std::string& name, uint64_t start,
+              uint64_t bytes)
+{
+  uint64_t duration = now() - start;
+  uint64_t nested = 0;
+
+  if (!mNested.empty())
+    {
+      nested = mNested.back();
+      mNested.pop_back();
+    }
+
+  if (!mNested.empty()) mNested.back() += duration;
+
+  pair<CounterIndex::iterator, bool> inserted =
+    mIndex.insert(make_pair(make_pair(string(phase), name), mCounters.size()));
+
+  if (inserted.second)
+    {
+      mCounters.push_back(SedTraceCounter());
+      mCounters.back().phase = phase;
+      mCounters.back().name = name;
+    }
+
+  SedTraceCounter& counter = mCounters[inserted.first->second];
+  ++counter.count;
+  counter.bytes += bytes;
+  counter.nanoseconds += duration;
+  counter.selfNanoseconds += duration > nested ? duration - nested : 0;
+
+  if (mRecordEvents)
+    {
+      Event event;
+      event.counter = inserted.first->second;
+      event.start = start;
+      event.duration = duration;
+      mEvents.push_back(event);
+    }
+}
+
+
+uint64_t
+SedTrace::getOutputPosition() const
+{
+  return mOutput;
+}
+
+
+void
+SedTrace::addOutput(uint64_t bytes)
+{
+  mOutput += bytes;
+}
+
+
+SedTraceBuffer::SedTraceBuffer(std::streambuf* target, SedTrace* trace)
+  : mTarget(target)
+  , mTrace(trace)
+{
+}
+
+
+SedTraceBuffer::int_type
+SedTraceBuffer::overflow(int_type c)
+{
+  if (traits_type::eq_int_type(c, traits_type::eof()))
+    return traits_type::not_eof(c);
+
+  if (traits_type::eq_int_type(mTarget->sputc(traits_type::to_char_type(c)),
+                               traits_type::eof()))
+    return traits_type::eof();
+
+  mTrace->addOutput(1);
+  return c;
+}
+
+
+std::streamsize
+SedTraceBuffer::xsputn(const char* s, std::streamsize n)
+{
+  std::streamsize written = mTarget->sputn(s, n);
+  if (written > 0) mTrace->addOutput((uint64_t)written);
+  return written;
+}
+
+
+int
+SedTraceBuffer::sync()
+{
+  return mTarget->pubsync();
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,359 @@
+/**
+ * @file   SedTrace.h
+ * @brief  Opt-in timers and counters for reading and writing
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedTraceCounter
+ * @ingroup Core
+ * @brief The count, size and time of one kind of traced operation.
+ *
+ * @class SedTrace
+ * @ingroup Core
+ * @brief Collects timers and counters while documents are read or written.
+ *
+ * <em style='color: #555'>These classes of objects are defined by libSed
+ * only and have no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedTrace is handed to a SedReader or SedWriter with setTrace(), or to
+ * a document with SedDocument::setTrace().  While it is set, reading and
+ * writing record for every element how often it occurred, how long it
+ * took with and without the elements nested in it and, when writing, how
+ * many bytes it produced.  The operations are told apart by their phase:
+ *
+ * @li @c "document": a whole read or write by SedReader or SedWriter,
+ * named @c "read" or @c "write"; bytes are the size of the input or
+ * output.
+ * @li @c "read": reading a Sed element, named after the element.  The
+ * time spent in the element itself, which is mostly tokenizing its XML
+ * and reading its attributes, is its self time.
+ * @li @c "createObject": creating the object for a child element.
+ * @li @c "xml": reading XML content that is not a Sed element, named
+ * @c "math", @c "notes", @c "annotation", @c "newXML" and so on;
+ * this covers the construction of ASTNode and XMLNode objects.
+ * @li @c "error": logging an error, named after the error id.
+ * @li @c "write": writing a Sed element, named after the element.
+ *
+ * With setRecordEvents(), every single operation is kept as well, and
+ * toChromeTrace() returns them in the trace event format that
+ * <code>chrome://tracing</code> and Perfetto display.
+ *
+ * Without a trace, reading and writing only check for it once per
+ * element.  A trace is not synchronized: it must be used by one read or
+ * write at a time.
+ */
+
+#ifndef SedTrace_h
+#define SedTrace_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedTraceCounter
+{
+public:
+
+  /**
+   * Creates a counter with nothing counted.
+   */
+  SedTraceCounter();
+
+  /** The phase of the operation, e.g. @c "read". */
+  std::string phase;
+
+  /** The element or content the operation was applied to. */
+  std::string name;
+
+  /** The number of operations. */
+  unsigned long count;
+
+  /** The bytes written by the operations, or read for documents. */
+  uint64_t bytes;
+
+  /** The time of the operations, including nested ones. */
+  uint64_t nanoseconds;
+
+  /** The time of the operations, excluding nested ones. */
+  uint64_t selfNanoseconds;
+};
+
+
+class LIBSEDML_EXTERN SedTrace
+{
+public:
+
+  /**
+   * Creates an empty trace that only keeps counters.
+   */
+  SedTrace();
+
+
+  /**
+   * Sets whether every single operation is kept for toChromeTrace().
+   *
+   * @param record a boolean, @c true to keep the operations.
+   */
+  void setRecordEvents(bool record);
+
+
+  /**
+   * @return @c true if every single operation is kept.
+   */
+  bool getRecordEvents() const;
+
+
+  /**
+   * Discards all counters and operations.
+   */
+  void clear();
+
+
+  /**
+   * @return the number of counters, one per phase and name that occurred.
+   */
+  unsigned int getNumCounters() const;
+
+
+  /**
+   * Returns the nth counter; counters are in the order in which their
+   * phase and name first occurred.
+   *
+   * @param n the index of the counter.
+   *
+   * @return the counter, or @c NULL if @p n is out of range.
+   */
+  const SedTraceCounter* getCounter(unsigned int n) const;
+
+
+  /**
+   * Returns the counter of the given phase and name.
+   *
+   * @param phase the phase, e.g. @c "read".
+   * @param name the name, e.g. @c "dataGenerator".
+   *
+   * @return the counter, or @c NULL if no such operation occurred.
+   */
+  const SedTraceCounter* getCounter(const std::string& phase,
+                                    const std::string& name) const;
+
+
+  /**
+   * Returns the sum of the counters of a phase, named after the phase.
+   *
+   * @param phase the phase, e.g. @c "xml".
+   *
+   * @return the sum.
+   */
+  SedTraceCounter getTotal(const std::string& phase) const;
+
+
+  /**
+   * @return the number of operations kept for toChromeTrace().
+   */
+  unsigned int getNumEvents() const;
+
+
+  /**
+   * Returns the kept operations in the trace event format, as complete
+   * ("X") events with timestamps in microseconds.
+   *
+   * @return the JSON text.
+   */
+  std::string toChromeTrace() const;
+
+
+  /**
+   * Writes toChromeTrace() to a file.
+   *
+   * @param filename the name of the file.
+   *
+   * @return @c true on success.
+   */
+  bool writeChromeTrace(const std::string& filename) const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+#ifndef SWIG
+
+  static const char* const PHASE_DOCUMENT;
+  static const char* const PHASE_READ;
+  static const char* const PHASE_CREATE_OBJECT;
+  static const char* const PHASE_XML;
+  static const char* const PHASE_ERROR;
+  static const char* const PHASE_WRITE;
+
+  /*
+   * A monotonic clock in nanoseconds.
+   */
+  static uint64_t now();
+
+  /*
+   * Starts an operation and returns its start time; operations started
+   * while it runs are nested in it.
+   */
+  uint64_t begin();
+
+  /*
+   * Ends the operation started last.
+   */
+  void end(const char* phase, const std::string& name, uint64_t start,
+           uint64_t bytes);
+
+  /*
+   * The bytes written so far by a traced SedWriter.
+   */
+  uint64_t getOutputPosition() const;
+  void addOutput(uint64_t bytes);
+
+#endif /* !SWIG */
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Event
+  {
+    size_t counter;
+    uint64_t start;
+    uint64_t duration;
+  };
+
+  typedef std::map<std::pair<std::string, std::string>, size_t> CounterIndex;
+
+  std::vector<SedTraceCounter> mCounters;
+  CounterIndex mIndex;
+  std::vector<uint64_t> mNested;
+  std::vector<Event> mEvents;
+  bool mRecordEvents;
+  uint64_t mOrigin;
+  uint64_t mOutput;
+
+  /** @endcond */
+};
+
+
+/** @cond doxygen-libsedml-internal */
+
+#ifndef SWIG
+
+/*
+ * Times the enclosing block as one operation if the trace is not NULL.
+ */
+class LIBSEDML_EXTERN SedTraceScope
+{
+public:
+  SedTraceScope(SedTrace* trace, const char* phase, const std::string& name)
+    : mTrace(trace)
+    , mPhase(phase)
+    , mStart(0)
+    , mOutput(0)
+    , mBytes(0)
+  {
+    if (mTrace == NULL) return;
+
+    mName = name;
+    mOutput = mTrace->getOutputPosition();
+    mStart = mTrace->begin();
+  }
+
+  ~SedTraceScope()
+  {
+    if (mTrace == NULL) return;
+
+    uint64_t bytes = mBytes + (mTrace->getOutputPosition() - mOutput);
+    mTrace->end(mPhase, mName, mStart, bytes);
+  }
+
+  /*
+   * Adds bytes that were not written through the output of the trace.
+   */
+  void addBytes(uint64_t bytes) { mBytes += bytes; }
+
+private:
+  SedTraceScope(const SedTraceScope&);
+  SedTraceScope& operator=(const SedTraceScope&);
+
+  SedTrace* mTrace;
+  const char* mPhase;
+  std::string mName;
+  uint64_t mStart;
+  uint64_t mOutput;
+  uint64_t mBytes;
+};
+
+
+/*
+ * Passes output on to another buffer and counts it as output of a trace.
+ */
+class LIBSEDML_EXTERN SedTraceBuffer : public std::streambuf
+{
+public:
+  SedTraceBuffer(std::streambuf* target, SedTrace* trace);
+
+protected:
+  virtual int_type overflow(int_type c);
+  virtual std::streamsize xsputn(const char* s, std::streamsize n);
+  virtual int sync();
+
+private:
+  std::streambuf* mTarget;
+  SedTrace* mTrace;
+};
+
+#endif /* !SWIG */
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedTrace_h */
@@ -0,0 +1,341 @@
+/**
+ * @file   SedTypedVisitor.h
+ * @brief  Visitor dispatched on the type code at compile time
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ *
+ * @class SedTypedVisitor
+ * @ingroup Core
+ * @brief A visitor with one typed handler per Sed class, selected by a
+ * switch on the type code instead of dynamic_cast.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * Code that needs to tell the kinds of ranges, tasks or outputs apart
+ * usually tries one dynamic_cast after the other.  Each failed cast walks
+ * the type information of the object, so a chain of them costs a lot on
+ * large documents.  SedTypedVisitor uses the curiously recurring template
+ * pattern instead: derive from SedTypedVisitor<YourClass> and define the
+ * handlers you need, such as
+ *
+ * @code{.cpp}
+ * class RangeCounter : public SedTypedVisitor<RangeCounter>
+ * {
+ * public:
+ *   bool visitUniformRange(const SedUniformRange& range) { ++uniform; return true; }
+ *   bool visitRange(const SedRange& range) { ++other; return true; }
+ *   ...
+ * };
+ * @endcode
+ *
+ * dispatch() reads the type code of an object once, and calls the handler
+ * of its class through a static_cast, which the compiler can inline.  A
+ * handler that is not defined forwards to the handler of the base class,
+ * for example visitRepeatedTask() to visitTask() and visitSurface() to
+ * visitCurve(), and all of them end in visitBase(), which does nothing.
+ *
+ * The handlers return @c true to have traverse() descend into the children
+ * of the object.  Objects of other packages or with unknown type codes go
+ * to visitBase().
+ */
+
+#ifndef SedTypedVisitor_h
+#define SedTypedVisitor_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedTypeCodes.h>
+
+
+#ifdef __cplusplus
+
+
+#include <algorithm>
+#include <vector>
+
+#include <sedml/SedBase.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedListOf.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedChange.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedRemoveXML.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedAddXML.h>
+#include <sedml/SedChangeXML.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedParameter.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedSubTask.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedOutput.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedSurface.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedPlot3D.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedAlgorithmParameter.h>
+#include <sedml/SedOneStep.h>
+#include <sedml/SedSteadyState.h>
+#include <sedml/SedRange.h>
+#include <sedml/SedUniformRange.h>
+#include <sedml/SedVectorRange.h>
+#include <sedml/SedFunctionalRange.h>
+#include <sedml/SedDataDescription.h>
+#include <sedml/SedDataSource.h>
+#include <sedml/SedSlice.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+template <class Derived>
+class SedTypedVisitor
+{
+public:
+
+  /**
+   * Calls the handler for the class of @p x.
+   *
+   * @param x the object to visit.
+   *
+   * @return the value returned by the handler.
+   */
+  bool dispatch(const SedBase& x)
+  {
+    Derived& self = static_cast<Derived&>(*this);
+
+    switch (x.getTypeCode())
+      {
+      case SEDML_DOCUMENT:
+        return self.visitDocument(static_cast<const SedDocument&>(x));
+      case SEDML_LIST_OF:
+        return self.visitListOf(static_cast<const SedListOf&>(x));
+      case SEDML_MODEL:
+        return self.visitModel(static_cast<const SedModel&>(x));
+      case SEDML_CHANGE:
+        return self.visitChange(static_cast<const SedChange&>(x));
+      case SEDML_CHANGE_ATTRIBUTE:
+        return self.visitChangeAttribute(static_cast<const SedChangeAttribute&>(x));
+      case SEDML_CHANGE_REMOVEXML:
+        return self.visitRemoveXML(static_cast<const SedRemoveXML&>(x));
+      case SEDML_CHANGE_COMPUTECHANGE:
+        return self.visitComputeChange(static_cast<const SedComputeChange&>(x));
+      case SEDML_CHANGE_ADDXML:
+        return self.visitAddXML(static_cast<const SedAddXML&>(x));
+      case SEDML_CHANGE_CHANGEXML:
+        return self.visitChangeXML(static_cast<const SedChangeXML&>(x));
+      case SEDML_DATAGENERATOR:
+        return self.visitDataGenerator(static_cast<const SedDataGenerator&>(x));
+      case SEDML_VARIABLE:
+        return self.visitVariable(static_cast<const SedVariable&>(x));
+      case SEDML_PARAMETER:
+        return self.visitParameter(static_cast<const SedParameter&>(x));
+      case SEDML_TASK:
+        return self.visitTask(static_cast<const SedTask&>(x));
+      case SEDML_TASK_SUBTASK:
+        return self.visitSubTask(static_cast<const SedSubTask&>(x));
+      case SEDML_TASK_SETVALUE:
+        return self.visitSetValue(static_cast<const SedSetValue&>(x));
+      case SEDML_TASK_REPEATEDTASK:
+        return self.visitRepeatedTask(static_cast<const SedRepeatedTask&>(x));
+      case SEDML_OUTPUT:
+        return self.visitOutput(static_cast<const SedOutput&>(x));
+      case SEDML_OUTPUT_DATASET:
+        return self.visitDataSet(static_cast<const SedDataSet&>(x));
+      case SEDML_OUTPUT_CURVE:
+        return self.visitCurve(static_cast<const SedCurve&>(x));
+      case SEDML_OUTPUT_SURFACE:
+        return self.visitSurface(static_cast<const SedSurface&>(x));
+      case SEDML_OUTPUT_REPORT:
+        return self.visitReport(static_cast<const SedReport&>(x));
+      case SEDML_OUTPUT_PLOT2D:
+        return self.visitPlot2D(static_cast<const SedPlot2D&>(x));
+      case SEDML_OUTPUT_PLOT3D:
+        return self.visitPlot3D(static_cast<const SedPlot3D&>(x));
+      case SEDML_SIMULATION:
+        return self.visitSimulation(static_cast<const SedSimulation&>(x));
+      case SEDML_SIMULATION_ALGORITHM:
+        return self.visitAlgorithm(static_cast<const SedAlgorithm&>(x));
+      case SEDML_SIMULATION_UNIFORMTIMECOURSE:
+        return self.visitUniformTimeCourse(static_cast<const SedUniformTimeCourse&>(x));
+      case SEDML_SIMULATION_ALGORITHM_PARAMETER:
+        return self.visitAlgorithmParameter(static_cast<const SedAlgorithmParameter&>(x));
+      case SEDML_SIMULATION_ONESTEP:
+        return self.visitOneStep(static_cast<const SedOneStep&>(x));
+      case SEDML_SIMULATION_STEADYSTATE:
+        return self.visitSteadyState(static_cast<const SedSteadyState&>(x));
+      case SEDML_RANGE:
+        return self.visitRange(static_cast<const SedRange&>(x));
+      case SEDML_RANGE_UNIFORMRANGE:
+        return self.visitUniformRange(static_cast<const SedUniformRange&>(x));
+      case SEDML_RANGE_VECTORRANGE:
+        return self.visitVectorRange(static_cast<const SedVectorRange&>(x));
+      case SEDML_RANGE_FUNCTIONALRANGE:
+        return self.visitFunctionalRange(static_cast<const SedFunctionalRange&>(x));
+      case SEDML_DATA_DESCRIPTION:
+        return self.visitDataDescription(static_cast<const SedDataDescription&>(x));
+      case SEDML_DATA_SOURCE:
+        return self.visitDataSource(static_cast<const SedDataSource&>(x));
+      case SEDML_DATA_SLICE:
+        return self.visitSlice(static_cast<const SedSlice&>(x));
+      default:
+        return self.visitBase(x);
+      }
+  }
+
+
+  /**
+   * Dispatches @p x and, depth first in document order, all objects below
+   * it whose parents' handlers returned @c true.  The objects still to be
+   * visited are kept on an explicit stack local to the call, so the walk
+   * does not recurse and handlers may call traverse() themselves.
+   *
+   * @param x the object at which to start.
+   */
+  void traverse(const SedBase& x)
+  {
+    std::vector<const SedBase*> stack(1, &x);
+
+    while (!stack.empty())
+      {
+        const SedBase* current = stack.back();
+        stack.pop_back();
+
+        if (!dispatch(*current)) continue;
+
+        size_t first = stack.size();
+        current->getChildObjects(stack);
+        std::reverse(stack.begin() + first, stack.end());
+      }
+  }
+
+
+  /**
+   * The handler every other handler ends in.
+   *
+   * @return @c true.
+   */
+  bool visitBase(const SedBase&)
+  { return true; }
+
+  /** @cond doxygen-libsedml-internal */
+
+  bool visitDocument(const SedDocument& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitListOf(const SedListOf& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitModel(const SedModel& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitChange(const SedChange& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitChangeAttribute(const SedChangeAttribute& x)
+  { return static_cast<Derived*>(this)->visitChange(x); }
+  bool visitRemoveXML(const SedRemoveXML& x)
+  { return static_cast<Derived*>(this)->visitChange(x); }
+  bool visitComputeChange(const SedComputeChange& x)
+  { return static_cast<Derived*>(this)->visitChange(x); }
+  bool visitAddXML(const SedAddXML& x)
+  { return static_cast<Derived*>(this)->visitChange(x); }
+  bool visitChangeXML(const SedChangeXML& x)
+  { return static_cast<Derived*>(this)->visitChange(x); }
+  bool visitDataGenerator(const SedDataGenerator& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitVariable(const SedVariable& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitParameter(const SedParameter& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitTask(const SedTask& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitSubTask(const SedSubTask& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitSetValue(const SedSetValue& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitRepeatedTask(const SedRepeatedTask& x)
+  { return static_cast<Derived*>(this)->visitTask(x); }
+  bool visitOutput(const SedOutput& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitDataSet(const SedDataSet& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitCurve(const SedCurve& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitSurface(const SedSurface& x)
+  { return static_cast<Derived*>(this)->visitCurve(x); }
+  bool visitReport(const SedReport& x)
+  { return static_cast<Derived*>(this)->visitOutput(x); }
+  bool visitPlot2D(const SedPlot2D& x)
+  { return static_cast<Derived*>(this)->visitOutput(x); }
+  bool visitPlot3D(const SedPlot3D& x)
+  { return static_cast<Derived*>(this)->visitOutput(x); }
+  bool visitSimulation(const SedSimulation& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitAlgorithm(const SedAlgorithm& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitUniformTimeCourse(const SedUniformTimeCourse& x)
+  { return static_cast<Derived*>(this)->visitSimulation(x); }
+  bool visitAlgorithmParameter(const SedAlgorithmParameter& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitOneStep(const SedOneStep& x)
+  { return static_cast<Derived*>(this)->visitSimulation(x); }
+  bool visitSteadyState(const SedSteadyState& x)
+  { return static_cast<Derived*>(this)->visitSimulation(x); }
+  bool visitRange(const SedRange& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitUniformRange(const SedUniformRange& x)
+  { return static_cast<Derived*>(this)->visitRange(x); }
+  bool visitVectorRange(const SedVectorRange& x)
+  { return static_cast<Derived*>(this)->visitRange(x); }
+  bool visitFunctionalRange(const SedFunctionalRange& x)
+  { return static_cast<Derived*>(this)->visitRange(x); }
+  bool visitDataDescription(const SedDataDescription& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitDataSource(const SedDataSource& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+  bool visitSlice(const SedSlice& x)
+  { return static_cast<Derived*>(this)->visitBase(x); }
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedTypedVisitor_h */
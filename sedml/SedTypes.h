@@ -80,6 +80,26 @@
 
 #include <sedml/SedReader.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedCanonicalForm.h>
+#include <sedml/SedPatch.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDocumentMerger.h>
+#include <sedml/SedTargetResolver.h>
+#include <sedml/SedChangeEngine.h>
+#include <sedml/SedModelRepository.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedPreparedTaskChanges.h>
+#include <sedml/SedTimeGrid.h>
+#include <sedml/SedDownsampler.h>
+#include <sedml/SedEvaluationPlan.h>
+#include <sedml/SedTaskDeduplicator.h>
+#include <sedml/SedFrozenDocument.h>
+#include <sedml/SedSerializer.h>
+#include <sedml/SedTrace.h>
+#include <sedml/SedMemoryFootprint.h>
+#include <sedml/SedVisitor.h>
+#include <sedml/SedParallelVisitor.h>
+#include <sedml/SedTypedVisitor.h>
 
 #include <sbml/xml/XMLError.h>
 #include <sbml/math/ASTNode.h>
@@ -225,6 +225,8 @@ SedUniformRange::isSetType() const
 int
 SedUniformRange::setStart(double start)
 {
+  markDirty();
+
   mStart = start;
   mIsSetStart = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -237,6 +239,8 @@ SedUniformRange::setStart(double start)
 int
 SedUniformRange::setEnd(double end)
 {
+  markDirty();
+
   mEnd = end;
   mIsSetEnd = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -249,6 +253,8 @@ SedUniformRange::setEnd(double end)
 int
 SedUniformRange::setNumberOfPoints(int numberOfPoints)
 {
+  markDirty();
+
   mNumberOfPoints = numberOfPoints;
   mIsSetNumberOfPoints = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -261,6 +267,8 @@ SedUniformRange::setNumberOfPoints(int numberOfPoints)
 int
 SedUniformRange::setType(const std::string& type)
 {
+  markDirty();
+
   {
     mType = type;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -274,6 +282,8 @@ SedUniformRange::setType(const std::string& type)
 int
 SedUniformRange::unsetStart()
 {
+  markDirty();
+
   mStart = numeric_limits<double>::quiet_NaN();
   mIsSetStart = false;
 
@@ -294,6 +304,8 @@ SedUniformRange::unsetStart()
 int
 SedUniformRange::unsetEnd()
 {
+  markDirty();
+
   mEnd = numeric_limits<double>::quiet_NaN();
   mIsSetEnd = false;
 
@@ -314,6 +326,8 @@ SedUniformRange::unsetEnd()
 int
 SedUniformRange::unsetNumberOfPoints()
 {
+  markDirty();
+
   mNumberOfPoints = SEDML_INT_MAX;
   mIsSetNumberOfPoints = false;
 
@@ -334,6 +348,8 @@ SedUniformRange::unsetNumberOfPoints()
 int
 SedUniformRange::unsetType()
 {
+  markDirty();
+
   mType.erase();
 
   if (mType.empty() == true)
@@ -406,6 +422,158 @@ SedUniformRange::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedUniformRange to the vector.
+ */
+void
+SedUniformRange::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedRange::getAttributeNames(names);
+
+  names.push_back("start");
+  names.push_back("end");
+  names.push_back("numberOfPoints");
+  names.push_back("type");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedUniformRange::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "start")
+    {
+      return isSetStart();
+    }
+  else if (attributeName == "end")
+    {
+      return isSetEnd();
+    }
+  else if (attributeName == "numberOfPoints")
+    {
+      return isSetNumberOfPoints();
+    }
+  else if (attributeName == "type")
+    {
+      return isSetType();
+    }
+
+  return SedRange::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedUniformRange::getAttribute(const std::string& attributeName,
+                              std::string& value) const
+{
+  if (attributeName == "start")
+    {
+      if (isSetStart() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mStart);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "end")
+    {
+      if (isSetEnd() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mEnd);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "numberOfPoints")
+    {
+      if (isSetNumberOfPoints() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mNumberOfPoints);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "type")
+    {
+      if (isSetType() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mType;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedRange::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedUniformRange::setAttribute(const std::string& attributeName,
+                              const std::string& value)
+{
+  if (attributeName == "start")
+    {
+      double parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setStart(parsed);
+    }
+  else if (attributeName == "end")
+    {
+      double parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setEnd(parsed);
+    }
+  else if (attributeName == "numberOfPoints")
+    {
+      int parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setNumberOfPoints(parsed);
+    }
+  else if (attributeName == "type")
+    {
+      return setType(value);
+    }
+
+  return SedRange::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedUniformRange::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "start")
+    {
+      return unsetStart();
+    }
+  else if (attributeName == "end")
+    {
+      return unsetEnd();
+    }
+  else if (attributeName == "numberOfPoints")
+    {
+      return unsetNumberOfPoints();
+    }
+  else if (attributeName == "type")
+    {
+      return unsetType();
+    }
+
+  return SedRange::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -429,8 +597,30 @@ SedUniformRange::writeElements(XMLOutputStream& stream) const
 bool
 SedUniformRange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedUniformRange::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedRange::addMemoryFootprint(footprint);
 
+  footprint.addString(mType);
 }
 
 
@@ -229,6 +229,8 @@ SedUniformTimeCourse::isSetNumberOfPoints() const
 int
 SedUniformTimeCourse::setInitialTime(double initialTime)
 {
+  markDirty();
+
   mInitialTime = initialTime;
   mIsSetInitialTime = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -241,6 +243,8 @@ SedUniformTimeCourse::setInitialTime(double initialTime)
 int
 SedUniformTimeCourse::setOutputStartTime(double outputStartTime)
 {
+  markDirty();
+
   mOutputStartTime = outputStartTime;
   mIsSetOutputStartTime = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -253,6 +257,8 @@ SedUniformTimeCourse::setOutputStartTime(double outputStartTime)
 int
 SedUniformTimeCourse::setOutputEndTime(double outputEndTime)
 {
+  markDirty();
+
   mOutputEndTime = outputEndTime;
   mIsSetOutputEndTime = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -265,6 +271,8 @@ SedUniformTimeCourse::setOutputEndTime(double outputEndTime)
 int
 SedUniformTimeCourse::setNumberOfPoints(int numberOfPoints)
 {
+  markDirty();
+
   mNumberOfPoints = numberOfPoints;
   mIsSetNumberOfPoints = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -277,6 +285,8 @@ SedUniformTimeCourse::setNumberOfPoints(int numberOfPoints)
 int
 SedUniformTimeCourse::unsetInitialTime()
 {
+  markDirty();
+
   mInitialTime = numeric_limits<double>::quiet_NaN();
   mIsSetInitialTime = false;
 
@@ -297,6 +307,8 @@ SedUniformTimeCourse::unsetInitialTime()
 int
 SedUniformTimeCourse::unsetOutputStartTime()
 {
+  markDirty();
+
   mOutputStartTime = numeric_limits<double>::quiet_NaN();
   mIsSetOutputStartTime = false;
 
@@ -317,6 +329,8 @@ SedUniformTimeCourse::unsetOutputStartTime()
 int
 SedUniformTimeCourse::unsetOutputEndTime()
 {
+  markDirty();
+
   mOutputEndTime = numeric_limits<double>::quiet_NaN();
   mIsSetOutputEndTime = false;
 
@@ -337,6 +351,8 @@ SedUniformTimeCourse::unsetOutputEndTime()
 int
 SedUniformTimeCourse::unsetNumberOfPoints()
 {
+  markDirty();
+
   mNumberOfPoints = SEDML_INT_MAX;
   mIsSetNumberOfPoints = false;
 
@@ -410,6 +426,163 @@ SedUniformTimeCourse::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedUniformTimeCourse to the vector.
+ */
+void
+SedUniformTimeCourse::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedSimulation::getAttributeNames(names);
+
+  names.push_back("initialTime");
+  names.push_back("outputStartTime");
+  names.push_back("outputEndTime");
+  names.push_back("numberOfPoints");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedUniformTimeCourse::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "initialTime")
+    {
+      return isSetInitialTime();
+    }
+  else if (attributeName == "outputStartTime")
+    {
+      return isSetOutputStartTime();
+    }
+  else if (attributeName == "outputEndTime")
+    {
+      return isSetOutputEndTime();
+    }
+  else if (attributeName == "numberOfPoints")
+    {
+      return isSetNumberOfPoints();
+    }
+
+  return SedSimulation::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedUniformTimeCourse::getAttribute(const std::string& attributeName,
+                                   std::string& value) const
+{
+  if (attributeName == "initialTime")
+    {
+      if (isSetInitialTime() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mInitialTime);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "outputStartTime")
+    {
+      if (isSetOutputStartTime() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mOutputStartTime);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "outputEndTime")
+    {
+      if (isSetOutputEndTime() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mOutputEndTime);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "numberOfPoints")
+    {
+      if (isSetNumberOfPoints() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = attributeValueToString(mNumberOfPoints);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedSimulation::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedUniformTimeCourse::setAttribute(const std::string& attributeName,
+                                   const std::string& value)
+{
+  if (attributeName == "initialTime")
+    {
+      double parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setInitialTime(parsed);
+    }
+  else if (attributeName == "outputStartTime")
+    {
+      double parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setOutputStartTime(parsed);
+    }
+  else if (attributeName == "outputEndTime")
+    {
+      double parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setOutputEndTime(parsed);
+    }
+  else if (attributeName == "numberOfPoints")
+    {
+      int parsed;
+
+      if (attributeValueFromString(value, parsed) == false)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      return setNumberOfPoints(parsed);
+    }
+
+  return SedSimulation::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedUniformTimeCourse::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "initialTime")
+    {
+      return unsetInitialTime();
+    }
+  else if (attributeName == "outputStartTime")
+    {
+      return unsetOutputStartTime();
+    }
+  else if (attributeName == "outputEndTime")
+    {
+      return unsetOutputEndTime();
+    }
+  else if (attributeName == "numberOfPoints")
+    {
+      return unsetNumberOfPoints();
+    }
+
+  return SedSimulation::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -433,8 +606,13 @@ SedUniformTimeCourse::writeElements(XMLOutputStream& stream) const
 bool
 SedUniformTimeCourse::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
 
+  return result;
 }
 
 
@@ -261,7 +261,9 @@ SedVariable::isSetModelReference() const
 int
 SedVariable::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  markDirty();
+
+  return checkAndSetSId(id, mId);
 }
 
 
@@ -271,6 +273,8 @@ SedVariable::setId(const std::string& id)
 int
 SedVariable::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -284,8 +288,10 @@ SedVariable::setName(const std::string& name)
 int
 SedVariable::setSymbol(const std::string& symbol)
 {
+  markDirty();
+
   {
-    mSymbol = symbol;
+    mSymbol = internString(symbol);
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -297,8 +303,10 @@ SedVariable::setSymbol(const std::string& symbol)
 int
 SedVariable::setTarget(const std::string& target)
 {
+  markDirty();
+
   {
-    mTarget = target;
+    mTarget = internString(target);
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -310,13 +318,15 @@ SedVariable::setTarget(const std::string& target)
 int
 SedVariable::setTaskReference(const std::string& taskReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(taskReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mTaskReference = taskReference;
+      mTaskReference = internString(taskReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -328,13 +338,15 @@ SedVariable::setTaskReference(const std::string& taskReference)
 int
 SedVariable::setModelReference(const std::string& modelReference)
 {
+  markDirty();
+
   if (!(SyntaxChecker::isValidInternalSId(modelReference)))
     {
       return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
     }
   else
     {
-      mModelReference = modelReference;
+      mModelReference = internString(modelReference);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -346,6 +358,8 @@ SedVariable::setModelReference(const std::string& modelReference)
 int
 SedVariable::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -365,6 +379,8 @@ SedVariable::unsetId()
 int
 SedVariable::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -384,6 +400,8 @@ SedVariable::unsetName()
 int
 SedVariable::unsetSymbol()
 {
+  markDirty();
+
   mSymbol.erase();
 
   if (mSymbol.empty() == true)
@@ -403,6 +421,8 @@ SedVariable::unsetSymbol()
 int
 SedVariable::unsetTarget()
 {
+  markDirty();
+
   mTarget.erase();
 
   if (mTarget.empty() == true)
@@ -422,6 +442,8 @@ SedVariable::unsetTarget()
 int
 SedVariable::unsetTaskReference()
 {
+  markDirty();
+
   mTaskReference.erase();
 
   if (mTaskReference.empty() == true)
@@ -441,6 +463,8 @@ SedVariable::unsetTaskReference()
 int
 SedVariable::unsetModelReference()
 {
+  markDirty();
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -490,6 +514,183 @@ SedVariable::hasRequiredAttributes() const
 }
 
 
+/*
+ * Adds the names of the attributes of this SedVariable to the vector.
+ */
+void
+SedVariable::getAttributeNames(std::vector<std::string>& names) const
+{
+  SedBase::getAttributeNames(names);
+
+  names.push_back("id");
+  names.push_back("name");
+  names.push_back("symbol");
+  names.push_back("target");
+  names.push_back("taskReference");
+  names.push_back("modelReference");
+}
+
+
+/*
+ * Predicate returning true if the given attribute is set.
+ */
+bool
+SedVariable::isSetAttribute(const std::string& attributeName) const
+{
+  if (attributeName == "id")
+    {
+      return isSetId();
+    }
+  else if (attributeName == "name")
+    {
+      return isSetName();
+    }
+  else if (attributeName == "symbol")
+    {
+      return isSetSymbol();
+    }
+  else if (attributeName == "target")
+    {
+      return isSetTarget();
+    }
+  else if (attributeName == "taskReference")
+    {
+      return isSetTaskReference();
+    }
+  else if (attributeName == "modelReference")
+    {
+      return isSetModelReference();
+    }
+
+  return SedBase::isSetAttribute(attributeName);
+}
+
+
+/*
+ * Returns the value of the given attribute as a string.
+ */
+int
+SedVariable::getAttribute(const std::string& attributeName,
+                          std::string& value) const
+{
+  if (attributeName == "id")
+    {
+      if (isSetId() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mId;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "name")
+    {
+      if (isSetName() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mName;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "symbol")
+    {
+      if (isSetSymbol() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mSymbol;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "target")
+    {
+      if (isSetTarget() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mTarget;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "taskReference")
+    {
+      if (isSetTaskReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mTaskReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+  else if (attributeName == "modelReference")
+    {
+      if (isSetModelReference() == false) return LIBSEDML_OPERATION_FAILED;
+
+      value = mModelReference;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  return SedBase::getAttribute(attributeName, value);
+}
+
+
+/*
+ * Sets the given attribute from its string form.
+ */
+int
+SedVariable::setAttribute(const std::string& attributeName,
+                          const std::string& value)
+{
+  if (attributeName == "id")
+    {
+      return setId(value);
+    }
+  else if (attributeName == "name")
+    {
+      return setName(value);
+    }
+  else if (attributeName == "symbol")
+    {
+      return setSymbol(value);
+    }
+  else if (attributeName == "target")
+    {
+      return setTarget(value);
+    }
+  else if (attributeName == "taskReference")
+    {
+      return setTaskReference(value);
+    }
+  else if (attributeName == "modelReference")
+    {
+      return setModelReference(value);
+    }
+
+  return SedBase::setAttribute(attributeName, value);
+}
+
+
+/*
+ * Unsets the given attribute.
+ */
+int
+SedVariable::unsetAttribute(const std::string& attributeName)
+{
+  if (attributeName == "id")
+    {
+      return unsetId();
+    }
+  else if (attributeName == "name")
+    {
+      return unsetName();
+    }
+  else if (attributeName == "symbol")
+    {
+      return unsetSymbol();
+    }
+  else if (attributeName == "target")
+    {
+      return unsetTarget();
+    }
+  else if (attributeName == "taskReference")
+    {
+      return unsetTaskReference();
+    }
+  else if (attributeName == "modelReference")
+    {
+      return unsetModelReference();
+    }
+
+  return SedBase::unsetAttribute(attributeName);
+}
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -513,8 +714,56 @@ SedVariable::writeElements(XMLOutputStream& stream) const
 bool
 SedVariable::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
 
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedVariable::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedBase::addMemoryFootprint(footprint);
+
+  footprint.addString(mId);
+  footprint.addString(mName);
+  footprint.addString(mSymbol);
+  footprint.addString(mTarget);
+  footprint.addString(mTaskReference);
+  footprint.addString(mModelReference);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Interns the strings of this object in the pool of its document.
+ */
+void
+SedVariable::internStrings()
+{
+  SedBase::internStrings();
+
+  reinternString(mId);
+  reinternString(mSymbol);
+  reinternString(mTarget);
+  reinternString(mTaskReference);
+  reinternString(mModelReference);
 }
 
 
@@ -574,7 +823,7 @@ SedVariable::readAttributes(const XMLAttributes& attributes,
   //
   // id SId  ( use = "required" )
   //
-  assigned = attributes.readInto("id", mId, getErrorLog(), true);
+  assigned = readInto(attributes, "id", mId, true);
 
   if (assigned == true)
     {
@@ -608,7 +857,7 @@ SedVariable::readAttributes(const XMLAttributes& attributes,
   //
   // symbol string   ( use = "optional" )
   //
-  assigned = attributes.readInto("symbol", mSymbol, getErrorLog(), false);
+  assigned = readInto(attributes, "symbol", mSymbol, false);
 
   if (assigned == true)
     {
@@ -623,7 +872,7 @@ SedVariable::readAttributes(const XMLAttributes& attributes,
   //
   // target string   ( use = "optional" )
   //
-  assigned = attributes.readInto("target", mTarget, getErrorLog(), false);
+  assigned = readInto(attributes, "target", mTarget, false);
 
   if (assigned == true)
     {
@@ -638,7 +887,7 @@ SedVariable::readAttributes(const XMLAttributes& attributes,
   //
   // taskReference SIdRef   ( use = "optional" )
   //
-  assigned = attributes.readInto("taskReference", mTaskReference, getErrorLog(), false);
+  assigned = readInto(attributes, "taskReference", mTaskReference, false);
 
   if (assigned == true)
     {
@@ -657,7 +906,7 @@ SedVariable::readAttributes(const XMLAttributes& attributes,
   //
   // modelReference SIdRef   ( use = "optional" )
   //
-  assigned = attributes.readInto("modelReference", mModelReference, getErrorLog(), false);
+  assigned = readInto(attributes, "modelReference", mModelReference, false);
 
   if (assigned == true)
     {
@@ -864,6 +1113,8 @@ SedListOfVariables::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      item->connectToParent(NULL);
+      markDirty();
     }
 
   return static_cast <SedVariable*>(item);
@@ -901,15 +1152,12 @@ SedListOfVariables::getItemTypeCode() const
 }
 
 
-/** @cond doxygen-libsedml-internal */
-
 /*
- * Creates a new SedVariable in this SedListOfVariables
+ * Creates a new item for the given element name and appends it.
  */
 SedBase*
-SedListOfVariables::createObject(XMLInputStream& stream)
+SedListOfVariables::createChildObject(const std::string& name)
 {
-  const std::string& name   = stream.peek().getName();
   SedBase* object = NULL;
 
   if (name == "variable")
@@ -922,6 +1170,18 @@ SedListOfVariables::createObject(XMLInputStream& stream)
 }
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates a new SedVariable in this SedListOfVariables
+ */
+SedBase*
+SedListOfVariables::createObject(XMLInputStream& stream)
+{
+  return createChildObject(stream.peek().getName());
+}
+
+
 /** @endcond doxygen-libsedml-internal */
 
 
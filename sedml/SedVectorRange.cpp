@@ -131,6 +131,9 @@ SedVectorRange::getValues() const
 std::vector<double>&
 SedVectorRange::getValues()
 {
+  // the caller may modify the values through the returned reference
+  markDirty();
+
   return mValues;
 }
 
@@ -177,6 +180,8 @@ SedVectorRange::getNumValues() const
 int
 SedVectorRange::setValues(const std::vector<double>& value)
 {
+  markDirty();
+
   mValues = value;
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -197,6 +202,8 @@ SedVectorRange::setValues(const std::vector<double>& value)
 int
 SedVectorRange::addValue(double value)
 {
+  markDirty();
+
   mValues.push_back(value);
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -215,6 +222,8 @@ SedVectorRange::addValue(double value)
 int
 SedVectorRange::clearValues()
 {
+  markDirty();
+
   mValues.clear();
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -302,8 +311,30 @@ SedVectorRange::writeElements(XMLOutputStream& stream) const
 bool
 SedVectorRange::accept(SedVisitor& v) const
 {
-  return false;
+  bool result = v.visit(*this);
+
+  if (result) acceptChildren(v);
+
+  v.leave(*this);
+
+  return result;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Charges the memory this object owns to the footprint.
+ */
+void
+SedVectorRange::addMemoryFootprint(SedMemoryFootprint& footprint) const
+{
+  SedRange::addMemoryFootprint(footprint);
 
+  footprint.addValues(mValues);
 }
 
 
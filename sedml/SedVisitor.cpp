@@ -63,7 +63,7 @@ SedVisitor::visit(const SedListOf& x, int type)
 bool
 SedVisitor::visit(const SedBase& sb)
 {
-  return false;
+  return true;
 }
 
 
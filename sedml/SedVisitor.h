@@ -53,6 +53,13 @@
  * <code>accept</code> that are used for invoking an object of class
  * SedVisitor.  An example of its use is in the Sed validation system,
  * which is internally implemented using this Visitor Pattern facility.
+ *
+ * SedDocument::accept() walks the whole document: every object is passed
+ * to visit(), then its children are visited in document order, then the
+ * object is passed to leave().  Returning @c false from
+ * visit(const SedBase&) skips the children of that object.  To spread a
+ * pass over several threads, derive from SedMergeableVisitor and run it
+ * with SedParallelVisitor.
  */
 
 #ifndef SedVisitor_h
@@ -76,7 +83,7 @@ class SedDocument;
 class SedListOf;
 
 
-class SedVisitor
+class LIBSEDML_EXTERN SedVisitor
 {
 public:
 
@@ -112,6 +119,9 @@ public:
    * Pattern</i></a> to perform operations on SedBase objects.
    *
    * @param x the SedBase object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   * The default implementation returns @c true.
    */
   virtual bool visit(const SedBase                    &x);
 
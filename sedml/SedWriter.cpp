@@ -47,6 +47,8 @@
 #include <sedml/SedErrorLog.h>
 #include <sedml/SedDocument.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedFragmentOutputStream.h>
+#include <sedml/SedTrace.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/OutputCompressor.h>
@@ -63,6 +65,10 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new SedWriter.
  */
 SedWriter::SedWriter()
+  : mProgramName("")
+  , mProgramVersion("")
+  , mCacheFragments(false)
+  , mTrace(NULL)
 {
 }
 
@@ -113,6 +119,76 @@ SedWriter::setProgramVersion(const std::string& version)
 }
 
 
+/*
+ * Sets whether the XML of unmodified objects is reused.
+ */
+int
+SedWriter::setCacheFragments(bool cache)
+{
+  mCacheFragments = cache;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if the XML of unmodified objects is reused.
+ */
+bool
+SedWriter::getCacheFragments() const
+{
+  return mCacheFragments;
+}
+
+
+/*
+ * Sets the trace into which the documents written are recorded.
+ */
+int
+SedWriter::setTrace(SedTrace* trace)
+{
+  mTrace = trace;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the trace into which the documents written are recorded.
+ */
+SedTrace*
+SedWriter::getTrace() const
+{
+  return mTrace;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Sets a trace on a document for as long as it exists.
+ */
+class SedTraceAttachment
+{
+public:
+  SedTraceAttachment(const SedDocument* d, SedTrace* trace)
+    : mDocument(const_cast<SedDocument*>(d))
+    , mPrevious(d->getTrace())
+  {
+    mDocument->setTrace(trace);
+  }
+
+  ~SedTraceAttachment()
+  {
+    mDocument->setTrace(mPrevious);
+  }
+
+private:
+  SedDocument* mDocument;
+  SedTrace* mPrevious;
+};
+
+/** @endcond */
+
+
 /*
  * Writes the given Sed document to filename.
  *
@@ -244,9 +320,39 @@ SedWriter::writeSedML(const SedDocument* d, std::ostream& stream)
   try
     {
       stream.exceptions(ios_base::badbit | ios_base::failbit | ios_base::eofbit);
-      XMLOutputStream xos(stream, "UTF-8", true, mProgramName,
-                          mProgramVersion);
-      d->write(xos);
+
+      if (mTrace != NULL)
+        {
+          // count every byte on its way to the stream, so that each element
+          // knows how much it wrote
+          SedTraceAttachment attachment(d, mTrace);
+          SedTraceBuffer buffer(stream.rdbuf(), mTrace);
+          std::ostream tracedStream(&buffer);
+          tracedStream.exceptions(ios_base::badbit | ios_base::failbit | ios_base::eofbit);
+
+          SedTraceScope scope(mTrace, SedTrace::PHASE_DOCUMENT, "write");
+          SedRawOutputStream xos(tracedStream, "UTF-8", true, mProgramName,
+                                 mProgramVersion);
+          d->write(xos);
+        }
+      else if (mCacheFragments)
+        {
+          // collect the output in memory so that SedBase::write can record
+          // and reuse the text of every element
+          SedFragmentBuffer buffer;
+          std::ostream bufferStream(&buffer);
+          SedFragmentOutputStream xos(bufferStream, buffer, "UTF-8", true,
+                                      mProgramName, mProgramVersion);
+          d->write(xos);
+          stream.write(buffer.str().data(), buffer.str().size());
+        }
+      else
+        {
+          SedRawOutputStream xos(stream, "UTF-8", true, mProgramName,
+                                 mProgramVersion);
+          d->write(xos);
+        }
+
       stream << endl;
 
       result = true;
@@ -400,6 +506,40 @@ SedWriter_setProgramVersion(SedWriter_t *sw, const char *version)
 }
 
 
+/**
+ * Sets whether the given SedWriter_t structure reuses the XML of
+ * unmodified objects.
+ *
+ * @return integer value indicating success/failure of the
+ * function.  @if clike The value is drawn from the
+ * enumeration #OperationReturnValues_t. @endif@~ The possible values
+ * returned by this function are:
+ * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+ * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setCacheFragments(SedWriter_t *sw, int cache)
+{
+  if (sw != NULL)
+    return sw->setCacheFragments(cache != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * @return @c 1 if the given SedWriter_t structure reuses the XML of
+ * unmodified objects, @c 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_getCacheFragments(const SedWriter_t *sw)
+{
+  return (sw != NULL) ? static_cast<int>(sw->getCacheFragments()) : 0;
+}
+
+
 /**
  * Writes the given Sed document to filename.
  *
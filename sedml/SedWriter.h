@@ -95,6 +95,7 @@
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
 class SedDocument;
+class SedTrace;
 
 
 class LIBSEDML_EXTERN SedWriter
@@ -174,6 +175,70 @@ public:
   int setProgramVersion(const std::string& version);
 
 
+  /**
+   * Sets whether this SedWriter reuses the XML of unmodified objects.
+   *
+   * With fragment caching enabled, every item of the top-level lists
+   * (models, simulations, tasks, data generators, outputs, ...) keeps the
+   * XML produced for it (see SedBase::isDirty()).  Writing the same document
+   * again then only serializes the items that were modified since, and
+   * copies the cached text for everything else, which makes repeatedly
+   * saving a large document after small edits much cheaper.  The output is
+   * identical to the one produced without caching.
+   *
+   * The cached text is stored on the items themselves, so enabling this
+   * roughly adds the size of the written document to the memory it uses,
+   * and a document must not be written by several threads at once while
+   * caching is enabled.
+   *
+   * @param cache a boolean, @c true to enable fragment caching.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   *
+   * @see getCacheFragments()
+   * @see SedDocument::invalidateXMLFragments()
+   */
+  int setCacheFragments(bool cache);
+
+
+  /**
+   * @return @c true if this SedWriter reuses the XML of unmodified objects,
+   * @c false otherwise.
+   *
+   * @see setCacheFragments(bool cache)
+   */
+  bool getCacheFragments() const;
+
+
+  /**
+   * Sets the trace into which this SedWriter records the timers and
+   * counters of the documents it writes.
+   *
+   * A traced write does not use cached fragments, so that the size and
+   * time of every element are measured.  While it runs, the trace is set
+   * on the document, so a document must not be written by several
+   * threads at once with tracing enabled.
+   *
+   * @param trace the SedTrace, which is not owned by this SedWriter, or
+   * @c NULL to stop tracing.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   *
+   * @see SedTrace
+   */
+  int setTrace(SedTrace* trace);
+
+
+  /**
+   * @return the trace of this SedWriter, or @c NULL if it does not trace.
+   */
+  SedTrace* getTrace() const;
+
+
   /**
    * Writes the given Sed document to filename.
    *
@@ -322,6 +387,8 @@ protected:
 
   std::string mProgramName;
   std::string mProgramVersion;
+  bool mCacheFragments;
+  SedTrace* mTrace;
 
   /** @endcond */
 };
@@ -378,6 +445,22 @@ LIBSEDML_EXTERN
 int
 SedWriter_setProgramVersion(SedWriter_t *sw, const char *version);
 
+/**
+ * Sets whether the given SedWriter_t structure reuses the XML of
+ * unmodified objects.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setCacheFragments(SedWriter_t *sw, int cache);
+
+/**
+ * @return @c 1 if the given SedWriter_t structure reuses the XML of
+ * unmodified objects, @c 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_getCacheFragments(const SedWriter_t *sw);
+
 /**
  * Writes the given Sed document to filename.
  *
@@ -84,6 +84,12 @@ typedef CLASS_OR_STRUCT SedReader                     SedReader_t;
  */
 typedef CLASS_OR_STRUCT SedWriter                     SedWriter_t;
 
+/**
+ * @var typedef class SedPatch SedPatch_t
+ * @copydoc SedPatch
+ */
+typedef CLASS_OR_STRUCT SedPatch                      SedPatch_t;
+
 
 /**
  * @var typedef class SedNamespaces SedNamespaces_t
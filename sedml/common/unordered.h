@@ -0,0 +1,66 @@
+/**
+ * @file    unordered.h
+ * @brief   Hash based maps and sets for C++98 and later compilers
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * libSEDML is written in C++98, which has no hash tables.  This header
+ * includes std::unordered_map and std::unordered_set where the compiler
+ * provides them, and the TR1 versions otherwise; use them as
+ * LIBSEDML_UNORDERED_NAMESPACE::unordered_map and
+ * LIBSEDML_UNORDERED_NAMESPACE::unordered_set.
+ */
+
+
+#ifndef LIBSEDML_UNORDERED_H
+#define LIBSEDML_UNORDERED_H
+
+#ifdef __cplusplus
+
+/* any standard header defines _LIBCPP_VERSION for libc++ */
+#include <cstddef>
+
+#if __cplusplus >= 201103L || defined(_LIBCPP_VERSION) \
+    || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#  include <unordered_map>
+#  include <unordered_set>
+#  define LIBSEDML_UNORDERED_NAMESPACE std
+#else
+#  include <tr1/unordered_map>
+#  include <tr1/unordered_set>
+#  define LIBSEDML_UNORDERED_NAMESPACE std::tr1
+#endif
+
+#endif  /* __cplusplus */
+
+#endif  /* LIBSEDML_UNORDERED_H */
@@ -37,11 +37,16 @@
  * 
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <limits>
 
 #include <iostream>
 #include <check.h>
 #include <string>
+#include <map>
 #include <sstream>
 
 #include <sbml/common/libsbml-version.h>
@@ -49,7 +54,40 @@
 
 #include <sedml/SedDocument.h>
 #include <sedml/SedDataGenerator.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedAddXML.h>
+#include <sedml/SedChangeXML.h>
+#include <sedml/SedRemoveXML.h>
+#include <sedml/SedUniformTimeCourse.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedReader.h>
+#include <sedml/SedCanonicalForm.h>
+#include <sedml/SedPatch.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDocumentMerger.h>
+#include <sedml/SedTargetResolver.h>
+#include <sedml/SedChangeEngine.h>
+#include <sedml/SedModelRepository.h>
+#include <sedml/SedPreparedTaskChanges.h>
+#include <sedml/SedTimeGrid.h>
+#include <sedml/SedDownsampler.h>
+#include <sedml/SedEvaluationPlan.h>
+#include <sedml/SedTaskDeduplicator.h>
+#include <sedml/SedFrozenDocument.h>
+#include <sedml/SedParallelVisitor.h>
+#include <sedml/SedTypedVisitor.h>
+#include <sedml/SedSerializer.h>
+#include <sedml/SedTrace.h>
+#include <sedml/SedMemoryFootprint.h>
+#include <sedml/SedVectorRange.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedUniformRange.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedAlgorithm.h>
 
 #include <sbml/math/L3FormulaFormatter.h>
 #include <sbml/math/L3Parser.h>
@@ -63,6 +101,64 @@ LIBSEDML_CPP_NAMESPACE_USE
 /** @endcond */
 
 
+/*
+ * Records the ids of the visited objects in order, and skips the
+ * variables of data generators when asked to.
+ */
+class IdCollector : public SedMergeableVisitor
+{
+public:
+  IdCollector(bool skipVariables = false)
+    : skipVariables(skipVariables), numLists(0) {}
+
+  virtual bool visit(const SedBase& x)
+  {
+    if (x.isSetId()) ids += x.getId() + " ";
+    return !(skipVariables && x.getTypeCode() == SEDML_DATAGENERATOR);
+  }
+
+  virtual void visit(const SedListOf& x, int type) { ++numLists; }
+
+  virtual SedMergeableVisitor* clone() const
+  {
+    return new IdCollector(skipVariables);
+  }
+
+  virtual void merge(const SedMergeableVisitor& other)
+  {
+    const IdCollector& collector = static_cast<const IdCollector&>(other);
+    ids += collector.ids;
+    numLists += collector.numLists;
+  }
+
+  bool skipVariables;
+  string ids;
+  int numLists;
+};
+
+
+/*
+ * Counts ranges by kind; repeated tasks reach visitTask() and the
+ * children of plots are skipped.
+ */
+class RangeCounter : public SedTypedVisitor<RangeCounter>
+{
+public:
+  RangeCounter() : numUniform(0), numOtherRanges(0), numTasks(0), numOther(0) {}
+
+  bool visitUniformRange(const SedUniformRange&) { ++numUniform; return true; }
+  bool visitRange(const SedRange&) { ++numOtherRanges; return true; }
+  bool visitTask(const SedTask&) { ++numTasks; return true; }
+  bool visitPlot2D(const SedPlot2D&) { return false; }
+  bool visitBase(const SedBase&) { ++numOther; return true; }
+
+  int numUniform;
+  int numOtherRanges;
+  int numTasks;
+  int numOther;
+};
+
+
 CK_CPPSTART
 
 
@@ -100,6 +196,1740 @@ END_TEST
 
 
 
+START_TEST (test_writer_fragment_cache)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("model1");
+  model->setLanguage("urn:sedml:language:sbml");
+  model->setSource("model1.xml");
+  SedChangeAttribute* change = model->createChangeAttribute();
+  change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']/@value");
+  change->setNewValue("1.0");
+  SedDataGenerator* sdg = doc.createDataGenerator();
+  sdg->setId("dg1");
+  sdg->setMath(SBML_parseL3Formula("S1/S2"));
+
+  SedWriter plain;
+  SedWriter cached;
+  cached.setCacheFragments(true);
+
+  ostringstream stream;
+  ostringstream expected;
+  cached.writeSedML(&doc, stream);
+  plain.writeSedML(&doc, expected);
+  fail_unless( stream.str() == expected.str() );
+  fail_unless( !doc.isDirty() );
+  fail_unless( !change->isDirty() );
+
+  change->setNewValue("2.0");
+  fail_unless( change->isDirty() );
+  fail_unless( model->isDirty() );
+  fail_unless( doc.isDirty() );
+  fail_unless( !sdg->isDirty() );
+
+  stream.str("");
+  expected.str("");
+  cached.writeSedML(&doc, stream);
+  plain.writeSedML(&doc, expected);
+  fail_unless( stream.str() == expected.str() );
+  fail_unless( expected.str().find("newValue=\"2.0\"") != string::npos );
+
+  doc.invalidateXMLFragments();
+  stream.str("");
+  cached.writeSedML(&doc, stream);
+  fail_unless( stream.str() == expected.str() );
+
+  // nested objects are written with their cached item
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->setId("repeated1");
+  repeated->setRangeId("range1");
+  SedVectorRange* range = repeated->createVectorRange();
+  range->setId("range1");
+  range->addValue(1);
+
+  stream.str("");
+  cached.writeSedML(&doc, stream);
+  fail_unless( !range->isDirty() );
+
+  range->addValue(2);
+  fail_unless( range->isDirty() );
+  fail_unless( repeated->isDirty() );
+
+  stream.str("");
+  expected.str("");
+  cached.writeSedML(&doc, stream);
+  plain.writeSedML(&doc, expected);
+  fail_unless( stream.str() == expected.str() );
+}
+END_TEST
+
+
+START_TEST (test_canonical_hash)
+{
+  const char* first =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <listOfSimulations>\n"
+    "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' outputEndTime='10' numberOfPoints='100'>\n"
+    "      <algorithm kisaoID='KISAO:0000019'/>\n"
+    "    </uniformTimeCourse>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='model1' language='urn:sedml:language:sbml' source='model1.xml'/>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <task id='task1' modelReference='model1' simulationReference='sim1'/>\n"
+    "  </listOfTasks>\n"
+    "</sedML>\n";
+
+  // same content: other attribute order, number format, prefix and layout
+  const char* second =
+    "<?xml version='1.0' encoding='UTF-8'?>"
+    "<!-- Created by some tool -->"
+    "<s:sedML xmlns:s='http://sed-ml.org/sed-ml/level1/version2' version='2' level='1'>"
+    "<s:listOfSimulations><s:uniformTimeCourse numberOfPoints='100' outputEndTime='1e1'"
+    " outputStartTime='0.0' initialTime='0' id='sim1'><s:algorithm kisaoID='KISAO:0000019'/>"
+    "</s:uniformTimeCourse></s:listOfSimulations>"
+    "<s:listOfModels><s:model source='model1.xml' language='urn:sedml:language:sbml' id='model1'/>"
+    "</s:listOfModels><s:listOfTasks>"
+    "<s:task simulationReference='sim1' modelReference='model1' id='task1'/>"
+    "</s:listOfTasks><s:listOfOutputs/></s:sedML>";
+
+  SedReader reader;
+  SedDocument* doc1 = reader.readSedMLFromString(first);
+  SedDocument* doc2 = reader.readSedMLFromString(second);
+
+  SedCanonicalForm canonical;
+  fail_unless( canonical.toString(doc1) == canonical.toString(doc2) );
+  fail_unless( canonical.hash(doc1) == canonical.hash(doc2) );
+  fail_unless( canonical.hashTaskClosure(doc1->getTask("task1")) ==
+               canonical.hashTaskClosure(doc2->getTask("task1")) );
+
+  SedHash before = canonical.hashTaskClosure(doc2->getTask("task1"));
+
+  // objects outside of the closure do not change its hash
+  doc2->createDataGenerator()->setId("dg1");
+  fail_unless( canonical.hashTaskClosure(doc2->getTask("task1")) == before );
+  fail_unless( canonical.hash(doc1) != canonical.hash(doc2) );
+
+  static_cast<SedUniformTimeCourse*>(doc2->getSimulation("sim1"))->setNumberOfPoints(200);
+  fail_unless( canonical.hashTaskClosure(doc2->getTask("task1")) != before );
+
+  // a graph passed in gives the same closure as one built for the call,
+  // and a graph of another document is not used
+  SedHash current = canonical.hashTaskClosure(doc2->getTask("task1"));
+  SedDependencyGraph graph(doc2);
+  fail_unless( canonical.hashTaskClosure(doc2->getTask("task1"), &graph) == current );
+  fail_unless( canonical.hashTaskClosure(doc1->getTask("task1"), &graph) ==
+               canonical.hashTaskClosure(doc1->getTask("task1")) );
+
+  // edits after an earlier hash are seen by the next one
+  SedModel* model2 = doc2->createModel();
+  model2->setId("model2");
+  model2->setLanguage("urn:sedml:language:sbml");
+  model2->setSource("model2.xml");
+  doc2->getTask("task1")->setModelReference("model2");
+  SedHash edited = canonical.hashTaskClosure(doc2->getTask("task1"));
+  fail_unless( edited != current );
+  fail_unless( canonical.taskClosureToString(doc2->getTask("task1")).find("model2.xml")
+               != std::string::npos );
+
+  model2->setSource("model3.xml");
+  fail_unless( canonical.hashTaskClosure(doc2->getTask("task1")) != edited );
+
+  delete doc1;
+  delete doc2;
+}
+END_TEST
+
+
+START_TEST (test_structural_patch)
+{
+  const char* base =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <listOfSimulations>\n"
+    "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' outputEndTime='10' numberOfPoints='100'>\n"
+    "      <algorithm kisaoID='KISAO:0000019'/>\n"
+    "    </uniformTimeCourse>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='model1' language='urn:sedml:language:sbml' source='model1.xml'>\n"
+    "      <listOfChanges>\n"
+    "        <changeAttribute target='/sbml:sbml/sbml:model' newValue='1'/>\n"
+    "      </listOfChanges>\n"
+    "    </model>\n"
+    "    <model id='model2' language='urn:sedml:language:sbml' source='model2.xml'/>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <task id='task1' modelReference='model1' simulationReference='sim1'/>\n"
+    "    <task id='task2' modelReference='model2' simulationReference='sim1'/>\n"
+    "  </listOfTasks>\n"
+    "</sedML>\n";
+
+  const char* target =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <listOfSimulations>\n"
+    "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' outputEndTime='20' numberOfPoints='100'>\n"
+    "      <algorithm kisaoID='KISAO:0000088'/>\n"
+    "    </uniformTimeCourse>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='model1' language='urn:sedml:language:sbml' source='model1.xml'>\n"
+    "      <listOfChanges>\n"
+    "        <changeAttribute target='/sbml:sbml/sbml:model' newValue='2'/>\n"
+    "        <changeAttribute target='/sbml:sbml/sbml:model/@name' newValue='x y'/>\n"
+    "      </listOfChanges>\n"
+    "    </model>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <repeatedTask id='task3' range='r1' resetModel='false'>\n"
+    "      <listOfRanges>\n"
+    "        <vectorRange id='r1'><value>1</value><value>2.5</value></vectorRange>\n"
+    "      </listOfRanges>\n"
+    "      <listOfSubTasks><subTask order='1' task='task1'/></listOfSubTasks>\n"
+    "    </repeatedTask>\n"
+    "    <task id='task1' modelReference='model1' simulationReference='sim1'/>\n"
+    "  </listOfTasks>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='t' taskReference='task1' symbol='urn:sedml:symbol:time'/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><ci> t </ci></math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "</sedML>\n";
+
+  SedReader reader;
+  SedDocument* doc1 = reader.readSedMLFromString(base);
+  SedDocument* doc2 = reader.readSedMLFromString(target);
+
+  SedPatch* patch = SedPatch::createDiff(doc1, doc2);
+  fail_unless( patch != NULL );
+  fail_unless( !patch->isEmpty() );
+
+  // the text form reads back to the same patch
+  SedPatch* copy = SedPatch::fromString(patch->toString());
+  fail_unless( copy != NULL );
+  fail_unless( copy->toString() == patch->toString() );
+
+  fail_unless( copy->apply(doc1) == LIBSEDML_OPERATION_SUCCESS );
+
+  SedCanonicalForm canonical;
+  canonical.setIncludeNotes(true);
+  fail_unless( canonical.toString(doc1) == canonical.toString(doc2) );
+
+  SedPatch* rest = SedPatch::createDiff(doc1, doc2);
+  fail_unless( rest->isEmpty() );
+
+  fail_unless( SedPatch::fromString("unknown /") == NULL );
+
+  // a patch that fails part way leaves the document unchanged
+  SedPatch* broken = SedPatch::fromString(
+    "set /listOfTasks/@task1 name changed\n"
+    "set /listOfTasks/@missing name changed\n");
+  fail_unless( broken != NULL );
+  fail_unless( broken->getNumEdits() == 2 );
+
+  SedTask* task1 = doc1->getTask("task1");
+  fail_unless( broken->apply(doc1) == LIBSEDML_INVALID_OBJECT );
+  fail_unless( doc1->getTask("task1") == task1 );
+  fail_unless( !task1->isSetName() );
+  fail_unless( canonical.toString(doc1) == canonical.toString(doc2) );
+
+  delete broken;
+  delete rest;
+  delete copy;
+  delete patch;
+  delete doc1;
+  delete doc2;
+}
+END_TEST
+
+
+START_TEST (test_dependency_closure)
+{
+  const char* text =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <listOfSimulations>\n"
+    "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' outputEndTime='10' numberOfPoints='100'>\n"
+    "      <algorithm kisaoID='KISAO:0000019'/>\n"
+    "    </uniformTimeCourse>\n"
+    "    <steadyState id='sim2'><algorithm kisaoID='KISAO:0000282'/></steadyState>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='base' language='urn:sedml:language:sbml' source='model.xml'/>\n"
+    "    <model id='derived' language='urn:sedml:language:sbml' source='#base'/>\n"
+    "    <model id='other' language='urn:sedml:language:sbml' source='other.xml'/>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <task id='task1' modelReference='derived' simulationReference='sim1'/>\n"
+    "    <task id='task2' modelReference='other' simulationReference='sim2'/>\n"
+    "  </listOfTasks>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='t' taskReference='task1' symbol='urn:sedml:symbol:time'/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><ci> t </ci></math>\n"
+    "    </dataGenerator>\n"
+    "    <dataGenerator id='dg2'>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='x' taskReference='task2' target='/sbml:sbml'/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><ci> x </ci></math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "  <listOfOutputs>\n"
+    "    <report id='report1'>\n"
+    "      <listOfDataSets><dataSet id='d1' label='t' dataReference='dg1'/></listOfDataSets>\n"
+    "    </report>\n"
+    "    <report id='report2'>\n"
+    "      <listOfDataSets><dataSet id='d2' label='x' dataReference='dg2'/></listOfDataSets>\n"
+    "    </report>\n"
+    "  </listOfOutputs>\n"
+    "</sedML>\n";
+
+  SedReader reader;
+  SedDocument* doc = reader.readSedMLFromString(text);
+  SedDependencyGraph graph(doc);
+
+  std::vector<std::string> ids(1, "report1");
+  SedDocument* part = graph.extract(ids);
+  fail_unless( part != NULL );
+  fail_unless( part->getNumOutputs() == 1 );
+  fail_unless( part->getNumDataGenerators() == 1 );
+  fail_unless( part->getNumTasks() == 1 );
+  fail_unless( part->getNumSimulations() == 1 );
+  // the chained model is kept with the model derived from it
+  fail_unless( part->getNumModels() == 2 );
+  fail_unless( part->getModel("base") != NULL );
+  fail_unless( part->getModel("other") == NULL );
+  delete part;
+
+  ids[0] = "unknown";
+  fail_unless( graph.extract(ids) == NULL );
+
+  std::vector<SedDocument*> shards;
+  graph.partition(2, shards);
+  fail_unless( shards.size() == 2 );
+  fail_unless( shards[0]->getNumOutputs() == 1 );
+  fail_unless( shards[1]->getNumOutputs() == 1 );
+  fail_unless( shards[0]->getNumModels() + shards[1]->getNumModels() == 3 );
+
+  delete shards[0];
+  delete shards[1];
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_merge_documents)
+{
+  const char* text =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' xmlns:sbml='http://www.sbml.org/sbml/level2/version4' level='1' version='2'>\n"
+    "  <listOfSimulations>\n"
+    "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' outputEndTime='10' numberOfPoints='100'>\n"
+    "      <algorithm kisaoID='KISAO:0000019'/>\n"
+    "    </uniformTimeCourse>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='model1' language='urn:sedml:language:sbml' source='model.xml'/>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <task id='task1' modelReference='model1' simulationReference='sim1'/>\n"
+    "  </listOfTasks>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='x' taskReference='task1' target=\"/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S1']\"/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><ci> x </ci></math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "</sedML>\n";
+
+  SedReader reader;
+  SedDocument* target = reader.readSedMLFromString(text);
+  SedDocument* source = reader.readSedMLFromString(text);
+  SedModel* moved = source->getModel("model1");
+
+  SedDocumentMerger merger(target);
+  std::map<std::string, std::string> renamed;
+  fail_unless( merger.merge(source, &renamed) == LIBSEDML_OPERATION_SUCCESS );
+
+  // the elements are moved, not copied
+  fail_unless( source->getNumModels() == 0 );
+  fail_unless( target->getNumModels() == 2 );
+  fail_unless( target->getModel(1) == moved );
+  fail_unless( moved->getSedDocument() == target );
+
+  // the variable x is local to its data generator and keeps its id
+  fail_unless( renamed.size() == 4 );
+  fail_unless( renamed.find("x") == renamed.end() );
+  fail_unless( renamed["model1"] == "model1_1" );
+  fail_unless( moved->getId() == "model1_1" );
+
+  SedTask* task = target->getTask(1);
+  fail_unless( task->getId() == "task1_1" );
+  fail_unless( task->getModelReference() == "model1_1" );
+  fail_unless( task->getSimulationReference() == "sim1_1" );
+
+  SedDataGenerator* dg = target->getDataGenerator(1);
+  fail_unless( dg->getVariable(0)->getTaskReference() == "task1_1" );
+  fail_unless( dg->getVariable(0)->getId() == "x" );
+  fail_unless( std::string(dg->getMath()->getName()) == "x" );
+
+  // a prefix bound to another namespace is rejected before any change
+  SedDocument* clash = reader.readSedMLFromString(text);
+  clash->getNamespaces()->remove("sbml");
+  clash->getNamespaces()->add("http://www.sbml.org/sbml/level3/version1/core", "sbml");
+
+  fail_unless( merger.merge(clash) == LIBSEDML_NAMESPACES_MISMATCH );
+  fail_unless( clash->getNumModels() == 1 );
+  fail_unless( clash->getModel(0)->getId() == "model1" );
+  fail_unless( target->getNumModels() == 2 );
+
+  delete clash;
+  delete source;
+  delete target;
+}
+END_TEST
+
+
+START_TEST (test_target_resolver)
+{
+  const char* text =
+    "<sbml xmlns='http://www.sbml.org/sbml/level2/version4' level='2' version='4'>"
+    "<model id='m'>"
+    "<listOfSpecies>"
+    "<species id='S1' initialConcentration='1'/>"
+    "<species id='S2' initialConcentration='2'/>"
+    "</listOfSpecies>"
+    "<listOfParameters>"
+    "<parameter id='k1' value='0.1'/>"
+    "<parameter id='k2' value='0.2'/>"
+    "</listOfParameters>"
+    "</model>"
+    "</sbml>";
+
+  XMLNode* model = XMLNode::convertStringToXMLNode(text);
+  fail_unless( model != NULL );
+
+  XMLNamespaces ns;
+  ns.add("http://www.sbml.org/sbml/level2/version4", "sbml");
+
+  SedXPath path("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S2']/@initialConcentration", &ns);
+  fail_unless( path.isValid() );
+  fail_unless( path.getNumSteps() == 4 );
+  fail_unless( path.selectsAttribute() );
+  fail_unless( path.getAttributeName() == "initialConcentration" );
+
+  unsigned int step = 0;
+  fail_unless( path.getIdPredicate(step) == "S2" );
+  fail_unless( step == 3 );
+
+  fail_unless( !SedXPath("sbml/model").isValid() );
+  fail_unless( !SedXPath("/sbml/@id/model").isValid() );
+  fail_unless( !SedXPath("/sbml/model[@id='m'").isValid() );
+
+  SedTargetResolver resolver(model, &ns);
+
+  const SedTargetHandle* handle = resolver.resolve(path.getExpression());
+  fail_unless( handle != NULL );
+  fail_unless( handle->isAttribute() );
+  fail_unless( handle->getValue() == "2" );
+
+  // the handle is cached and writes through to the model
+  fail_unless( resolver.resolve(path.getExpression()) == handle );
+  fail_unless( handle->setValue("5") == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( model->getChild(0).getChild(0).getChild(1).getAttrValue("initialConcentration") == "5" );
+
+  // positional and unprefixed steps use the general path
+  handle = resolver.resolve("/sbml/model/listOfParameters/parameter[2]/@value");
+  fail_unless( handle != NULL );
+  fail_unless( handle->getValue() == "0.2" );
+
+  handle = resolver.resolve("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']");
+  fail_unless( handle != NULL );
+  fail_unless( !handle->isAttribute() );
+  fail_unless( handle->getNode()->getAttrValue("value") == "0.1" );
+
+  // an id in the wrong place, or unknown, does not resolve
+  fail_unless( resolver.resolve("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='k1']") == NULL );
+  fail_unless( resolver.resolve("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S3']") == NULL );
+  fail_unless( resolver.getNumCached() == 5 );
+
+  std::vector<SedTargetHandle> handles;
+  resolver.resolveAll(SedXPath("/sbml/model/listOfSpecies/species/@id"), handles);
+  fail_unless( handles.size() == 2 );
+  fail_unless( handles[0].getValue() == "S1" );
+  fail_unless( handles[1].getValue() == "S2" );
+
+  // changing the children of one element only drops the targets below it,
+  // after it, or that selected nothing
+  const std::string k3 = "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k3']";
+  const SedTargetHandle* s2 = resolver.resolve(path.getExpression());
+  XMLNode* parameters = &model->getChild(0).getChild(1);
+  resolver.invalidateChildren(parameters);
+  fail_unless( resolver.getNumCached() == 1 );
+
+  XMLNode* added = XMLNode::convertStringToXMLNode("<parameter id='k3' value='0.3'/>");
+  parameters->insertChild(0, *added);
+  delete added;
+  resolver.indexChildren(parameters);
+
+  handle = resolver.resolve(k3 + "/@value");
+  fail_unless( handle != NULL );
+  fail_unless( handle->getValue() == "0.3" );
+  fail_unless( resolver.getParent(handle->getNode()) == parameters );
+  fail_unless( resolver.resolve(path.getExpression()) == s2 );
+  fail_unless( resolver.resolve("/sbml/model/listOfParameters/parameter[2]/@value")->getValue() == "0.1" );
+
+  // an id used twice keeps its candidates in document order
+  XMLNode* species = &model->getChild(0).getChild(0);
+  resolver.invalidateChildren(species);
+  added = XMLNode::convertStringToXMLNode("<species id='k1'/>");
+  species->addChild(*added);
+  delete added;
+  resolver.indexChildren(species);
+  handles.clear();
+  resolver.resolveAll(SedXPath("/sbml/model/*/*[@id='k1']"), handles);
+  fail_unless( handles.size() == 2 );
+  fail_unless( handles[0].getNode()->getName() == "species" );
+
+  resolver.invalidate();
+  fail_unless( resolver.getNumCached() == 0 );
+
+  delete model;
+}
+END_TEST
+
+
+START_TEST (test_change_engine)
+{
+  const char* text =
+    "<sbml xmlns='http://www.sbml.org/sbml/level2/version4' level='2' version='4'>"
+    "<model id='m'>"
+    "<listOfSpecies>"
+    "<species id='S1' initialConcentration='1'/>"
+    "<species id='S2' initialConcentration='2'/>"
+    "</listOfSpecies>"
+    "<listOfParameters>"
+    "<parameter id='k1' value='0.1'/>"
+    "<parameter id='k2' value='0.2'/>"
+    "</listOfParameters>"
+    "</model>"
+    "</sbml>";
+  const std::string k1 = "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']";
+  const std::string s1 = "/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S1']";
+
+  SedDocument doc;
+  doc.getNamespaces()->add("http://www.sbml.org/sbml/level2/version4", "sbml");
+  SedModel* model = doc.createModel();
+
+  SedChangeAttribute* attribute = model->createChangeAttribute();
+  attribute->setTarget(k1 + "/@value");
+  attribute->setNewValue("3");
+
+  // reads the value set above, before it is written
+  SedComputeChange* compute = model->createComputeChange();
+  compute->setTarget(s1 + "/@initialConcentration");
+  SedVariable* variable = compute->createVariable();
+  variable->setId("k");
+  variable->setTarget(k1 + "/@value");
+  SedParameter* parameter = compute->createParameter();
+  parameter->setId("f");
+  parameter->setValue(2);
+  compute->setMath(SBML_parseL3Formula("k * f + 1"));
+
+  SedRemoveXML* remove = model->createRemoveXML();
+  remove->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S2']");
+
+  SedAddXML* add = model->createAddXML();
+  add->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters");
+  XMLNode* newXML = XMLNode::convertStringToXMLNode("<parameter id='k3' value='3'/>");
+  add->setNewXML(newXML);
+  delete newXML;
+
+  SedChangeXML* change = model->createChangeXML();
+  change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k2']");
+  newXML = XMLNode::convertStringToXMLNode("<parameter id='k4' value='4'/>");
+  change->setNewXML(newXML);
+  delete newXML;
+
+  // fails, but does not stop the others
+  attribute = model->createChangeAttribute();
+  attribute->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k2']/@value");
+  attribute->setNewValue("5");
+
+  XMLNode* xml = XMLNode::convertStringToXMLNode(text);
+  SedChangeEngine engine(xml, doc.getNamespaces());
+  fail_unless( engine.apply(model) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( engine.getNumFailed() == 1 );
+  fail_unless( engine.getFailed(0) == attribute );
+
+  const XMLNode& species = xml->getChild(0).getChild(0);
+  fail_unless( species.getNumChildren() == 1 );
+  fail_unless( species.getChild(0).getAttrValue("initialConcentration") == "7" );
+
+  const XMLNode& parameters = xml->getChild(0).getChild(1);
+  fail_unless( parameters.getNumChildren() == 3 );
+  fail_unless( parameters.getChild(0).getAttrValue("value") == "3" );
+  fail_unless( parameters.getChild(1).getAttrValue("id") == "k4" );
+  fail_unless( parameters.getChild(2).getAttrValue("id") == "k3" );
+
+  // two paths to the same attribute share one value, the last one set
+  SedModel* second = doc.createModel();
+  second->setId("m2");
+  attribute = second->createChangeAttribute();
+  attribute->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[1]/@value");
+  attribute->setNewValue("10");
+  attribute = second->createChangeAttribute();
+  attribute->setTarget(k1 + "/@value");
+  attribute->setNewValue("20");
+
+  // a variable of another model cannot be read
+  compute = second->createComputeChange();
+  compute->setTarget(s1 + "/@initialConcentration");
+  variable = compute->createVariable();
+  variable->setId("k");
+  variable->setModelReference("other");
+  variable->setTarget(k1 + "/@value");
+  compute->setMath(SBML_parseL3Formula("k"));
+
+  fail_unless( engine.apply(second) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( engine.getNumFailed() == 1 );
+  fail_unless( engine.getFailed(0) == compute );
+  fail_unless( parameters.getChild(0).getAttrValue("value") == "20" );
+  fail_unless( species.getChild(0).getAttrValue("initialConcentration") == "7" );
+
+  std::map<std::string, double> values;
+  values["x"] = 4;
+  double result = 0;
+  ASTNode* math = SBML_parseL3Formula("piecewise(sqrt(x), x > 0, 0) + abs(-x)");
+  fail_unless( SedChangeEngine::evaluate(math, values, result) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( result == 6 );
+  values.clear();
+  fail_unless( SedChangeEngine::evaluate(math, values, result) == LIBSEDML_OPERATION_FAILED );
+  delete math;
+
+  delete xml;
+}
+END_TEST
+
+
+START_TEST (test_model_repository)
+{
+  const char* text =
+    "<sbml xmlns='http://www.sbml.org/sbml/level2/version4' level='2' version='4'>"
+    "<model id='m'>"
+    "<listOfParameters>"
+    "<parameter id='k1' value='1'/>"
+    "<parameter id='k2' value='2'/>"
+    "</listOfParameters>"
+    "</model>"
+    "</sbml>";
+  const std::string k1 = "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']/@value";
+  const std::string k2 = "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k2']/@value";
+
+  SedDocument doc;
+  doc.getNamespaces()->add("http://www.sbml.org/sbml/level2/version4", "sbml");
+
+  SedModel* model = doc.createModel();
+  model->setId("base");
+  model->setSource("model.xml");
+
+  model = doc.createModel();
+  model->setId("a");
+  model->setSource("#base");
+  SedChangeAttribute* attribute = model->createChangeAttribute();
+  attribute->setTarget(k1);
+  attribute->setNewValue("10");
+
+  model = doc.createModel();
+  model->setId("b");
+  model->setSource("#a");
+  SedComputeChange* compute = model->createComputeChange();
+  compute->setTarget(k2);
+  SedVariable* variable = compute->createVariable();
+  variable->setId("k");
+  variable->setTarget(k1);
+  compute->setMath(SBML_parseL3Formula("k + 1"));
+
+  model = doc.createModel();
+  model->setId("c");
+  model->setSource("#b");
+  SedRemoveXML* remove = model->createRemoveXML();
+  remove->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']");
+
+  model = doc.createModel();
+  model->setId("loop1");
+  model->setSource("#loop2");
+  model = doc.createModel();
+  model->setId("loop2");
+  model->setSource("#loop1");
+
+  // reads a variable of another model, which fails
+  model = doc.createModel();
+  model->setId("d");
+  model->setSource("#base");
+  compute = model->createComputeChange();
+  compute->setTarget(k2);
+  variable = compute->createVariable();
+  variable->setId("k");
+  variable->setModelReference("a");
+  variable->setTarget(k1);
+  compute->setMath(SBML_parseL3Formula("k"));
+
+  model = doc.createModel();
+  model->setId("e");
+  model->setSource("#d");
+  attribute = model->createChangeAttribute();
+  attribute->setTarget(k1);
+  attribute->setNewValue("5");
+
+  SedModelRepository repository(&doc);
+  fail_unless( repository.addSource("model.xml", XMLNode::convertStringToXMLNode(text)) == LIBSEDML_OPERATION_SUCCESS );
+
+  const SedDerivedModel* b = repository.getModel("b");
+  const SedDerivedModel* a = repository.getModel("a");
+  fail_unless( a != NULL && b != NULL );
+  fail_unless( repository.getNumSources() == 1 );
+
+  // both share the parsed source and only hold their values
+  fail_unless( a->getXML() == repository.getSource("model.xml") );
+  fail_unless( b->getXML() == a->getXML() );
+  fail_unless( !b->hasOwnXML() );
+  fail_unless( a->getNumChangedValues() == 1 );
+  fail_unless( b->getNumChangedValues() == 2 );
+
+  std::string value;
+  fail_unless( b->getValue(k2, value) && value == "11" );
+  fail_unless( a->getValue(k2, value) && value == "2" );
+  fail_unless( repository.getModel("base")->getValue(k1, value) && value == "1" );
+
+  XMLNode* xml = b->createXML();
+  fail_unless( xml->getChild(0).getChild(0).getChild(0).getAttrValue("value") == "10" );
+  fail_unless( xml->getChild(0).getChild(0).getChild(1).getAttrValue("value") == "11" );
+  fail_unless( repository.getSource("model.xml")->getChild(0).getChild(0).getChild(0).getAttrValue("value") == "1" );
+  delete xml;
+
+  // removing XML needs a tree of its own
+  const SedDerivedModel* c = repository.getModel("c");
+  fail_unless( c->hasOwnXML() );
+  fail_unless( c->getNumFailed() == 0 );
+  fail_unless( c->getXML()->getChild(0).getChild(0).getNumChildren() == 1 );
+  fail_unless( c->getValue(k2, value) && value == "11" );
+
+  // failures of the models derived from are counted as well
+  fail_unless( repository.getModel("d")->getNumFailed() == 1 );
+  fail_unless( repository.getModel("e")->getNumFailed() == 1 );
+  fail_unless( repository.getModel("e")->getValue(k2, value) && value == "2" );
+
+  fail_unless( repository.getModel("loop1") == NULL );
+  fail_unless( repository.getModel("loop2") == NULL );
+  fail_unless( repository.getModel("unknown") == NULL );
+}
+END_TEST
+
+
+START_TEST (test_prepared_task_changes)
+{
+  const char* text =
+    "<sbml xmlns='http://www.sbml.org/sbml/level2/version4' level='2' version='4'>"
+    "<model id='m'>"
+    "<listOfSpecies>"
+    "<species id='S1' initialConcentration='3'/>"
+    "</listOfSpecies>"
+    "<listOfParameters>"
+    "<parameter id='k1' value='1'/>"
+    "<parameter id='k2' value='2'/>"
+    "</listOfParameters>"
+    "</model>"
+    "</sbml>";
+
+  SedDocument doc;
+  doc.getNamespaces()->add("http://www.sbml.org/sbml/level2/version4", "sbml");
+
+  SedRepeatedTask* task = doc.createRepeatedTask();
+  task->setRangeId("r");
+  SedUniformRange* range = task->createUniformRange();
+  range->setId("r");
+
+  SedSetValue* setValue = task->createTaskChange();
+  setValue->setModelReference("model1");
+  setValue->setRange("r");
+  setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']/@value");
+  setValue->setMath(SBML_parseL3Formula("r * 2"));
+
+  setValue = task->createTaskChange();
+  setValue->setModelReference("model1");
+  setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k2']/@value");
+  SedVariable* variable = setValue->createVariable();
+  variable->setId("s");
+  variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S1']/@initialConcentration");
+  SedParameter* parameter = setValue->createParameter();
+  parameter->setId("f");
+  parameter->setValue(10);
+  setValue->setMath(SBML_parseL3Formula("r + s * f"));
+
+  setValue = task->createTaskChange();
+  setValue->setModelReference("model1");
+  setValue->setMath(SBML_parseL3Formula("unknown + 1"));
+
+  SedPreparedTaskChanges prepared(task);
+  fail_unless( prepared.getNumRanges() == 1 );
+  fail_unless( prepared.getRangeId(0) == "r" );
+  fail_unless( prepared.getNumSetValues() == 3 );
+  fail_unless( prepared.isCompiled(0) );
+  fail_unless( prepared.isCompiled(1) );
+  fail_unless( !prepared.isCompiled(2) );
+
+  XMLNode* xml = XMLNode::convertStringToXMLNode(text);
+  SedTargetResolver resolver(xml, doc.getNamespaces());
+
+  // the third set value has no target
+  fail_unless( prepared.bindModel("model1", &resolver) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( prepared.getHandle(0) != NULL );
+  fail_unless( prepared.getHandle(2) == NULL );
+
+  double k1 = 0;
+  fail_unless( prepared.bindValue(0, &k1) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( prepared.bindValue(3, &k1) == LIBSEDML_INDEX_EXCEEDS_SIZE );
+
+  for (int i = 0; i < 5; ++i)
+  {
+    double r = i;
+    fail_unless( prepared.apply(&r) == LIBSEDML_OPERATION_SUCCESS );
+    fail_unless( k1 == 2 * r );
+    fail_unless( prepared.getValue(1) == r + 30 );
+  }
+
+  fail_unless( prepared.writeValues() == 2 );
+  fail_unless( prepared.getHandle(0)->getValue() == "8" );
+  fail_unless( prepared.getHandle(1)->getValue() == "34" );
+  fail_unless( prepared.apply(NULL) == LIBSEDML_INVALID_OBJECT );
+
+  delete xml;
+}
+END_TEST
+
+
+START_TEST (test_compiled_math)
+{
+  std::map<std::string, unsigned int> inputs;
+  inputs["x"] = 0;
+
+  SedCompiledMath shallow;
+  ASTNode* math = SBML_parseL3Formula("2 * x + 1");
+  fail_unless( shallow.compile(math, inputs) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( shallow.getStackSize() == 2 );
+  delete math;
+
+  // deeper than the buffer of evaluate(), so its stack is allocated
+  std::string formula = "x";
+  for (int i = 0; i < 100; ++i)
+    formula = "1 + (" + formula + ")";
+
+  SedCompiledMath deep;
+  math = SBML_parseL3Formula(formula.c_str());
+  fail_unless( deep.compile(math, inputs) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( deep.getStackSize() > SedCompiledMath::STACK_BUFFER_SIZE );
+  delete math;
+
+  double x = 3;
+  fail_unless( shallow.evaluate(&x) == 7 );
+  fail_unless( deep.evaluate(&x) == 103 );
+
+  std::vector<double> workspace(deep.getStackSize());
+  fail_unless( deep.evaluate(&x, &workspace[0]) == 103 );
+  fail_unless( shallow.evaluate(&x, &workspace[0]) == 7 );
+  fail_unless( deep.evaluate(&x, NULL) != deep.evaluate(&x, NULL) );
+}
+END_TEST
+
+
+START_TEST (test_time_grid)
+{
+  SedUniformTimeCourse timeCourse;
+  timeCourse.setInitialTime(0);
+  timeCourse.setOutputStartTime(0.1);
+  timeCourse.setOutputEndTime(0.7);
+  timeCourse.setNumberOfPoints(3000000);
+
+  SedTimeGrid grid(&timeCourse);
+  fail_unless( grid.isValid() );
+  fail_unless( grid.getNumTimes() == 3000001 );
+  fail_unless( grid.getTime(0) == 0.1 );
+  fail_unless( grid.getTime(3000000) == 0.7 );
+  fail_unless( fabs(grid.getTime(1500000) - 0.4) < 1e-15 );
+  fail_unless( fabs(grid.getTime(2999999) - (0.7 - 0.6 / 3000000)) < 1e-15 );
+
+  fail_unless( !SedTimeGrid(1, 0, 10).isValid() );
+  fail_unless( !SedTimeGrid(0, 1, 0).isValid() );
+
+  // two columns at adaptive steps, onto 0, 0.5, ..., 2
+  SedTimeGrid coarse(0, 2, 4);
+  double times[] = { 0, 0.2, 1, 1.75 };
+  double values[] = { 0, 10,  2, 10,  10, 20,  17.5, 0 };
+  double result[10];
+
+  fail_unless( coarse.resample(times, 4, values, 2, result) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( result[0] == 0 && result[1] == 10 );
+  fail_unless( fabs(result[2] - 5) < 1e-12 && fabs(result[3] - 13.75) < 1e-12 );
+  fail_unless( result[4] == 10 && result[5] == 20 );
+  fail_unless( fabs(result[6] - 15) < 1e-12 );
+  fail_unless( util_isNaN(result[8]) && util_isNaN(result[9]) );
+
+  double decreasing[] = { 0, 1, 0.5, 2 };
+  fail_unless( coarse.resample(decreasing, 4, values, 2, result) == LIBSEDML_INVALID_ATTRIBUTE_VALUE );
+}
+END_TEST
+
+
+START_TEST (test_downsampler)
+{
+  SedDocument doc;
+  SedPlot2D* plot = doc.createPlot2D();
+  SedCurve* curve = plot->createCurve();
+  curve->setId("c1");
+  curve->setLogX(false);
+  curve->setLogY(true);
+
+  SedPlotDownsampler downsamplers(plot, 100, 100000);
+  fail_unless( downsamplers.getNumSeries() == 1 );
+  fail_unless( downsamplers.getDownsampler("c2") == NULL );
+
+  SedDownsampler* downsampler = downsamplers.getDownsampler("c1");
+  fail_unless( downsampler->getMethod() == SEDML_DOWNSAMPLE_LTTB );
+
+  // a spike and a non-positive value, in chunks of 1000
+  std::vector<double> x(1000), y(1000);
+
+  for (int chunk = 0; chunk < 100; ++chunk)
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      x[i] = chunk * 1000 + i;
+      y[i] = x[i] == 54321 ? 1e6 : 1 + x[i] / 1000;
+    }
+
+    if (chunk == 7) y[3] = 0;
+
+    fail_unless( downsampler->addPoints(&x[0], &y[0], NULL, 1000) == LIBSEDML_OPERATION_SUCCESS );
+  }
+
+  downsamplers.finish();
+
+  std::vector<double> xs, ys, zs;
+  downsampler->takePoints(xs, ys, zs);
+  fail_unless( xs.size() <= 100 && xs.size() > 90 );
+  fail_unless( xs.front() == 0 && xs.back() == 99999 );
+  fail_unless( std::find(xs.begin(), xs.end(), 54321.0) != xs.end() );
+  fail_unless( std::find(xs.begin(), xs.end(), 7003.0) == xs.end() );
+  fail_unless( downsampler->getNumPoints() == 0 );
+
+  SedDownsampler minmax(8, 8, SEDML_DOWNSAMPLE_MINMAX);
+  double mx[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  double my[] = { 5, 9, 1, 5, 5, 5, 0, 5 };
+  minmax.addPoints(mx, my, NULL, 8);
+  minmax.finish();
+  minmax.takePoints(xs, ys, zs);
+  fail_unless( xs.size() == 7 );
+  fail_unless( xs[1] == 1 && xs[2] == 2 && xs[4] == 4 && xs[5] == 6 );
+}
+END_TEST
+
+
+START_TEST (test_evaluation_plan)
+{
+  SedDocument doc;
+
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("scaled");
+  SedVariable* variable = dg->createVariable();
+  variable->setId("v1");
+  variable->setTaskReference("task1");
+  variable->setTarget("X");
+  SedParameter* parameter = dg->createParameter();
+  parameter->setId("s");
+  parameter->setValue(2);
+  dg->setMath(SBML_parseL3Formula("v1 / s"));
+
+  dg = doc.createDataGenerator();
+  dg->setId("sum");
+  variable = dg->createVariable();
+  variable->setId("a");
+  variable->setTaskReference("task1");
+  variable->setTarget("X");
+  variable = dg->createVariable();
+  variable->setId("b");
+  variable->setTaskReference("task1");
+  variable->setTarget("Y");
+  dg->setMath(SBML_parseL3Formula("a / 2 + b"));
+
+  dg = doc.createDataGenerator();
+  dg->setId("unknown");
+  dg->setMath(SBML_parseL3Formula("c + 1"));
+
+  dg = doc.createDataGenerator();
+  dg->setId("other");
+  variable = dg->createVariable();
+  variable->setId("w");
+  variable->setTaskReference("task2");
+  variable->setTarget("X");
+  dg->setMath(SBML_parseL3Formula("w * (1 + 1)"));
+
+  SedEvaluationPlan plan(&doc);
+  fail_unless( plan.getNumDataGenerators() == 4 );
+  fail_unless( plan.isPlanned(0) && plan.isPlanned(1) && !plan.isPlanned(2) );
+  fail_unless( plan.getNumVariables() == 4 );
+  fail_unless( plan.getNumColumns() == 3 );
+  fail_unless( plan.getColumn(0) == doc.getDataGenerator(0)->getVariable(0) );
+  fail_unless( plan.getColumnIndex(doc.getDataGenerator(1)->getVariable(0)) == 0 );
+  fail_unless( plan.getColumnIndex(variable) == 2 );
+
+  // v1 / s and a / 2 are computed once, 1 + 1 is folded
+  fail_unless( plan.getNumUnsharedOperations() == 5 );
+  fail_unless( plan.getNumOperations() == 3 );
+
+  double x1[] = { 4, 6 };
+  double y1[] = { 1, 2 };
+  double x2[] = { 3, 5 };
+  const double* columns[] = { x1, y1, x2 };
+  double scaled[2], sum[2], unknown[2];
+  double* results[] = { scaled, sum, unknown, NULL };
+
+  fail_unless( plan.evaluate(columns, 2, results) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( scaled[0] == 2 && scaled[1] == 3 );
+  fail_unless( sum[0] == 3 && sum[1] == 5 );
+  fail_unless( unknown[0] != unknown[0] );
+
+  double other[2];
+  results[3] = other;
+  fail_unless( plan.evaluate(columns, 2, results) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( other[0] == 6 && other[1] == 10 );
+
+  columns[1] = NULL;
+  fail_unless( plan.evaluate(columns, 2, results) == LIBSEDML_INVALID_OBJECT );
+}
+END_TEST
+
+
+START_TEST (test_task_deduplication)
+{
+  const char* text =
+    "<sbml xmlns='http://www.sbml.org/sbml/level2/version4' level='2' version='4'>"
+    "<model id='m'>"
+    "<listOfParameters>"
+    "<parameter id='k1' value='1'/>"
+    "</listOfParameters>"
+    "</model>"
+    "</sbml>";
+  const std::string k1 = "/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k1']/@value";
+
+  SedDocument doc;
+  doc.getNamespaces()->add("http://www.sbml.org/sbml/level2/version4", "sbml");
+
+  SedModel* model = doc.createModel();
+  model->setId("m1");
+  model->setLanguage("urn:sedml:language:sbml");
+  model->setSource("model.xml");
+
+  // derived without changes: the same work as m1
+  model = doc.createModel();
+  model->setId("m2");
+  model->setSource("#m1");
+
+  model = doc.createModel();
+  model->setId("m3");
+  model->setSource("#m1");
+  SedChangeAttribute* attribute = model->createChangeAttribute();
+  attribute->setTarget(k1);
+  attribute->setNewValue("10");
+
+  // sets the value k1 already has, which only the resolved model shows
+  model = doc.createModel();
+  model->setId("m4");
+  model->setSource("#m1");
+  attribute = model->createChangeAttribute();
+  attribute->setTarget(k1);
+  attribute->setNewValue("1");
+
+  for (int i = 0; i < 3; ++i)
+  {
+    SedUniformTimeCourse* timeCourse = doc.createUniformTimeCourse();
+    timeCourse->setId(i == 0 ? "s1" : i == 1 ? "s2" : "s3");
+    timeCourse->setInitialTime(0);
+    timeCourse->setOutputStartTime(0);
+    timeCourse->setOutputEndTime(10);
+    timeCourse->setNumberOfPoints(i == 2 ? 200 : 100);
+    timeCourse->createAlgorithm()->setKisaoID("KISAO:0000019");
+  }
+
+  const char* tasks[][3] = {
+    { "t1", "m1", "s1" },
+    { "t2", "m1", "s2" },
+    { "t3", "m2", "s1" },
+    { "t4", "m3", "s1" },
+    { "t5", "m1", "s3" },
+    { "t6", "m4", "s1" },
+  };
+
+  for (int i = 0; i < 6; ++i)
+  {
+    SedTask* task = doc.createTask();
+    task->setId(tasks[i][0]);
+    task->setModelReference(tasks[i][1]);
+    task->setSimulationReference(tasks[i][2]);
+  }
+
+  SedCanonicalForm canonical;
+  fail_unless( canonical.hashTaskWork(doc.getTask(0)) == canonical.hashTaskWork(doc.getTask(1)) );
+  fail_unless( canonical.hashTaskClosure(doc.getTask(0)) != canonical.hashTaskClosure(doc.getTask(1)) );
+
+  SedTaskDeduplicator byDocument(&doc);
+  fail_unless( byDocument.getNumClasses() == 4 );
+  fail_unless( byDocument.getNumTasks(0) == 3 );
+  fail_unless( byDocument.getTask(0, 0)->getId() == "t1" );
+  fail_unless( byDocument.getClassIndex("t3") == 0 );
+  fail_unless( byDocument.getClassIndex("t6") == 3 );
+  fail_unless( byDocument.getClassIndex("t7") == -1 );
+
+  SedModelRepository repository(&doc);
+  repository.addSource("model.xml", XMLNode::convertStringToXMLNode(text));
+
+  SedTaskDeduplicator byModel(&doc, &repository);
+  fail_unless( byModel.getNumClasses() == 3 );
+  fail_unless( byModel.getNumTasks(0) == 4 );
+  fail_unless( byModel.getClassIndex("t6") == 0 );
+  fail_unless( byModel.getClassIndex("t4") == 1 );
+
+  std::string result;
+  SedFileResultCache cache(".");
+  fail_unless( !byModel.lookup("t1", result) );
+  byModel.setCache(&cache);
+  fail_unless( byModel.store("t7", "none") == LIBSEDML_INVALID_OBJECT );
+  fail_unless( byModel.store("t2", "results of t2") == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( byModel.lookup("t6", result) && result == "results of t2" );
+  fail_unless( !byModel.lookup("t4", result) );
+  remove(cache.getPath(byModel.getHash(0)).c_str());
+}
+END_TEST
+
+
+START_TEST (test_frozen_document)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("m1");
+  model->setSource("model.xml");
+  SedUniformTimeCourse* timeCourse = doc.createUniformTimeCourse();
+  timeCourse->setId("s1");
+  SedTask* task = doc.createTask();
+  task->setId("t1");
+  task->setModelReference("m1");
+  task->setSimulationReference("s1");
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg1");
+  SedVariable* variable = dg->createVariable();
+  variable->setId("v");
+  variable->setTaskReference("t1");
+  dg->setMath(SBML_parseL3Formula("v * 2"));
+
+  SedFrozenDocument* frozen = doc.freeze();
+
+  // the copy does not follow the document
+  task->setId("t2");
+
+  unsigned int root = frozen->getRoot();
+  fail_unless( frozen->getTypeCode(root) == SEDML_DOCUMENT );
+  fail_unless( frozen->getParent(root) == SedFrozenDocument::npos );
+
+  unsigned int t1 = frozen->getElementBySId("t1");
+  fail_unless( frozen->getTypeCode(t1) == SEDML_TASK );
+  fail_unless( frozen->getElementBySId("t2") == SedFrozenDocument::npos );
+  fail_unless( std::string(frozen->getAttribute(t1, "simulationReference")) == "s1" );
+  fail_unless( frozen->getAttribute(t1, "name") == NULL );
+  fail_unless( frozen->getReference(t1, "modelReference") == frozen->getElementBySId("m1") );
+  fail_unless( frozen->getReference(t1, "simulationReference") == frozen->getElementBySId("s1") );
+
+  fail_unless( frozen->getNumElementsOfType(SEDML_TASK) == 1 );
+  fail_unless( frozen->getElementOfType(SEDML_TASK, 0) == t1 );
+  fail_unless( frozen->getElementOfType(SEDML_TASK, 1) == SedFrozenDocument::npos );
+  fail_unless( frozen->getElementOfType(SEDML_MODEL, 0) == frozen->getElementBySId("m1") );
+
+  unsigned int v = frozen->getElementBySId("v");
+  unsigned int dg1 = frozen->getElementBySId("dg1");
+  fail_unless( frozen->getParent(frozen->getParent(v)) == dg1 );
+  fail_unless( frozen->getReference(v, "taskReference") == t1 );
+  fail_unless( std::string(frozen->getMath(dg1)) == "v * 2" );
+  fail_unless( std::string(frozen->getMath(t1)).empty() );
+
+  delete frozen;
+}
+END_TEST
+
+
+START_TEST (test_string_pool)
+{
+  SedDocument doc;
+  SedTask* task = doc.createTask();
+  task->setId("t1");
+  task->setModelReference("m1");
+
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg1");
+
+  for (int i = 0; i < 3; ++i)
+  {
+    SedVariable* variable = dg->createVariable();
+    variable->setId(i == 0 ? "v0" : i == 1 ? "v1" : "v2");
+    variable->setTaskReference("t1");
+    variable->setModelReference("m1");
+    variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S1']");
+  }
+
+  // t1, m1, dg1, v0, v1, v2 and the target, each stored once
+  SedStringPool& pool = doc.getStringPool();
+  fail_unless( pool.getNumStrings() == 7 );
+  fail_unless( dg->getVariable(2)->getTaskReference() == "t1" );
+
+  dg->getVariable(2)->setTaskReference("t2");
+  fail_unless( pool.getNumStrings() == 8 );
+  fail_unless( pool.purge() == 0 );
+  dg->getVariable(2)->unsetTaskReference();
+  fail_unless( pool.purge() == 1 );
+
+  SedString a = pool.intern("t1");
+  SedString b = pool.intern("t1");
+  fail_unless( a.isSameAs(b) );
+  fail_unless( a == SedString("t1") );
+  fail_unless( a != pool.intern("m1") );
+
+  // values read from a file are interned too
+  SedWriter writer;
+  char* text = writer.writeSedMLToString(&doc);
+  SedReader reader;
+  SedDocument* copy = reader.readSedMLFromString(text);
+  free(text);
+  fail_unless( copy->getStringPool().getNumStrings() == 7 );
+  fail_unless( copy->getTask(0)->getId() == "t1" );
+  delete copy;
+
+  // a copy of the document interns its strings in its own pool
+  copy = doc.clone();
+  fail_unless( copy->getStringPool().getNumStrings() == 7 );
+  fail_unless( copy->getTask(0)->getId() == "t1" );
+  fail_unless( &copy->getTask(0)->getId() != &doc.getTask(0)->getId() );
+  fail_unless( &copy->getDataGenerator(0)->getVariable(0)->getTaskReference()
+               == &copy->getTask(0)->getId() );
+
+  SedDocument assigned;
+  assigned = doc;
+  fail_unless( assigned.getStringPool().getNumStrings() == 7 );
+  fail_unless( &assigned.getTask(0)->getModelReference() != &doc.getTask(0)->getModelReference() );
+  delete copy;
+
+  // changing a reference many times does not keep every old value
+  for (int i = 0; i < 10000; ++i)
+  {
+    ostringstream id;
+    id << "t" << i;
+    task->setModelReference(id.str());
+  }
+
+  fail_unless( pool.getNumStrings() < 2100 );
+  fail_unless( task->getModelReference() == "t9999" );
+}
+END_TEST
+
+
+START_TEST (test_visitor_traversal)
+{
+  SedDocument doc;
+  doc.createModel()->setId("m1");
+  doc.createTask()->setId("t1");
+
+  for (int i = 0; i < 50; ++i)
+  {
+    ostringstream id;
+    id << "dg" << i;
+    SedDataGenerator* dg = doc.createDataGenerator();
+    dg->setId(id.str());
+    dg->createVariable()->setId(id.str() + "_v");
+  }
+
+  IdCollector serial;
+  fail_unless( doc.accept(serial) == true );
+  fail_unless( serial.ids.find("m1 t1 dg0 dg0_v dg1 dg1_v ") != string::npos );
+  fail_unless( serial.ids.find("dg49 dg49_v ") != string::npos );
+
+  // the data generator list is cut into 7 chunks of up to 8 items
+  IdCollector parallel;
+  SedParallelVisitor driver(4, 8);
+  fail_unless( driver.run(&doc, parallel) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( parallel.ids == serial.ids );
+  fail_unless( parallel.numLists == serial.numLists );
+
+  IdCollector pruned(true);
+  fail_unless( driver.run(&doc, pruned) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( pruned.ids.find("dg0 dg1 ") != string::npos );
+  fail_unless( pruned.ids.find("_v") == string::npos );
+
+  // skipping the children of the first item still visits the others
+  IdCollector serialPruned(true);
+  doc.accept(serialPruned);
+  fail_unless( serialPruned.ids == pruned.ids );
+  fail_unless( serialPruned.ids.find("dg48 dg49 ") != string::npos );
+
+  fail_unless( driver.run(NULL, pruned) == LIBSEDML_INVALID_OBJECT );
+  fail_unless( SedParallelVisitor::getHardwareConcurrency() >= 1 );
+}
+END_TEST
+
+
+START_TEST (test_typed_visitor)
+{
+  SedDocument doc;
+  doc.createTask();
+  SedRepeatedTask* repeat = doc.createRepeatedTask();
+  repeat->createUniformRange();
+  repeat->createVectorRange();
+  repeat->createFunctionalRange();
+  doc.createPlot2D()->createCurve();
+
+  RangeCounter counter;
+  fail_unless( counter.dispatch(*repeat->getRange(0)) == true );
+  fail_unless( counter.numUniform == 1 );
+
+  counter.traverse(doc);
+  fail_unless( counter.numUniform == 2 );
+  fail_unless( counter.numOtherRanges == 2 );
+  fail_unless( counter.numTasks == 2 );
+
+  // the document, its six lists, the list of ranges and the empty lists
+  // of changes and subtasks; the curve of the plot is not reached
+  fail_unless( counter.numOther == 10 );
+}
+END_TEST
+
+
+START_TEST (test_serializer)
+{
+  const char* text =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <notes><p xmlns='http://www.w3.org/1999/xhtml'>A simple time course</p></notes>\n"
+    "  <listOfSimulations>\n"
+    "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' outputEndTime='10' numberOfPoints='100'>\n"
+    "      <algorithm kisaoID='KISAO:0000019'/>\n"
+    "    </uniformTimeCourse>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='model1' language='urn:sedml:language:sbml' source='model1.xml'/>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <task id='task1' modelReference='model1' simulationReference='sim1'/>\n"
+    "  </listOfTasks>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='t' taskReference='task1' symbol='urn:sedml:symbol:time'/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'>\n"
+    "        <apply><times/><cn> 0.1 </cn><ci> t </ci></apply>\n"
+    "      </math>\n"
+    "    </dataGenerator>\n"
+    "    <dataGenerator id='dg2'>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='u' taskReference='task1' symbol='urn:sedml:symbol:time'/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><ci> u </ci></math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "</sedML>\n";
+
+  SedReader reader;
+  SedDocument* doc = reader.readSedMLFromString(text);
+  SedCanonicalForm canonical;
+
+  std::string data = SedSerializer::serialize(doc);
+  fail_unless( !data.empty() );
+
+  SedDocument* copy = SedSerializer::deserialize(data);
+  fail_unless( copy != NULL );
+  fail_unless( SedSerializer::getObject(copy, data) == copy );
+  fail_unless( canonical.hash(copy) == canonical.hash(doc) );
+  fail_unless( copy->isSetNotes() );
+  fail_unless( copy->getDataGenerator("dg1")->getMath()->getNumChildren() == 2 );
+  delete copy;
+
+  // an object inside a document comes with what it depends on
+  data = SedSerializer::serialize(doc->getDataGenerator("dg2"));
+  copy = SedSerializer::deserialize(data);
+  fail_unless( copy != NULL );
+
+  SedBase* object = SedSerializer::getObject(copy, data);
+  fail_unless( object != NULL );
+  fail_unless( object->getId() == "dg2" );
+  fail_unless( copy->getNumDataGenerators() == 1 );
+  fail_unless( copy->getTask("task1") != NULL );
+  fail_unless( copy->getModel("model1") != NULL );
+  delete copy;
+
+  // so does one below a top level element
+  data = SedSerializer::serialize(doc->getDataGenerator("dg1")->getVariable(0));
+  copy = SedSerializer::deserialize(data);
+  object = SedSerializer::getObject(copy, data);
+  fail_unless( object != NULL );
+  fail_unless( object->getId() == "t" );
+  delete copy;
+
+  // a detached top level element is written in a document of its own
+  SedModel model(1, 2);
+  model.setId("detached");
+  model.setSource("detached.xml");
+  data = SedSerializer::serialize(&model);
+  copy = SedSerializer::deserialize(data);
+  fail_unless( copy != NULL );
+  fail_unless( SedSerializer::getObject(copy, data) == copy->getModel("detached") );
+  delete copy;
+
+  fail_unless( SedSerializer::deserialize("") == NULL );
+  fail_unless( SedSerializer::deserialize(data.substr(0, data.size() - 1)) == NULL );
+
+  delete doc;
+}
+END_TEST
+
+START_TEST (test_trace)
+{
+  const char* text =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <annotation><info xmlns='urn:example'/></annotation>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='t' taskReference='task1' symbol='urn:sedml:symbol:time'/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><ci> t </ci></math>\n"
+    "    </dataGenerator>\n"
+    "    <dataGenerator id='dg2'>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><cn> 1 </cn></math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "</sedML>\n";
+
+  SedTrace trace;
+  trace.setRecordEvents(true);
+
+  SedReader reader;
+  reader.setTrace(&trace);
+  SedDocument* doc = reader.readSedMLFromString(text);
+  fail_unless( doc->getTrace() == NULL );
+
+  const SedTraceCounter* counter = trace.getCounter("document", "read");
+  fail_unless( counter != NULL );
+  fail_unless( counter->count == 1 );
+  fail_unless( counter->bytes == strlen(text) );
+
+  counter = trace.getCounter("read", "dataGenerator");
+  fail_unless( counter != NULL );
+  fail_unless( counter->count == 2 );
+  fail_unless( counter->selfNanoseconds <= counter->nanoseconds );
+  fail_unless( trace.getCounter("createObject", "variable")->count == 1 );
+  fail_unless( trace.getCounter("xml", "math")->count == 2 );
+  fail_unless( trace.getCounter("xml", "annotation")->count == 1 );
+  fail_unless( trace.getTotal("read").count == 6 );
+  fail_unless( trace.getNumEvents() > 0 );
+  fail_unless( trace.toChromeTrace().find("\"cat\":\"xml\"") != std::string::npos );
+
+  // the bytes of the elements add up to the size of the output
+  trace.clear();
+  SedWriter writer;
+  writer.setTrace(&trace);
+  char* written = writer.writeSedMLToString(doc);
+  fail_unless( doc->getTrace() == NULL );
+  fail_unless( trace.getCounter("write", "dataGenerator")->count == 2 );
+  fail_unless( trace.getCounter("write", "sedML")->bytes <=
+               trace.getCounter("document", "write")->bytes );
+  fail_unless( trace.getCounter("document", "write")->bytes + 1 == strlen(written) );
+  free(written);
+
+  // nothing is recorded without a trace
+  trace.clear();
+  written = SedWriter().writeSedMLToString(doc);
+  fail_unless( trace.getNumCounters() == 0 );
+  free(written);
+
+  delete doc;
+}
+END_TEST
+
+START_TEST (test_memory_footprint)
+{
+  const char* text =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <notes><p xmlns='http://www.w3.org/1999/xhtml'>A scan over k1</p></notes>\n"
+    "  <listOfSimulations>\n"
+    "    <steadyState id='sim1'><algorithm kisaoID='KISAO:0000282'/></steadyState>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='model1' language='urn:sedml:language:sbml' source='model1.xml'/>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <task id='task1' modelReference='model1' simulationReference='sim1'/>\n"
+    "    <repeatedTask id='scan' range='r' resetModel='true'>\n"
+    "      <listOfRanges><vectorRange id='r'><value>1</value><value>2</value></vectorRange></listOfRanges>\n"
+    "      <listOfSubTasks><subTask order='1' task='task1'/></listOfSubTasks>\n"
+    "    </repeatedTask>\n"
+    "  </listOfTasks>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='x' taskReference='scan' target='/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id=&apos;S1&apos;]'/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'>\n"
+    "        <apply><times/><cn> 2 </cn><ci> x </ci></apply>\n"
+    "      </math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "</sedML>\n";
+
+  SedReader reader;
+  SedDocument* doc = reader.readSedMLFromString(text);
+
+  SedMemoryFootprint footprint = doc->getMemoryFootprint();
+  fail_unless( footprint.getNumObjects(SEDML_DOCUMENT) == 1 );
+  fail_unless( footprint.getNumObjects(SEDML_DATAGENERATOR) == 1 );
+  fail_unless( footprint.getNumObjects(SEDML_RANGE_VECTORRANGE) == 1 );
+  fail_unless( footprint.getBytes(SEDML_DATAGENERATOR) >= sizeof(SedDataGenerator) );
+  fail_unless( footprint.getMathBytes() > 0 );
+  fail_unless( footprint.getXMLBytes() > 0 );
+  fail_unless( footprint.getNamespaceBytes() > 0 );
+  fail_unless( footprint.getValueBytes() >= 2 * sizeof(double) );
+
+  // what is not shared is charged to a type code
+  size_t charged = 0;
+  for (unsigned int n = 0; n < footprint.getNumTypeCodes(); ++n)
+    charged += footprint.getBytes(footprint.getTypeCode(n));
+  fail_unless( charged + footprint.getSharedStringBytes() == footprint.getTotalBytes() );
+
+  // part of the document uses less
+  SedMemoryFootprint part = doc->getDataGenerator("dg1")->getMemoryFootprint();
+  fail_unless( part.getNumObjects(SEDML_DOCUMENT) == 0 );
+  fail_unless( part.getTotalBytes() < footprint.getTotalBytes() );
+
+  // values are counted with their capacity
+  std::vector<double> values(10000, 1.0);
+  static_cast<SedVectorRange*>(static_cast<SedRepeatedTask*>(doc->getTask("scan"))->getRange(0))->setValues(values);
+  SedMemoryFootprint larger = doc->getMemoryFootprint();
+  fail_unless( larger.getValueBytes() >= values.size() * sizeof(double) );
+  fail_unless( larger.getBytes(SEDML_RANGE_VECTORRANGE) >
+               footprint.getBytes(SEDML_RANGE_VECTORRANGE) );
+
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_lazy_notes)
+{
+  const char* text =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <notes><p xmlns='http://www.w3.org/1999/xhtml'>A  note</p></notes>\n"
+    "      <annotation><info xmlns='urn:example'/></annotation>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><cn> 1 </cn></math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "</sedML>\n";
+  const char* notes =
+    "<notes><p xmlns=\"http://www.w3.org/1999/xhtml\">A  note</p></notes>";
+  const char* annotation =
+    "<annotation><info xmlns=\"urn:example\"/></annotation>";
+
+  SedReader reader;
+  fail_unless( reader.getLazyNotesAndAnnotations() == false );
+  fail_unless( reader.setLazyNotesAndAnnotations(true) == LIBSEDML_OPERATION_SUCCESS );
+
+  SedDocument* doc = reader.readSedMLFromString(text);
+  fail_unless( doc->getNumErrors(LIBSEDML_SEV_ERROR) == 0 );
+  fail_unless( doc->getLazyNotesAndAnnotations() == false );
+
+  SedDataGenerator* dg = doc->getDataGenerator(0);
+  fail_unless( dg->hasUnparsedNotes() );
+  fail_unless( dg->hasUnparsedAnnotation() );
+  fail_unless( dg->isSetNotes() );
+  fail_unless( dg->isSetAnnotation() );
+
+  // untouched notes and annotation are written as they were read
+  SedWriter writer;
+  char* xml = writer.writeSedMLToString(doc);
+  std::string written = xml;
+  free(xml);
+  fail_unless( written.find(notes) != std::string::npos );
+  fail_unless( written.find(annotation) != std::string::npos );
+  fail_unless( dg->hasUnparsedNotes() );
+
+  // copies keep the text
+  SedDataGenerator* copy = dg->clone();
+  fail_unless( copy->hasUnparsedNotes() );
+  fail_unless( copy->hasUnparsedAnnotation() );
+  delete copy;
+
+  // the first request parses them
+  XMLNode* node = dg->getNotes();
+  fail_unless( node != NULL );
+  fail_unless( node->getName() == "notes" );
+  fail_unless( node->getNumChildren() == 1 );
+  fail_unless( !dg->hasUnparsedNotes() );
+
+  node = dg->getAnnotation();
+  fail_unless( node != NULL );
+  fail_unless( node->getChild(0).getName() == "info" );
+  fail_unless( !dg->hasUnparsedAnnotation() );
+
+  // changes replace the text
+  delete doc;
+  doc = reader.readSedMLFromString(text);
+  dg = doc->getDataGenerator(0);
+  fail_unless( dg->unsetNotes() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( !dg->isSetNotes() );
+  fail_unless( dg->unsetAnnotation() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( !dg->isSetAnnotation() );
+  xml = writer.writeSedMLToString(doc);
+  written = xml;
+  free(xml);
+  fail_unless( written.find("<notes>") == std::string::npos );
+  fail_unless( written.find("<annotation>") == std::string::npos );
+  delete doc;
+
+  // without the option everything is parsed while reading
+  doc = readSedMLFromString(text);
+  dg = doc->getDataGenerator(0);
+  fail_unless( !dg->hasUnparsedNotes() );
+  fail_unless( !dg->hasUnparsedAnnotation() );
+  fail_unless( dg->getNotes() != NULL );
+  delete doc;
+
+  // an annotation kept as text is checked while reading, and logs what
+  // reading it eagerly logs; parsing it later logs nothing
+  std::string duplicate = text;
+  duplicate.replace(duplicate.find("<info xmlns='urn:example'/>"), 27,
+                    "<info xmlns='urn:example'/>\n <more xmlns='urn:example'/>");
+  doc = readSedMLFromString(duplicate.c_str());
+  unsigned int numErrors = doc->getNumErrors();
+  delete doc;
+
+  doc = reader.readSedMLFromString(duplicate.c_str());
+  fail_unless( doc->getNumErrors() == numErrors );
+  fail_unless( doc->getDataGenerator(0)->hasUnparsedAnnotation() );
+  fail_unless( doc->getDataGenerator(0)->getAnnotation() != NULL );
+  fail_unless( doc->getNumErrors() == numErrors );
+
+  // a copy made after parsing gets the parsed XML
+  copy = doc->getDataGenerator(0)->clone();
+  fail_unless( !copy->hasUnparsedAnnotation() );
+  fail_unless( copy->getAnnotation()->getNumChildren() == 2 );
+  delete copy;
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_selective_read)
+{
+  const char* text =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <listOfSimulations>\n"
+    "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' outputEndTime='10' numberOfPoints='100'>\n"
+    "      <algorithm kisaoID='KISAO:0000019'/>\n"
+    "    </uniformTimeCourse>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='model1' language='urn:sedml:language:sbml' source='model1.xml'>\n"
+    "      <listOfChanges>\n"
+    "        <changeAttribute target='/sbml:sbml/sbml:model' newValue='1'/>\n"
+    "      </listOfChanges>\n"
+    "    </model>\n"
+    "    <model id='model2' language='urn:sedml:language:sbml' source='model2.xml'/>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <task id='task1' modelReference='model1' simulationReference='sim1'/>\n"
+    "    <task id='task2' modelReference='model2' simulationReference='sim1'/>\n"
+    "  </listOfTasks>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'><cn> 1 </cn></math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "</sedML>\n";
+
+  SedReader reader;
+  fail_unless( !reader.isSetElementsToRead() );
+  fail_unless( reader.addTypeToRead(SEDML_LIST_OF) == LIBSEDML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( reader.addListToRead("notes") == LIBSEDML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( !reader.isSetElementsToRead() );
+
+  fail_unless( reader.addTypeToRead(SEDML_MODEL) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( reader.addTypeToRead(SEDML_SIMULATION) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( reader.addTypeToRead(SEDML_SIMULATION_ALGORITHM) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( reader.isSetElementsToRead() );
+
+  // only the models, simulations and algorithms are created
+  SedDocument* doc = reader.readSedMLFromString(text);
+  fail_unless( doc->getNumErrors(LIBSEDML_SEV_ERROR) == 0 );
+  fail_unless( doc->getElementFilter() == NULL );
+  fail_unless( doc->getNumModels() == 2 );
+  fail_unless( doc->getModel(0)->getSource() == "model1.xml" );
+  fail_unless( doc->getModel(0)->getNumChanges() == 0 );
+  fail_unless( doc->getNumSimulations() == 1 );
+  fail_unless( doc->getSimulation(0)->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE );
+  fail_unless( doc->getSimulation(0)->getAlgorithm()->getKisaoID() == "KISAO:0000019" );
+  fail_unless( doc->getNumTasks() == 0 );
+  fail_unless( doc->getNumDataGenerators() == 0 );
+  delete doc;
+
+  // a list is read with everything in it
+  fail_unless( reader.addListToRead("listOfTasks") == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( reader.addListToRead("listOfChanges") == LIBSEDML_OPERATION_SUCCESS );
+  doc = reader.readSedMLFromString(text);
+  fail_unless( doc->getNumErrors(LIBSEDML_SEV_ERROR) == 0 );
+  fail_unless( doc->getNumTasks() == 2 );
+  fail_unless( doc->getModel(0)->getNumChanges() == 1 );
+  fail_unless( doc->getNumDataGenerators() == 0 );
+  delete doc;
+
+  // the parents of the objects are needed
+  fail_unless( reader.clearElementsToRead() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( reader.addTypeToRead(SEDML_SIMULATION_ALGORITHM) == LIBSEDML_OPERATION_SUCCESS );
+  doc = reader.readSedMLFromString(text);
+  fail_unless( doc->getNumSimulations() == 0 );
+  delete doc;
+
+  fail_unless( reader.clearElementsToRead() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( !reader.isSetElementsToRead() );
+  doc = reader.readSedMLFromString(text);
+  fail_unless( doc->getNumTasks() == 2 );
+  fail_unless( doc->getNumDataGenerators() == 1 );
+  delete doc;
+}
+END_TEST
+
+
 Suite *
 create_suite_SedMLIssues (void)
 {
@@ -117,6 +1947,29 @@ create_suite_SedMLIssues (void)
   cout << "  libSEDML : " << getLibSEDMLDottedVersion() << endl << endl;
  
   tcase_add_test( tcase, test_mathml_issue1         );
+  tcase_add_test( tcase, test_writer_fragment_cache );
+  tcase_add_test( tcase, test_canonical_hash );
+  tcase_add_test( tcase, test_structural_patch );
+  tcase_add_test( tcase, test_dependency_closure );
+  tcase_add_test( tcase, test_merge_documents );
+  tcase_add_test( tcase, test_target_resolver );
+  tcase_add_test( tcase, test_change_engine );
+  tcase_add_test( tcase, test_model_repository );
+  tcase_add_test( tcase, test_prepared_task_changes );
+  tcase_add_test( tcase, test_compiled_math );
+  tcase_add_test( tcase, test_time_grid );
+  tcase_add_test( tcase, test_downsampler );
+  tcase_add_test( tcase, test_evaluation_plan );
+  tcase_add_test( tcase, test_task_deduplication );
+  tcase_add_test( tcase, test_frozen_document );
+  tcase_add_test( tcase, test_string_pool );
+  tcase_add_test( tcase, test_visitor_traversal );
+  tcase_add_test( tcase, test_typed_visitor );
+  tcase_add_test( tcase, test_serializer );
+  tcase_add_test( tcase, test_trace );
+  tcase_add_test( tcase, test_memory_footprint );
+  tcase_add_test( tcase, test_lazy_notes );
+  tcase_add_test( tcase, test_selective_read );
 
   suite_add_tcase(suite, tcase);
 